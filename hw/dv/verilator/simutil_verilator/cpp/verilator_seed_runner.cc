@@ -0,0 +1,337 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "verilator_seed_runner.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <signal.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "verilator_sim_ctrl.h"
+
+#ifdef VM_TRACE_FMT_FST
+static const char kTraceFileExt[] = ".fst";
+#else
+static const char kTraceFileExt[] = ".vcd";
+#endif
+
+/**
+ * Parse the value of a --name=value argument if `arg` is one
+ *
+ * @return true if `arg` is a --name=value argument, with the value in `value`
+ */
+static bool match_arg(const char *arg, const char *name, const char **value) {
+  size_t name_len = strlen(name);
+  if (strncmp(arg, "--", 2) != 0 || strncmp(arg + 2, name, name_len) != 0 ||
+      arg[2 + name_len] != '=') {
+    return false;
+  }
+  *value = arg + 2 + name_len + 1;
+  return true;
+}
+
+static bool read_ul_arg(unsigned long *arg_val, const char *arg_name,
+                        const char *arg_text) {
+  char *txt_end;
+  errno = 0;
+  if ('0' <= arg_text[0] && arg_text[0] <= '9') {
+    *arg_val = strtoul(arg_text, &txt_end, 0);
+    if (*txt_end == '\0' && errno == 0) {
+      return true;
+    }
+  }
+  std::cerr << "ERROR: Bad format for " << arg_name << " argument: `"
+            << arg_text << "' is not an unsigned integer.\n";
+  return false;
+}
+
+static double seconds(std::chrono::steady_clock::duration duration) {
+  return std::chrono::duration<double>(duration).count();
+}
+
+VerilatorSeedRunner::VerilatorSeedRunner(SimFunction sim)
+    : sim_(sim),
+      num_seeds_(0),
+      first_seed_(1),
+      num_jobs_(0),
+      log_dir_(".") {}
+
+int VerilatorSeedRunner::Exec(int argc, char **argv) {
+  if (!ParseCommandArgs(argc, argv)) {
+    return 1;
+  }
+  if (num_seeds_ == 0) {
+    return sim_(argc, argv);
+  }
+
+  if (num_jobs_ == 0) {
+    long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    num_jobs_ = num_cpus > 0 ? num_cpus : 1;
+  }
+  if (num_jobs_ > num_seeds_) {
+    num_jobs_ = num_seeds_;
+  }
+
+  if (mkdir(log_dir_.c_str(), 0755) != 0 && errno != EEXIST) {
+    std::cerr << "ERROR: Unable to create " << log_dir_ << ": "
+              << strerror(errno) << std::endl;
+    return 1;
+  }
+
+  std::cout << "Running " << num_seeds_ << " seeds starting at " << first_seed_
+            << " in " << num_jobs_ << " parallel jobs, logs are written to "
+            << log_dir_ << std::endl
+            << std::endl;
+
+  Run();
+  PrintStatistics();
+
+  if (results_.size() != num_seeds_) {
+    return 1;
+  }
+  for (const SeedResult &result : results_) {
+    if (!result.passed) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+bool VerilatorSeedRunner::ParseCommandArgs(int argc, char **argv) {
+  sim_args_.clear();
+  for (int i = 0; i < argc; ++i) {
+    const char *value;
+    if (i > 0 && match_arg(argv[i], "seeds", &value)) {
+      if (!read_ul_arg(&num_seeds_, "seeds", value)) {
+        return false;
+      }
+    } else if (i > 0 && match_arg(argv[i], "seed", &value)) {
+      if (!read_ul_arg(&first_seed_, "seed", value)) {
+        return false;
+      }
+      // Verilator picks a random seed if given 0, which can't be reproduced.
+      if (first_seed_ == 0) {
+        std::cerr << "ERROR: The seed must be non-zero.\n";
+        return false;
+      }
+    } else if (i > 0 && match_arg(argv[i], "jobs", &value)) {
+      if (!read_ul_arg(&num_jobs_, "jobs", value)) {
+        return false;
+      }
+    } else if (i > 0 && match_arg(argv[i], "log-dir", &value)) {
+      log_dir_ = value;
+    } else {
+      sim_args_.push_back(argv[i]);
+    }
+  }
+  return true;
+}
+
+std::vector<std::string> VerilatorSeedRunner::GetSimArgs(
+    unsigned long seed) const {
+  std::string prefix = log_dir_ + "/seed_" + std::to_string(seed);
+  std::vector<std::string> args;
+  for (const std::string &arg : sim_args_) {
+    // Every worker writes its own trace.
+    if (arg == "-t" || arg == "--trace" || arg.rfind("--trace=", 0) == 0) {
+      args.push_back("--trace=" + prefix + kTraceFileExt);
+    } else {
+      args.push_back(arg);
+    }
+  }
+  args.push_back("+verilator+seed+" + std::to_string(seed));
+  return args;
+}
+
+void VerilatorSeedRunner::RunWorker(unsigned long seed, int result_fd) {
+  signal(SIGINT, SIG_DFL);
+
+  std::string log_path = log_dir_ + "/seed_" + std::to_string(seed) + ".log";
+  int log_fd = open(log_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (log_fd < 0) {
+    std::cerr << "ERROR: Unable to open " << log_path << ": "
+              << strerror(errno) << std::endl;
+    _exit(1);
+  }
+  dup2(log_fd, STDOUT_FILENO);
+  dup2(log_fd, STDERR_FILENO);
+  close(log_fd);
+
+  std::vector<std::string> args = GetSimArgs(seed);
+  std::vector<char *> argv;
+  for (std::string &arg : args) {
+    argv.push_back(&arg[0]);
+  }
+  argv.push_back(nullptr);
+
+  int ret_code = sim_(args.size(), argv.data());
+
+  unsigned long cycles = VerilatorSimCtrl::GetInstance().GetTime() / 2;
+  if (write(result_fd, &cycles, sizeof(cycles)) != sizeof(cycles)) {
+    ret_code = 1;
+  }
+  close(result_fd);
+
+  std::cout.flush();
+  std::cerr.flush();
+  fflush(nullptr);
+  _exit(ret_code);
+}
+
+void VerilatorSeedRunner::Run() {
+  // Ctrl-C stops the workers, which then report their results as usual.
+  signal(SIGINT, SIG_IGN);
+
+  // Result index and result pipe of every running worker
+  std::map<pid_t, std::pair<size_t, int>> workers;
+  unsigned long next_seed = 0;
+
+  results_.clear();
+  time_begin_ = std::chrono::steady_clock::now();
+
+  while (next_seed < num_seeds_ || !workers.empty()) {
+    if (next_seed < num_seeds_ && workers.size() < num_jobs_) {
+      SeedResult result = {};
+      result.seed = first_seed_ + next_seed;
+      result.time_begin = std::chrono::steady_clock::now();
+
+      int result_fds[2];
+      pid_t pid = -1;
+      if (pipe(result_fds) == 0) {
+        std::cout.flush();
+        fflush(nullptr);
+        pid = fork();
+        if (pid == 0) {
+          close(result_fds[0]);
+          RunWorker(result.seed, result_fds[1]);
+        }
+        close(result_fds[1]);
+        if (pid < 0) {
+          close(result_fds[0]);
+        }
+      }
+
+      if (pid > 0) {
+        results_.push_back(result);
+        workers[pid] = std::make_pair(results_.size() - 1, result_fds[0]);
+        ++next_seed;
+        continue;
+      }
+      std::cerr << "ERROR: Unable to start worker: " << strerror(errno)
+                << std::endl;
+      if (workers.empty()) {
+        break;
+      }
+      // Only start the remaining seeds after others have finished.
+      num_jobs_ = workers.size();
+    }
+
+    int status;
+    pid_t pid = wait(&status);
+    if (pid < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+    auto worker = workers.find(pid);
+    if (worker == workers.end()) {
+      continue;
+    }
+
+    SeedResult &result = results_[worker->second.first];
+    int result_fd = worker->second.second;
+    result.time_end = std::chrono::steady_clock::now();
+    result.crashed = !WIFEXITED(status);
+    result.passed = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    if (read(result_fd, &result.cycles, sizeof(result.cycles)) !=
+        sizeof(result.cycles)) {
+      result.cycles = 0;
+    }
+    close(result_fd);
+    workers.erase(worker);
+
+    std::cout << "Seed " << result.seed << ": "
+              << (result.passed ? "PASSED"
+                                : (result.crashed ? "CRASHED" : "FAILED"))
+              << std::endl;
+  }
+
+  time_end_ = std::chrono::steady_clock::now();
+  signal(SIGINT, SIG_DFL);
+}
+
+void VerilatorSeedRunner::PrintStatistics() const {
+  unsigned long num_passed = 0;
+  unsigned long total_cycles = 0;
+  double total_seed_time = 0.0;
+  double total_seed_speed = 0.0;
+
+  std::cout << std::endl
+            << "Seed results" << std::endl
+            << "============" << std::endl
+            << std::setw(12) << "Seed" << std::setw(9) << "Result"
+            << std::setw(14) << "Cycles" << std::setw(12) << "Time [s]"
+            << std::setw(18) << "Speed [cycles/s]" << std::endl;
+
+  for (const SeedResult &result : results_) {
+    double time = seconds(result.time_end - result.time_begin);
+    double speed = time > 0.0 ? result.cycles / time : 0.0;
+    num_passed += result.passed;
+    total_cycles += result.cycles;
+    total_seed_time += time;
+    total_seed_speed += speed;
+
+    std::cout << std::setw(12) << result.seed << std::setw(9)
+              << (result.passed ? "PASSED"
+                                : (result.crashed ? "CRASHED" : "FAILED"))
+              << std::setw(14) << result.cycles << std::setw(12) << std::fixed
+              << std::setprecision(3) << time << std::setw(18)
+              << std::setprecision(1) << speed << std::endl;
+  }
+  std::cout.unsetf(std::ios_base::floatfield);
+  std::cout << std::setprecision(6);
+
+  double wall_time = seconds(time_end_ - time_begin_);
+  double speedup = wall_time > 0.0 ? total_seed_time / wall_time : 0.0;
+
+  std::cout << std::endl
+            << "Seed statistics" << std::endl
+            << "===============" << std::endl
+            << "Seeds passed:      " << num_passed << " of " << num_seeds_
+            << std::endl
+            << "Parallel jobs:     " << num_jobs_ << std::endl
+            << "Executed cycles:   " << total_cycles << std::endl
+            << "Wallclock time:    " << wall_time << " s" << std::endl
+            << "Throughput:        "
+            << (wall_time > 0.0 ? total_cycles / wall_time : 0.0)
+            << " cycles/s" << std::endl
+            << "Speed per seed:    "
+            << (results_.empty() ? 0.0 : total_seed_speed / results_.size())
+            << " cycles/s (mean)" << std::endl
+            << "Parallel speedup:  " << speedup << "x with " << num_jobs_
+            << " jobs (" << 100.0 * speedup / num_jobs_ << " % efficiency)"
+            << std::endl;
+
+  if (num_passed != num_seeds_) {
+    std::cout << std::endl << "Failing seeds:";
+    for (const SeedResult &result : results_) {
+      if (!result.passed) {
+        std::cout << " " << result.seed;
+      }
+    }
+    std::cout << std::endl
+              << "Rerun a seed with --seeds=1 --seed=<seed>, see "
+              << log_dir_ << "/seed_<seed>.log for its output." << std::endl;
+  }
+}
@@ -0,0 +1,94 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_VERILATOR_SEED_RUNNER_H_
+#define OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_VERILATOR_SEED_RUNNER_H_
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Runner repeating a simulation with different random seeds
+ *
+ * The simulation is given as a function with the signature of main(), which
+ * sets up and executes a simulation through VerilatorSimCtrl. Without the
+ * command line arguments of the runner, Exec() simply calls this function once.
+ *
+ * With --seeds=N, Exec() instead runs the simulation once for each of N seeds
+ * in worker processes, up to --jobs=J of them in parallel. Every worker gets
+ * the original command line arguments plus +verilator+seed+<seed>, which seeds
+ * $random and $urandom in the design. Its output is written to
+ * seed_<seed>.log in the --log-dir=DIR directory, as is its trace if one was
+ * requested with --trace. Once all seeds are done, the pass/fail status,
+ * executed cycles and simulation speed of every seed are reported, together
+ * with the throughput of the whole run and its speedup over running the seeds
+ * one after the other.
+ */
+class VerilatorSeedRunner {
+ public:
+  using SimFunction = std::function<int(int argc, char **argv)>;
+
+  explicit VerilatorSeedRunner(SimFunction sim);
+
+  /**
+   * Run the simulation once, or once for every seed
+   *
+   * @return a main()-compatible process exit code, 0 if the simulation passed
+   *         for all seeds and 1 otherwise.
+   */
+  int Exec(int argc, char **argv);
+
+ private:
+  struct SeedResult {
+    unsigned long seed;
+    bool passed;
+    bool crashed;
+    unsigned long cycles;
+    std::chrono::steady_clock::time_point time_begin;
+    std::chrono::steady_clock::time_point time_end;
+  };
+
+  SimFunction sim_;
+  unsigned long num_seeds_;
+  unsigned long first_seed_;
+  unsigned long num_jobs_;
+  std::string log_dir_;
+  std::vector<std::string> sim_args_;
+  std::vector<SeedResult> results_;
+  std::chrono::steady_clock::time_point time_begin_;
+  std::chrono::steady_clock::time_point time_end_;
+
+  /**
+   * Parse the arguments of the runner and keep all others for the simulation
+   *
+   * @return Return code, true == success
+   */
+  bool ParseCommandArgs(int argc, char **argv);
+
+  /**
+   * Get the command line arguments of the simulation for a seed
+   */
+  std::vector<std::string> GetSimArgs(unsigned long seed) const;
+
+  /**
+   * Run the simulation for a seed in the current process and exit
+   *
+   * The number of executed cycles is written to `result_fd`.
+   */
+  [[noreturn]] void RunWorker(unsigned long seed, int result_fd);
+
+  /**
+   * Run all seeds in worker processes
+   */
+  void Run();
+
+  /**
+   * Print the results of all seeds and the overall throughput
+   */
+  void PrintStatistics() const;
+};
+
+#endif  // OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_VERILATOR_SEED_RUNNER_H_
@@ -118,98 +118,281 @@ void c_dpi_aes_crypt_block(const unsigned char impl_i, const unsigned char op_i,
   return;
 }
 
-void c_dpi_aes_crypt_message(unsigned char impl_i, unsigned char op_i,
-                             const svBitVecVal *mode_i, const svBitVecVal *iv_i,
-                             const svBitVecVal *key_len_i,
-                             const svBitVecVal *key_i,
-                             const svOpenArrayHandle data_i,
-                             svOpenArrayHandle data_o) {
-  // Mask out unused bits as their value is undetermined.
-  const unsigned char impl = impl_i & impl_mask;
-  const unsigned char op = op_i & op_mask;
-  const crypto_mode_t mode = (crypto_mode_t)(*mode_i & mode_mask);
-  if (mode == kCryptoAesNone) {
-    printf(
-        "ERROR: Mode kCryptoAesNone not supported by c_dpi_aes_crypt_message");
-    return;
-  }
-
+/**
+ * Reference model context for encrypting/decrypting messages with one key.
+ */
+typedef struct aes_dpi_ctx {
+  unsigned char impl;
+  unsigned char op;
+  crypto_mode_t mode;
+  // Expanded key for the C model
+  aes_key_sched_t key_sched;
+  // Cipher context for OpenSSL/BoringSSL
+  crypto_ctx_t *crypto_ctx;
+} aes_dpi_ctx_t;
+
+// Number of blocks encrypted at once when generating key streams.
+#define AES_DPI_CHUNK_BLOCKS 64
+
+static int aes_key_len_get(const svBitVecVal *key_len_i) {
   // key_len_i is one-hot encoded.
-  int key_len;
   if ((*key_len_i & key_len_mask) == 0x1) {
-    key_len = 16;
+    return 16;
   } else if ((*key_len_i & key_len_mask) == 0x2) {
-    key_len = 24;
+    return 24;
   } else {  // 0x4
-    key_len = 32;
+    return 32;
   }
+}
 
-  if (impl == 0) {
-    // The C model is currently not supported.
-    printf(
-        "ERROR: c_dpi_aes_crypt_message() currently supports OpenSSL/BoringSSL "
-        "only\n");
-    return;
+static void aes_iv_get(const svBitVecVal *iv_i, unsigned char *iv) {
+  // iv_i is a 1D array of words (4x32bit), but we need 16 bytes.
+  for (int i = 0; i < 4; ++i) {
+    svBitVecVal value = iv_i[i];
+    iv[4 * i + 0] = (unsigned char)(value >> 0);
+    iv[4 * i + 1] = (unsigned char)(value >> 8);
+    iv[4 * i + 2] = (unsigned char)(value >> 16);
+    iv[4 * i + 3] = (unsigned char)(value >> 24);
   }
+}
 
-  // Get key from simulator.
-  unsigned char *key = aes_key_get(key_i);
+static void aes_xor_bytes(unsigned char *out, const unsigned char *a,
+                          const unsigned char *b, int len) {
+  for (int i = 0; i < len; ++i) {
+    out[i] = a[i] ^ b[i];
+  }
+}
 
-  // Modes other than ECB require an IV from the simulator.
-  unsigned char *iv = (unsigned char *)malloc(16 * sizeof(unsigned char));
-  assert(iv);
-  if (mode != kCryptoAesEcb) {
-    // iv_i is a 1D array of words (4x32bit), but we need 16 bytes.
-    svBitVecVal value;
-    for (int i = 0; i < 4; ++i) {
-      value = iv_i[i];
-      iv[4 * i + 0] = (unsigned char)(value >> 0);
-      iv[4 * i + 1] = (unsigned char)(value >> 8);
-      iv[4 * i + 2] = (unsigned char)(value >> 16);
-      iv[4 * i + 3] = (unsigned char)(value >> 24);
+// Increment the counter block as a 128-bit big-endian number.
+static void aes_ctr_inc(unsigned char *ctr) {
+  for (int i = 15; i >= 0; --i) {
+    if (++ctr[i]) {
+      break;
     }
+  }
+}
+
+/**
+ * Encrypt/decrypt a message with the C model, which does ECB only.
+ *
+ * The modes are emulated on top of the multi-block ECB functions. Blocks that
+ * don't depend on each other are passed to the model together, which is the
+ * case for ECB, CTR, CBC decryption and CFB decryption.
+ *
+ * @param  ctx    Context
+ * @param  iv     16-byte initialization vector
+ * @param  input  Input data, must not overlap output
+ * @param  output Output data
+ * @param  len    Length in bytes, a multiple of 16
+ */
+static void aes_model_crypt_message(const aes_dpi_ctx_t *ctx,
+                                    const unsigned char *iv,
+                                    const unsigned char *input,
+                                    unsigned char *output, int len) {
+  const aes_key_sched_t *key_sched = &ctx->key_sched;
+  const int num_blocks = len / 16;
+  unsigned char block[16];
+
+  if (num_blocks == 0) {
+    return;
+  }
+
+  if (ctx->mode == kCryptoAesEcb) {
+    if (!ctx->op) {
+      aes_encrypt_blocks(key_sched, input, output, num_blocks);
+    } else {
+      aes_decrypt_blocks(key_sched, input, output, num_blocks);
+    }
+  } else if (ctx->mode == kCryptoAesCtr) {
+    // Encrypt chunks of counter values to get the key stream.
+    unsigned char ctr[16];
+    unsigned char key_stream[16 * AES_DPI_CHUNK_BLOCKS];
+    memcpy(ctr, iv, 16);
+    for (int i = 0; i < num_blocks; i += AES_DPI_CHUNK_BLOCKS) {
+      int n = num_blocks - i < AES_DPI_CHUNK_BLOCKS ? num_blocks - i
+                                                    : AES_DPI_CHUNK_BLOCKS;
+      for (int j = 0; j < n; ++j) {
+        memcpy(&key_stream[16 * j], ctr, 16);
+        aes_ctr_inc(ctr);
+      }
+      aes_encrypt_blocks(key_sched, key_stream, key_stream, n);
+      aes_xor_bytes(&output[16 * i], &input[16 * i], key_stream, 16 * n);
+    }
+  } else if (ctx->mode == kCryptoAesCbc && ctx->op) {
+    // output = D(input) XOR previous input (or iv)
+    aes_decrypt_blocks(key_sched, input, output, num_blocks);
+    aes_xor_bytes(output, output, iv, 16);
+    aes_xor_bytes(&output[16], &output[16], input, 16 * (num_blocks - 1));
+  } else if (ctx->mode == kCryptoAesCfb && ctx->op) {
+    // output = E(previous input (or iv)) XOR input
+    aes_encrypt_blocks(key_sched, iv, output, 1);
+    aes_encrypt_blocks(key_sched, input, &output[16], num_blocks - 1);
+    aes_xor_bytes(output, output, input, len);
   } else {
-    memset(iv, 0, 16);
+    // CBC/CFB encryption and OFB chain every block to the one before.
+    const unsigned char *prev = iv;
+    for (int i = 0; i < num_blocks; ++i) {
+      const unsigned char *in = &input[16 * i];
+      unsigned char *out = &output[16 * i];
+      if (ctx->mode == kCryptoAesCbc) {
+        // output = E(input XOR previous output (or iv))
+        aes_xor_bytes(block, in, prev, 16);
+        aes_encrypt_blocks(key_sched, block, out, 1);
+        prev = out;
+      } else if (ctx->mode == kCryptoAesCfb) {
+        // output = E(previous output (or iv)) XOR input
+        aes_encrypt_blocks(key_sched, prev, block, 1);
+        aes_xor_bytes(out, block, in, 16);
+        prev = out;
+      } else {  // OFB
+        // output = E(previous key stream (or iv)) XOR input
+        aes_encrypt_blocks(key_sched, prev, block, 1);
+        aes_xor_bytes(out, block, in, 16);
+        prev = block;
+      }
+    }
+  }
+}
+
+static int aes_dpi_ctx_crypt(aes_dpi_ctx_t *ctx, const unsigned char *iv,
+                             const unsigned char *input, unsigned char *output,
+                             int len) {
+  if (len % 16) {
+    printf(
+        "ERROR: Message length must be a multiple of 16 bytes (the block "
+        "size).\n");
+    return -1;
+  }
+
+  if (ctx->impl == 0) {
+    aes_model_crypt_message(ctx, iv, input, output, len);
+    return len;
+  } else {  // OpenSSL/BoringSSL
+    return crypto_ctx_crypt(ctx->crypto_ctx, output, iv, input, len);
+  }
+}
+
+void *c_dpi_aes_ctx_new(unsigned char impl_i, unsigned char op_i,
+                        const svBitVecVal *mode_i,
+                        const svBitVecVal *key_len_i,
+                        const svBitVecVal *key_i) {
+  // Mask out unused bits as their value is undetermined.
+  const crypto_mode_t mode = (crypto_mode_t)(*mode_i & mode_mask);
+  if (mode == kCryptoAesNone) {
+    printf("ERROR: Mode kCryptoAesNone not supported by c_dpi_aes_ctx_new\n");
+    return NULL;
+  }
+
+  aes_dpi_ctx_t *ctx = (aes_dpi_ctx_t *)calloc(1, sizeof(aes_dpi_ctx_t));
+  assert(ctx);
+  ctx->impl = impl_i & impl_mask;
+  ctx->op = op_i & op_mask;
+  ctx->mode = mode;
+
+  const int key_len = aes_key_len_get(key_len_i);
+  unsigned char *key = aes_key_get(key_i);
+  int ret;
+  if (ctx->impl == 0) {
+    ret = aes_key_sched_init(&ctx->key_sched, key, key_len);
+  } else {  // OpenSSL/BoringSSL
+    ctx->crypto_ctx = crypto_ctx_new(ctx->op, key, key_len, mode);
+    ret = ctx->crypto_ctx ? 0 : -1;
   }
+  free(key);
+
+  if (ret) {
+    c_dpi_aes_ctx_free(ctx);
+    return NULL;
+  }
+  return ctx;
+}
 
-  // Get message length.
-  int data_len = svSize(data_i, 1);
+void c_dpi_aes_ctx_crypt_message(void *ctx_i, const svBitVecVal *iv_i,
+                                 const svOpenArrayHandle data_i,
+                                 svOpenArrayHandle data_o) {
+  aes_dpi_ctx_t *ctx = (aes_dpi_ctx_t *)ctx_i;
+
+  // Modes other than ECB require an IV from the simulator.
+  unsigned char iv[16] = {0};
+  if (ctx->mode != kCryptoAesEcb) {
+    aes_iv_get(iv_i, iv);
+  }
 
   // Get input data from simulator.
+  const int data_len = svSize(data_i, 1);
   unsigned char *ref_in = aes_data_unpacked_get(data_i);
+  unsigned char *ref_out =
+      (unsigned char *)calloc(data_len, sizeof(unsigned char));
+  assert(ref_out);
+
+  aes_dpi_ctx_crypt(ctx, iv, ref_in, ref_out, data_len);
 
-  // Allocate output buffer.
+  // Write output data back to simulator, free ref_out.
+  aes_data_unpacked_put(data_o, ref_out);
+  free(ref_in);
+}
+
+void c_dpi_aes_ctx_crypt_messages(void *ctx_i, const svOpenArrayHandle iv_i,
+                                  const svOpenArrayHandle msg_len_i,
+                                  const svOpenArrayHandle data_i,
+                                  svOpenArrayHandle data_o) {
+  aes_dpi_ctx_t *ctx = (aes_dpi_ctx_t *)ctx_i;
+  const int num_msgs = svSize(msg_len_i, 1);
+  const int data_len = svSize(data_i, 1);
+
+  // Get all messages from simulator at once.
+  unsigned char *ref_in = aes_data_unpacked_get(data_i);
   unsigned char *ref_out =
-      (unsigned char *)malloc(data_len * sizeof(unsigned char));
+      (unsigned char *)calloc(data_len, sizeof(unsigned char));
   assert(ref_out);
 
-  // OpenSSL/BoringSSL
-  if ((int)data_len % 16) {
-    printf(
-        "ERROR: Message length must be a multiple of 16 bytes (the block "
-        "size).\n");
-    return;
-  }
+  int offset = 0;
+  for (int i = 0; i < num_msgs; ++i) {
+    const int len = *(const int *)svGetArrElemPtr1(msg_len_i, i);
+    if (len < 0 || offset + len > data_len) {
+      printf(
+          "ERROR: Message lengths exceed the data passed to "
+          "c_dpi_aes_ctx_crypt_messages\n");
+      break;
+    }
 
-  if (impl == 0) {
-    // The C model is currently not supported.
-    printf(
-        "ERROR: c_dpi_aes_crypt_message() currently supports OpenSSL/BoringSSL "
-        "only\n");
-  } else {  // OpenSSL/BoringSSL
-    if (!op) {
-      crypto_encrypt(ref_out, iv, ref_in, data_len, key, key_len, mode);
-    } else {
-      crypto_decrypt(ref_out, iv, ref_in, data_len, key, key_len, mode);
+    unsigned char iv[16] = {0};
+    if (ctx->mode != kCryptoAesEcb) {
+      aes_iv_get((const svBitVecVal *)svGetArrElemPtr1(iv_i, i), iv);
+    }
+    if (aes_dpi_ctx_crypt(ctx, iv, &ref_in[offset], &ref_out[offset], len) <
+        0) {
+      break;
     }
+    offset += len;
   }
 
   // Write output data back to simulator, free ref_out.
   aes_data_unpacked_put(data_o, ref_out);
+  free(ref_in);
+}
 
-  // Free memory.
-  free(iv);
-  free(key);
+void c_dpi_aes_ctx_free(void *ctx_i) {
+  aes_dpi_ctx_t *ctx = (aes_dpi_ctx_t *)ctx_i;
+  if (!ctx) {
+    return;
+  }
+  crypto_ctx_free(ctx->crypto_ctx);
+  free(ctx);
+}
+
+void c_dpi_aes_crypt_message(unsigned char impl_i, unsigned char op_i,
+                             const svBitVecVal *mode_i, const svBitVecVal *iv_i,
+                             const svBitVecVal *key_len_i,
+                             const svBitVecVal *key_i,
+                             const svOpenArrayHandle data_i,
+                             svOpenArrayHandle data_o) {
+  void *ctx = c_dpi_aes_ctx_new(impl_i, op_i, mode_i, key_len_i, key_i);
+  if (!ctx) {
+    return;
+  }
+  c_dpi_aes_ctx_crypt_message(ctx, iv_i, data_i, data_o);
+  c_dpi_aes_ctx_free(ctx);
 }
 
 void c_dpi_aes_sub_bytes(const unsigned char op_i, const svBitVecVal *data_i,
@@ -352,10 +535,17 @@ unsigned char *aes_data_unpacked_get(const svOpenArrayHandle data_i) {
   data = (unsigned char *)malloc(len * sizeof(unsigned char));
   assert(data);
 
-  // get data from simulator
-  for (int i = 0; i < len; i++) {
-    svGetBitArrElem1VecVal(&value, data_i, i);
-    data[i] = (unsigned char)value;
+  // get data from simulator, directly if the simulator uses a C-style layout
+  const svBitVecVal *arr = (const svBitVecVal *)svGetArrayPtr(data_i);
+  if (arr) {
+    for (int i = 0; i < len; i++) {
+      data[i] = (unsigned char)arr[i];
+    }
+  } else {
+    for (int i = 0; i < len; i++) {
+      svGetBitArrElem1VecVal(&value, data_i, i);
+      data[i] = (unsigned char)value;
+    }
   }
 
   return data;
@@ -369,10 +559,18 @@ void aes_data_unpacked_put(const svOpenArrayHandle data_o,
   // get size of data buffer
   len = svSize(data_o, 1);
 
-  // write output data to simulation
-  for (int i = 0; i < len; i++) {
-    value = (svBitVecVal)data[i];
-    svPutBitArrElem1VecVal(data_o, &value, i);
+  // write output data to simulation, directly if the simulator uses a C-style
+  // layout
+  svBitVecVal *arr = (svBitVecVal *)svGetArrayPtr(data_o);
+  if (arr) {
+    for (int i = 0; i < len; i++) {
+      arr[i] = (svBitVecVal)data[i];
+    }
+  } else {
+    for (int i = 0; i < len; i++) {
+      value = (svBitVecVal)data[i];
+      svPutBitArrElem1VecVal(data_o, &value, i);
+    }
   }
 
   // free data
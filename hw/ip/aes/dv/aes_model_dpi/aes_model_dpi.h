@@ -41,7 +41,11 @@ void c_dpi_aes_crypt_block(const unsigned char impl_i, const unsigned char op_i,
                            svBitVecVal *data_o);
 
 /**
- * Perform encryption/decryption of an entire message using OpenSSL/BoringSSL.
+ * Perform encryption/decryption of an entire message.
+ *
+ * This sets up a new reference model context for every call. Use
+ * c_dpi_aes_ctx_new() and c_dpi_aes_ctx_crypt_message() instead to process
+ * many messages with the same key.
  *
  * @param  impl_i    Select reference impl.: 0 = C model, 1 = OpenSSL/BoringSSL
  * @param  op_i      Operation: 0 = encrypt, 1 = decrypt
@@ -62,6 +66,67 @@ void c_dpi_aes_crypt_message(unsigned char impl_i, unsigned char op_i,
                              const svOpenArrayHandle data_i,
                              svOpenArrayHandle data_o);
 
+/**
+ * Create a reference model context for encrypting/decrypting messages with one
+ * key.
+ *
+ * The key is expanded (C model) or the cipher context is set up
+ * (OpenSSL/BoringSSL) once here rather than for every message.
+ *
+ * @param  impl_i    Select reference impl.: 0 = C model, 1 = OpenSSL/BoringSSL
+ * @param  op_i      Operation: 0 = encrypt, 1 = decrypt
+ * @param  mode_i    Cipher mode: 6'b00_0001 = ECB, 6'00_b0010 = CBC,
+ *                                6'b00_0100 = CFB, 6'b00_1000 = OFB,
+ *                                6'b01_0000 = CTR
+ * @param  key_len_i Key length: 3'b001 = 128b, 3'b010 = 192b, 3'b100 = 256b
+ * @param  key_i     Full input key, 1D array of words (2D packed array in SV)
+ * @return Context handle (chandle in SV), NULL in case of an error
+ */
+void *c_dpi_aes_ctx_new(unsigned char impl_i, unsigned char op_i,
+                        const svBitVecVal *mode_i,
+                        const svBitVecVal *key_len_i,
+                        const svBitVecVal *key_i);
+
+/**
+ * Perform encryption/decryption of an entire message using a context.
+ *
+ * @param  ctx_i  Context created by c_dpi_aes_ctx_new()
+ * @param  iv_i   Initialization vector: 1D array of words (2D packed array in
+ *                SV), ignored for ECB
+ * @param  data_i Input data, 1D byte array (open array in SV)
+ * @param  data_o Output data, 1D byte array (open array in SV)
+ */
+void c_dpi_aes_ctx_crypt_message(void *ctx_i, const svBitVecVal *iv_i,
+                                 const svOpenArrayHandle data_i,
+                                 svOpenArrayHandle data_o);
+
+/**
+ * Perform encryption/decryption of several messages using a context.
+ *
+ * The messages are concatenated in data_i. Each one is processed separately,
+ * starting from its own IV.
+ *
+ * @param  ctx_i     Context created by c_dpi_aes_ctx_new()
+ * @param  iv_i      Initialization vector of each message: 1D array of 2D
+ *                   packed arrays in SV, ignored for ECB
+ * @param  msg_len_i Length of each message in bytes, a multiple of 16
+ * @param  data_i    Input data of all messages, 1D byte array (open array in
+ *                   SV)
+ * @param  data_o    Output data of all messages, 1D byte array (open array in
+ *                   SV)
+ */
+void c_dpi_aes_ctx_crypt_messages(void *ctx_i, const svOpenArrayHandle iv_i,
+                                  const svOpenArrayHandle msg_len_i,
+                                  const svOpenArrayHandle data_i,
+                                  svOpenArrayHandle data_o);
+
+/**
+ * Free a context created by c_dpi_aes_ctx_new().
+ *
+ * @param  ctx_i Context, may be NULL
+ */
+void c_dpi_aes_ctx_free(void *ctx_i);
+
 /**
  * Perform sub bytes operation for forward/inverse cipher operation.
  *
@@ -36,6 +36,15 @@ class aes_scoreboard extends cip_base_scoreboard #(
   // once an operation is started the item is put here to wait for the resuting output
   aes_seq_item                      rcv_item_q[$];
 
+  // reference model context and the configuration it was set up for, reused while consecutive
+  // messages use the same key and configuration
+  chandle                           ref_ctx;
+  bit                               ref_ctx_impl;
+  bit                               ref_ctx_op;
+  aes_mode_e                        ref_ctx_mode;
+  bit [2:0]                         ref_ctx_keylen;
+  bit [7:0][31:0]                   ref_ctx_key;
+
   function void build_phase(uvm_phase phase);
     super.build_phase(phase);
     msg_fifo         = new();
@@ -571,6 +580,28 @@ class aes_scoreboard extends cip_base_scoreboard #(
   endtask // rebuild_message
 
 
+  // Return a reference model context for the key and configuration of msg. The context of the
+  // previous message is reused if they haven't changed, as setting up a context expands the key
+  // and would otherwise take most of the time spent in the reference model.
+  function chandle get_ref_ctx(bit impl, bit operation, aes_message_item msg);
+    bit [7:0][31:0] key = msg.aes_key[0] ^ msg.aes_key[1];
+    if (ref_ctx == null || impl != ref_ctx_impl || operation != ref_ctx_op ||
+        msg.aes_mode != ref_ctx_mode || msg.aes_keylen != ref_ctx_keylen || key != ref_ctx_key)
+    begin
+      c_dpi_aes_ctx_free(ref_ctx);
+      ref_ctx = c_dpi_aes_ctx_new(impl, operation, msg.aes_mode, msg.aes_keylen, key);
+      if (ref_ctx == null) begin
+        `uvm_fatal(`gfn, "Failed to set up the reference model")
+      end
+      ref_ctx_impl   = impl;
+      ref_ctx_op     = operation;
+      ref_ctx_mode   = msg.aes_mode;
+      ref_ctx_keylen = msg.aes_keylen;
+      ref_ctx_key    = key;
+    end
+    return ref_ctx;
+  endfunction
+
   virtual task compare();
     string txt="";
     bit [3:0][31:0] tmp_input;
@@ -586,9 +617,8 @@ class aes_scoreboard extends cip_base_scoreboard #(
         //ref-model     / opration     / chipher mode /    IV   / key_len   / key /data i /data o //
         operation = msg.aes_operation == AES_ENC ? 1'b0 :
                     msg.aes_operation == AES_DEC ? 1'b1 : 1'b0;
-        c_dpi_aes_crypt_message(cfg.ref_model, operation, msg.aes_mode, msg.aes_iv,
-                                msg.aes_keylen, msg.aes_key[0] ^ msg.aes_key[1],
-                                msg.input_msg, msg.predicted_msg);
+        c_dpi_aes_ctx_crypt_message(get_ref_ctx(cfg.ref_model, operation, msg), msg.aes_iv,
+                                    msg.input_msg, msg.predicted_msg);
 
         `uvm_info(`gfn, $sformatf("\n\t ----| printing MESSAGE %s", msg.convert2string()),
                   UVM_MEDIUM)
@@ -5,8 +5,16 @@
 #include "aes.h"
 
 #include <errno.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    !defined(AES_MODEL_DISABLE_AESNI)
+#define AES_MODEL_AESNI
+#include <wmmintrin.h>
+#endif
 
 int aes_encrypt_block(const unsigned char *plain_text, const unsigned char *key,
                       const int key_len, unsigned char *cipher_text) {
@@ -19,12 +27,7 @@ int aes_encrypt_block(const unsigned char *plain_text, const unsigned char *key,
   unsigned char rcon;
   unsigned char state[16];
   unsigned char round_key[16];
-  unsigned char *full_key =
-      (unsigned char *)malloc(key_len * sizeof(unsigned char));
-  if (full_key == NULL) {
-    printf("ERROR: malloc() failed\n");
-    return -ENOMEM;
-  }
+  unsigned char full_key[32];
 
   // init
   for (int i = 0; i < 16; i++) {
@@ -41,13 +44,12 @@ int aes_encrypt_block(const unsigned char *plain_text, const unsigned char *key,
   // ecnrypt
   aes_add_round_key(state, round_key);
   for (int j = 0; j < num_rounds; j++) {
-    aes_sub_bytes(state);
-    aes_shift_rows(state);
+    aes_key_expand(round_key, full_key, key_len, &rcon, j);
     if (j < (num_rounds - 1)) {
-      aes_mix_columns(state);
+      aes_round(state, round_key);
+    } else {
+      aes_final_round(state, round_key);
     }
-    aes_key_expand(round_key, full_key, key_len, &rcon, j);
-    aes_add_round_key(state, round_key);
   }
 
   // finish
@@ -55,8 +57,6 @@ int aes_encrypt_block(const unsigned char *plain_text, const unsigned char *key,
     cipher_text[i] = state[i];
   }
 
-  free(full_key);
-
   return 0;
 }
 
@@ -72,12 +72,7 @@ int aes_decrypt_block(const unsigned char *cipher_text,
   unsigned char rcon;
   unsigned char state[16];
   unsigned char round_key[16];
-  unsigned char *full_key =
-      (unsigned char *)malloc(key_len * sizeof(unsigned char));
-  if (full_key == NULL) {
-    printf("ERROR: malloc() failed\n");
-    return -ENOMEM;
-  }
+  unsigned char full_key[32];
 
   // init
   for (int i = 0; i < 16; i++) {
@@ -100,16 +95,13 @@ int aes_decrypt_block(const unsigned char *cipher_text,
   // decrypt - using Equivalent Inverse Cipher
   aes_add_round_key(state, round_key);
   for (int j = 0; j < num_rounds; j++) {
-    aes_inv_sub_bytes(state);
-    aes_inv_shift_rows(state);
-    if (j < (num_rounds - 1)) {
-      aes_inv_mix_columns(state);
-    }
     aes_inv_key_expand(round_key, full_key, key_len, &rcon, j);
     if (j < (num_rounds - 1)) {
       aes_inv_mix_columns(round_key);
+      aes_inv_round(state, round_key);
+    } else {
+      aes_inv_final_round(state, round_key);
     }
-    aes_add_round_key(state, round_key);
   }
 
   // finish
@@ -117,7 +109,6 @@ int aes_decrypt_block(const unsigned char *cipher_text,
     plain_text[i] = state[i];
   }
 
-  free(full_key);
   return 0;
 }
 
@@ -152,39 +143,71 @@ int aes_get_num_rounds(int key_len) {
 }
 
 static unsigned char aes_mul2(unsigned char in) {
-  // set individual bits of out
-  unsigned char out = 0x0;
+  // shift left, reduce by the AES polynomial if the top bit was set
+  return (unsigned char)((in << 1) ^ ((in >> 7) * 0x1b));
+}
+
+// aes_mul2() applied to each byte of a word
+static uint32_t aes_mul2_word(uint32_t in) {
+  return ((in & 0x7f7f7f7f) << 1) ^ (((in >> 7) & 0x01010101) * 0x1b);
+}
 
-  //        extract bits     possible xor    shift to right position
-  out |= (((in >> 7) & 0x1)) << 0;
-  out |= (((in >> 0) & 0x1) ^ ((in >> 7) & 0x1)) << 1;
-  out |= (((in >> 1) & 0x1)) << 2;
-  out |= (((in >> 2) & 0x1) ^ ((in >> 7) & 0x1)) << 3;
-  out |= (((in >> 3) & 0x1) ^ ((in >> 7) & 0x1)) << 4;
-  out |= (((in >> 4) & 0x1)) << 5;
-  out |= (((in >> 5) & 0x1)) << 6;
-  out |= (((in >> 6) & 0x1)) << 7;
+// Rotate right by `n` bits, i.e., move byte i + n/8 of a column to byte i.
+static uint32_t aes_ror(uint32_t in, int n) {
+  return (in >> n) | (in << (32 - n));
+}
 
-  return out;
+// Get column `j` of the state as a word, row 0 in the least significant byte.
+static uint32_t aes_col_get(const unsigned char *state, int j) {
+  return (uint32_t)state[4 * j] | ((uint32_t)state[4 * j + 1] << 8) |
+         ((uint32_t)state[4 * j + 2] << 16) |
+         ((uint32_t)state[4 * j + 3] << 24);
 }
 
-static unsigned char aes_mul4(unsigned char in) {
-  // return aes_mul2(aes_mul2(in));
+static void aes_col_put(unsigned char *state, int j, uint32_t col) {
+  state[4 * j] = (unsigned char)col;
+  state[4 * j + 1] = (unsigned char)(col >> 8);
+  state[4 * j + 2] = (unsigned char)(col >> 16);
+  state[4 * j + 3] = (unsigned char)(col >> 24);
+}
 
-  // set individual bits of out
-  unsigned char out = 0x0;
+// MixColumns of one column: 2 * a[i] ^ 3 * a[i + 1] ^ a[i + 2] ^ a[i + 3]
+static uint32_t aes_mix_column(uint32_t col) {
+  uint32_t rot1 = aes_ror(col, 8);
+  return aes_mul2_word(col ^ rot1) ^ rot1 ^ aes_ror(col, 16) ^
+         aes_ror(col, 24);
+}
 
-  //        extract bits     possible xor    shift to right position
-  out |= (((in >> 6) & 0x1)) << 0;
-  out |= (((in >> 7) & 0x1) ^ ((in >> 6) & 0x1)) << 1;
-  out |= (((in >> 0) & 0x1) ^ ((in >> 7) & 0x1)) << 2;
-  out |= (((in >> 1) & 0x1) ^ ((in >> 6) & 0x1)) << 3;
-  out |= (((in >> 2) & 0x1) ^ ((in >> 7) & 0x1) ^ ((in >> 6) & 0x1)) << 4;
-  out |= (((in >> 3) & 0x1) ^ ((in >> 7) & 0x1)) << 5;
-  out |= (((in >> 4) & 0x1)) << 6;
-  out |= (((in >> 5) & 0x1)) << 7;
+// InvMixColumns of one column. InvMixColumns equals MixColumns after
+// a[i] ^= 4 * (a[i] ^ a[i + 2]), see satoh_compact_2001.pdf.
+static uint32_t aes_inv_mix_column(uint32_t col) {
+  uint32_t t = aes_mul2_word(aes_mul2_word(col ^ aes_ror(col, 16)));
+  return aes_mix_column(col ^ t);
+}
 
-  return out;
+// Lookup tables for full rounds. aes_enc_table[k][x] is the contribution of
+// a byte x in row k to its output column, i.e., MixColumns of a column holding
+// sbox[x] in row k and 0 elsewhere. aes_dec_table is the same for inv_sbox and
+// InvMixColumns.
+static uint32_t aes_enc_table[4][256];
+static uint32_t aes_dec_table[4][256];
+static int aes_tables_ready;
+
+static void aes_tables_init(void) {
+  if (aes_tables_ready) {
+    return;
+  }
+  for (int x = 0; x < 256; x++) {
+    uint32_t enc = aes_mix_column(sbox[x]);
+    uint32_t dec = aes_inv_mix_column(inv_sbox[x]);
+    for (int k = 0; k < 4; k++) {
+      aes_enc_table[k][x] = enc;
+      aes_dec_table[k][x] = dec;
+      enc = aes_ror(enc, 24);
+      dec = aes_ror(dec, 24);
+    }
+  }
+  aes_tables_ready = 1;
 }
 
 void aes_add_round_key(unsigned char *state, const unsigned char *round_key) {
@@ -274,70 +297,70 @@ void aes_inv_shift_rows(unsigned char *state) {
 }
 
 void aes_mix_columns(unsigned char *state) {
-  unsigned char temp[16];
-
-  // copy state to temp
-  for (int i = 0; i < 16; i++) {
-    temp[i] = state[i];
-  }
-
-  // do the matrix mul column by column
-  unsigned char x3, x2, x1, x0;
   for (int j = 0; j < 4; j++) {
-    // see satoh_compact_2001.pdf
-
-    x3 = temp[0 + j * 4] ^ temp[1 + j * 4];
-    x2 = temp[1 + j * 4] ^ temp[2 + j * 4];
-    x1 = temp[2 + j * 4] ^ temp[3 + j * 4];
-    x0 = temp[3 + j * 4] ^ temp[0 + j * 4];
-
-    state[0 + j * 4] = aes_mul2(x3) ^ x1 ^ temp[1 + j * 4];
-    state[1 + j * 4] = aes_mul2(x2) ^ x1 ^ temp[0 + j * 4];
-    state[2 + j * 4] = aes_mul2(x1) ^ x3 ^ temp[3 + j * 4];
-    state[3 + j * 4] = aes_mul2(x0) ^ x3 ^ temp[2 + j * 4];
+    aes_col_put(state, j, aes_mix_column(aes_col_get(state, j)));
   }
 
   return;
 }
 
 void aes_inv_mix_columns(unsigned char *state) {
-  unsigned char temp[16];
-
-  // copy state to temp
-  for (int i = 0; i < 16; i++) {
-    temp[i] = state[i];
+  for (int j = 0; j < 4; j++) {
+    aes_col_put(state, j, aes_inv_mix_column(aes_col_get(state, j)));
   }
 
-  // do the matrix mul column by column
-  unsigned char x3, x2, x1, x0;
-  unsigned char y2, y1, y0, z1, z0;
-  for (int j = 0; j < 4; j++) {
-    // see satoh_compact_2001.pdf
+  return;
+}
 
-    // first step equal to encryption
-    x3 = temp[0 + j * 4] ^ temp[1 + j * 4];
-    x2 = temp[1 + j * 4] ^ temp[2 + j * 4];
-    x1 = temp[2 + j * 4] ^ temp[3 + j * 4];
-    x0 = temp[3 + j * 4] ^ temp[0 + j * 4];
+void aes_round(unsigned char *state, const unsigned char *round_key) {
+  aes_tables_init();
+
+  // ShiftRows moves the byte in row k of column j + k to column j.
+  const uint32_t(*t)[256] = aes_enc_table;
+  const unsigned char *s = state;
+  uint32_t col0 = t[0][s[0]] ^ t[1][s[5]] ^ t[2][s[10]] ^ t[3][s[15]];
+  uint32_t col1 = t[0][s[4]] ^ t[1][s[9]] ^ t[2][s[14]] ^ t[3][s[3]];
+  uint32_t col2 = t[0][s[8]] ^ t[1][s[13]] ^ t[2][s[2]] ^ t[3][s[7]];
+  uint32_t col3 = t[0][s[12]] ^ t[1][s[1]] ^ t[2][s[6]] ^ t[3][s[11]];
+  aes_col_put(state, 0, col0 ^ aes_col_get(round_key, 0));
+  aes_col_put(state, 1, col1 ^ aes_col_get(round_key, 1));
+  aes_col_put(state, 2, col2 ^ aes_col_get(round_key, 2));
+  aes_col_put(state, 3, col3 ^ aes_col_get(round_key, 3));
 
-    state[0 + j * 4] = aes_mul2(x3) ^ x1 ^ temp[1 + j * 4];
-    state[1 + j * 4] = aes_mul2(x2) ^ x1 ^ temp[0 + j * 4];
-    state[2 + j * 4] = aes_mul2(x1) ^ x3 ^ temp[3 + j * 4];
-    state[3 + j * 4] = aes_mul2(x0) ^ x3 ^ temp[2 + j * 4];
+  return;
+}
+
+void aes_final_round(unsigned char *state, const unsigned char *round_key) {
+  aes_sub_bytes(state);
+  aes_shift_rows(state);
+  aes_add_round_key(state, round_key);
 
-    // second & third step
-    y0 = aes_mul4(temp[1 + j * 4] ^ temp[3 + j * 4]);
-    y1 = aes_mul4(temp[0 + j * 4] ^ temp[2 + j * 4]);
-    y2 = aes_mul2(y1 ^ y0);
+  return;
+}
 
-    z0 = y2 ^ y0;
-    z1 = y2 ^ y1;
+void aes_inv_round(unsigned char *state, const unsigned char *round_key) {
+  aes_tables_init();
+
+  // InvShiftRows moves the byte in row k of column j - k to column j.
+  const uint32_t(*t)[256] = aes_dec_table;
+  const unsigned char *s = state;
+  uint32_t col0 = t[0][s[0]] ^ t[1][s[13]] ^ t[2][s[10]] ^ t[3][s[7]];
+  uint32_t col1 = t[0][s[4]] ^ t[1][s[1]] ^ t[2][s[14]] ^ t[3][s[11]];
+  uint32_t col2 = t[0][s[8]] ^ t[1][s[5]] ^ t[2][s[2]] ^ t[3][s[15]];
+  uint32_t col3 = t[0][s[12]] ^ t[1][s[9]] ^ t[2][s[6]] ^ t[3][s[3]];
+  aes_col_put(state, 0, col0 ^ aes_col_get(round_key, 0));
+  aes_col_put(state, 1, col1 ^ aes_col_get(round_key, 1));
+  aes_col_put(state, 2, col2 ^ aes_col_get(round_key, 2));
+  aes_col_put(state, 3, col3 ^ aes_col_get(round_key, 3));
 
-    state[0 + j * 4] ^= z1;
-    state[1 + j * 4] ^= z0;
-    state[2 + j * 4] ^= z1;
-    state[3 + j * 4] ^= z0;
-  }
+  return;
+}
+
+void aes_inv_final_round(unsigned char *state,
+                         const unsigned char *round_key) {
+  aes_inv_sub_bytes(state);
+  aes_inv_shift_rows(state);
+  aes_add_round_key(state, round_key);
 
   return;
 }
@@ -352,11 +375,7 @@ void aes_key_expand(unsigned char *round_key, unsigned char *key, int key_len,
   //       for key_len == 16, key == round_key
 
   unsigned char temp[4];
-  unsigned char *old_key;
-  old_key = (unsigned char *)malloc(key_len * sizeof(unsigned char));
-  if (!old_key) {
-    printf("ERROR: malloc() failed.");
-  }
+  unsigned char old_key[32];
 
   // copy key to temp
   for (int i = 0; i < key_len; i++) {
@@ -648,8 +667,6 @@ void aes_key_expand(unsigned char *round_key, unsigned char *key, int key_len,
     round_key[i] = key[key_len - 16 + i];
   }
 
-  free(old_key);
-
   return;
 }
 
@@ -663,11 +680,7 @@ void aes_inv_key_expand(unsigned char *round_key, unsigned char *key,
   //       for key_len == 16, key == round_key
 
   unsigned char temp[4];
-  unsigned char *old_key;
-  old_key = (unsigned char *)malloc(key_len * sizeof(unsigned char));
-  if (!old_key) {
-    printf("ERROR: malloc() failed.");
-  }
+  unsigned char old_key[32];
 
   // copy key to temp
   for (int i = 0; i < key_len; i++) {
@@ -951,8 +964,6 @@ void aes_inv_key_expand(unsigned char *round_key, unsigned char *key,
     round_key[i] = key[i];
   }
 
-  free(old_key);
-
   return;
 }
 
@@ -1002,3 +1013,168 @@ void aes_rcon_prev(unsigned char *rcon, int key_len) {
 
   return;
 }
+
+int aes_key_sched_init(aes_key_sched_t *key_sched, const unsigned char *key,
+                       const int key_len) {
+  int num_rounds = aes_get_num_rounds(key_len);
+  if (num_rounds < 0) {
+    printf("ERROR: aes_get_num_rounds() failed\n");
+    return -EINVAL;
+  }
+
+  unsigned char rcon = 0;
+  unsigned char full_key[32];
+  memcpy(full_key, key, key_len);
+
+  // Round keys in encryption order
+  key_sched->num_rounds = num_rounds;
+  memcpy(key_sched->enc_keys[0], full_key, 16);
+  for (int j = 0; j < num_rounds; j++) {
+    aes_key_expand(key_sched->enc_keys[j + 1], full_key, key_len, &rcon, j);
+  }
+
+  // Round keys for the Equivalent Inverse Cipher
+  for (int j = 0; j <= num_rounds; j++) {
+    memcpy(key_sched->dec_keys[j], key_sched->enc_keys[num_rounds - j], 16);
+    if (j > 0 && j < num_rounds) {
+      aes_inv_mix_columns(key_sched->dec_keys[j]);
+    }
+  }
+
+  return 0;
+}
+
+#ifdef AES_MODEL_AESNI
+static int aes_aesni_supported(void) {
+  static int supported = -1;
+  if (supported < 0) {
+    __builtin_cpu_init();
+    supported = __builtin_cpu_supports("aes");
+  }
+  return supported;
+}
+
+// Four blocks are processed at a time to hide the latency of the AES
+// instructions.
+__attribute__((target("aes,sse2"))) static void aes_aesni_encrypt_blocks(
+    const aes_key_sched_t *key_sched, const unsigned char *in,
+    unsigned char *out, const int num_blocks) {
+  const int nr = key_sched->num_rounds;
+  __m128i rk[15];
+  for (int j = 0; j <= nr; j++) {
+    rk[j] = _mm_loadu_si128((const __m128i *)key_sched->enc_keys[j]);
+  }
+
+  int i = 0;
+  for (; i + 4 <= num_blocks; i += 4) {
+    const __m128i *src = (const __m128i *)&in[16 * i];
+    __m128i b0 = _mm_xor_si128(_mm_loadu_si128(src + 0), rk[0]);
+    __m128i b1 = _mm_xor_si128(_mm_loadu_si128(src + 1), rk[0]);
+    __m128i b2 = _mm_xor_si128(_mm_loadu_si128(src + 2), rk[0]);
+    __m128i b3 = _mm_xor_si128(_mm_loadu_si128(src + 3), rk[0]);
+    for (int j = 1; j < nr; j++) {
+      b0 = _mm_aesenc_si128(b0, rk[j]);
+      b1 = _mm_aesenc_si128(b1, rk[j]);
+      b2 = _mm_aesenc_si128(b2, rk[j]);
+      b3 = _mm_aesenc_si128(b3, rk[j]);
+    }
+    __m128i *dst = (__m128i *)&out[16 * i];
+    _mm_storeu_si128(dst + 0, _mm_aesenclast_si128(b0, rk[nr]));
+    _mm_storeu_si128(dst + 1, _mm_aesenclast_si128(b1, rk[nr]));
+    _mm_storeu_si128(dst + 2, _mm_aesenclast_si128(b2, rk[nr]));
+    _mm_storeu_si128(dst + 3, _mm_aesenclast_si128(b3, rk[nr]));
+  }
+  for (; i < num_blocks; i++) {
+    __m128i b = _mm_loadu_si128((const __m128i *)&in[16 * i]);
+    b = _mm_xor_si128(b, rk[0]);
+    for (int j = 1; j < nr; j++) {
+      b = _mm_aesenc_si128(b, rk[j]);
+    }
+    _mm_storeu_si128((__m128i *)&out[16 * i], _mm_aesenclast_si128(b, rk[nr]));
+  }
+}
+
+__attribute__((target("aes,sse2"))) static void aes_aesni_decrypt_blocks(
+    const aes_key_sched_t *key_sched, const unsigned char *in,
+    unsigned char *out, const int num_blocks) {
+  const int nr = key_sched->num_rounds;
+  __m128i rk[15];
+  for (int j = 0; j <= nr; j++) {
+    rk[j] = _mm_loadu_si128((const __m128i *)key_sched->dec_keys[j]);
+  }
+
+  int i = 0;
+  for (; i + 4 <= num_blocks; i += 4) {
+    const __m128i *src = (const __m128i *)&in[16 * i];
+    __m128i b0 = _mm_xor_si128(_mm_loadu_si128(src + 0), rk[0]);
+    __m128i b1 = _mm_xor_si128(_mm_loadu_si128(src + 1), rk[0]);
+    __m128i b2 = _mm_xor_si128(_mm_loadu_si128(src + 2), rk[0]);
+    __m128i b3 = _mm_xor_si128(_mm_loadu_si128(src + 3), rk[0]);
+    for (int j = 1; j < nr; j++) {
+      b0 = _mm_aesdec_si128(b0, rk[j]);
+      b1 = _mm_aesdec_si128(b1, rk[j]);
+      b2 = _mm_aesdec_si128(b2, rk[j]);
+      b3 = _mm_aesdec_si128(b3, rk[j]);
+    }
+    __m128i *dst = (__m128i *)&out[16 * i];
+    _mm_storeu_si128(dst + 0, _mm_aesdeclast_si128(b0, rk[nr]));
+    _mm_storeu_si128(dst + 1, _mm_aesdeclast_si128(b1, rk[nr]));
+    _mm_storeu_si128(dst + 2, _mm_aesdeclast_si128(b2, rk[nr]));
+    _mm_storeu_si128(dst + 3, _mm_aesdeclast_si128(b3, rk[nr]));
+  }
+  for (; i < num_blocks; i++) {
+    __m128i b = _mm_loadu_si128((const __m128i *)&in[16 * i]);
+    b = _mm_xor_si128(b, rk[0]);
+    for (int j = 1; j < nr; j++) {
+      b = _mm_aesdec_si128(b, rk[j]);
+    }
+    _mm_storeu_si128((__m128i *)&out[16 * i], _mm_aesdeclast_si128(b, rk[nr]));
+  }
+}
+#endif
+
+void aes_encrypt_blocks(const aes_key_sched_t *key_sched,
+                        const unsigned char *plain_text,
+                        unsigned char *cipher_text, const int num_blocks) {
+#ifdef AES_MODEL_AESNI
+  if (aes_aesni_supported()) {
+    aes_aesni_encrypt_blocks(key_sched, plain_text, cipher_text, num_blocks);
+    return;
+  }
+#endif
+
+  const int num_rounds = key_sched->num_rounds;
+  unsigned char state[16];
+  for (int i = 0; i < num_blocks; i++) {
+    memcpy(state, &plain_text[16 * i], 16);
+    aes_add_round_key(state, key_sched->enc_keys[0]);
+    for (int j = 1; j < num_rounds; j++) {
+      aes_round(state, key_sched->enc_keys[j]);
+    }
+    aes_final_round(state, key_sched->enc_keys[num_rounds]);
+    memcpy(&cipher_text[16 * i], state, 16);
+  }
+}
+
+void aes_decrypt_blocks(const aes_key_sched_t *key_sched,
+                        const unsigned char *cipher_text,
+                        unsigned char *plain_text, const int num_blocks) {
+#ifdef AES_MODEL_AESNI
+  if (aes_aesni_supported()) {
+    aes_aesni_decrypt_blocks(key_sched, cipher_text, plain_text, num_blocks);
+    return;
+  }
+#endif
+
+  const int num_rounds = key_sched->num_rounds;
+  unsigned char state[16];
+  for (int i = 0; i < num_blocks; i++) {
+    memcpy(state, &cipher_text[16 * i], 16);
+    aes_add_round_key(state, key_sched->dec_keys[0]);
+    for (int j = 1; j < num_rounds; j++) {
+      aes_inv_round(state, key_sched->dec_keys[j]);
+    }
+    aes_inv_final_round(state, key_sched->dec_keys[num_rounds]);
+    memcpy(&plain_text[16 * i], state, 16);
+  }
+}
@@ -95,6 +95,46 @@ void aes_mix_columns(unsigned char *state);
  */
 void aes_inv_mix_columns(unsigned char *state);
 
+/**
+ * Full cipher round: SubBytes, ShiftRows, MixColumns and AddRoundKey
+ *
+ * Computed with lookup tables combining the first three operations. The
+ * resulting state is the same as when calling the individual functions.
+ *
+ * @param  state     State
+ * @param  round_key 128-bit round key
+ */
+void aes_round(unsigned char *state, const unsigned char *round_key);
+
+/**
+ * Final cipher round: SubBytes, ShiftRows and AddRoundKey
+ *
+ * @param  state     State
+ * @param  round_key 128-bit round key
+ */
+void aes_final_round(unsigned char *state, const unsigned char *round_key);
+
+/**
+ * Full inverse cipher round of the Equivalent Inverse Cipher: InvSubBytes,
+ * InvShiftRows, InvMixColumns and AddRoundKey
+ *
+ * Computed with lookup tables combining the first three operations. The
+ * resulting state is the same as when calling the individual functions.
+ *
+ * @param  state     State
+ * @param  round_key 128-bit round key, with InvMixColumns already applied
+ */
+void aes_inv_round(unsigned char *state, const unsigned char *round_key);
+
+/**
+ * Final inverse cipher round: InvSubBytes, InvShiftRows and AddRoundKey
+ *
+ * @param  state     State
+ * @param  round_key 128-bit round key
+ */
+void aes_inv_final_round(unsigned char *state,
+                         const unsigned char *round_key);
+
 /**
  * Generate full key and round key for next round during encryption.
  *
@@ -137,6 +177,60 @@ void aes_rcon_next(unsigned char *rcon);
  */
 void aes_rcon_prev(unsigned char *rcon, int key_len);
 
+/**
+ * Expanded key for encrypting/decrypting many blocks with the same key.
+ *
+ * enc_keys holds the round keys in encryption order. dec_keys holds them in
+ * the order used by the Equivalent Inverse Cipher, i.e., reversed and with
+ * InvMixColumns applied to all but the first and last one.
+ */
+typedef struct aes_key_sched {
+  int num_rounds;
+  unsigned char enc_keys[15][16];
+  unsigned char dec_keys[15][16];
+} aes_key_sched_t;
+
+/**
+ * Expand a key into all round keys.
+ *
+ * @param  key_sched Expanded key
+ * @param  key       Initial encryption key
+ * @param  key_len   Key length in bytes (16, 24, 32)
+ * @return 0 on success, -ERRNO otherwise
+ */
+int aes_key_sched_init(aes_key_sched_t *key_sched, const unsigned char *key,
+                       const int key_len);
+
+/**
+ * Encrypt consecutive data blocks (16 Bytes each) in ECB mode.
+ *
+ * Uses the AES-NI instructions if supported by the host, unless
+ * AES_MODEL_DISABLE_AESNI is defined. Otherwise, the round functions of the
+ * model are used.
+ *
+ * @param  key_sched   Expanded key
+ * @param  plain_text  Input blocks to encrypt
+ * @param  cipher_text Encrypted output blocks, may be equal to plain_text
+ * @param  num_blocks  Number of blocks
+ */
+void aes_encrypt_blocks(const aes_key_sched_t *key_sched,
+                        const unsigned char *plain_text,
+                        unsigned char *cipher_text, const int num_blocks);
+
+/**
+ * Decrypt consecutive data blocks (16 Bytes each) in ECB mode.
+ *
+ * See aes_encrypt_blocks() for the implementation used.
+ *
+ * @param  key_sched   Expanded key
+ * @param  cipher_text Encrypted input blocks
+ * @param  plain_text  Decrypted output blocks, may be equal to cipher_text
+ * @param  num_blocks  Number of blocks
+ */
+void aes_decrypt_blocks(const aes_key_sched_t *key_sched,
+                        const unsigned char *cipher_text,
+                        unsigned char *plain_text, const int num_blocks);
+
 static const unsigned char sbox[256] = {
     0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5,
     0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
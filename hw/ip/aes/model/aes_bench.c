@@ -0,0 +1,157 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "aes.h"
+
+#define NUM_ITERATIONS 1000000
+#define NUM_BLOCKS 4096
+
+static double time_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void report(const char *name, double start, int num_ops,
+                   int bytes_per_op) {
+  double time = time_now() - start;
+  printf("%-24s %8.1f ns/op", name, time / num_ops * 1e9);
+  if (bytes_per_op) {
+    printf(" %8.1f MB/s", (double)num_ops * bytes_per_op / time / 1e6);
+  }
+  printf("\n");
+}
+
+// Check that the combined round functions give the same state as the
+// individual round operations.
+static int check_rounds(void) {
+  unsigned char state[16], state_ref[16], round_key[16];
+
+  for (int i = 0; i < 1000; i++) {
+    for (int j = 0; j < 16; j++) {
+      state[j] = rand();
+      round_key[j] = rand();
+    }
+
+    memcpy(state_ref, state, 16);
+    aes_sub_bytes(state_ref);
+    aes_shift_rows(state_ref);
+    aes_mix_columns(state_ref);
+    aes_add_round_key(state_ref, round_key);
+    aes_round(state, round_key);
+    if (memcmp(state, state_ref, 16)) {
+      printf("ERROR: aes_round() does not match the round operations\n");
+      return 1;
+    }
+
+    memcpy(state_ref, state, 16);
+    aes_inv_sub_bytes(state_ref);
+    aes_inv_shift_rows(state_ref);
+    aes_inv_mix_columns(state_ref);
+    aes_add_round_key(state_ref, round_key);
+    aes_inv_round(state, round_key);
+    if (memcmp(state, state_ref, 16)) {
+      printf("ERROR: aes_inv_round() does not match the round operations\n");
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  unsigned char state[16] = {0};
+  unsigned char round_key[16] = {0};
+  unsigned char key[32] = {0};
+  unsigned char rcon;
+  double start;
+
+  if (check_rounds()) {
+    return 1;
+  }
+
+  start = time_now();
+  for (int i = 0; i < NUM_ITERATIONS; i++) {
+    aes_sub_bytes(state);
+  }
+  report("aes_sub_bytes", start, NUM_ITERATIONS, 0);
+
+  start = time_now();
+  for (int i = 0; i < NUM_ITERATIONS; i++) {
+    aes_shift_rows(state);
+  }
+  report("aes_shift_rows", start, NUM_ITERATIONS, 0);
+
+  start = time_now();
+  for (int i = 0; i < NUM_ITERATIONS; i++) {
+    aes_mix_columns(state);
+  }
+  report("aes_mix_columns", start, NUM_ITERATIONS, 0);
+
+  start = time_now();
+  for (int i = 0; i < NUM_ITERATIONS; i++) {
+    aes_inv_mix_columns(state);
+  }
+  report("aes_inv_mix_columns", start, NUM_ITERATIONS, 0);
+
+  rcon = 0;
+  start = time_now();
+  for (int i = 0; i < NUM_ITERATIONS; i++) {
+    aes_key_expand(round_key, key, 32, &rcon, i % 14);
+  }
+  report("aes_key_expand", start, NUM_ITERATIONS, 0);
+
+  start = time_now();
+  for (int i = 0; i < NUM_ITERATIONS; i++) {
+    aes_round(state, round_key);
+  }
+  report("aes_round", start, NUM_ITERATIONS, 0);
+
+  start = time_now();
+  for (int i = 0; i < NUM_ITERATIONS; i++) {
+    aes_inv_round(state, round_key);
+  }
+  report("aes_inv_round", start, NUM_ITERATIONS, 0);
+
+  start = time_now();
+  for (int i = 0; i < NUM_ITERATIONS / 10; i++) {
+    aes_encrypt_block(state, key, 32, state);
+  }
+  report("aes_encrypt_block", start, NUM_ITERATIONS / 10, 16);
+
+  start = time_now();
+  for (int i = 0; i < NUM_ITERATIONS / 10; i++) {
+    aes_decrypt_block(state, key, 32, state);
+  }
+  report("aes_decrypt_block", start, NUM_ITERATIONS / 10, 16);
+
+  aes_key_sched_t key_sched;
+  unsigned char *data = (unsigned char *)calloc(NUM_BLOCKS, 16);
+  if (!data || aes_key_sched_init(&key_sched, key, 32)) {
+    return 1;
+  }
+
+  start = time_now();
+  for (int i = 0; i < 100; i++) {
+    aes_encrypt_blocks(&key_sched, data, data, NUM_BLOCKS);
+  }
+  report("aes_encrypt_blocks", start, 100 * NUM_BLOCKS, 16);
+
+  start = time_now();
+  for (int i = 0; i < 100; i++) {
+    aes_decrypt_blocks(&key_sched, data, data, NUM_BLOCKS);
+  }
+  report("aes_decrypt_blocks", start, 100 * NUM_BLOCKS, 16);
+
+  // Keep the results live.
+  printf("(%02x%02x)\n", state[0], data[0]);
+  free(data);
+
+  return 0;
+}
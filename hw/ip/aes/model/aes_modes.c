@@ -118,6 +118,36 @@ static int crypto_compare(const unsigned char *cipher_text,
   return 0;
 }
 
+static int model_compare_ecb(const unsigned char *cipher_text,
+                             const unsigned char *plain_text, int len,
+                             const unsigned char *key, int key_len) {
+  aes_key_sched_t key_sched;
+  unsigned char data_out[64];
+
+  if (aes_key_sched_init(&key_sched, key, key_len)) {
+    return 1;
+  }
+
+  aes_encrypt_blocks(&key_sched, plain_text, data_out, len / 16);
+  for (int j = 0; j < len / 16; ++j) {
+    if (check_block(&data_out[j * 16], &cipher_text[j * 16], 1)) {
+      printf("ERROR: model encrypt output does not match NIST example\n");
+      return 1;
+    }
+  }
+
+  aes_decrypt_blocks(&key_sched, cipher_text, data_out, len / 16);
+  for (int j = 0; j < len / 16; ++j) {
+    if (check_block(&data_out[j * 16], &plain_text[j * 16], 1)) {
+      printf("ERROR: model decrypt output does not match NIST example\n");
+      return 1;
+    }
+  }
+
+  printf("SUCCESS: model output matches NIST example\n");
+  return 0;
+}
+
 int main(int argc, char *argv[]) {
   const int len = 64;
   int key_len;
@@ -154,6 +184,11 @@ int main(int argc, char *argv[]) {
                        mode)) {
       return 1;
     }
+
+    if (model_compare_ecb(cipher_text, kAesModesPlainText, len, key,
+                          key_len)) {
+      return 1;
+    }
   }
 
   /////////
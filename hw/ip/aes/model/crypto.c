@@ -6,6 +6,8 @@
 
 #include <openssl/conf.h>
 #include <openssl/evp.h>
+#include <stdio.h>
+#include <stdlib.h>
 
 /**
  * Get EVP_CIPHER type pointer defined by key_len and mode.
@@ -64,6 +66,83 @@ static const EVP_CIPHER *crypto_get_EVP_cipher(int key_len,
   return cipher;
 }
 
+struct crypto_ctx {
+  EVP_CIPHER_CTX *evp_ctx;
+};
+
+crypto_ctx_t *crypto_ctx_new(int decrypt, const unsigned char *key,
+                             int key_len, crypto_mode_t mode) {
+  crypto_ctx_t *ctx = (crypto_ctx_t *)malloc(sizeof(crypto_ctx_t));
+  if (!ctx) {
+    printf("ERROR: malloc() failed\n");
+    return NULL;
+  }
+
+  // Create new cipher context
+  ctx->evp_ctx = EVP_CIPHER_CTX_new();
+  if (!ctx->evp_ctx) {
+    printf("ERROR: Creation of cipher context failed\n");
+    free(ctx);
+    return NULL;
+  }
+
+  // Get cipher
+  const EVP_CIPHER *cipher = crypto_get_EVP_cipher(key_len, mode);
+
+  // Init context with the key, the IV is set for every message
+  int ret = EVP_CipherInit_ex(ctx->evp_ctx, cipher, NULL, key, NULL, !decrypt);
+  if (ret != 1) {
+    printf("ERROR: Initialization of cipher context failed\n");
+    crypto_ctx_free(ctx);
+    return NULL;
+  }
+
+  // Disable padding - It is safe to do so here because we only ever encrypt
+  // and decrypt multiples of 16 bytes (the block size).
+  EVP_CIPHER_CTX_set_padding(ctx->evp_ctx, 0);
+
+  return ctx;
+}
+
+int crypto_ctx_crypt(crypto_ctx_t *ctx, unsigned char *output,
+                     const unsigned char *iv, const unsigned char *input,
+                     int input_len) {
+  int ret;
+  int len, output_len;
+
+  // Restart from the given IV, keeping cipher, key and direction
+  ret = EVP_CipherInit_ex(ctx->evp_ctx, NULL, NULL, NULL, iv, -1);
+  if (ret != 1) {
+    printf("ERROR: Setting the IV of the cipher context failed\n");
+    return -1;
+  }
+
+  // Provide input, get first output bytes
+  ret = EVP_CipherUpdate(ctx->evp_ctx, output, &output_len, input, input_len);
+  if (ret != 1) {
+    printf("ERROR: Cipher operation failed\n");
+    return -1;
+  }
+
+  // Finalize, further bytes might be written
+  ret = EVP_CipherFinal_ex(ctx->evp_ctx, output + output_len, &len);
+  if (ret != 1) {
+    printf("ERROR: Cipher finalizing failed\n");
+    return -1;
+  }
+  output_len += len;
+
+  return output_len;
+}
+
+void crypto_ctx_free(crypto_ctx_t *ctx) {
+  if (!ctx) {
+    return;
+  }
+  EVP_CIPHER_CTX_free(ctx->evp_ctx);
+  free(ctx);
+}
+
 int crypto_encrypt(unsigned char *output, const unsigned char *iv,
                    const unsigned char *input, int input_len,
                    const unsigned char *key, int key_len, crypto_mode_t mode) {
@@ -51,4 +51,50 @@ int crypto_decrypt(unsigned char *output, const unsigned char *iv,
                    const unsigned char *input, int input_len,
                    const unsigned char *key, int key_len, crypto_mode_t mode);
 
+/**
+ * BoringSSL/OpenSSL cipher context
+ *
+ * Holds a cipher set up for one key, mode and direction, so that many messages
+ * can be processed without creating a new cipher context and expanding the key
+ * for every message.
+ */
+typedef struct crypto_ctx crypto_ctx_t;
+
+/**
+ * Create a BoringSSL/OpenSSL cipher context
+ *
+ * @param  decrypt   0 = encrypt, 1 = decrypt
+ * @param  key       Encryption key, decryption key is derived internally
+ * @param  key_len   Encryption key length in bytes (16, 24, 32)
+ * @param  mode      AES cipher mode @see crypto_mode.
+ * @return Cipher context, NULL in case of error
+ */
+crypto_ctx_t *crypto_ctx_new(int decrypt, const unsigned char *key,
+                             int key_len, crypto_mode_t mode);
+
+/**
+ * Encrypt or decrypt one message using a BoringSSL/OpenSSL cipher context
+ *
+ * Every message starts from the given IV, i.e., no state is carried over from
+ * previous messages.
+ *
+ * @param  ctx       Cipher context
+ * @param  output    Output text, must be a multiple of 16 bytes
+ * @param  iv        16-byte initialization vector
+ * @param  input     Input text, must be a multiple of 16 bytes
+ * @param  input_len Length of the input text in bytes, must be a multiple of
+ *                   16
+ * @return Length of the output text in bytes, -1 in case of error
+ */
+int crypto_ctx_crypt(crypto_ctx_t *ctx, unsigned char *output,
+                     const unsigned char *iv, const unsigned char *input,
+                     int input_len);
+
+/**
+ * Free a BoringSSL/OpenSSL cipher context
+ *
+ * @param  ctx Cipher context
+ */
+void crypto_ctx_free(crypto_ctx_t *ctx);
+
 #endif  // OPENTITAN_HW_IP_AES_MODEL_CRYPTO_H_
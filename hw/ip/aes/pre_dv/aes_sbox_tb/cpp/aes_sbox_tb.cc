@@ -9,6 +9,7 @@
 #include "Vaes_sbox_tb.h"
 #include "sim_ctrl_extension.h"
 #include "verilated_toplevel.h"
+#include "verilator_seed_runner.h"
 #include "verilator_sim_ctrl.h"
 
 class AESSBoxTB : public SimCtrlExtension {
@@ -34,7 +35,8 @@ void AESSBoxTB::OnClock(unsigned long sim_time) {
   }
 }
 
-int main(int argc, char **argv) {
+// Run a single simulation
+static int RunSimulation(int argc, char **argv) {
   int ret_code;
 
   // Init verilog instance
@@ -58,3 +60,9 @@ int main(int argc, char **argv) {
 
   return ret_code;
 }
+
+int main(int argc, char **argv) {
+  // Run the simulation once, or once per seed if requested with --seeds
+  VerilatorSeedRunner runner(RunSimulation);
+  return runner.Exec(argc, argv);
+}
@@ -6,14 +6,49 @@
 #ifndef OPENTITAN_HW_IP_AES_PRE_SCA_ALMA_CPP_TESTBENCH_H_
 #define OPENTITAN_HW_IP_AES_PRE_SCA_ALMA_CPP_TESTBENCH_H_
 
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
 #include "verilated.h"
+
+// Traces are written as VCD, which is what Alma reads. Models verilated with
+// --trace-fst write the much more compact binary FST format instead, which is
+// preferable when collecting many traces and can be converted back with
+// fst2vcd.
+#if VM_TRACE_FST
+#include "verilated_fst_c.h"
+typedef VerilatedFstC TraceFile;
+#define TRACE_FILE_EXT ".fst"
+#else
 #include "verilated_vcd_c.h"
+typedef VerilatedVcdC TraceFile;
+#define TRACE_FILE_EXT ".vcd"
+#endif
 
 template <class Module>
 struct Testbench {
   unsigned long m_tickcount;
   Module m_core;
-  VerilatedVcdC *m_trace = NULL;
+  TraceFile *m_trace = NULL;
+
+  // Number of ticks between flushes of the trace to disk, or 0 to flush only
+  // when closing the trace. Flushing every tick keeps the trace readable if
+  // the simulation crashes, but makes tracing much slower.
+  unsigned long m_flush_interval = 0;
+
+  // Whether to evaluate the model once more at the end of each tick after
+  // lowering the clock. This is not traced and can be turned off for designs
+  // without logic on the falling clock edge.
+  bool m_settle_eval = true;
 
   Testbench() {
     Verilated::traceEverOn(true);
@@ -22,10 +57,11 @@ struct Testbench {
 
   ~Testbench() { closetrace(); }
 
-  void opentrace(const char *vcdname) {
+  // Opens a trace of the signals in the top `levels` levels of hierarchy.
+  void opentrace(const char *vcdname, int levels = 99) {
     if (!m_trace) {
-      m_trace = new VerilatedVcdC;
-      m_core.trace(m_trace, 99);
+      m_trace = new TraceFile;
+      m_core.trace(m_trace, levels);
       m_trace->open(vcdname);
     }
   }
@@ -59,15 +95,173 @@ struct Testbench {
       m_trace->dump(20 * m_tickcount + 10);
 
     // Falling edge settle eval
-    m_core.clk_i = 0;
-    m_core.eval();
+    if (m_settle_eval) {
+      m_core.clk_i = 0;
+      m_core.eval();
+    }
 
-    if (m_trace)
-      m_trace->flush();
     m_tickcount++;
+    if (m_trace && m_flush_interval && m_tickcount % m_flush_interval == 0)
+      m_trace->flush();
   }
 
   bool done() { return Verilated::gotFinish(); }
 };
 
+// Options of run_testbench(), see parse_testbench_options() for the
+// corresponding command line arguments.
+struct TestbenchOptions {
+  // Number of simulations with randomized data, masks and randomness. 0 runs
+  // a single simulation with fixed inputs tracing to tmp.vcd, as expected by
+  // Alma's trace.py.
+  unsigned long runs = 0;
+  // Maximum number of simulations running in parallel processes.
+  unsigned long jobs = 1;
+  // Seed of the first simulation, simulation i uses seed + i.
+  uint64_t seed = 1;
+  // Traces are written to <prefix>_<i>.vcd, the index to <prefix>.index.
+  std::string prefix = "trace";
+  // Number of levels of hierarchy to trace.
+  int levels = 99;
+  // See Testbench::m_flush_interval.
+  unsigned long flush_interval = 0;
+};
+
+// Parses --runs=N, --jobs=N, --seed=N, --prefix=P, --levels=N and
+// --flush-interval=N. Other arguments are left to Verilated::commandArgs().
+static inline bool parse_testbench_options(int argc, char **argv,
+                                           TestbenchOptions *opts) {
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    const char *val = strchr(arg, '=');
+    if (strncmp(arg, "--", 2) != 0 || !val) {
+      continue;
+    }
+    const std::string name(arg + 2, val++);
+    char *end;
+    const unsigned long long num = strtoull(val, &end, 0);
+    const bool is_num = *val != '\0' && *end == '\0';
+    if (name == "prefix") {
+      opts->prefix = val;
+      continue;
+    }
+    if (!is_num) {
+      fprintf(stderr, "Invalid value for --%s: %s\n", name.c_str(), val);
+      return false;
+    }
+    if (name == "runs") {
+      opts->runs = num;
+    } else if (name == "jobs") {
+      opts->jobs = num ? num : 1;
+    } else if (name == "seed") {
+      opts->seed = num;
+    } else if (name == "levels") {
+      opts->levels = num;
+    } else if (name == "flush-interval") {
+      opts->flush_interval = num;
+    }
+  }
+  return true;
+}
+
+/**
+ * Runs the simulations requested on the command line.
+ *
+ * `stimulus` resets the testbench and drives the inputs of the module. It gets
+ * NULL for the single run with fixed inputs, and otherwise a random number
+ * generator to draw data, masks and randomness from.
+ *
+ * Randomized runs are distributed over up to `jobs` child processes, each of
+ * which writes its own trace. Once all of them are done, an index listing the
+ * run number, seed, status and trace file of every run is written to
+ * <prefix>.index. A run can be reproduced with --runs=1 and its seed.
+ *
+ * @return 0 if all runs succeeded, 1 otherwise.
+ */
+template <class Module>
+int run_testbench(int argc, char **argv,
+                  void (*stimulus)(Testbench<Module> &tb,
+                                   std::mt19937_64 *rng)) {
+  TestbenchOptions opts;
+  if (!parse_testbench_options(argc, argv, &opts)) {
+    return 1;
+  }
+
+  if (opts.runs == 0) {
+    Testbench<Module> tb;
+    tb.m_flush_interval = opts.flush_interval;
+    tb.opentrace("tmp.vcd", opts.levels);
+    stimulus(tb, NULL);
+    tb.closetrace();
+    return 0;
+  }
+
+  std::vector<pid_t> pids(opts.runs, 0);
+  std::vector<bool> passed(opts.runs, false);
+  unsigned long next = 0;
+  unsigned long running = 0;
+  fflush(stdout);
+  fflush(stderr);
+  while (next < opts.runs || running > 0) {
+    if (next < opts.runs && running < opts.jobs) {
+      const pid_t pid = fork();
+      if (pid == 0) {
+        const std::string name =
+            opts.prefix + "_" + std::to_string(next) + TRACE_FILE_EXT;
+        std::mt19937_64 rng(opts.seed + next);
+        Testbench<Module> tb;
+        tb.m_flush_interval = opts.flush_interval;
+        tb.opentrace(name.c_str(), opts.levels);
+        stimulus(tb, &rng);
+        tb.closetrace();
+        _exit(0);
+      }
+      if (pid < 0) {
+        perror("fork");
+        if (running == 0) {
+          break;
+        }
+      } else {
+        pids[next++] = pid;
+        ++running;
+        continue;
+      }
+    }
+
+    int status;
+    const pid_t pid = wait(&status);
+    if (pid < 0) {
+      perror("wait");
+      break;
+    }
+    for (unsigned long i = 0; i < next; ++i) {
+      if (pids[i] == pid) {
+        passed[i] = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        --running;
+        break;
+      }
+    }
+  }
+
+  const std::string index_name = opts.prefix + ".index";
+  FILE *index = fopen(index_name.c_str(), "w");
+  if (!index) {
+    perror(index_name.c_str());
+    return 1;
+  }
+  unsigned long failures = 0;
+  fprintf(index, "# run seed status trace\n");
+  for (unsigned long i = 0; i < opts.runs; ++i) {
+    failures += !passed[i];
+    fprintf(index, "%lu %llu %s %s_%lu%s\n", i,
+            (unsigned long long)(opts.seed + i), passed[i] ? "ok" : "failed",
+            opts.prefix.c_str(), i, TRACE_FILE_EXT);
+  }
+  fclose(index);
+
+  printf("%lu of %lu runs passed, index written to %s\n",
+         opts.runs - failures, opts.runs, index_name.c_str());
+  return failures ? 1 : 0;
+}
+
 #endif  // OPENTITAN_HW_IP_AES_PRE_SCA_ALMA_CPP_TESTBENCH_H_
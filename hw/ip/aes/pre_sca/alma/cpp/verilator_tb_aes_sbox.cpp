@@ -8,18 +8,21 @@
 #include "Vcircuit.h"
 #include "testbench.h"
 
-int main(int argc, char **argv) {
-  Verilated::commandArgs(argc, argv);
-  Testbench<Vcircuit> tb;
-  tb.opentrace("tmp.vcd");
-
+static void stimulus(Testbench<Vcircuit> &tb, std::mt19937_64 *rng) {
   tb.reset();
 
   // Data signals - we don't really care about the data fed to the module.
-  // The whole tracing is really just about control signals.
-  tb.m_core.data_i = 0x12;
-  tb.m_core.mask_i = 0x34;
-  tb.m_core.prd_i = 0x56789AB;
+  // The whole tracing is really just about control signals. Randomized runs
+  // draw fresh data, masks and randomness.
+  if (rng) {
+    tb.m_core.data_i = (*rng)() & 0xFF;
+    tb.m_core.mask_i = (*rng)() & 0xFF;
+    tb.m_core.prd_i = (*rng)() & 0xFFFFFFF;
+  } else {
+    tb.m_core.data_i = 0x12;
+    tb.m_core.mask_i = 0x34;
+    tb.m_core.prd_i = 0x56789AB;
+  }
 
   // Control signals
   tb.m_core.op_i = 0;  // encrypt
@@ -34,6 +37,9 @@ int main(int argc, char **argv) {
     tb.tick();
   }
   tb.tick();
+}
 
-  tb.closetrace();
+int main(int argc, char **argv) {
+  Verilated::commandArgs(argc, argv);
+  return run_testbench<Vcircuit>(argc, argv, stimulus);
 }
@@ -8,19 +8,16 @@
 #include "Vcircuit.h"
 #include "testbench.h"
 
-int main(int argc, char **argv) {
-  Verilated::commandArgs(argc, argv);
-  Testbench<Vcircuit> tb;
-  tb.opentrace("tmp.vcd");
-
+static void stimulus(Testbench<Vcircuit> &tb, std::mt19937_64 *rng) {
   tb.reset();
 
   // Data signals - we don't really care about the data fed to the module.
-  // The whole tracing is really just about control signals.
+  // The whole tracing is really just about control signals. Randomized runs
+  // draw fresh data, masks and randomness.
   for (int i = 0; i < 4; ++i) {
-    tb.m_core.data_i[i] = i;
-    tb.m_core.mask_i[i] = 4 + i;
-    tb.m_core.prd_i[i] = 8 + i;
+    tb.m_core.data_i[i] = rng ? (uint32_t)(*rng)() : i;
+    tb.m_core.mask_i[i] = rng ? (uint32_t)(*rng)() : 4 + i;
+    tb.m_core.prd_i[i] = rng ? (uint32_t)(*rng)() : 8 + i;
   }
 
   // Control signals
@@ -36,6 +33,9 @@ int main(int argc, char **argv) {
     tb.tick();
   }
   tb.tick();
+}
 
-  tb.closetrace();
+int main(int argc, char **argv) {
+  Verilated::commandArgs(argc, argv);
+  return run_testbench<Vcircuit>(argc, argv, stimulus);
 }
@@ -3,13 +3,16 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "hmac.h"
 #include "hmac_wrap.h"
 #include "sha.h"
+#include "sha2_accel.h"
 #include "sha256.h"
 #include "sha384.h"
 #include "sha512.h"
@@ -33,9 +36,7 @@ static uint8_t *collect_bytes(const svOpenArrayHandle arg, uint64_t len) {
     const svBitVecVal *ptr = (svBitVecVal *)svGetArrayPtr(arg);
     if (ptr) {
       // C-style layout
-      for (uint64_t idx = 0u; idx < len; ++idx) {
-        arr[idx] = (uint8_t)ptr[idx];
-      }
+      SHA2_accel_narrow(ptr, arr, len);
     } else {
       // The implementation-independent way to access open arrays is to use the
       // SystemVerilog array bounds/indexes.
@@ -68,52 +69,57 @@ extern void c_dpi_SHA_hash(const svOpenArrayHandle msg, uint64_t len,
   }
 }
 
-extern void c_dpi_SHA256_hash(const svOpenArrayHandle msg, uint64_t len,
-                              uint32_t hash[8]) {
-  if (len > 0u) {
-    uint8_t *arr = collect_bytes(msg, len);
-    assert(arr);
+// Hash the elements of the open array into `ctx`. When the simulator gives
+// direct access to the array it is narrowed to bytes a chunk at a time, so the
+// message is never copied in full.
+static void update_from_array(HASH_CTX *ctx, const svOpenArrayHandle arg,
+                              uint64_t len) {
+  if (len == 0u) {
+    return;
+  }
 
-    // compute SHA256 hash
-    SHA256_hash(arr, len, (uint8_t *)hash);
+  assert(1 == svDimensions(arg));
+  assert(len <= svSize(arg, 1));
 
-    free(arr);
+  const svBitVecVal *ptr = (svBitVecVal *)svGetArrayPtr(arg);
+  if (ptr) {
+    uint8_t chunk[4096];
+    for (uint64_t offset = 0u; offset < len; offset += sizeof(chunk)) {
+      size_t chunk_len =
+          (len - offset < sizeof(chunk)) ? len - offset : sizeof(chunk);
+      SHA2_accel_narrow(ptr + offset, chunk, chunk_len);
+      SHA2_accel_update(ctx, chunk, chunk_len);
+    }
   } else {
-    // compute SHA256 hash when msg is empty
-    SHA256_hash(NULL, 0u, (uint8_t *)hash);
+    uint8_t *arr = collect_bytes(arg, len);
+    assert(arr);
+    SHA2_accel_update(ctx, arr, len);
+    free(arr);
   }
 }
 
+extern void c_dpi_SHA256_hash(const svOpenArrayHandle msg, uint64_t len,
+                              uint32_t hash[8]) {
+  LITE_SHA256_CTX ctx;
+  SHA256_init(&ctx);
+  update_from_array(&ctx, msg, len);
+  memcpy(hash, SHA256_final(&ctx), SHA256_DIGEST_SIZE);
+}
+
 extern void c_dpi_SHA384_hash(const svOpenArrayHandle msg, uint64_t len,
                               uint32_t hash[12]) {
-  if (len > 0u) {
-    uint8_t *arr = collect_bytes(msg, len);
-    assert(arr);
-
-    // compute SHA384 hash
-    SHA384_hash(arr, len, (uint8_t *)hash);
-
-    free(arr);
-  } else {
-    // compute SHA384 hash when msg is empty
-    SHA384_hash(NULL, 0u, (uint8_t *)hash);
-  }
+  LITE_SHA384_CTX ctx;
+  SHA384_init(&ctx);
+  update_from_array(&ctx, msg, len);
+  memcpy(hash, SHA384_final(&ctx), SHA384_DIGEST_SIZE);
 }
 
 extern void c_dpi_SHA512_hash(const svOpenArrayHandle msg, uint64_t len,
                               uint32_t hash[16]) {
-  if (len > 0u) {
-    uint8_t *arr = collect_bytes(msg, len);
-    assert(arr);
-
-    // compute SHA512 hash
-    SHA512_hash(arr, len, (uint8_t *)hash);
-
-    free(arr);
-  } else {
-    // compute SHA512 hash when msg is empty
-    SHA512_hash(NULL, 0u, (uint8_t *)hash);
-  }
+  LITE_SHA512_CTX ctx;
+  SHA512_init(&ctx);
+  update_from_array(&ctx, msg, len);
+  memcpy(hash, SHA512_final(&ctx), SHA512_DIGEST_SIZE);
 }
 
 extern void c_dpi_HMAC_SHA(const svOpenArrayHandle key, uint64_t key_len,
@@ -140,39 +146,24 @@ extern void c_dpi_HMAC_SHA256(const svOpenArrayHandle key, uint64_t key_len,
   uint8_t *key_arr = collect_bytes(key, key_len);
   assert(key_arr);
 
-  if (msg_len > 0u) {
-    uint8_t *msg_arr = collect_bytes(msg, msg_len);
-    assert(msg_arr);
-
-    // compute SHA256 hash
-    HMAC_SHA256(key_arr, key_len, msg_arr, msg_len, (uint8_t *)hmac);
-
-    free(msg_arr);
-  } else {
-    // compute SHA256 hash when msg is empty
-    HMAC_SHA256(key_arr, key_len, NULL, 0u, (uint8_t *)hmac);
-  }
+  LITE_HMAC_CTX ctx;
+  HMAC_SHA256_init(&ctx, key_arr, key_len);
+  update_from_array(&ctx.hash, msg, msg_len);
+  memcpy(hmac, HMAC_final_LITE(&ctx), SHA256_DIGEST_SIZE);
 
   free(key_arr);
 }
+
 extern void c_dpi_HMAC_SHA384(const svOpenArrayHandle key, uint64_t key_len,
                               const svOpenArrayHandle msg, uint64_t msg_len,
                               uint32_t hmac[12]) {
   uint8_t *key_arr = collect_bytes(key, key_len);
   assert(key_arr);
 
-  if (msg_len > 0u) {
-    uint8_t *msg_arr = collect_bytes(msg, msg_len);
-    assert(msg_arr);
-
-    // compute SHA384 hash
-    HMAC_SHA384(key_arr, key_len, msg_arr, msg_len, (uint8_t *)hmac);
-
-    free(msg_arr);
-  } else {
-    // compute SHA384 hash when msg is empty
-    HMAC_SHA384(key_arr, key_len, NULL, 0u, (uint8_t *)hmac);
-  }
+  HMAC_CTX ctx;
+  HMAC_SHA384_init(&ctx, key_arr, key_len);
+  update_from_array(&ctx.hash, msg, msg_len);
+  memcpy(hmac, HMAC_final(&ctx), SHA384_DIGEST_SIZE);
 
   free(key_arr);
 }
@@ -183,18 +174,117 @@ extern void c_dpi_HMAC_SHA512(const svOpenArrayHandle key, uint64_t key_len,
   uint8_t *key_arr = collect_bytes(key, key_len);
   assert(key_arr);
 
-  if (msg_len > 0u) {
-    uint8_t *msg_arr = collect_bytes(msg, msg_len);
-    assert(msg_arr);
+  HMAC_CTX ctx;
+  HMAC_SHA512_init(&ctx, key_arr, key_len);
+  update_from_array(&ctx.hash, msg, msg_len);
+  memcpy(hmac, HMAC_final(&ctx), SHA512_DIGEST_SIZE);
 
-    // compute SHA512 hash
-    HMAC_SHA512(key_arr, key_len, msg_arr, msg_len, (uint8_t *)hmac);
+  free(key_arr);
+}
 
-    free(msg_arr);
-  } else {
-    // compute SHA512 hash when msg is empty
-    HMAC_SHA512(key_arr, key_len, NULL, 0u, (uint8_t *)hmac);
+// Incremental SHA-2 and HMAC
+//
+// A context is created by c_dpi_SHA2_init or c_dpi_HMAC_SHA2_init and passed
+// to SV as a chandle. The message can then be given in any number of calls to
+// c_dpi_SHA2_update. c_dpi_SHA2_final returns the digest of the message so
+// far without changing the context, so the message can be continued after
+// checking a partial digest. c_dpi_SHA2_save and c_dpi_SHA2_restore copy the
+// whole context, matching the save and restore of the HMAC block's context.
+typedef struct dpi_sha2_ctx {
+  // Digest length in bits: 256, 384 or 512
+  uint32_t sha_len;
+  bool hmac;
+  // For HMAC the context of the inner hash, at the start of both HMAC context
+  // types, is the one the message is hashed into.
+  union {
+    HASH_CTX hash;
+    LITE_HMAC_CTX hmac_lite;
+    HMAC_CTX hmac;
+  } u;
+} dpi_sha2_ctx_t;
+
+extern void *c_dpi_SHA2_init(uint32_t sha_len) {
+  dpi_sha2_ctx_t *ctx = (dpi_sha2_ctx_t *)malloc(sizeof(dpi_sha2_ctx_t));
+  assert(ctx);
+
+  ctx->sha_len = sha_len;
+  ctx->hmac = false;
+  switch (sha_len) {
+    case 256:
+      SHA256_init(&ctx->u.hash);
+      break;
+    case 384:
+      SHA384_init(&ctx->u.hash);
+      break;
+    case 512:
+      SHA512_init(&ctx->u.hash);
+      break;
+    default:
+      assert(false && "Unsupported SHA-2 digest length");
+  }
+
+  return ctx;
+}
+
+extern void *c_dpi_HMAC_SHA2_init(uint32_t sha_len, const svOpenArrayHandle key,
+                                  uint64_t key_len) {
+  dpi_sha2_ctx_t *ctx = (dpi_sha2_ctx_t *)malloc(sizeof(dpi_sha2_ctx_t));
+  assert(ctx);
+
+  uint8_t *key_arr = collect_bytes(key, key_len);
+  assert(key_arr);
+
+  ctx->sha_len = sha_len;
+  ctx->hmac = true;
+  switch (sha_len) {
+    case 256:
+      HMAC_SHA256_init(&ctx->u.hmac_lite, key_arr, key_len);
+      break;
+    case 384:
+      HMAC_SHA384_init(&ctx->u.hmac, key_arr, key_len);
+      break;
+    case 512:
+      HMAC_SHA512_init(&ctx->u.hmac, key_arr, key_len);
+      break;
+    default:
+      assert(false && "Unsupported SHA-2 digest length");
   }
 
   free(key_arr);
+  return ctx;
+}
+
+extern void c_dpi_SHA2_update(void *ctx, const svOpenArrayHandle msg,
+                              uint64_t len) {
+  update_from_array(&((dpi_sha2_ctx_t *)ctx)->u.hash, msg, len);
 }
+
+extern void c_dpi_SHA2_final(void *ctx, uint32_t digest[16]) {
+  // Finalize a copy, leaving the context ready for more of the message
+  dpi_sha2_ctx_t final_ctx = *(dpi_sha2_ctx_t *)ctx;
+  const uint8_t *result;
+
+  if (!final_ctx.hmac) {
+    result = HASH_final(&final_ctx.u.hash);
+  } else if (final_ctx.sha_len == 256) {
+    result = HMAC_final_LITE(&final_ctx.u.hmac_lite);
+  } else {
+    result = HMAC_final(&final_ctx.u.hmac);
+  }
+
+  memset(digest, 0, 16 * sizeof(uint32_t));
+  memcpy(digest, result, final_ctx.sha_len / 8);
+}
+
+extern void *c_dpi_SHA2_save(void *ctx) {
+  dpi_sha2_ctx_t *saved = (dpi_sha2_ctx_t *)malloc(sizeof(dpi_sha2_ctx_t));
+  assert(saved);
+  *saved = *(dpi_sha2_ctx_t *)ctx;
+  return saved;
+}
+
+extern void c_dpi_SHA2_restore(void *ctx, void *saved) {
+  *(dpi_sha2_ctx_t *)ctx = *(dpi_sha2_ctx_t *)saved;
+}
+
+extern void c_dpi_SHA2_free(void *ctx) { free(ctx); }
@@ -54,6 +54,34 @@ package cryptoc_dpi_pkg;
                                                          input longint unsigned msg_len,
                                                          output int unsigned hmac[16]);
 
+  // Incremental SHA-2 / HMAC
+  //
+  // c_dpi_SHA2_init and c_dpi_HMAC_SHA2_init (sha_len of 256, 384 or 512) return a handle to a
+  // hash context held in C, to which the message can be given in any number of c_dpi_SHA2_update
+  // calls. c_dpi_SHA2_final returns the digest of the message so far (in the first sha_len / 32
+  // words of digest) and leaves the context unchanged, so the message can be continued.
+  // c_dpi_SHA2_save returns a new handle holding a copy of the context and c_dpi_SHA2_restore
+  // copies a saved context back. Every handle must be released with c_dpi_SHA2_free.
+  import "DPI-C" context function chandle c_dpi_SHA2_init(input int unsigned sha_len);
+
+  import "DPI-C" context function chandle c_dpi_HMAC_SHA2_init(input int unsigned sha_len,
+                                                               input bit[7:0] key[],
+                                                               input longint unsigned key_len);
+
+  import "DPI-C" context function void c_dpi_SHA2_update(input chandle ctx,
+                                                         input bit[7:0] msg[],
+                                                         input longint unsigned len);
+
+  import "DPI-C" context function void c_dpi_SHA2_final(input chandle ctx,
+                                                        output int unsigned digest[16]);
+
+  import "DPI-C" context function chandle c_dpi_SHA2_save(input chandle ctx);
+
+  import "DPI-C" context function void c_dpi_SHA2_restore(input chandle ctx,
+                                                          input chandle saved);
+
+  import "DPI-C" context function void c_dpi_SHA2_free(input chandle ctx);
+
   // sv wrapper functions
   function automatic void sv_dpi_get_sha_digest(input bit[7:0] msg[],
                                                 output int unsigned hash[8]);
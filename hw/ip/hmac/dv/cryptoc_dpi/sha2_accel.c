@@ -0,0 +1,310 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sha2_accel.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "sha256.h"
+#include "sha512.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SHA2_ACCEL_X86
+#endif
+
+#define ror32(value, bits) (((value) >> (bits)) | ((value) << (32 - (bits))))
+#define ror64(value, bits) (((value) >> (bits)) | ((value) << (64 - (bits))))
+
+static const uint32_t K256[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+static const uint64_t K512[80] = {
+    0x428A2F98D728AE22ll, 0x7137449123EF65CDll, 0xB5C0FBCFEC4D3B2Fll,
+    0xE9B5DBA58189DBBCll, 0x3956C25BF348B538ll, 0x59F111F1B605D019ll,
+    0x923F82A4AF194F9Bll, 0xAB1C5ED5DA6D8118ll, 0xD807AA98A3030242ll,
+    0x12835B0145706FBEll, 0x243185BE4EE4B28Cll, 0x550C7DC3D5FFB4E2ll,
+    0x72BE5D74F27B896Fll, 0x80DEB1FE3B1696B1ll, 0x9BDC06A725C71235ll,
+    0xC19BF174CF692694ll, 0xE49B69C19EF14AD2ll, 0xEFBE4786384F25E3ll,
+    0x0FC19DC68B8CD5B5ll, 0x240CA1CC77AC9C65ll, 0x2DE92C6F592B0275ll,
+    0x4A7484AA6EA6E483ll, 0x5CB0A9DCBD41FBD4ll, 0x76F988DA831153B5ll,
+    0x983E5152EE66DFABll, 0xA831C66D2DB43210ll, 0xB00327C898FB213Fll,
+    0xBF597FC7BEEF0EE4ll, 0xC6E00BF33DA88FC2ll, 0xD5A79147930AA725ll,
+    0x06CA6351E003826Fll, 0x142929670A0E6E70ll, 0x27B70A8546D22FFCll,
+    0x2E1B21385C26C926ll, 0x4D2C6DFC5AC42AEDll, 0x53380D139D95B3DFll,
+    0x650A73548BAF63DEll, 0x766A0ABB3C77B2A8ll, 0x81C2C92E47EDAEE6ll,
+    0x92722C851482353Bll, 0xA2BFE8A14CF10364ll, 0xA81A664BBC423001ll,
+    0xC24B8B70D0F89791ll, 0xC76C51A30654BE30ll, 0xD192E819D6EF5218ll,
+    0xD69906245565A910ll, 0xF40E35855771202All, 0x106AA07032BBD1B8ll,
+    0x19A4C116B8D2D0C8ll, 0x1E376C085141AB53ll, 0x2748774CDF8EEB99ll,
+    0x34B0BCB5E19B48A8ll, 0x391C0CB3C5C95A63ll, 0x4ED8AA4AE3418ACBll,
+    0x5B9CCA4F7763E373ll, 0x682E6FF3D6B2B8A3ll, 0x748F82EE5DEFB2FCll,
+    0x78A5636F43172F60ll, 0x84C87814A1F0AB72ll, 0x8CC702081A6439ECll,
+    0x90BEFFFA23631E28ll, 0xA4506CEBDE82BDE9ll, 0xBEF9A3F7B2C67915ll,
+    0xC67178F2E372532Bll, 0xCA273ECEEA26619Cll, 0xD186B8C721C0C207ll,
+    0xEADA7DD6CDE0EB1Ell, 0xF57D4F7FEE6ED178ll, 0x06F067AA72176FBAll,
+    0x0A637DC5A2C898A6ll, 0x113F9804BEF90DAEll, 0x1B710B35131C471Bll,
+    0x28DB77F523047D84ll, 0x32CAAB7B40C72493ll, 0x3C9EBE0A15C9BEBCll,
+    0x431D67C49C100D4Cll, 0x4CC5D4BECB3E42B6ll, 0x597F299CFC657E2All,
+    0x5FCB6FAB3AD6FAECll, 0x6C44198C4A475817ll};
+
+static uint32_t load_be32(const uint8_t *p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+         ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static uint64_t load_be64(const uint8_t *p) {
+  return ((uint64_t)load_be32(p) << 32) | load_be32(p + 4);
+}
+
+static void sha256_blocks_scalar(uint32_t state[8], const uint8_t *data,
+                                 size_t num_blocks) {
+  for (; num_blocks; --num_blocks, data += 64) {
+    uint32_t W[64];
+    int t;
+
+    for (t = 0; t < 16; ++t) {
+      W[t] = load_be32(data + 4 * t);
+    }
+    for (; t < 64; ++t) {
+      uint32_t s0 =
+          ror32(W[t - 15], 7) ^ ror32(W[t - 15], 18) ^ (W[t - 15] >> 3);
+      uint32_t s1 =
+          ror32(W[t - 2], 17) ^ ror32(W[t - 2], 19) ^ (W[t - 2] >> 10);
+      W[t] = W[t - 16] + s0 + W[t - 7] + s1;
+    }
+
+    uint32_t A = state[0], B = state[1], C = state[2], D = state[3];
+    uint32_t E = state[4], F = state[5], G = state[6], H = state[7];
+
+    for (t = 0; t < 64; ++t) {
+      uint32_t s0 = ror32(A, 2) ^ ror32(A, 13) ^ ror32(A, 22);
+      uint32_t maj = (A & B) ^ (A & C) ^ (B & C);
+      uint32_t s1 = ror32(E, 6) ^ ror32(E, 11) ^ ror32(E, 25);
+      uint32_t ch = (E & F) ^ (~E & G);
+      uint32_t t1 = H + s1 + ch + K256[t] + W[t];
+      uint32_t t2 = s0 + maj;
+
+      H = G;
+      G = F;
+      F = E;
+      E = D + t1;
+      D = C;
+      C = B;
+      B = A;
+      A = t1 + t2;
+    }
+
+    state[0] += A;
+    state[1] += B;
+    state[2] += C;
+    state[3] += D;
+    state[4] += E;
+    state[5] += F;
+    state[6] += G;
+    state[7] += H;
+  }
+}
+
+#ifdef SHA2_ACCEL_X86
+// SHA-256 with the SHA extensions. The state is held as ABEF and CDGH, the
+// layout the sha256rnds2 instruction works on.
+__attribute__((target("sha,sse4.1"))) static void sha256_blocks_shani(
+    uint32_t state[8], const uint8_t *data, size_t num_blocks) {
+  const __m128i bswap_mask =
+      _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+  __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((__m128i *)&state[0]), 0xB1);
+  __m128i state1 =
+      _mm_shuffle_epi32(_mm_loadu_si128((__m128i *)&state[4]), 0x1B);
+  __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);  // ABEF
+  state1 = _mm_blend_epi16(state1, tmp, 0xF0);       // CDGH
+
+  for (; num_blocks; --num_blocks, data += 64) {
+    __m128i abef_save = state0;
+    __m128i cdgh_save = state1;
+    // Message schedule, four words per vector, for the last four groups of
+    // four rounds
+    __m128i W[4];
+
+    for (int g = 0; g < 16; ++g) {
+      if (g < 4) {
+        W[g] = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *)(data + 16 * g)),
+                                bswap_mask);
+      } else {
+        // W[t] = s1(W[t-2]) + W[t-7] + s0(W[t-15]) + W[t-16]
+        __m128i w = _mm_sha256msg1_epu32(W[g & 3], W[(g + 1) & 3]);
+        w = _mm_add_epi32(w, _mm_alignr_epi8(W[(g + 3) & 3], W[(g + 2) & 3], 4));
+        W[g & 3] = _mm_sha256msg2_epu32(w, W[(g + 3) & 3]);
+      }
+
+      __m128i msg =
+          _mm_add_epi32(W[g & 3], _mm_loadu_si128((__m128i *)&K256[4 * g]));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+    }
+
+    state0 = _mm_add_epi32(state0, abef_save);
+    state1 = _mm_add_epi32(state1, cdgh_save);
+  }
+
+  tmp = _mm_shuffle_epi32(state0, 0x1B);      // FEBA
+  state1 = _mm_shuffle_epi32(state1, 0xB1);   // DCHG
+  state0 = _mm_blend_epi16(tmp, state1, 0xF0);  // DCBA
+  state1 = _mm_alignr_epi8(state1, tmp, 8);   // ABEF
+  _mm_storeu_si128((__m128i *)&state[0], state0);
+  _mm_storeu_si128((__m128i *)&state[4], state1);
+}
+#endif
+
+static void sha512_blocks_scalar(uint64_t state[8], const uint8_t *data,
+                                 size_t num_blocks) {
+  for (; num_blocks; --num_blocks, data += 128) {
+    uint64_t W[80];
+    int t;
+
+    for (t = 0; t < 16; ++t) {
+      W[t] = load_be64(data + 8 * t);
+    }
+    for (; t < 80; ++t) {
+      uint64_t s0 = ror64(W[t - 15], 1) ^ ror64(W[t - 15], 8) ^ (W[t - 15] >> 7);
+      uint64_t s1 = ror64(W[t - 2], 19) ^ ror64(W[t - 2], 61) ^ (W[t - 2] >> 6);
+      W[t] = W[t - 16] + s0 + W[t - 7] + s1;
+    }
+
+    uint64_t A = state[0], B = state[1], C = state[2], D = state[3];
+    uint64_t E = state[4], F = state[5], G = state[6], H = state[7];
+
+    for (t = 0; t < 80; ++t) {
+      uint64_t s0 = ror64(A, 28) ^ ror64(A, 34) ^ ror64(A, 39);
+      uint64_t maj = (A & B) ^ (A & C) ^ (B & C);
+      uint64_t s1 = ror64(E, 14) ^ ror64(E, 18) ^ ror64(E, 41);
+      uint64_t ch = (E & F) ^ (~E & G);
+      uint64_t t1 = H + s1 + ch + K512[t] + W[t];
+      uint64_t t2 = s0 + maj;
+
+      H = G;
+      G = F;
+      F = E;
+      E = D + t1;
+      D = C;
+      C = B;
+      B = A;
+      A = t1 + t2;
+    }
+
+    state[0] += A;
+    state[1] += B;
+    state[2] += C;
+    state[3] += D;
+    state[4] += E;
+    state[5] += F;
+    state[6] += G;
+    state[7] += H;
+  }
+}
+
+static void sha256_blocks(HASH_CTX *ctx, const uint8_t *data,
+                          size_t num_blocks) {
+  // The cryptoc SHA-256 keeps its 32-bit state words in the 64-bit state
+  // array of HASH_CTX, ignoring the upper halves.
+  uint32_t state[8];
+  for (int i = 0; i < 8; ++i) {
+    state[i] = (uint32_t)ctx->state[i];
+  }
+
+#ifdef SHA2_ACCEL_X86
+  if (__builtin_cpu_supports("sha")) {
+    sha256_blocks_shani(state, data, num_blocks);
+  } else {
+    sha256_blocks_scalar(state, data, num_blocks);
+  }
+#else
+  sha256_blocks_scalar(state, data, num_blocks);
+#endif
+
+  for (int i = 0; i < 8; ++i) {
+    ctx->state[i] = state[i];
+  }
+}
+
+void SHA2_accel_update(HASH_CTX *ctx, const void *data, size_t len) {
+  size_t block_size;
+  if (ctx->f->update == SHA256_update) {
+    block_size = 64;
+  } else if (ctx->f->update == SHA512_update) {
+    block_size = 128;
+  } else {
+    HASH_update(ctx, data, len);
+    return;
+  }
+
+  const uint8_t *p = (const uint8_t *)data;
+
+  // Complete any partial block in the context buffer
+  size_t buffered = ctx->count & (block_size - 1);
+  if (buffered) {
+    size_t fill = block_size - buffered;
+    if (fill > len) {
+      fill = len;
+    }
+    HASH_update(ctx, p, fill);
+    p += fill;
+    len -= fill;
+  }
+
+  size_t num_blocks = len / block_size;
+  if (num_blocks) {
+    if (block_size == 64) {
+      sha256_blocks(ctx, p, num_blocks);
+    } else {
+      sha512_blocks_scalar(ctx->state, p, num_blocks);
+    }
+    ctx->count += num_blocks * block_size;
+    p += num_blocks * block_size;
+    len -= num_blocks * block_size;
+  }
+
+  if (len) {
+    HASH_update(ctx, p, len);
+  }
+}
+
+void SHA2_accel_narrow(const uint32_t *words, uint8_t *bytes, size_t len) {
+  size_t i = 0;
+
+#ifdef SHA2_ACCEL_X86
+  // SSE2 is part of the x86-64 baseline. Mask each word to its byte then pack
+  // 16 words to 16 bytes with two saturating packs (which can't saturate).
+  const __m128i byte_mask = _mm_set1_epi32(0xff);
+  for (; i + 16 <= len; i += 16) {
+    __m128i w0 = _mm_and_si128(_mm_loadu_si128((__m128i *)&words[i]), byte_mask);
+    __m128i w1 =
+        _mm_and_si128(_mm_loadu_si128((__m128i *)&words[i + 4]), byte_mask);
+    __m128i w2 =
+        _mm_and_si128(_mm_loadu_si128((__m128i *)&words[i + 8]), byte_mask);
+    __m128i w3 =
+        _mm_and_si128(_mm_loadu_si128((__m128i *)&words[i + 12]), byte_mask);
+    __m128i h0 = _mm_packs_epi32(w0, w1);
+    __m128i h1 = _mm_packs_epi32(w2, w3);
+    _mm_storeu_si128((__m128i *)&bytes[i], _mm_packus_epi16(h0, h1));
+  }
+#endif
+
+  for (; i < len; ++i) {
+    bytes[i] = (uint8_t)words[i];
+  }
+}
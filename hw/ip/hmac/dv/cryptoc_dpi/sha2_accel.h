@@ -0,0 +1,32 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_HW_IP_HMAC_DV_CRYPTOC_DPI_SHA2_ACCEL_H_
+#define OPENTITAN_HW_IP_HMAC_DV_CRYPTOC_DPI_SHA2_ACCEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hash-internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Equivalent to HASH_update(ctx, data, len), but compresses whole blocks
+// directly from `data` rather than a byte at a time through ctx->buf. SHA-256
+// blocks use the x86 SHA extensions where the host supports them.
+//
+// Contexts for hashes other than SHA-256/384/512 are passed to HASH_update.
+void SHA2_accel_update(HASH_CTX *ctx, const void *data, size_t len);
+
+// Narrow `len` 32-bit words, each holding one byte (as SV open arrays of
+// bit[7:0] are laid out), to a byte array.
+void SHA2_accel_narrow(const uint32_t *words, uint8_t *bytes, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // OPENTITAN_HW_IP_HMAC_DV_CRYPTOC_DPI_SHA2_ACCEL_H_
@@ -2,28 +2,172 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <list>
+#include <vector>
 
+#include "keccak_batch.h"
 #include "svdpi.h"
 #include "vendor/kerukuro_digestpp/algorithm/kmac.hpp"
 #include "vendor/kerukuro_digestpp/algorithm/sha3.hpp"
 #include "vendor/kerukuro_digestpp/algorithm/shake.hpp"
 
+namespace {
+
+/**
+ * State of an incremental hash computation, shared between the
+ * `c_dpi_*_init`, `c_dpi_digestpp_absorb` and `c_dpi_digestpp_squeeze`
+ * functions below through an SV chandle.
+ */
+class DigestppCtx {
+ public:
+  virtual ~DigestppCtx() {}
+
+  virtual bool Absorb(const uint8_t *data, size_t len) = 0;
+  virtual bool Squeeze(uint8_t *out, size_t len) = 0;
+};
+
+/**
+ * Context for a fixed output length function (SHA-3 or KMAC).
+ *
+ * Squeezing returns the digest of the message absorbed so far without
+ * finalizing the state, so more of the message can then be absorbed. This
+ * allows a digest to be checked at several points through a long message
+ * without hashing the message from the start each time.
+ */
+template <typename Hasher>
+class FixedDigestppCtx : public DigestppCtx {
+ public:
+  FixedDigestppCtx(const Hasher &hasher, size_t digest_len)
+      : hasher_(hasher), digest_len_(digest_len) {}
+
+  bool Absorb(const uint8_t *data, size_t len) override {
+    hasher_.absorb(data, len);
+    return true;
+  }
+
+  bool Squeeze(uint8_t *out, size_t len) override {
+    if (len != digest_len_) {
+      fprintf(stderr,
+              "ERROR: digestpp_dpi: squeezed %zu bytes from a hash with a %zu "
+              "byte digest\n",
+              len, digest_len_);
+      return false;
+    }
+    hasher_.digest(out, len);
+    return true;
+  }
+
+ private:
+  Hasher hasher_;
+  size_t digest_len_;
+};
+
+/**
+ * Context for an extendable output function (SHAKE, cSHAKE or KMAC-XOF).
+ *
+ * The first squeeze ends the message, after which each squeeze returns the
+ * next bytes of the output.
+ *
+ * Output is generated from a copy of the absorbed state in a single squeeze of
+ * the hasher and buffered: digestpp doesn't apply the permutation when a
+ * squeeze starts exactly at the end of a previous one that filled the rate.
+ * The buffer at least doubles each time it is refilled, so the cost of a
+ * sequence of squeezes stays linear in the output length.
+ */
+template <typename Hasher>
+class XofDigestppCtx : public DigestppCtx {
+ public:
+  explicit XofDigestppCtx(const Hasher &hasher)
+      : hasher_(hasher), squeezing_(false), output_pos_(0) {}
+
+  bool Absorb(const uint8_t *data, size_t len) override {
+    if (squeezing_) {
+      fprintf(stderr,
+              "ERROR: digestpp_dpi: cannot absorb after squeezing output\n");
+      return false;
+    }
+    hasher_.absorb(data, len);
+    return true;
+  }
+
+  bool Squeeze(uint8_t *out, size_t len) override {
+    squeezing_ = true;
+
+    if (output_pos_ + len > output_.size()) {
+      size_t new_size = std::max(output_pos_ + len, 2 * output_.size());
+      Hasher copy(hasher_);
+      output_.resize(new_size);
+      copy.squeeze(output_.data(), new_size);
+    }
+
+    memcpy(out, &output_[output_pos_], len);
+    output_pos_ += len;
+    return true;
+  }
+
+ private:
+  Hasher hasher_;
+  bool squeezing_;
+  std::vector<uint8_t> output_;
+  size_t output_pos_;
+};
+
+}  // namespace
+
 extern "C" {
 
 //////////////////////
 // HELPER FUNCTIONS //
 //////////////////////
 
+/**
+ * Returns a direct pointer to the elements of an unsized `bit [7:0]` array and
+ * the size in bytes of each element, if the simulator supports `svGetArrayPtr`
+ * for it. Returns nullptr otherwise.
+ *
+ * Elements are expected in canonical form: either packed one per byte or one
+ * per `svBitVecVal`, with the lowest index first.
+ */
+static void *get_array_ptr(const svOpenArrayHandle arr, uint64_t *elem_size) {
+  void *ptr = svGetArrayPtr(arr);
+  int arr_len = svSize(arr, 1);
+  if (ptr == nullptr || arr_len <= 0 || svLeft(arr, 1) != 0 ||
+      svRight(arr, 1) != arr_len - 1) {
+    return nullptr;
+  }
+
+  *elem_size = svSizeOfArray(arr) / arr_len;
+  if (*elem_size != 1 && *elem_size != sizeof(svBitVecVal)) {
+    return nullptr;
+  }
+  return ptr;
+}
+
 /**
  * Generic function to load an unsized array from SV memory into C memory.
  */
 static void load_arr_from_simulator(const svOpenArrayHandle arr,
                                     uint8_t *array_out, uint64_t array_len) {
+  uint64_t elem_size;
+  void *arr_ptr = get_array_ptr(arr, &elem_size);
+
+  if (arr_ptr != nullptr && array_len <= (uint64_t)svSize(arr, 1)) {
+    if (elem_size == 1) {
+      memcpy(array_out, arr_ptr, array_len);
+    } else {
+      const svBitVecVal *vals = (const svBitVecVal *)arr_ptr;
+      for (uint64_t i = 0; i < array_len; i++) {
+        array_out[i] = (uint8_t)vals[i];
+      }
+    }
+    return;
+  }
+
   for (uint64_t i = 0; i < array_len; i++) {
     svBitVecVal val;
     svGetBitArrElem1VecVal(&val, arr, i);
@@ -37,6 +181,20 @@ static void load_arr_from_simulator(const svOpenArrayHandle arr,
 static void write_array_to_simulator(const svOpenArrayHandle arr,
                                      uint8_t *data) {
   uint64_t arr_len = svSize(arr, 1);
+  uint64_t elem_size;
+  void *arr_ptr = get_array_ptr(arr, &elem_size);
+
+  if (arr_ptr != nullptr) {
+    if (elem_size == 1) {
+      memcpy(arr_ptr, data, arr_len);
+    } else {
+      svBitVecVal *vals = (svBitVecVal *)arr_ptr;
+      for (uint64_t i = 0; i < arr_len; ++i) {
+        vals[i] = (svBitVecVal)data[i];
+      }
+    }
+    return;
+  }
 
   for (uint64_t i = 0; i < arr_len; ++i) {
     svBitVecVal data_val = (svBitVecVal)data[i];
@@ -358,4 +516,198 @@ extern void c_dpi_kmac256_xof(const svOpenArrayHandle msg, uint64_t msg_len,
   // Return the digest array to SV code
   write_array_to_simulator(digest, digest_arr);
 }
+
+////////////////////////////
+// Incremental hash state //
+////////////////////////////
+
+/**
+ * Start an incremental SHA3 computation. `sha_len` must be in
+ * {224, 256, 384, 512}.
+ *
+ * Returns a handle to pass to `c_dpi_digestpp_absorb` and
+ * `c_dpi_digestpp_squeeze`, which must be released with `c_dpi_digestpp_free`.
+ */
+extern void *c_dpi_sha3_init(uint32_t sha_len) {
+  return new FixedDigestppCtx<digestpp::sha3>(digestpp::sha3(sha_len),
+                                              sha_len / 8);
+}
+
+/**
+ * Start an incremental SHAKE computation (or cSHAKE if either of
+ * `function_name` or `customization_str` is non-empty). `strength` must be in
+ * {128, 256}.
+ */
+extern void *c_dpi_shake_init(uint32_t strength, const char *function_name,
+                              const char *customization_str) {
+  if (strength == 128) {
+    digestpp::cshake128 shake;
+    shake.set_function_name(function_name, strlen(function_name));
+    shake.set_customization(customization_str, strlen(customization_str));
+    return new XofDigestppCtx<digestpp::cshake128>(shake);
+  }
+
+  digestpp::cshake256 shake;
+  shake.set_function_name(function_name, strlen(function_name));
+  shake.set_customization(customization_str, strlen(customization_str));
+  return new XofDigestppCtx<digestpp::cshake256>(shake);
+}
+
+/**
+ * Start an incremental KMAC computation. `strength` must be in {128, 256}.
+ *
+ * `output_len` is the digest length in bytes, which KMAC encodes into the
+ * message so must be known up front. It is ignored if `xof` is set, in which
+ * case the output can be squeezed in any number of chunks.
+ */
+extern void *c_dpi_kmac_init(uint32_t strength, svBit xof,
+                             const svOpenArrayHandle key, uint64_t key_len,
+                             const char *customization_str,
+                             uint64_t output_len) {
+  std::vector<uint8_t> key_arr(key_len);
+  load_arr_from_simulator(key, key_arr.data(), key_len);
+
+  DigestppCtx *ctx;
+  if (strength == 128 && xof) {
+    digestpp::kmac128_xof kmac;
+    kmac.set_customization(customization_str, strlen(customization_str));
+    kmac.set_key(key_arr.data(), key_len);
+    ctx = new XofDigestppCtx<digestpp::kmac128_xof>(kmac);
+  } else if (strength == 128) {
+    digestpp::kmac128 kmac(output_len * 8);
+    kmac.set_customization(customization_str, strlen(customization_str));
+    kmac.set_key(key_arr.data(), key_len);
+    ctx = new FixedDigestppCtx<digestpp::kmac128>(kmac, output_len);
+  } else if (xof) {
+    digestpp::kmac256_xof kmac;
+    kmac.set_customization(customization_str, strlen(customization_str));
+    kmac.set_key(key_arr.data(), key_len);
+    ctx = new XofDigestppCtx<digestpp::kmac256_xof>(kmac);
+  } else {
+    digestpp::kmac256 kmac(output_len * 8);
+    kmac.set_customization(customization_str, strlen(customization_str));
+    kmac.set_key(key_arr.data(), key_len);
+    ctx = new FixedDigestppCtx<digestpp::kmac256>(kmac, output_len);
+  }
+
+  return ctx;
+}
+
+/**
+ * Absorb the next `msg_len` bytes of the message into an incremental hash.
+ */
+extern void c_dpi_digestpp_absorb(void *ctx, const svOpenArrayHandle msg,
+                                  uint64_t msg_len) {
+  std::vector<uint8_t> msg_arr(msg_len);
+  load_arr_from_simulator(msg, msg_arr.data(), msg_len);
+
+  static_cast<DigestppCtx *>(ctx)->Absorb(msg_arr.data(), msg_len);
+}
+
+/**
+ * Get output from an incremental hash.
+ *
+ * For SHA3 and KMAC this is the digest of the message absorbed so far, and
+ * `output_len` must be the digest length. The message can then be continued
+ * with further calls to `c_dpi_digestpp_absorb`.
+ *
+ * For SHAKE, cSHAKE and KMAC-XOF this ends the message and returns the next
+ * `output_len` bytes of output.
+ */
+extern void c_dpi_digestpp_squeeze(void *ctx, uint64_t output_len,
+                                   svOpenArrayHandle digest) {
+  // The digest array may be larger than output_len, as for the one-shot
+  // functions above
+  std::vector<uint8_t> digest_arr(
+      std::max<uint64_t>(output_len, svSize(digest, 1)));
+
+  if (static_cast<DigestppCtx *>(ctx)->Squeeze(digest_arr.data(),
+                                               output_len)) {
+    write_array_to_simulator(digest, digest_arr.data());
+  }
+}
+
+/**
+ * Release an incremental hash handle.
+ */
+extern void c_dpi_digestpp_free(void *ctx) {
+  delete static_cast<DigestppCtx *>(ctx);
+}
+
+///////////////////
+// Batch hashing //
+///////////////////
+
+/**
+ * Hash `num_msgs` messages at once using the multi-buffer Keccak in
+ * keccak_batch.cc, which is much faster than hashing them one at a time when
+ * the host supports AVX2 or AVX-512.
+ *
+ * The messages are concatenated in `msgs`, with their lengths in `msg_lens`.
+ * `output_len` bytes of output are written to `digest` for each message in
+ * turn.
+ */
+static void keccak_batch_from_simulator(const KeccakSpongeParams &params,
+                                        const svOpenArrayHandle msgs,
+                                        const svOpenArrayHandle msg_lens,
+                                        uint32_t num_msgs, uint64_t output_len,
+                                        svOpenArrayHandle digest) {
+  std::vector<size_t> lens(num_msgs);
+  uint64_t total_len = 0;
+  for (uint32_t i = 0; i < num_msgs; ++i) {
+    lens[i] = *(const uint64_t *)svGetArrElemPtr1(msg_lens, i);
+    total_len += lens[i];
+  }
+
+  std::vector<uint8_t> msg_arr(total_len);
+  load_arr_from_simulator(msgs, msg_arr.data(), total_len);
+
+  std::vector<const uint8_t *> msg_ptrs(num_msgs);
+  uint64_t offset = 0;
+  for (uint32_t i = 0; i < num_msgs; ++i) {
+    msg_ptrs[i] = msg_arr.data() + offset;
+    offset += lens[i];
+  }
+
+  std::vector<uint8_t> digest_arr(
+      std::max<uint64_t>(num_msgs * output_len, svSize(digest, 1)));
+  keccak_sponge_batch(params, msg_ptrs.data(), lens.data(), num_msgs,
+                      digest_arr.data(), output_len);
+
+  write_array_to_simulator(digest, digest_arr.data());
+}
+
+extern void c_dpi_sha3_batch(uint32_t sha_len, const svOpenArrayHandle msgs,
+                             const svOpenArrayHandle msg_lens,
+                             uint32_t num_msgs, svOpenArrayHandle digest) {
+  keccak_batch_from_simulator(keccak_sha3_params(sha_len), msgs, msg_lens,
+                              num_msgs, sha_len / 8, digest);
+}
+
+extern void c_dpi_shake_batch(uint32_t strength, const char *function_name,
+                              const char *customization_str,
+                              const svOpenArrayHandle msgs,
+                              const svOpenArrayHandle msg_lens,
+                              uint32_t num_msgs, uint64_t output_len,
+                              svOpenArrayHandle digest) {
+  keccak_batch_from_simulator(
+      keccak_cshake_params(strength, function_name, customization_str), msgs,
+      msg_lens, num_msgs, output_len, digest);
+}
+
+extern void c_dpi_kmac_batch(uint32_t strength, svBit xof,
+                             const svOpenArrayHandle key, uint64_t key_len,
+                             const char *customization_str,
+                             const svOpenArrayHandle msgs,
+                             const svOpenArrayHandle msg_lens,
+                             uint32_t num_msgs, uint64_t output_len,
+                             svOpenArrayHandle digest) {
+  std::vector<uint8_t> key_arr(key_len);
+  load_arr_from_simulator(key, key_arr.data(), key_len);
+
+  keccak_batch_from_simulator(
+      keccak_kmac_params(strength, xof, key_arr.data(), key_len,
+                         customization_str, output_len),
+      msgs, msg_lens, num_msgs, output_len, digest);
+}
 }
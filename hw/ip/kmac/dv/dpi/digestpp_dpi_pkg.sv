@@ -107,4 +107,92 @@ package digestpp_dpi_pkg;
     output bit[7:0]         digest[]
   );
 
+  // Incremental hashing
+  //
+  // Each of the *_init functions returns a handle to hash state held in C++.
+  // The message is given to c_dpi_digestpp_absorb in any number of chunks and
+  // output is read with c_dpi_digestpp_squeeze. The handle must be released
+  // with c_dpi_digestpp_free.
+  //
+  // For SHA3 and KMAC, c_dpi_digestpp_squeeze returns the digest of the message
+  // absorbed so far (output_len must be the digest length) and more of the
+  // message can be absorbed afterwards. For SHAKE, cSHAKE and KMAC-XOF it ends
+  // the message, and each call returns the next output_len bytes.
+  import "DPI-C" context function chandle c_dpi_sha3_init(
+    input int unsigned      sha_len
+  );
+
+  // cSHAKE if either string is non-empty, otherwise SHAKE
+  import "DPI-C" context function chandle c_dpi_shake_init(
+    input int unsigned      strength,
+    input string            function_name,
+    input string            customization_str
+  );
+
+  // output_len is ignored when xof is set
+  import "DPI-C" context function chandle c_dpi_kmac_init(
+    input int unsigned      strength,
+    input bit               xof,
+    input bit[7:0]          key[],
+    input longint unsigned  key_len,
+    input string            customization_str,
+    input longint unsigned  output_len
+  );
+
+  import "DPI-C" context function void c_dpi_digestpp_absorb(
+    input chandle           ctx,
+    input bit[7:0]          msg[],
+    input longint unsigned  msg_len
+  );
+
+  import "DPI-C" context function void c_dpi_digestpp_squeeze(
+    input chandle           ctx,
+    input longint unsigned  output_len,
+    output bit[7:0]         digest[]
+  );
+
+  import "DPI-C" context function void c_dpi_digestpp_free(
+    input chandle           ctx
+  );
+
+  // Batch hashing
+  //
+  // Hash num_msgs messages with the same function, using a multi-buffer
+  // Keccak-f[1600] that processes several messages at once with AVX2 or
+  // AVX-512 when the host supports it. The messages are concatenated in msgs
+  // with their lengths in msg_lens. The digests are concatenated in digest,
+  // output_len bytes each (sha_len / 8 for SHA3).
+  import "DPI-C" context function void c_dpi_sha3_batch(
+    input int unsigned      sha_len,
+    input bit[7:0]          msgs[],
+    input longint unsigned  msg_lens[],
+    input int unsigned      num_msgs,
+    output bit[7:0]         digest[]
+  );
+
+  // cSHAKE if either string is non-empty, otherwise SHAKE
+  import "DPI-C" context function void c_dpi_shake_batch(
+    input int unsigned      strength,
+    input string            function_name,
+    input string            customization_str,
+    input bit[7:0]          msgs[],
+    input longint unsigned  msg_lens[],
+    input int unsigned      num_msgs,
+    input longint unsigned  output_len,
+    output bit[7:0]         digest[]
+  );
+
+  import "DPI-C" context function void c_dpi_kmac_batch(
+    input int unsigned      strength,
+    input bit               xof,
+    input bit[7:0]          key[],
+    input longint unsigned  key_len,
+    input string            customization_str,
+    input bit[7:0]          msgs[],
+    input longint unsigned  msg_lens[],
+    input int unsigned      num_msgs,
+    input longint unsigned  output_len,
+    output bit[7:0]         digest[]
+  );
+
 endpackage
@@ -0,0 +1,392 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "keccak_batch.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <numeric>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define KECCAK_BATCH_X86 1
+#endif
+
+namespace {
+
+const uint64_t kRoundConstants[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
+    0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
+    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
+    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL};
+
+// Lanes of 4 and 8 states, using the GCC/Clang vector extensions. Element i of
+// a vector lane belongs to state i.
+typedef uint64_t KeccakLanes4 __attribute__((vector_size(32)));
+typedef uint64_t KeccakLanes8 __attribute__((vector_size(64)));
+
+// A macro rather than a function, as passing vectors by value between
+// functions compiled for different instruction sets isn't portable.
+#define KECCAK_ROL(x, n) (((x) << (n)) | ((x) >> (64 - (n))))
+
+// The 24 rounds of Keccak-f[1600] on a state whose lanes are of type `Lane`,
+// which is either a single uint64_t or a vector of the same lane of several
+// states. This is always inlined so that it is compiled for the instruction set
+// of the caller.
+template <typename Lane>
+__attribute__((always_inline)) inline void KeccakRounds(Lane *A) {
+  Lane B[25];
+
+  for (int round = 0; round < 24; ++round) {
+    // Theta
+    Lane C0 = A[0] ^ A[5] ^ A[10] ^ A[15] ^ A[20];
+    Lane C1 = A[1] ^ A[6] ^ A[11] ^ A[16] ^ A[21];
+    Lane C2 = A[2] ^ A[7] ^ A[12] ^ A[17] ^ A[22];
+    Lane C3 = A[3] ^ A[8] ^ A[13] ^ A[18] ^ A[23];
+    Lane C4 = A[4] ^ A[9] ^ A[14] ^ A[19] ^ A[24];
+    Lane D0 = C4 ^ KECCAK_ROL(C1, 1);
+    Lane D1 = C0 ^ KECCAK_ROL(C2, 1);
+    Lane D2 = C1 ^ KECCAK_ROL(C3, 1);
+    Lane D3 = C2 ^ KECCAK_ROL(C4, 1);
+    Lane D4 = C3 ^ KECCAK_ROL(C0, 1);
+
+    // Rho and pi: B[y + 5 * ((2x + 3y) % 5)] = rot(A[x + 5y], r[x, y])
+    B[0] = A[0] ^ D0;
+    B[1] = KECCAK_ROL(A[6] ^ D1, 44);
+    B[2] = KECCAK_ROL(A[12] ^ D2, 43);
+    B[3] = KECCAK_ROL(A[18] ^ D3, 21);
+    B[4] = KECCAK_ROL(A[24] ^ D4, 14);
+    B[5] = KECCAK_ROL(A[3] ^ D3, 28);
+    B[6] = KECCAK_ROL(A[9] ^ D4, 20);
+    B[7] = KECCAK_ROL(A[10] ^ D0, 3);
+    B[8] = KECCAK_ROL(A[16] ^ D1, 45);
+    B[9] = KECCAK_ROL(A[22] ^ D2, 61);
+    B[10] = KECCAK_ROL(A[1] ^ D1, 1);
+    B[11] = KECCAK_ROL(A[7] ^ D2, 6);
+    B[12] = KECCAK_ROL(A[13] ^ D3, 25);
+    B[13] = KECCAK_ROL(A[19] ^ D4, 8);
+    B[14] = KECCAK_ROL(A[20] ^ D0, 18);
+    B[15] = KECCAK_ROL(A[4] ^ D4, 27);
+    B[16] = KECCAK_ROL(A[5] ^ D0, 36);
+    B[17] = KECCAK_ROL(A[11] ^ D1, 10);
+    B[18] = KECCAK_ROL(A[17] ^ D2, 15);
+    B[19] = KECCAK_ROL(A[23] ^ D3, 56);
+    B[20] = KECCAK_ROL(A[2] ^ D2, 62);
+    B[21] = KECCAK_ROL(A[8] ^ D3, 55);
+    B[22] = KECCAK_ROL(A[14] ^ D4, 39);
+    B[23] = KECCAK_ROL(A[15] ^ D0, 41);
+    B[24] = KECCAK_ROL(A[21] ^ D1, 2);
+
+    // Chi
+    for (int y = 0; y < 25; y += 5) {
+      A[y + 0] = B[y + 0] ^ (~B[y + 1] & B[y + 2]);
+      A[y + 1] = B[y + 1] ^ (~B[y + 2] & B[y + 3]);
+      A[y + 2] = B[y + 2] ^ (~B[y + 3] & B[y + 4]);
+      A[y + 3] = B[y + 3] ^ (~B[y + 4] & B[y + 0]);
+      A[y + 4] = B[y + 4] ^ (~B[y + 0] & B[y + 1]);
+    }
+
+    // Iota
+    A[0] ^= kRoundConstants[round];
+  }
+}
+
+void KeccakF1600Scalar(uint64_t (*states)[25]) { KeccakRounds(states[0]); }
+
+#ifdef KECCAK_BATCH_X86
+// The vector implementations transpose `Width` states so that each vector
+// holds the same lane of every state.
+template <typename Lane, int Width>
+__attribute__((always_inline)) inline void KeccakF1600Vec(
+    uint64_t (*states)[25]) {
+  Lane A[25];
+  for (int i = 0; i < 25; ++i) {
+    for (int s = 0; s < Width; ++s) {
+      A[i][s] = states[s][i];
+    }
+  }
+
+  KeccakRounds(A);
+
+  for (int i = 0; i < 25; ++i) {
+    for (int s = 0; s < Width; ++s) {
+      states[s][i] = A[i][s];
+    }
+  }
+}
+
+__attribute__((target("avx2"))) void KeccakF1600Avx2(uint64_t (*states)[25]) {
+  KeccakF1600Vec<KeccakLanes4, 4>(states);
+}
+
+__attribute__((target("avx512f"))) void KeccakF1600Avx512(
+    uint64_t (*states)[25]) {
+  KeccakF1600Vec<KeccakLanes8, 8>(states);
+}
+#endif
+
+KeccakImpl selected_impl = keccak_best_impl();
+
+void (*ImplFunction(KeccakImpl impl))(uint64_t (*)[25]) {
+  switch (impl) {
+#ifdef KECCAK_BATCH_X86
+    case kKeccakImplAvx512:
+      return KeccakF1600Avx512;
+    case kKeccakImplAvx2:
+      return KeccakF1600Avx2;
+#endif
+    default:
+      return KeccakF1600Scalar;
+  }
+}
+
+uint64_t LoadLE64(const uint8_t *bytes) {
+  uint64_t val = 0;
+  for (int i = 7; i >= 0; --i) {
+    val = (val << 8) | bytes[i];
+  }
+  return val;
+}
+
+void StoreLE64(uint64_t val, uint8_t *bytes) {
+  for (int i = 0; i < 8; ++i) {
+    bytes[i] = static_cast<uint8_t>(val >> (8 * i));
+  }
+}
+
+// XOR `rate` bytes (a multiple of 8) into a state
+void AbsorbBlock(uint64_t *state, const uint8_t *block, size_t rate) {
+  for (size_t i = 0; i < rate / 8; ++i) {
+    state[i] ^= LoadLE64(block + 8 * i);
+  }
+}
+
+void SqueezeBytes(const uint64_t *state, uint8_t *out, size_t len) {
+  uint8_t lane_bytes[8];
+  for (size_t i = 0; i < len; i += 8) {
+    StoreLE64(state[i / 8], lane_bytes);
+    memcpy(out + i, lane_bytes, std::min<size_t>(8, len - i));
+  }
+}
+
+// Encodings from NIST SP 800-185
+void LeftEncode(uint64_t x, std::vector<uint8_t> &out) {
+  uint8_t bytes[8];
+  int n = 0;
+  do {
+    bytes[n++] = static_cast<uint8_t>(x);
+    x >>= 8;
+  } while (x);
+
+  out.push_back(n);
+  for (int i = n - 1; i >= 0; --i) {
+    out.push_back(bytes[i]);
+  }
+}
+
+void RightEncode(uint64_t x, std::vector<uint8_t> &out) {
+  uint8_t bytes[8];
+  int n = 0;
+  do {
+    bytes[n++] = static_cast<uint8_t>(x);
+    x >>= 8;
+  } while (x);
+
+  for (int i = n - 1; i >= 0; --i) {
+    out.push_back(bytes[i]);
+  }
+  out.push_back(n);
+}
+
+void EncodeString(const uint8_t *str, size_t len, std::vector<uint8_t> &out) {
+  LeftEncode(static_cast<uint64_t>(len) * 8, out);
+  out.insert(out.end(), str, str + len);
+}
+
+// Append bytepad(x, rate), where x is everything in `out` from `start`
+void BytePad(size_t start, size_t rate, std::vector<uint8_t> &out) {
+  std::vector<uint8_t> x(out.begin() + start, out.end());
+  out.resize(start);
+  LeftEncode(rate, out);
+  out.insert(out.end(), x.begin(), x.end());
+  out.resize(start + (out.size() - start + rate - 1) / rate * rate, 0);
+}
+
+// Rate in bytes for a capacity of twice `strength` bits (which for SHA3 is the
+// digest length)
+size_t RateForStrength(uint32_t strength) { return 200 - strength / 4; }
+
+}  // namespace
+
+KeccakImpl keccak_best_impl() {
+#ifdef KECCAK_BATCH_X86
+  // This may run before the constructor that initialises the CPU feature
+  // flags, from the initialisation of selected_impl.
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return kKeccakImplAvx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return kKeccakImplAvx2;
+  }
+#endif
+  return kKeccakImplScalar;
+}
+
+KeccakImpl keccak_get_impl() { return selected_impl; }
+
+bool keccak_set_impl(KeccakImpl impl) {
+  if (impl > keccak_best_impl()) {
+    return false;
+  }
+  selected_impl = impl;
+  return true;
+}
+
+const char *keccak_impl_name(KeccakImpl impl) {
+  switch (impl) {
+    case kKeccakImplAvx512:
+      return "avx512";
+    case kKeccakImplAvx2:
+      return "avx2";
+    default:
+      return "scalar";
+  }
+}
+
+void keccak_f1600_batch(uint64_t (*states)[25], size_t num_states) {
+  size_t width = selected_impl;
+  void (*permute)(uint64_t(*)[25]) = ImplFunction(selected_impl);
+
+  size_t i = 0;
+  for (; i + width <= num_states; i += width) {
+    permute(states + i);
+  }
+
+  // Remaining states are permuted with the rest of the lanes unused
+  if (i < num_states) {
+    uint64_t tail[kKeccakImplAvx512][25] = {};
+    memcpy(tail, states + i, (num_states - i) * sizeof(*states));
+    permute(tail);
+    memcpy(states + i, tail, (num_states - i) * sizeof(*states));
+  }
+}
+
+KeccakSpongeParams keccak_sha3_params(uint32_t sha_len) {
+  return {RateForStrength(sha_len), 0x06, {}, {}};
+}
+
+KeccakSpongeParams keccak_cshake_params(uint32_t strength,
+                                        const std::string &function_name,
+                                        const std::string &customization_str) {
+  KeccakSpongeParams params = {RateForStrength(strength), 0x1f, {}, {}};
+
+  if (!function_name.empty() || !customization_str.empty()) {
+    params.suffix = 0x04;
+    EncodeString(reinterpret_cast<const uint8_t *>(function_name.data()),
+                 function_name.size(), params.prefix);
+    EncodeString(reinterpret_cast<const uint8_t *>(customization_str.data()),
+                 customization_str.size(), params.prefix);
+    BytePad(0, params.rate, params.prefix);
+  }
+
+  return params;
+}
+
+KeccakSpongeParams keccak_kmac_params(uint32_t strength, bool xof,
+                                      const uint8_t *key, size_t key_len,
+                                      const std::string &customization_str,
+                                      size_t output_len) {
+  KeccakSpongeParams params =
+      keccak_cshake_params(strength, "KMAC", customization_str);
+
+  size_t key_start = params.prefix.size();
+  EncodeString(key, key_len, params.prefix);
+  BytePad(key_start, params.rate, params.prefix);
+
+  RightEncode(xof ? 0 : static_cast<uint64_t>(output_len) * 8, params.trailer);
+  return params;
+}
+
+void keccak_sponge_batch(const KeccakSpongeParams &params,
+                         const uint8_t *const *msgs, const size_t *msg_lens,
+                         size_t num_msgs, uint8_t *out, size_t output_len) {
+  const size_t rate = params.rate;
+  assert(params.prefix.size() % rate == 0);
+
+  // The prefix is the same for every message, so it is absorbed just once
+  uint64_t prefix_state[25] = {};
+  for (size_t i = 0; i < params.prefix.size(); i += rate) {
+    AbsorbBlock(prefix_state, &params.prefix[i], rate);
+    keccak_f1600_batch(&prefix_state, 1);
+  }
+
+  // Process messages in order of length so each group has a similar number of
+  // blocks to absorb
+  std::vector<size_t> order(num_msgs);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return msg_lens[a] < msg_lens[b];
+  });
+
+  const size_t group_size = keccak_get_impl();
+  uint64_t states[kKeccakImplAvx512][25];
+  uint64_t final_states[kKeccakImplAvx512][25];
+  std::vector<uint8_t> padded[kKeccakImplAvx512];
+
+  for (size_t group = 0; group < num_msgs; group += group_size) {
+    size_t num_states = std::min(group_size, num_msgs - group);
+    size_t max_blocks = 0;
+
+    // Pad each message along with its trailer. The last byte of the padding
+    // may also be the first.
+    for (size_t s = 0; s < num_states; ++s) {
+      size_t msg = order[group + s];
+      std::vector<uint8_t> &input = padded[s];
+      input.assign(msgs[msg], msgs[msg] + msg_lens[msg]);
+      input.insert(input.end(), params.trailer.begin(), params.trailer.end());
+      input.push_back(params.suffix);
+      input.resize((input.size() + rate - 1) / rate * rate, 0);
+      input.back() |= 0x80;
+
+      max_blocks = std::max(max_blocks, input.size() / rate);
+      memcpy(states[s], prefix_state, sizeof(prefix_state));
+    }
+
+    // Absorb. A state that has absorbed all its blocks is saved, as it is
+    // still permuted with the others in the group.
+    for (size_t block = 0; block < max_blocks; ++block) {
+      for (size_t s = 0; s < num_states; ++s) {
+        if (block * rate < padded[s].size()) {
+          AbsorbBlock(states[s], &padded[s][block * rate], rate);
+        }
+      }
+
+      keccak_f1600_batch(states, num_states);
+
+      for (size_t s = 0; s < num_states; ++s) {
+        if ((block + 1) * rate == padded[s].size()) {
+          memcpy(final_states[s], states[s], sizeof(states[s]));
+        }
+      }
+    }
+
+    // Squeeze
+    for (size_t pos = 0; pos < output_len; pos += rate) {
+      if (pos) {
+        keccak_f1600_batch(final_states, num_states);
+      }
+
+      size_t len = std::min(rate, output_len - pos);
+      for (size_t s = 0; s < num_states; ++s) {
+        SqueezeBytes(final_states[s], out + order[group + s] * output_len + pos,
+                     len);
+      }
+    }
+  }
+}
@@ -0,0 +1,110 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_HW_IP_KMAC_DV_DPI_KECCAK_BATCH_H_
+#define OPENTITAN_HW_IP_KMAC_DV_DPI_KECCAK_BATCH_H_
+
+// Multi-buffer Keccak-f[1600] and the SHA-3 family sponge built on it, for
+// computing reference digests of many independent messages at once.
+//
+// The permutation is applied to several states in parallel using SIMD where
+// the host supports it: 8 states with AVX-512, 4 with AVX2, otherwise one at a
+// time with a scalar implementation. The implementation is picked at runtime.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum KeccakImpl {
+  kKeccakImplScalar = 1,
+  kKeccakImplAvx2 = 4,
+  kKeccakImplAvx512 = 8,
+};
+
+/**
+ * Returns the widest Keccak-f[1600] implementation supported by the host.
+ */
+KeccakImpl keccak_best_impl();
+
+/**
+ * Returns the implementation currently used by keccak_f1600_batch().
+ */
+KeccakImpl keccak_get_impl();
+
+/**
+ * Selects the implementation used by keccak_f1600_batch(), e.g. to compare
+ * them in tests.
+ *
+ * @return false (leaving the implementation unchanged) if the host doesn't
+ *         support `impl`
+ */
+bool keccak_set_impl(KeccakImpl impl);
+
+/**
+ * Returns a short name for `impl`.
+ */
+const char *keccak_impl_name(KeccakImpl impl);
+
+/**
+ * Applies Keccak-f[1600] to `num_states` independent states.
+ *
+ * Each state is 25 lanes, with lane (x, y) at index x + 5 * y.
+ */
+void keccak_f1600_batch(uint64_t (*states)[25], size_t num_states);
+
+/**
+ * Parameters of a SHA-3 family function as a Keccak sponge.
+ *
+ * The input to the sponge is `prefix || message || trailer`, padded with the
+ * `suffix` domain separation bits and pad10*1.
+ */
+struct KeccakSpongeParams {
+  // Rate in bytes
+  size_t rate;
+  // Domain separation bits, including the first bit of the padding
+  uint8_t suffix;
+  // Absorbed before every message. Must be a multiple of `rate` long.
+  std::vector<uint8_t> prefix;
+  // Absorbed after every message.
+  std::vector<uint8_t> trailer;
+};
+
+/**
+ * SHA3-`sha_len` (`sha_len` in {224, 256, 384, 512}).
+ */
+KeccakSpongeParams keccak_sha3_params(uint32_t sha_len);
+
+/**
+ * cSHAKE`strength` (`strength` in {128, 256}). This is SHAKE`strength` if
+ * `function_name` and `customization_str` are both empty.
+ */
+KeccakSpongeParams keccak_cshake_params(uint32_t strength,
+                                        const std::string &function_name,
+                                        const std::string &customization_str);
+
+/**
+ * KMAC`strength` (`strength` in {128, 256}) with an `output_len` byte digest,
+ * or KMACXOF`strength` if `xof` is set.
+ */
+KeccakSpongeParams keccak_kmac_params(uint32_t strength, bool xof,
+                                      const uint8_t *key, size_t key_len,
+                                      const std::string &customization_str,
+                                      size_t output_len);
+
+/**
+ * Hashes `num_msgs` messages with the same sponge parameters.
+ *
+ * Messages are processed in groups as wide as the selected Keccak-f[1600]
+ * implementation. They are grouped by length, so a batch of similar length
+ * messages makes best use of the SIMD lanes.
+ *
+ * @param msgs, msg_lens The messages and their lengths in bytes
+ * @param out Receives `output_len` bytes of output for each message in turn
+ */
+void keccak_sponge_batch(const KeccakSpongeParams &params,
+                         const uint8_t *const *msgs, const size_t *msg_lens,
+                         size_t num_msgs, uint8_t *out, size_t output_len);
+
+#endif  // OPENTITAN_HW_IP_KMAC_DV_DPI_KECCAK_BATCH_H_
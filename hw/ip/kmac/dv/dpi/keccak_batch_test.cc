@@ -0,0 +1,203 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Checks that keccak_batch gives the same results as the vendored digestpp
+// model for every supported Keccak-f[1600] implementation, and with --bench
+// compares their throughput.
+//
+// Build and run from this directory with:
+//   g++ -std=c++14 -O2 keccak_batch_test.cc keccak_batch.cc -o keccak_batch_test
+//   ./keccak_batch_test [--bench]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "keccak_batch.h"
+#include "vendor/kerukuro_digestpp/algorithm/kmac.hpp"
+#include "vendor/kerukuro_digestpp/algorithm/sha3.hpp"
+#include "vendor/kerukuro_digestpp/algorithm/shake.hpp"
+
+static const KeccakImpl kImpls[] = {kKeccakImplScalar, kKeccakImplAvx2,
+                                    kKeccakImplAvx512};
+
+// Messages of every length up to a few blocks of the widest rate, plus some
+// long ones, so that padding at and around block boundaries is covered.
+static std::vector<std::vector<uint8_t>> make_msgs(std::mt19937 &rng) {
+  std::vector<std::vector<uint8_t>> msgs;
+  for (size_t len = 0; len < 3 * 168 + 2; ++len) {
+    msgs.emplace_back(len);
+  }
+  for (size_t len : {1000, 4096, 10007}) {
+    msgs.emplace_back(len);
+  }
+  for (auto &msg : msgs) {
+    for (auto &byte : msg) {
+      byte = rng();
+    }
+  }
+  return msgs;
+}
+
+// Hash every message with keccak_sponge_batch() and compare with the digestpp
+// hasher made for each message by `make_ref`.
+template <typename MakeRef>
+static int check(const char *name, const KeccakSpongeParams &params,
+                 const std::vector<std::vector<uint8_t>> &msgs,
+                 size_t output_len, MakeRef make_ref) {
+  std::vector<const uint8_t *> msg_ptrs;
+  std::vector<size_t> msg_lens;
+  for (const auto &msg : msgs) {
+    msg_ptrs.push_back(msg.data());
+    msg_lens.push_back(msg.size());
+  }
+
+  std::vector<uint8_t> out(msgs.size() * output_len);
+  keccak_sponge_batch(params, msg_ptrs.data(), msg_lens.data(), msgs.size(),
+                      out.data(), output_len);
+
+  int failures = 0;
+  std::vector<uint8_t> expected(output_len);
+  for (size_t i = 0; i < msgs.size(); ++i) {
+    make_ref(msgs[i], expected.data());
+    if (memcmp(expected.data(), &out[i * output_len], output_len) != 0) {
+      printf("FAIL: %s (%s) for a %zu byte message\n", name,
+             keccak_impl_name(keccak_get_impl()), msgs[i].size());
+      ++failures;
+    }
+  }
+  return failures;
+}
+
+static int run_tests() {
+  std::mt19937 rng(1);
+  std::vector<std::vector<uint8_t>> msgs = make_msgs(rng);
+  std::vector<uint8_t> key(32);
+  for (auto &byte : key) {
+    byte = rng();
+  }
+
+  int failures = 0;
+  for (KeccakImpl impl : kImpls) {
+    if (!keccak_set_impl(impl)) {
+      printf("Skipping %s: not supported by this host\n",
+             keccak_impl_name(impl));
+      continue;
+    }
+
+    for (uint32_t sha_len : {224, 256, 384, 512}) {
+      failures += check(
+          "SHA3", keccak_sha3_params(sha_len), msgs, sha_len / 8,
+          [&](const std::vector<uint8_t> &msg, uint8_t *out) {
+            digestpp::sha3 sha3(sha_len);
+            sha3.absorb(msg.data(), msg.size());
+            sha3.digest(out, sha_len / 8);
+          });
+    }
+
+    // Output longer than a block of either rate
+    const size_t xof_len = 400;
+
+    failures += check("SHAKE128", keccak_cshake_params(128, "", ""), msgs,
+                      xof_len,
+                      [&](const std::vector<uint8_t> &msg, uint8_t *out) {
+                        digestpp::shake128 shake;
+                        shake.absorb(msg.data(), msg.size());
+                        shake.squeeze(out, xof_len);
+                      });
+
+    failures += check("cSHAKE256", keccak_cshake_params(256, "", "ROM_CTRL"),
+                      msgs, xof_len,
+                      [&](const std::vector<uint8_t> &msg, uint8_t *out) {
+                        digestpp::cshake256 shake;
+                        shake.set_customization("ROM_CTRL");
+                        shake.absorb(msg.data(), msg.size());
+                        shake.squeeze(out, xof_len);
+                      });
+
+    failures += check(
+        "KMAC128", keccak_kmac_params(128, false, key.data(), key.size(), "", 32),
+        msgs, 32, [&](const std::vector<uint8_t> &msg, uint8_t *out) {
+          digestpp::kmac128 kmac(256);
+          kmac.set_key(key.data(), key.size());
+          kmac.absorb(msg.data(), msg.size());
+          kmac.digest(out, 32);
+        });
+
+    failures += check(
+        "KMAC256-XOF",
+        keccak_kmac_params(256, true, key.data(), key.size(), "My Tagged App",
+                           xof_len),
+        msgs, xof_len, [&](const std::vector<uint8_t> &msg, uint8_t *out) {
+          digestpp::kmac256_xof kmac;
+          kmac.set_customization("My Tagged App");
+          kmac.set_key(key.data(), key.size());
+          kmac.absorb(msg.data(), msg.size());
+          kmac.squeeze(out, xof_len);
+        });
+  }
+
+  keccak_set_impl(keccak_best_impl());
+
+  if (failures) {
+    printf("%d failures\n", failures);
+    return 1;
+  }
+  printf("PASS\n");
+  return 0;
+}
+
+// Time SHA3-256 of a batch of equal length messages with each implementation
+// and with digestpp.
+static void run_bench() {
+  const size_t num_msgs = 4096;
+  const size_t msg_len = 1024;
+
+  std::vector<uint8_t> data(num_msgs * msg_len, 0xa5);
+  std::vector<const uint8_t *> msg_ptrs;
+  std::vector<size_t> msg_lens(num_msgs, msg_len);
+  for (size_t i = 0; i < num_msgs; ++i) {
+    msg_ptrs.push_back(&data[i * msg_len]);
+  }
+  std::vector<uint8_t> out(num_msgs * 32);
+
+  auto report = [&](const char *name,
+                    std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+    printf("%-10s %8.1f MB/s\n", name, data.size() / time.count() / 1e6);
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < num_msgs; ++i) {
+    digestpp::sha3 sha3(256);
+    sha3.absorb(msg_ptrs[i], msg_len);
+    sha3.digest(&out[i * 32], 32);
+  }
+  report("digestpp", start);
+
+  KeccakSpongeParams params = keccak_sha3_params(256);
+  for (KeccakImpl impl : kImpls) {
+    if (!keccak_set_impl(impl)) {
+      continue;
+    }
+    start = std::chrono::steady_clock::now();
+    keccak_sponge_batch(params, msg_ptrs.data(), msg_lens.data(), num_msgs,
+                        out.data(), 32);
+    report(keccak_impl_name(impl), start);
+  }
+
+  keccak_set_impl(keccak_best_impl());
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+    run_bench();
+    return 0;
+  }
+  return run_tests();
+}
@@ -10,6 +10,7 @@
 
 #include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <svdpi.h>
 #include <vector>
 
@@ -50,6 +51,18 @@ class PresentState {
   // round and with is_last_round set, then count down.
   uint64_t dec_round(uint64_t input, unsigned round, bool is_last_round) const;
 
+  // Encrypt with num_rounds rounds, i.e. enc_round for rounds 1 to num_rounds.
+  uint64_t encrypt(uint64_t input, unsigned num_rounds) const;
+
+  // The inverse of encrypt.
+  uint64_t decrypt(uint64_t input, unsigned num_rounds) const;
+
+  // Encrypt or decrypt num_blocks blocks with num_rounds rounds. Groups of 64
+  // blocks are processed in bitsliced form, where word i holds bit i of every
+  // block, and each layer of the cipher is applied to all of them at once.
+  void crypt_batch(bool inverse, const uint64_t *input, uint64_t *output,
+                   size_t num_blocks, unsigned num_rounds) const;
+
  private:
   static key128_t next_round_key(const key128_t &k, unsigned key_size,
                                  unsigned round_count);
@@ -59,9 +72,93 @@ class PresentState {
   static uint64_t sbox_layer(bool inverse, uint64_t data);
   static uint64_t perm_layer(bool inverse, uint64_t data);
 
+  static void bs_crypt(bool inverse, uint64_t s[64],
+                       const uint64_t *round_keys, unsigned num_rounds);
+
   unsigned key_size;
   std::vector<key128_t> key_schedule;
+  // The 64-bit keys used by addRoundKey for each entry of key_schedule
+  std::vector<uint64_t> round_keys;
 };
+
+// Lookup tables for the sBoxLayer and pLayer (index 0) and their inverses
+// (index 1), which process the state a byte at a time.
+struct LayerTables {
+  LayerTables();
+
+  uint8_t sbox[2][256];
+  uint64_t perm[2][8][256];
+};
+
+LayerTables::LayerTables() {
+  for (int inv = 0; inv < 2; ++inv) {
+    const uint8_t *sb = inv ? sbox4_inv : sbox4;
+    const uint8_t *bp = inv ? bit_perm_inv : bit_perm;
+    for (unsigned v = 0; v < 256; ++v) {
+      sbox[inv][v] = (sb[v >> 4] << 4) | sb[v & 0xf];
+      for (unsigned pos = 0; pos < 8; ++pos) {
+        uint64_t out = 0;
+        for (unsigned bit = 0; bit < 8; ++bit) {
+          out |= (uint64_t)((v >> bit) & 1) << bp[8 * pos + bit];
+        }
+        perm[inv][pos][v] = out;
+      }
+    }
+  }
+}
+
+const LayerTables layer_tables;
+
+// Transpose a 64x64 bit matrix in place, i.e. swap bit j of word i with bit i
+// of word j.
+void bs_transpose(uint64_t m[64]) {
+  uint64_t mask = 0x00000000ffffffff;
+  for (int j = 32; j != 0; j >>= 1, mask ^= mask << j) {
+    for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+      uint64_t t = ((m[k] >> j) ^ m[k | j]) & mask;
+      m[k] ^= t << j;
+      m[k | j] ^= t;
+    }
+  }
+}
+
+void bs_add_round_key(uint64_t s[64], uint64_t k64) {
+  for (int i = 0; i < 64; ++i) {
+    s[i] ^= (uint64_t)0 - ((k64 >> i) & 1);
+  }
+}
+
+// The S-box and its inverse in algebraic normal form, where xij.. is the AND
+// of input bits i, j, ..
+void bs_sbox_layer(bool inverse, uint64_t s[64]) {
+  for (int i = 0; i < 64 / 4; ++i) {
+    uint64_t *y = &s[4 * i];
+    const uint64_t x0 = y[0], x1 = y[1], x2 = y[2], x3 = y[3];
+    const uint64_t x01 = x0 & x1, x02 = x0 & x2, x03 = x0 & x3, x12 = x1 & x2,
+                   x13 = x1 & x3, x23 = x2 & x3;
+    const uint64_t x012 = x01 & x2, x013 = x01 & x3, x023 = x02 & x3;
+    if (!inverse) {
+      y[0] = x0 ^ x2 ^ x12 ^ x3;
+      y[1] = x1 ^ x012 ^ x3 ^ x13 ^ x013 ^ x23 ^ x023;
+      y[2] = ~(x01 ^ x2 ^ x3 ^ x03 ^ x13 ^ x013 ^ x023);
+      y[3] = ~(x0 ^ x1 ^ x12 ^ x012 ^ x3 ^ x013 ^ x023);
+    } else {
+      y[0] = ~(x0 ^ x2 ^ x13);
+      y[1] = x0 ^ x1 ^ x02 ^ x012 ^ x3 ^ x13 ^ x013 ^ x23 ^ x023;
+      y[2] = ~(x01 ^ x02 ^ x12 ^ x012 ^ x3 ^ x03 ^ x13 ^ x013 ^ x023);
+      y[3] = x0 ^ x1 ^ x01 ^ x2 ^ x012 ^ x3 ^ x023;
+    }
+  }
+}
+
+void bs_perm_layer(bool inverse, uint64_t s[64]) {
+  const uint8_t *bp = inverse ? bit_perm_inv : bit_perm;
+  uint64_t in[64];
+  memcpy(in, s, sizeof(in));
+  for (int i = 0; i < 64; ++i) {
+    s[bp[i]] = in[i];
+  }
+}
 }  // namespace
 
 PresentState::PresentState(unsigned key_size, key128_t key)
@@ -73,15 +170,18 @@ PresentState::PresentState(unsigned key_size, key128_t key)
     key = next_round_key(key, key_size, i);
     key_schedule.push_back(key);
   }
+  round_keys.reserve(key_schedule.size());
+  for (const key128_t &k : key_schedule) {
+    round_keys.push_back(add_round_key(0, k, key_size));
+  }
 }
 
 uint64_t PresentState::enc_round(uint64_t input, unsigned round,
                                  bool is_last_round) const {
   assert(1 <= round && round < key_schedule.size());
-  const key128_t &key = key_schedule[round - 1];
 
   // addRoundKey
-  uint64_t w1 = add_round_key(input, key, key_size);
+  uint64_t w1 = input ^ round_keys[round - 1];
 
   // sBoxLayer
   uint64_t w2 = sbox_layer(false, w1);
@@ -90,8 +190,7 @@ uint64_t PresentState::enc_round(uint64_t input, unsigned round,
   uint64_t w3 = perm_layer(false, w2);
 
   // On the final round, call addRoundKey with the following key.
-  uint64_t w4 =
-      is_last_round ? add_round_key(w3, key_schedule[round], key_size) : w3;
+  uint64_t w4 = is_last_round ? w3 ^ round_keys[round] : w3;
 
   return w4;
 }
@@ -99,13 +198,10 @@ uint64_t PresentState::enc_round(uint64_t input, unsigned round,
 uint64_t PresentState::dec_round(uint64_t input, unsigned round,
                                  bool is_last_round) const {
   assert(1 <= round && round < key_schedule.size());
-  const key128_t &key = key_schedule[round - 1];
 
   // If we're undoing the last round, start by calling addRoundKey with the
   // following key.
-  uint64_t w1 = is_last_round
-                    ? add_round_key(input, key_schedule[round], key_size)
-                    : input;
+  uint64_t w1 = is_last_round ? input ^ round_keys[round] : input;
 
   // pLayer^{-1}
   uint64_t w2 = perm_layer(true, w1);
@@ -114,11 +210,72 @@ uint64_t PresentState::dec_round(uint64_t input, unsigned round,
   uint64_t w3 = sbox_layer(true, w2);
 
   // addRoundKey
-  uint64_t w4 = add_round_key(w3, key, key_size);
+  uint64_t w4 = w3 ^ round_keys[round - 1];
 
   return w4;
 }
 
+uint64_t PresentState::encrypt(uint64_t input, unsigned num_rounds) const {
+  assert(1 <= num_rounds && num_rounds < key_schedule.size());
+  uint64_t data = input;
+  for (unsigned round = 1; round <= num_rounds; ++round) {
+    data = perm_layer(false, sbox_layer(false, data ^ round_keys[round - 1]));
+  }
+  return data ^ round_keys[num_rounds];
+}
+
+uint64_t PresentState::decrypt(uint64_t input, unsigned num_rounds) const {
+  assert(1 <= num_rounds && num_rounds < key_schedule.size());
+  uint64_t data = input ^ round_keys[num_rounds];
+  for (unsigned round = num_rounds; round >= 1; --round) {
+    data = sbox_layer(true, perm_layer(true, data)) ^ round_keys[round - 1];
+  }
+  return data;
+}
+
+void PresentState::bs_crypt(bool inverse, uint64_t s[64],
+                            const uint64_t *round_keys, unsigned num_rounds) {
+  if (!inverse) {
+    for (unsigned round = 1; round <= num_rounds; ++round) {
+      bs_add_round_key(s, round_keys[round - 1]);
+      bs_sbox_layer(false, s);
+      bs_perm_layer(false, s);
+    }
+    bs_add_round_key(s, round_keys[num_rounds]);
+  } else {
+    bs_add_round_key(s, round_keys[num_rounds]);
+    for (unsigned round = num_rounds; round >= 1; --round) {
+      bs_perm_layer(true, s);
+      bs_sbox_layer(true, s);
+      bs_add_round_key(s, round_keys[round - 1]);
+    }
+  }
+}
+
+void PresentState::crypt_batch(bool inverse, const uint64_t *input,
+                               uint64_t *output, size_t num_blocks,
+                               unsigned num_rounds) const {
+  assert(1 <= num_rounds && num_rounds < key_schedule.size());
+
+  // The transposes only pay off for enough blocks, so process a final group of
+  // fewer than 16 blocks one at a time.
+  size_t i = 0;
+  while (num_blocks - i >= 16) {
+    size_t n = (num_blocks - i < 64) ? num_blocks - i : 64;
+    uint64_t s[64] = {0};
+    memcpy(s, &input[i], n * sizeof(uint64_t));
+    bs_transpose(s);
+    bs_crypt(inverse, s, round_keys.data(), num_rounds);
+    bs_transpose(s);
+    memcpy(&output[i], s, n * sizeof(uint64_t));
+    i += n;
+  }
+  for (; i < num_blocks; ++i) {
+    output[i] = inverse ? decrypt(input[i], num_rounds)
+                        : encrypt(input[i], num_rounds);
+  }
+}
+
 key128_t PresentState::next_round_key(const key128_t &k, unsigned key_size,
                                       unsigned round_count) {
   assert((round_count >> 5) == 0);
@@ -188,20 +345,18 @@ uint64_t PresentState::add_round_key(uint64_t data, const key128_t &k,
 }
 
 uint64_t PresentState::sbox_layer(bool inverse, uint64_t data) {
+  const uint8_t *sbox = layer_tables.sbox[inverse];
   uint64_t ret = 0;
-  for (int i = 0; i < 64 / 4; ++i) {
-    unsigned nibble = (data >> (4 * i)) & 0xf;
-    uint64_t subst = inverse ? sbox4_inv[nibble] : sbox4[nibble];
-    ret |= subst << (4 * i);
+  for (int i = 0; i < 64 / 8; ++i) {
+    ret |= (uint64_t)sbox[(data >> (8 * i)) & 0xff] << (8 * i);
   }
   return ret;
 }
 
 uint64_t PresentState::perm_layer(bool inverse, uint64_t data) {
   uint64_t ret = 0;
-  for (int i = 0; i < 64; ++i) {
-    uint64_t bit = (data >> i) & 1;
-    ret |= bit << (inverse ? bit_perm_inv[i] : bit_perm[i]);
+  for (int i = 0; i < 64 / 8; ++i) {
+    ret |= layer_tables.perm[inverse][i][(data >> (8 * i)) & 0xff];
   }
   return ret;
 }
@@ -254,4 +409,57 @@ void c_dpi_present_dec_round(const PresentState *ps, unsigned round,
   dst[1] = out64 >> 32;
   dst[0] = (uint32_t)out64;
 }
+
+void c_dpi_present_encrypt(const PresentState *ps, unsigned num_rounds,
+                           const svBitVecVal *src, svBitVecVal *dst) {
+  assert(ps);
+
+  uint64_t in64 = ((uint64_t)src[1] << 32) | src[0];
+  uint64_t out64 = ps->encrypt(in64, num_rounds);
+
+  dst[1] = out64 >> 32;
+  dst[0] = (uint32_t)out64;
+}
+
+void c_dpi_present_decrypt(const PresentState *ps, unsigned num_rounds,
+                           const svBitVecVal *src, svBitVecVal *dst) {
+  assert(ps);
+
+  uint64_t in64 = ((uint64_t)src[1] << 32) | src[0];
+  uint64_t out64 = ps->decrypt(in64, num_rounds);
+
+  dst[1] = out64 >> 32;
+  dst[0] = (uint32_t)out64;
+}
+
+// Encrypt (inverse = 0) or decrypt (inverse = 1) every element of src, an open
+// array of longint unsigned, into dst, which must have the same size.
+void c_dpi_present_crypt_batch(const PresentState *ps, unsigned char inverse,
+                               unsigned num_rounds,
+                               const svOpenArrayHandle src,
+                               const svOpenArrayHandle dst) {
+  assert(ps);
+  assert(svSize(src, 1) == svSize(dst, 1));
+
+  int num_blocks = svSize(src, 1);
+  const uint64_t *in = static_cast<const uint64_t *>(svGetArrayPtr(src));
+  uint64_t *out = static_cast<uint64_t *>(svGetArrayPtr(dst));
+  if (in && out) {
+    ps->crypt_batch(inverse != 0, in, out, num_blocks, num_rounds);
+    return;
+  }
+
+  // The simulator doesn't give direct access to the arrays, so copy them.
+  std::vector<uint64_t> buf(num_blocks);
+  for (int i = 0; i < num_blocks; ++i) {
+    buf[i] = *static_cast<const uint64_t *>(
+        svGetArrElemPtr1(src, svLow(src, 1) + i));
+  }
+  ps->crypt_batch(inverse != 0, buf.data(), buf.data(), num_blocks,
+                  num_rounds);
+  for (int i = 0; i < num_blocks; ++i) {
+    *static_cast<uint64_t *>(svGetArrElemPtr1(dst, svLow(dst, 1) + i)) =
+        buf[i];
+  }
+}
 }
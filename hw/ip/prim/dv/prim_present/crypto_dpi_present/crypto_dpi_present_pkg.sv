@@ -24,6 +24,41 @@ package crypto_dpi_present_pkg;
                                                        bit [DataWidth-1:0]        in,
                                                        output bit [DataWidth-1:0] out);
 
+  // Run all of rounds 1 to num_rounds, like a sequence of calls to c_dpi_present_enc_round or
+  // c_dpi_present_dec_round.
+  import "DPI-C" function void c_dpi_present_encrypt(chandle                    h,
+                                                     int unsigned               num_rounds,
+                                                     bit [DataWidth-1:0]        in,
+                                                     output bit [DataWidth-1:0] out);
+  import "DPI-C" function void c_dpi_present_decrypt(chandle                    h,
+                                                     int unsigned               num_rounds,
+                                                     bit [DataWidth-1:0]        in,
+                                                     output bit [DataWidth-1:0] out);
+
+  // Encrypt (inverse = 0) or decrypt (inverse = 1) every element of data_i into data_o, which must
+  // be the same size. This is much faster per block than c_dpi_present_encrypt for large batches.
+  import "DPI-C" function void c_dpi_present_crypt_batch(chandle                 h,
+                                                         bit                     inverse,
+                                                         int unsigned            num_rounds,
+                                                         longint unsigned        data_i[],
+                                                         output longint unsigned data_o[]);
+
+  // Handle for the key last used by the SV wrapper functions, so that its key schedule isn't
+  // computed again for every block.
+  chandle               cached_h;
+  bit [MaxKeyWidth-1:0] cached_key;
+  int unsigned          cached_key_size;
+
+  function automatic chandle get_handle(bit [MaxKeyWidth-1:0] key, int unsigned key_size);
+    if (cached_h == null || key != cached_key || key_size != cached_key_size) begin
+      if (cached_h != null) c_dpi_present_free(cached_h);
+      cached_h = c_dpi_present_mk(key_size, key);
+      cached_key = key;
+      cached_key_size = key_size;
+    end
+    return cached_h;
+  endfunction
+
   // This function encrypts the input plaintext with the PRESENT encryption algorithm.
   //
   // This produces a list of all intermediate values produced after each round of the algorithm,
@@ -36,17 +71,7 @@ package crypto_dpi_present_pkg;
     output bit [DataWidth-1:0]  ciphertext
   );
 
-    bit [DataWidth-1:0] round_in, round_out;
-    chandle h = c_dpi_present_mk(key_size, key);
-
-    round_out = plaintext;
-    for (int i = 1; i <= num_rounds; i++) begin
-      round_in = round_out;
-      c_dpi_present_enc_round(h, i, i == num_rounds, round_in, round_out);
-    end
-    ciphertext = round_out;
-
-    c_dpi_present_free(h);
+    c_dpi_present_encrypt(get_handle(key, key_size), num_rounds, plaintext, ciphertext);
 
   endfunction
 
@@ -62,17 +87,35 @@ package crypto_dpi_present_pkg;
     output bit [DataWidth-1:0]  plaintext
   );
 
-    bit [DataWidth-1:0] round_in, round_out;
-    chandle h = c_dpi_present_mk(key_size, key);
+    c_dpi_present_decrypt(get_handle(key, key_size), num_rounds, ciphertext, plaintext);
 
-    round_in = ciphertext;
-    for (int i = num_rounds; i > 0; i--) begin
-      c_dpi_present_dec_round(h, i, i == num_rounds, round_in, round_out);
-      round_in = round_out;
-    end
-    plaintext = round_out;
+  endfunction
+
+  // Encrypt a batch of blocks with the same key.
+  function automatic void sv_dpi_present_encrypt_batch(
+    input longint unsigned      plaintext[],
+    input bit [MaxKeyWidth-1:0] key,
+    input int unsigned          key_size,
+    input int unsigned          num_rounds,
+    output longint unsigned     ciphertext[]
+  );
+
+    ciphertext = new[plaintext.size()];
+    c_dpi_present_crypt_batch(get_handle(key, key_size), 1'b0, num_rounds, plaintext, ciphertext);
+
+  endfunction
+
+  // Decrypt a batch of blocks with the same key.
+  function automatic void sv_dpi_present_decrypt_batch(
+    input longint unsigned      ciphertext[],
+    input bit [MaxKeyWidth-1:0] key,
+    input int unsigned          key_size,
+    input int unsigned          num_rounds,
+    output longint unsigned     plaintext[]
+  );
 
-    c_dpi_present_free(h);
+    plaintext = new[ciphertext.size()];
+    c_dpi_present_crypt_batch(get_handle(key, key_size), 1'b1, num_rounds, ciphertext, plaintext);
 
   endfunction
 
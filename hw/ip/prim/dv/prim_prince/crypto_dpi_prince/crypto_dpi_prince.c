@@ -11,6 +11,8 @@ extern "C" {
 #include <stdlib.h>
 
 #include "prince_ref.h"
+// Must come after prince_ref.h
+#include "prince_batch.h"
 #include "svdpi.h"
 
 extern uint64_t c_dpi_prince_encrypt(uint64_t plaintext, uint64_t key0,
@@ -28,6 +30,63 @@ extern uint64_t c_dpi_prince_decrypt(const uint64_t ciphertext,
                                old_key_schedule);
 }
 
+extern void *c_dpi_prince_mk(uint64_t key0, uint64_t key1,
+                             int old_key_schedule) {
+  prince_keys_t *keys = (prince_keys_t *)malloc(sizeof(prince_keys_t));
+  if (!keys) {
+    fprintf(stderr, "ERROR: Memory allocation failed\n");
+    return NULL;
+  }
+  prince_keys_init(keys, key0, key1, old_key_schedule);
+  return keys;
+}
+
+extern void c_dpi_prince_free(void *keys) { free(keys); }
+
+extern uint64_t c_dpi_prince_crypt(void *keys, uint64_t data, int decrypt,
+                                   int num_half_rounds) {
+  return prince_keys_crypt((const prince_keys_t *)keys, data, decrypt,
+                           num_half_rounds);
+}
+
+extern void c_dpi_prince_crypt_batch(void *keys, int decrypt,
+                                     int num_half_rounds,
+                                     const svOpenArrayHandle data_i,
+                                     svOpenArrayHandle data_o) {
+  const int num_blocks = svSize(data_i, 1);
+  if (svSize(data_o, 1) != num_blocks) {
+    fprintf(stderr, "ERROR: Input and output arrays differ in size\n");
+    return;
+  }
+  if (num_blocks == 0) {
+    return;
+  }
+
+  uint64_t *in = (uint64_t *)svGetArrayPtr(data_i);
+  uint64_t *out = (uint64_t *)svGetArrayPtr(data_o);
+  if (in && out) {
+    prince_crypt_batch((const prince_keys_t *)keys, in, out, num_blocks,
+                       decrypt, num_half_rounds);
+    return;
+  }
+
+  // The simulator doesn't give direct access to the arrays, copy the elements.
+  uint64_t *buf = (uint64_t *)malloc(num_blocks * sizeof(uint64_t));
+  if (!buf) {
+    fprintf(stderr, "ERROR: Memory allocation failed\n");
+    return;
+  }
+  for (int i = 0; i < num_blocks; i++) {
+    buf[i] = *(uint64_t *)svGetArrElemPtr1(data_i, svLow(data_i, 1) + i);
+  }
+  prince_crypt_batch((const prince_keys_t *)keys, buf, buf, num_blocks,
+                     decrypt, num_half_rounds);
+  for (int i = 0; i < num_blocks; i++) {
+    *(uint64_t *)svGetArrElemPtr1(data_o, svLow(data_o, 1) + i) = buf[i];
+  }
+  free(buf);
+}
+
 #ifdef _cplusplus
 }
 #endif
@@ -27,6 +27,55 @@ package crypto_dpi_prince_pkg;
     input int unsigned      new_key_schedule
   );
 
+  // Create a handle holding the keys derived from key0 and key1, so that they aren't derived
+  // again for every block. The handle must be released with c_dpi_prince_free().
+  import "DPI-C" function chandle c_dpi_prince_mk(
+    input longint unsigned  key0,
+    input longint unsigned  key1,
+    input int unsigned      old_key_schedule
+  );
+
+  import "DPI-C" function void c_dpi_prince_free(
+    input chandle keys
+  );
+
+  // Encrypt (decrypt = 0) or decrypt (decrypt = 1) a block with the keys of a handle.
+  import "DPI-C" function longint c_dpi_prince_crypt(
+    input chandle           keys,
+    input longint unsigned  data,
+    input int unsigned      decrypt,
+    input int unsigned      num_half_rounds
+  );
+
+  // Encrypt or decrypt every block of data_i into data_o, which must be the same size. This is
+  // much faster per block than c_dpi_prince_crypt() for large batches, e.g. the scrambled
+  // addresses of a whole memory.
+  import "DPI-C" function void c_dpi_prince_crypt_batch(
+    input chandle           keys,
+    input int unsigned      decrypt,
+    input int unsigned      num_half_rounds,
+    input longint unsigned  data_i[],
+    output longint unsigned data_o[]
+  );
+
+  // Handle for the key last used by the SV wrapper functions
+  chandle     cached_keys;
+  bit [127:0] cached_key;
+  bit         cached_old_key_schedule;
+
+  function automatic chandle get_keys(bit [127:0] key, bit old_key_schedule);
+    if (cached_keys == null || key != cached_key ||
+        old_key_schedule != cached_old_key_schedule) begin
+      if (cached_keys != null) c_dpi_prince_free(cached_keys);
+      cached_keys = c_dpi_prince_mk(key[127:64], // k0 gets assigned the MSB halve
+                                    key[63:0],   // k1 gets assigned the LSB halve
+                                    old_key_schedule);
+      cached_key = key;
+      cached_old_key_schedule = old_key_schedule;
+    end
+    return cached_keys;
+  endfunction
+
   //////////////////////////////////////////////////////
   // SV wrapper functions to be used by the testbench //
   //////////////////////////////////////////////////////
@@ -37,12 +86,9 @@ package crypto_dpi_prince_pkg;
     input bit                             old_key_schedule,
     output bit [NumRoundsHalf-1:0][63:0]  ciphertext
   );
+    chandle keys = get_keys(key, old_key_schedule);
     for (int i = 0; i < NumRoundsHalf; i++) begin
-      ciphertext[i] = c_dpi_prince_encrypt(plaintext,
-                                           key[127:64], // k0 gets assigned the MSB halve
-                                           key[63:0],   // k1 gets assigned the LSB halve
-                                           i+1,
-                                           old_key_schedule);
+      ciphertext[i] = c_dpi_prince_crypt(keys, plaintext, 0, i+1);
     end
   endfunction
 
@@ -52,13 +98,36 @@ package crypto_dpi_prince_pkg;
     input bit                             old_key_schedule,
     output bit [NumRoundsHalf-1:0][63:0]  plaintext
   );
+    chandle keys = get_keys(key, old_key_schedule);
     for (int i = 0; i < NumRoundsHalf; i++) begin
-      plaintext[i] = c_dpi_prince_decrypt(ciphertext[i],
-                                          key[127:64],  // k0 gets assigned the MSB halve
-                                          key[63:0],    // k1 gets assigned the LSB halve
-                                          i+1,
-                                          old_key_schedule);
+      plaintext[i] = c_dpi_prince_crypt(keys, ciphertext[i], 1, i+1);
     end
   endfunction
 
+  // Encrypt a batch of blocks with num_half_rounds half-rounds.
+  function automatic void sv_dpi_prince_encrypt_batch(
+    input longint unsigned  plaintext[],
+    input bit [127:0]       key,
+    input bit               old_key_schedule,
+    input int unsigned      num_half_rounds,
+    output longint unsigned ciphertext[]
+  );
+    ciphertext = new[plaintext.size()];
+    c_dpi_prince_crypt_batch(get_keys(key, old_key_schedule), 0, num_half_rounds, plaintext,
+                             ciphertext);
+  endfunction
+
+  // Decrypt a batch of blocks with num_half_rounds half-rounds.
+  function automatic void sv_dpi_prince_decrypt_batch(
+    input longint unsigned  ciphertext[],
+    input bit [127:0]       key,
+    input bit               old_key_schedule,
+    input int unsigned      num_half_rounds,
+    output longint unsigned plaintext[]
+  );
+    plaintext = new[ciphertext.size()];
+    c_dpi_prince_crypt_batch(get_keys(key, old_key_schedule), 1, num_half_rounds, ciphertext,
+                             plaintext);
+  endfunction
+
 endpackage
@@ -0,0 +1,236 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_HW_IP_PRIM_DV_PRIM_PRINCE_CRYPTO_DPI_PRINCE_PRINCE_BATCH_H_
+#define OPENTITAN_HW_IP_PRIM_DV_PRIM_PRINCE_CRYPTO_DPI_PRINCE_PRINCE_BATCH_H_
+
+/**
+ * Precomputed keys and batch encryption/decryption for the PRINCE reference
+ * implementation in prince_ref.h, which must be included first.
+ *
+ * prince_keys_t holds the keys derived from K0 and K1, so that they are
+ * computed once per key rather than for every block.
+ *
+ * prince_crypt_batch() processes 64 blocks at a time in bitsliced form: the
+ * blocks are transposed so that word i holds bit i of all 64 blocks, and each
+ * layer of the cipher is then applied to all blocks at once with bitwise
+ * operations. The bitsliced linear layers are derived from the functions in
+ * prince_ref.h, so they are the same by construction.
+ */
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Keys derived from K0 and K1. Index 0 is for encryption, 1 for decryption.
+ */
+typedef struct prince_keys {
+  uint64_t k0[2];
+  uint64_t k0_prime[2];
+  uint64_t k1[2];
+  uint64_t k0_new[2];
+} prince_keys_t;
+
+/**
+ * Derive the keys for encryption and decryption, as done by
+ * prince_enc_dec_uint64().
+ */
+static void prince_keys_init(prince_keys_t *keys, const uint64_t enc_k0,
+                             const uint64_t enc_k1, int old_key_schedule) {
+  const uint64_t prince_alpha = 0xc0ac29b7c97c50dd;
+  const uint64_t enc_k0_prime = prince_k0_to_k0_prime(enc_k0);
+  for (int decrypt = 0; decrypt < 2; decrypt++) {
+    keys->k1[decrypt] = enc_k1 ^ (decrypt ? prince_alpha : 0);
+    keys->k0_new[decrypt] = old_key_schedule
+                                ? keys->k1[decrypt]
+                                : enc_k0 ^ (decrypt ? prince_alpha : 0);
+    keys->k0[decrypt] = decrypt ? enc_k0_prime : enc_k0;
+    keys->k0_prime[decrypt] = decrypt ? enc_k0 : enc_k0_prime;
+  }
+}
+
+/**
+ * Encrypt/decrypt one block with precomputed keys.
+ */
+static uint64_t prince_keys_crypt(const prince_keys_t *keys,
+                                  const uint64_t input, int decrypt,
+                                  int num_half_rounds) {
+  decrypt = decrypt ? 1 : 0;
+  const uint64_t core_output =
+      prince_core(input ^ keys->k0[decrypt], keys->k0_new[decrypt],
+                  keys->k1[decrypt], num_half_rounds);
+  return core_output ^ keys->k0_prime[decrypt];
+}
+
+/**
+ * A linear layer in bitsliced form: output bit j is the XOR of the input bits
+ * in[j][0 .. num_in[j] - 1].
+ */
+typedef struct prince_bs_linear {
+  uint8_t num_in[64];
+  uint8_t in[64][4];
+} prince_bs_linear_t;
+
+static struct {
+  int ready;
+  prince_bs_linear_t m;
+  prince_bs_linear_t m_inv;
+  prince_bs_linear_t m_prime;
+} prince_bs_tables;
+
+// Get the bitsliced form of a linear function from its images of the unit
+// vectors.
+static void prince_bs_linear_init(prince_bs_linear_t *lin,
+                                  uint64_t (*layer)(const uint64_t)) {
+  for (int j = 0; j < 64; j++) {
+    lin->num_in[j] = 0;
+  }
+  for (int i = 0; i < 64; i++) {
+    const uint64_t col = layer((uint64_t)1 << i);
+    for (int j = 0; j < 64; j++) {
+      if ((col >> j) & 1) {
+        assert(lin->num_in[j] < 4);
+        lin->in[j][lin->num_in[j]++] = i;
+      }
+    }
+  }
+}
+
+static void prince_bs_tables_init(void) {
+  if (prince_bs_tables.ready) {
+    return;
+  }
+  prince_bs_linear_init(&prince_bs_tables.m, prince_m_layer);
+  prince_bs_linear_init(&prince_bs_tables.m_inv, prince_m_inv_layer);
+  prince_bs_linear_init(&prince_bs_tables.m_prime, prince_m_prime_layer);
+  prince_bs_tables.ready = 1;
+}
+
+/**
+ * Transpose a 64x64 bit matrix in place, i.e., bit j of word i is swapped with
+ * bit i of word j.
+ */
+static void prince_bs_transpose(uint64_t m[64]) {
+  uint64_t mask = 0x00000000ffffffff;
+  for (int j = 32; j != 0; j >>= 1, mask ^= mask << j) {
+    for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+      const uint64_t t = ((m[k] >> j) ^ m[k | j]) & mask;
+      m[k] ^= t << j;
+      m[k | j] ^= t;
+    }
+  }
+}
+
+static void prince_bs_add_key(uint64_t s[64], const uint64_t key) {
+  for (int i = 0; i < 64; i++) {
+    s[i] ^= (uint64_t)0 - ((key >> i) & 1);
+  }
+}
+
+static void prince_bs_linear(uint64_t s[64], const prince_bs_linear_t *lin) {
+  uint64_t in[64];
+  memcpy(in, s, sizeof(in));
+  for (int j = 0; j < 64; j++) {
+    uint64_t out = in[lin->in[j][0]];
+    for (int k = 1; k < lin->num_in[j]; k++) {
+      out ^= in[lin->in[j][k]];
+    }
+    s[j] = out;
+  }
+}
+
+// The S-box (inverse = 0) or its inverse (inverse = 1) in algebraic normal
+// form, where xij.. is the AND of input bits i, j, ..
+static void prince_bs_s_layer(uint64_t s[64], int inverse) {
+  for (int n = 0; n < 16; n++) {
+    uint64_t *y = &s[4 * n];
+    const uint64_t x0 = y[0], x1 = y[1], x2 = y[2], x3 = y[3];
+    const uint64_t x01 = x0 & x1, x02 = x0 & x2, x03 = x0 & x3, x12 = x1 & x2,
+                   x13 = x1 & x3, x23 = x2 & x3;
+    const uint64_t x012 = x01 & x2, x013 = x01 & x3, x023 = x02 & x3,
+                   x123 = x12 & x3;
+    if (!inverse) {
+      y[0] = ~(x01 ^ x2 ^ x12 ^ x012 ^ x3 ^ x03 ^ x23);
+      y[1] = ~(x02 ^ x12 ^ x012 ^ x13 ^ x123);
+      y[2] = x0 ^ x01 ^ x3 ^ x03 ^ x13 ^ x013 ^ x123;
+      y[3] = ~(x1 ^ x12 ^ x012 ^ x3 ^ x013 ^ x23 ^ x023);
+    } else {
+      y[0] = ~(x01 ^ x12 ^ x3 ^ x013 ^ x23 ^ x023);
+      y[1] = ~(x02 ^ x12 ^ x012 ^ x13 ^ x23);
+      y[2] = x0 ^ x01 ^ x2 ^ x02 ^ x12 ^ x012 ^ x13 ^ x013;
+      y[3] = ~(x0 ^ x1 ^ x01 ^ x02 ^ x12 ^ x012 ^ x23 ^ x023 ^ x123);
+    }
+  }
+}
+
+/**
+ * The whole cipher on 64 bitsliced blocks, following prince_core().
+ */
+static void prince_bs_crypt(uint64_t s[64], const prince_keys_t *keys,
+                            int decrypt, int num_half_rounds) {
+  const uint64_t k0_new = keys->k0_new[decrypt];
+  const uint64_t k1 = keys->k1[decrypt];
+
+  prince_bs_add_key(s, keys->k0[decrypt] ^ k1 ^ prince_round_constant(0));
+  for (int round = 1; round <= num_half_rounds; round++) {
+    prince_bs_s_layer(s, 0);
+    prince_bs_linear(s, &prince_bs_tables.m);
+    prince_bs_add_key(s, ((round % 2 == 1) ? k0_new : k1) ^
+                             prince_round_constant(round));
+  }
+  prince_bs_s_layer(s, 0);
+  prince_bs_linear(s, &prince_bs_tables.m_prime);
+  prince_bs_s_layer(s, 1);
+  for (int round = 1; round <= num_half_rounds; round++) {
+    const unsigned int constant_idx = 10 - num_half_rounds + round;
+    prince_bs_add_key(s,
+                      (((num_half_rounds + round + 1) % 2 == 1) ? k0_new : k1) ^
+                          prince_round_constant(constant_idx));
+    prince_bs_linear(s, &prince_bs_tables.m_inv);
+    prince_bs_s_layer(s, 1);
+  }
+  prince_bs_add_key(
+      s, k1 ^ prince_round_constant(11) ^ keys->k0_prime[decrypt]);
+}
+
+/**
+ * Encrypt/decrypt a batch of blocks with precomputed keys.
+ *
+ * Groups of 64 blocks are processed in bitsliced form. A final group of fewer
+ * than 16 blocks is processed one block at a time, as the bitsliced form only
+ * pays off for enough blocks.
+ *
+ * @param keys            Precomputed keys
+ * @param input           Input blocks
+ * @param output          Output blocks, may be equal to input
+ * @param num_blocks      Number of blocks
+ * @param decrypt         0 = encrypt, 1 = decrypt
+ * @param num_half_rounds Number of half rounds
+ */
+static void prince_crypt_batch(const prince_keys_t *keys, const uint64_t *input,
+                               uint64_t *output, size_t num_blocks,
+                               int decrypt, int num_half_rounds) {
+  uint64_t s[64];
+  size_t i = 0;
+
+  decrypt = decrypt ? 1 : 0;
+  prince_bs_tables_init();
+
+  while (num_blocks - i >= 16) {
+    const size_t n = (num_blocks - i < 64) ? num_blocks - i : 64;
+    memcpy(s, &input[i], n * sizeof(uint64_t));
+    memset(&s[n], 0, (64 - n) * sizeof(uint64_t));
+    prince_bs_transpose(s);
+    prince_bs_crypt(s, keys, decrypt, num_half_rounds);
+    prince_bs_transpose(s);
+    memcpy(&output[i], s, n * sizeof(uint64_t));
+    i += n;
+  }
+  for (; i < num_blocks; i++) {
+    output[i] = prince_keys_crypt(keys, input[i], decrypt, num_half_rounds);
+  }
+}
+
+#endif  // OPENTITAN_HW_IP_PRIM_DV_PRIM_PRINCE_CRYPTO_DPI_PRINCE_PRINCE_BATCH_H_
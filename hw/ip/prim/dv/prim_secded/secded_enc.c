@@ -2,27 +2,175 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 //
-// SECDED encode code generated by
+// SECDED encode and decode code generated by
 // util/design/secded_gen.py from util/design/data/secded_cfg.hjson
 
 #include "secded_enc.h"
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SECDED_ENC_AVX2 1
+#endif
+
 // Calculates even parity for a 64-bit word
 static uint8_t calc_parity(uint64_t word, bool invert) {
-  bool parity = false;
+  return (uint8_t)__builtin_parityll(word) ^ invert;
+}
+
+// Corrects the data bit whose error gives `syndrome`, if any. `syndromes` holds
+// the syndrome of an error in each of the `k` data bits.
+static void correct_bytes(uint8_t *bytes, size_t num_bytes, uint8_t syndrome,
+                          const uint8_t *syndromes, int k) {
+  uint64_t flip = 0;
+  for (int i = 0; i < k; ++i) {
+    flip |= (uint64_t)(syndrome == syndromes[i]) << i;
+  }
+  for (size_t i = 0; i < num_bytes; ++i) {
+    bytes[i] ^= (uint8_t)(flip >> (8 * i));
+  }
+}
+
+// Error status from the syndrome of a Hsiao code. Bit 0: single error, bit 1:
+// double error.
+static uint8_t hsiao_err(uint8_t syndrome) {
+  uint8_t single = calc_parity(syndrome, false);
+  return single | ((!single && syndrome) << 1);
+}
+
+// Error status from the syndrome of a Hamming code with `m` integrity bits.
+// Bit 0: single error, bit 1: double error.
+static uint8_t hamming_err(uint8_t syndrome, int m) {
+  uint8_t single = (syndrome >> (m - 1)) & 1;
+  uint8_t others = syndrome & ((1 << (m - 1)) - 1);
+  return single | ((!single && others) << 1);
+}
+
+// Lookup tables for the batch encoders. As the codes are linear, apart from
+// the inverted integrity bits, the integrity bits of a word are `inv` XORed
+// with nibbles[i][v] for each nibble i of the word with value v.
+typedef struct enc_batch_tables {
+  bool ready;
+  uint8_t inv;
+  uint8_t nibbles[16][16];
+} enc_batch_tables_t;
+
+typedef uint8_t (*enc_fn_t)(const uint8_t *bytes);
+
+static void enc_batch_tables_init(enc_batch_tables_t *tables, enc_fn_t enc,
+                                  size_t word_size) {
+  uint8_t bytes[8] = {0};
+  tables->inv = enc(bytes);
+  for (size_t i = 0; i < 2 * word_size; ++i) {
+    for (uint8_t v = 0; v < 16; ++v) {
+      bytes[i / 2] = v << (4 * (i % 2));
+      tables->nibbles[i][v] = enc(bytes) ^ tables->inv;
+    }
+    bytes[i / 2] = 0;
+  }
+  tables->ready = true;
+}
+
+static uint64_t load_word(const void *words, size_t word_size, size_t i) {
+  switch (word_size) {
+    case 2:
+      return ((const uint16_t *)words)[i];
+    case 4:
+      return ((const uint32_t *)words)[i];
+    default:
+      return ((const uint64_t *)words)[i];
+  }
+}
+
+#ifdef SECDED_ENC_AVX2
+// Encodes words 4 at a time, looking up the integrity bits of all their
+// nibbles with byte shuffles. The table for byte i of a word is applied to all
+// bytes, then only byte i of each word is kept. The integrity bits of a word
+// are then the XOR of its bytes.
+__attribute__((target("avx2"))) static size_t enc_batch_avx2(
+    const enc_batch_tables_t *tables, const void *words, size_t word_size,
+    uint8_t *ecc, size_t num_words) {
+  __m256i lo_tables[8], hi_tables[8], byte_masks[8];
+  for (size_t i = 0; i < word_size; ++i) {
+    lo_tables[i] = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)tables->nibbles[2 * i]));
+    hi_tables[i] = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)tables->nibbles[2 * i + 1]));
+    byte_masks[i] = _mm256_set1_epi64x((int64_t)((uint64_t)0xff << (8 * i)));
+  }
+  const __m256i nibble_mask = _mm256_set1_epi8(0x0f);
+
+  size_t i = 0;
+  for (; i + 4 <= num_words; i += 4) {
+    __m256i w;
+    switch (word_size) {
+      case 2:
+        w = _mm256_cvtepu16_epi64(
+            _mm_loadl_epi64((const __m128i *)((const uint16_t *)words + i)));
+        break;
+      case 4:
+        w = _mm256_cvtepu32_epi64(
+            _mm_loadu_si128((const __m128i *)((const uint32_t *)words + i)));
+        break;
+      default:
+        w = _mm256_loadu_si256((const __m256i *)((const uint64_t *)words + i));
+        break;
+    }
+    __m256i lo = _mm256_and_si256(w, nibble_mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(w, 4), nibble_mask);
+
+    __m256i acc = _mm256_setzero_si256();
+    for (size_t j = 0; j < word_size; ++j) {
+      __m256i bits = _mm256_xor_si256(_mm256_shuffle_epi8(lo_tables[j], lo),
+                                      _mm256_shuffle_epi8(hi_tables[j], hi));
+      acc = _mm256_xor_si256(acc, _mm256_and_si256(bits, byte_masks[j]));
+    }
+    acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 32));
+    acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 16));
+    acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 8));
 
-  while (word) {
-    if (word & 1) {
-      parity = !parity;
+    uint64_t out[4];
+    _mm256_storeu_si256((__m256i *)out, acc);
+    for (int j = 0; j < 4; ++j) {
+      ecc[i + j] = (uint8_t)out[j] ^ tables->inv;
     }
+  }
+  return i;
+}
+#endif
+
+// Encodes `num_words` words of `word_size` bytes with `enc`, using AVX2 if the
+// host supports it.
+static void enc_batch(enc_batch_tables_t *tables, enc_fn_t enc,
+                      const void *words, size_t word_size, uint8_t *ecc,
+                      size_t num_words) {
+  size_t i = 0;
 
-    word >>= 1;
+#ifdef SECDED_ENC_AVX2
+  static int has_avx2 = -1;
+  if (has_avx2 < 0) {
+    __builtin_cpu_init();
+    has_avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+  }
+  if (has_avx2) {
+    if (!tables->ready) {
+      enc_batch_tables_init(tables, enc, word_size);
+    }
+    i = enc_batch_avx2(tables, words, word_size, ecc, num_words);
   }
+#endif
 
-  return parity ^ invert;
+  for (; i < num_words; ++i) {
+    uint64_t word = load_word(words, word_size, i);
+    uint8_t bytes[8];
+    for (size_t j = 0; j < word_size; ++j) {
+      bytes[j] = (uint8_t)(word >> (8 * j));
+    }
+    ecc[i] = enc(bytes);
+  }
 }
 
 uint8_t enc_secded_22_16(const uint8_t bytes[2]) {
@@ -36,6 +184,23 @@ uint8_t enc_secded_22_16(const uint8_t bytes[2]) {
          (calc_parity(word & 0x11f3, false) << 5);
 }
 
+static const uint8_t kSyndromes22_16[16] = {
+    0x32, 0x23, 0x19, 0x07, 0x2c, 0x31, 0x25, 0x34, 0x29, 0x0e, 0x1c, 0x15,
+    0x2a, 0x1a, 0x0b, 0x16};
+
+uint8_t dec_secded_22_16(uint8_t bytes[2], uint8_t ecc) {
+  uint8_t syndrome = (enc_secded_22_16(bytes) ^ ecc) & 0x3f;
+
+  correct_bytes(bytes, 2, syndrome, kSyndromes22_16, 16);
+  return hsiao_err(syndrome);
+}
+
+void enc_secded_22_16_batch(const uint16_t *words, uint8_t *ecc,
+                            size_t num_words) {
+  static enc_batch_tables_t tables;
+  enc_batch(&tables, enc_secded_22_16, words, sizeof(*words), ecc, num_words);
+}
+
 uint8_t enc_secded_28_22(const uint8_t bytes[3]) {
   uint32_t word = ((uint32_t)bytes[0] << 0) | ((uint32_t)bytes[1] << 8) |
                   ((uint32_t)bytes[2] << 16);
@@ -48,6 +213,23 @@ uint8_t enc_secded_28_22(const uint8_t bytes[3]) {
          (calc_parity(word & 0x3ed348, false) << 5);
 }
 
+static const uint8_t kSyndromes28_22[22] = {
+    0x07, 0x0b, 0x13, 0x23, 0x0d, 0x15, 0x25, 0x19, 0x29, 0x31, 0x0e, 0x16,
+    0x26, 0x1a, 0x2a, 0x32, 0x1c, 0x2c, 0x34, 0x38, 0x3b, 0x3d};
+
+uint8_t dec_secded_28_22(uint8_t bytes[3], uint8_t ecc) {
+  uint8_t syndrome = (enc_secded_28_22(bytes) ^ ecc) & 0x3f;
+
+  correct_bytes(bytes, 3, syndrome, kSyndromes28_22, 22);
+  return hsiao_err(syndrome);
+}
+
+void enc_secded_28_22_batch(const uint32_t *words, uint8_t *ecc,
+                            size_t num_words) {
+  static enc_batch_tables_t tables;
+  enc_batch(&tables, enc_secded_28_22, words, sizeof(*words), ecc, num_words);
+}
+
 uint8_t enc_secded_39_32(const uint8_t bytes[4]) {
   uint32_t word = ((uint32_t)bytes[0] << 0) | ((uint32_t)bytes[1] << 8) |
                   ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
@@ -61,6 +243,24 @@ uint8_t enc_secded_39_32(const uint8_t bytes[4]) {
          (calc_parity(word & 0x98505586, false) << 6);
 }
 
+static const uint8_t kSyndromes39_32[32] = {
+    0x19, 0x54, 0x61, 0x34, 0x1a, 0x15, 0x2a, 0x4c, 0x45, 0x38, 0x49, 0x0d,
+    0x51, 0x31, 0x68, 0x07, 0x1c, 0x0b, 0x25, 0x26, 0x46, 0x0e, 0x70, 0x32,
+    0x2c, 0x13, 0x23, 0x62, 0x4a, 0x29, 0x16, 0x52};
+
+uint8_t dec_secded_39_32(uint8_t bytes[4], uint8_t ecc) {
+  uint8_t syndrome = (enc_secded_39_32(bytes) ^ ecc) & 0x7f;
+
+  correct_bytes(bytes, 4, syndrome, kSyndromes39_32, 32);
+  return hsiao_err(syndrome);
+}
+
+void enc_secded_39_32_batch(const uint32_t *words, uint8_t *ecc,
+                            size_t num_words) {
+  static enc_batch_tables_t tables;
+  enc_batch(&tables, enc_secded_39_32, words, sizeof(*words), ecc, num_words);
+}
+
 uint8_t enc_secded_64_57(const uint8_t bytes[8]) {
   uint64_t word = ((uint64_t)bytes[0] << 0) | ((uint64_t)bytes[1] << 8) |
                   ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24) |
@@ -76,6 +276,26 @@ uint8_t enc_secded_64_57(const uint8_t bytes[8]) {
          (calc_parity(word & 0x1fbdda769a46910, false) << 6);
 }
 
+static const uint8_t kSyndromes64_57[57] = {
+    0x07, 0x0b, 0x13, 0x23, 0x43, 0x0d, 0x15, 0x25, 0x45, 0x19, 0x29, 0x49,
+    0x31, 0x51, 0x61, 0x0e, 0x16, 0x26, 0x46, 0x1a, 0x2a, 0x4a, 0x32, 0x52,
+    0x62, 0x1c, 0x2c, 0x4c, 0x34, 0x54, 0x64, 0x38, 0x58, 0x68, 0x70, 0x1f,
+    0x2f, 0x4f, 0x37, 0x57, 0x67, 0x3b, 0x5b, 0x6b, 0x73, 0x3d, 0x5d, 0x6d,
+    0x75, 0x79, 0x3e, 0x5e, 0x6e, 0x76, 0x7a, 0x7c, 0x7f};
+
+uint8_t dec_secded_64_57(uint8_t bytes[8], uint8_t ecc) {
+  uint8_t syndrome = (enc_secded_64_57(bytes) ^ ecc) & 0x7f;
+
+  correct_bytes(bytes, 8, syndrome, kSyndromes64_57, 57);
+  return hsiao_err(syndrome);
+}
+
+void enc_secded_64_57_batch(const uint64_t *words, uint8_t *ecc,
+                            size_t num_words) {
+  static enc_batch_tables_t tables;
+  enc_batch(&tables, enc_secded_64_57, words, sizeof(*words), ecc, num_words);
+}
+
 uint8_t enc_secded_72_64(const uint8_t bytes[8]) {
   uint64_t word = ((uint64_t)bytes[0] << 0) | ((uint64_t)bytes[1] << 8) |
                   ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24) |
@@ -92,6 +312,129 @@ uint8_t enc_secded_72_64(const uint8_t bytes[8]) {
          (calc_parity(word & 0x7aed348d221a4420, false) << 7);
 }
 
+static const uint8_t kSyndromes72_64[64] = {
+    0x07, 0x0b, 0x13, 0x23, 0x43, 0x83, 0x0d, 0x15, 0x25, 0x45, 0x85, 0x19,
+    0x29, 0x49, 0x89, 0x31, 0x51, 0x91, 0x61, 0xa1, 0xc1, 0x0e, 0x16, 0x26,
+    0x46, 0x86, 0x1a, 0x2a, 0x4a, 0x8a, 0x32, 0x52, 0x92, 0x62, 0xa2, 0xc2,
+    0x1c, 0x2c, 0x4c, 0x8c, 0x34, 0x54, 0x94, 0x64, 0xa4, 0xc4, 0x38, 0x58,
+    0x98, 0x68, 0xa8, 0xc8, 0x70, 0xb0, 0xd0, 0xe0, 0x6d, 0xd6, 0x3e, 0xcb,
+    0xb3, 0xb5, 0xce, 0x79};
+
+uint8_t dec_secded_72_64(uint8_t bytes[8], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_72_64(bytes) ^ ecc;
+
+  correct_bytes(bytes, 8, syndrome, kSyndromes72_64, 64);
+  return hsiao_err(syndrome);
+}
+
+void enc_secded_72_64_batch(const uint64_t *words, uint8_t *ecc,
+                            size_t num_words) {
+  static enc_batch_tables_t tables;
+  enc_batch(&tables, enc_secded_72_64, words, sizeof(*words), ecc, num_words);
+}
+
+uint8_t enc_secded_hamming_22_16(const uint8_t bytes[2]) {
+  uint16_t word = ((uint16_t)bytes[0] << 0) | ((uint16_t)bytes[1] << 8);
+
+  return (calc_parity(word & 0xad5b, false) << 0) |
+         (calc_parity(word & 0x366d, false) << 1) |
+         (calc_parity(word & 0xc78e, false) << 2) |
+         (calc_parity(word & 0x7f0, false) << 3) |
+         (calc_parity(word & 0xf800, false) << 4) |
+         (calc_parity(word & 0x5cb7, false) << 5);
+}
+
+static const uint8_t kSyndromesHamming22_16[16] = {
+    0x23, 0x25, 0x26, 0x27, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x31,
+    0x32, 0x33, 0x34, 0x35};
+
+uint8_t dec_secded_hamming_22_16(uint8_t bytes[2], uint8_t ecc) {
+  uint8_t syndrome = (enc_secded_hamming_22_16(bytes) ^ ecc) & 0x3f;
+  syndrome ^= calc_parity(syndrome & 0x1f, false) << 5;
+
+  correct_bytes(bytes, 2, syndrome, kSyndromesHamming22_16, 16);
+  return hamming_err(syndrome, 6);
+}
+
+void enc_secded_hamming_22_16_batch(const uint16_t *words, uint8_t *ecc,
+                                    size_t num_words) {
+  static enc_batch_tables_t tables;
+  enc_batch(&tables, enc_secded_hamming_22_16, words, sizeof(*words), ecc,
+            num_words);
+}
+
+uint8_t enc_secded_hamming_39_32(const uint8_t bytes[4]) {
+  uint32_t word = ((uint32_t)bytes[0] << 0) | ((uint32_t)bytes[1] << 8) |
+                  ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+
+  return (calc_parity(word & 0x56aaad5b, false) << 0) |
+         (calc_parity(word & 0x9b33366d, false) << 1) |
+         (calc_parity(word & 0xe3c3c78e, false) << 2) |
+         (calc_parity(word & 0x3fc07f0, false) << 3) |
+         (calc_parity(word & 0x3fff800, false) << 4) |
+         (calc_parity(word & 0xfc000000, false) << 5) |
+         (calc_parity(word & 0x2da65cb7, false) << 6);
+}
+
+static const uint8_t kSyndromesHamming39_32[32] = {
+    0x43, 0x45, 0x46, 0x47, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f, 0x51,
+    0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x5b, 0x5c, 0x5d,
+    0x5e, 0x5f, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66};
+
+uint8_t dec_secded_hamming_39_32(uint8_t bytes[4], uint8_t ecc) {
+  uint8_t syndrome = (enc_secded_hamming_39_32(bytes) ^ ecc) & 0x7f;
+  syndrome ^= calc_parity(syndrome & 0x3f, false) << 6;
+
+  correct_bytes(bytes, 4, syndrome, kSyndromesHamming39_32, 32);
+  return hamming_err(syndrome, 7);
+}
+
+void enc_secded_hamming_39_32_batch(const uint32_t *words, uint8_t *ecc,
+                                    size_t num_words) {
+  static enc_batch_tables_t tables;
+  enc_batch(&tables, enc_secded_hamming_39_32, words, sizeof(*words), ecc,
+            num_words);
+}
+
+uint8_t enc_secded_hamming_72_64(const uint8_t bytes[8]) {
+  uint64_t word = ((uint64_t)bytes[0] << 0) | ((uint64_t)bytes[1] << 8) |
+                  ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24) |
+                  ((uint64_t)bytes[4] << 32) | ((uint64_t)bytes[5] << 40) |
+                  ((uint64_t)bytes[6] << 48) | ((uint64_t)bytes[7] << 56);
+
+  return (calc_parity(word & 0xab55555556aaad5b, false) << 0) |
+         (calc_parity(word & 0xcd9999999b33366d, false) << 1) |
+         (calc_parity(word & 0xf1e1e1e1e3c3c78e, false) << 2) |
+         (calc_parity(word & 0x1fe01fe03fc07f0, false) << 3) |
+         (calc_parity(word & 0x1fffe0003fff800, false) << 4) |
+         (calc_parity(word & 0x1fffffffc000000, false) << 5) |
+         (calc_parity(word & 0xfe00000000000000, false) << 6) |
+         (calc_parity(word & 0x972cd2d32da65cb7, false) << 7);
+}
+
+static const uint8_t kSyndromesHamming72_64[64] = {
+    0x83, 0x85, 0x86, 0x87, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f, 0x91,
+    0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d,
+    0x9e, 0x9f, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa,
+    0xab, 0xac, 0xad, 0xae, 0xaf, 0xb0, 0xb1, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6,
+    0xb7, 0xb8, 0xb9, 0xba, 0xbb, 0xbc, 0xbd, 0xbe, 0xbf, 0xc1, 0xc2, 0xc3,
+    0xc4, 0xc5, 0xc6, 0xc7};
+
+uint8_t dec_secded_hamming_72_64(uint8_t bytes[8], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_hamming_72_64(bytes) ^ ecc;
+  syndrome ^= calc_parity(syndrome & 0x7f, false) << 7;
+
+  correct_bytes(bytes, 8, syndrome, kSyndromesHamming72_64, 64);
+  return hamming_err(syndrome, 8);
+}
+
+void enc_secded_hamming_72_64_batch(const uint64_t *words, uint8_t *ecc,
+                                    size_t num_words) {
+  static enc_batch_tables_t tables;
+  enc_batch(&tables, enc_secded_hamming_72_64, words, sizeof(*words), ecc,
+            num_words);
+}
+
 uint8_t enc_secded_inv_22_16(const uint8_t bytes[2]) {
   uint16_t word = ((uint16_t)bytes[0] << 0) | ((uint16_t)bytes[1] << 8);
 
@@ -103,6 +446,24 @@ uint8_t enc_secded_inv_22_16(const uint8_t bytes[2]) {
          (calc_parity(word & 0x11f3, true) << 5);
 }
 
+static const uint8_t kSyndromesInv22_16[16] = {
+    0x32, 0x23, 0x19, 0x07, 0x2c, 0x31, 0x25, 0x34, 0x29, 0x0e, 0x1c, 0x15,
+    0x2a, 0x1a, 0x0b, 0x16};
+
+uint8_t dec_secded_inv_22_16(uint8_t bytes[2], uint8_t ecc) {
+  uint8_t syndrome = (enc_secded_inv_22_16(bytes) ^ ecc) & 0x3f;
+
+  correct_bytes(bytes, 2, syndrome, kSyndromesInv22_16, 16);
+  return hsiao_err(syndrome);
+}
+
+void enc_secded_inv_22_16_batch(const uint16_t *words, uint8_t *ecc,
+                                size_t num_words) {
+  static enc_batch_tables_t tables;
+  enc_batch(&tables, enc_secded_inv_22_16, words, sizeof(*words), ecc,
+            num_words);
+}
+
 uint8_t enc_secded_inv_28_22(const uint8_t bytes[3]) {
   uint32_t word = ((uint32_t)bytes[0] << 0) | ((uint32_t)bytes[1] << 8) |
                   ((uint32_t)bytes[2] << 16);
@@ -115,6 +476,24 @@ uint8_t enc_secded_inv_28_22(const uint8_t bytes[3]) {
          (calc_parity(word & 0x3ed348, true) << 5);
 }
 
+static const uint8_t kSyndromesInv28_22[22] = {
+    0x07, 0x0b, 0x13, 0x23, 0x0d, 0x15, 0x25, 0x19, 0x29, 0x31, 0x0e, 0x16,
+    0x26, 0x1a, 0x2a, 0x32, 0x1c, 0x2c, 0x34, 0x38, 0x3b, 0x3d};
+
+uint8_t dec_secded_inv_28_22(uint8_t bytes[3], uint8_t ecc) {
+  uint8_t syndrome = (enc_secded_inv_28_22(bytes) ^ ecc) & 0x3f;
+
+  correct_bytes(bytes, 3, syndrome, kSyndromesInv28_22, 22);
+  return hsiao_err(syndrome);
+}
+
+void enc_secded_inv_28_22_batch(const uint32_t *words, uint8_t *ecc,
+                                size_t num_words) {
+  static enc_batch_tables_t tables;
+  enc_batch(&tables, enc_secded_inv_28_22, words, sizeof(*words), ecc,
+            num_words);
+}
+
 uint8_t enc_secded_inv_39_32(const uint8_t bytes[4]) {
   uint32_t word = ((uint32_t)bytes[0] << 0) | ((uint32_t)bytes[1] << 8) |
                   ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
@@ -128,6 +507,25 @@ uint8_t enc_secded_inv_39_32(const uint8_t bytes[4]) {
          (calc_parity(word & 0x98505586, false) << 6);
 }
 
+static const uint8_t kSyndromesInv39_32[32] = {
+    0x19, 0x54, 0x61, 0x34, 0x1a, 0x15, 0x2a, 0x4c, 0x45, 0x38, 0x49, 0x0d,
+    0x51, 0x31, 0x68, 0x07, 0x1c, 0x0b, 0x25, 0x26, 0x46, 0x0e, 0x70, 0x32,
+    0x2c, 0x13, 0x23, 0x62, 0x4a, 0x29, 0x16, 0x52};
+
+uint8_t dec_secded_inv_39_32(uint8_t bytes[4], uint8_t ecc) {
+  uint8_t syndrome = (enc_secded_inv_39_32(bytes) ^ ecc) & 0x7f;
+
+  correct_bytes(bytes, 4, syndrome, kSyndromesInv39_32, 32);
+  return hsiao_err(syndrome);
+}
+
+void enc_secded_inv_39_32_batch(const uint32_t *words, uint8_t *ecc,
+                                size_t num_words) {
+  static enc_batch_tables_t tables;
+  enc_batch(&tables, enc_secded_inv_39_32, words, sizeof(*words), ecc,
+            num_words);
+}
+
 uint8_t enc_secded_inv_64_57(const uint8_t bytes[8]) {
   uint64_t word = ((uint64_t)bytes[0] << 0) | ((uint64_t)bytes[1] << 8) |
                   ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24) |
@@ -143,6 +541,27 @@ uint8_t enc_secded_inv_64_57(const uint8_t bytes[8]) {
          (calc_parity(word & 0x1fbdda769a46910, false) << 6);
 }
 
+static const uint8_t kSyndromesInv64_57[57] = {
+    0x07, 0x0b, 0x13, 0x23, 0x43, 0x0d, 0x15, 0x25, 0x45, 0x19, 0x29, 0x49,
+    0x31, 0x51, 0x61, 0x0e, 0x16, 0x26, 0x46, 0x1a, 0x2a, 0x4a, 0x32, 0x52,
+    0x62, 0x1c, 0x2c, 0x4c, 0x34, 0x54, 0x64, 0x38, 0x58, 0x68, 0x70, 0x1f,
+    0x2f, 0x4f, 0x37, 0x57, 0x67, 0x3b, 0x5b, 0x6b, 0x73, 0x3d, 0x5d, 0x6d,
+    0x75, 0x79, 0x3e, 0x5e, 0x6e, 0x76, 0x7a, 0x7c, 0x7f};
+
+uint8_t dec_secded_inv_64_57(uint8_t bytes[8], uint8_t ecc) {
+  uint8_t syndrome = (enc_secded_inv_64_57(bytes) ^ ecc) & 0x7f;
+
+  correct_bytes(bytes, 8, syndrome, kSyndromesInv64_57, 57);
+  return hsiao_err(syndrome);
+}
+
+void enc_secded_inv_64_57_batch(const uint64_t *words, uint8_t *ecc,
+                                size_t num_words) {
+  static enc_batch_tables_t tables;
+  enc_batch(&tables, enc_secded_inv_64_57, words, sizeof(*words), ecc,
+            num_words);
+}
+
 uint8_t enc_secded_inv_72_64(const uint8_t bytes[8]) {
   uint64_t word = ((uint64_t)bytes[0] << 0) | ((uint64_t)bytes[1] << 8) |
                   ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24) |
@@ -158,3 +577,127 @@ uint8_t enc_secded_inv_72_64(const uint8_t bytes[8]) {
          (calc_parity(word & 0xcbdaaa4a91152210, false) << 6) |
          (calc_parity(word & 0x7aed348d221a4420, true) << 7);
 }
+
+static const uint8_t kSyndromesInv72_64[64] = {
+    0x07, 0x0b, 0x13, 0x23, 0x43, 0x83, 0x0d, 0x15, 0x25, 0x45, 0x85, 0x19,
+    0x29, 0x49, 0x89, 0x31, 0x51, 0x91, 0x61, 0xa1, 0xc1, 0x0e, 0x16, 0x26,
+    0x46, 0x86, 0x1a, 0x2a, 0x4a, 0x8a, 0x32, 0x52, 0x92, 0x62, 0xa2, 0xc2,
+    0x1c, 0x2c, 0x4c, 0x8c, 0x34, 0x54, 0x94, 0x64, 0xa4, 0xc4, 0x38, 0x58,
+    0x98, 0x68, 0xa8, 0xc8, 0x70, 0xb0, 0xd0, 0xe0, 0x6d, 0xd6, 0x3e, 0xcb,
+    0xb3, 0xb5, 0xce, 0x79};
+
+uint8_t dec_secded_inv_72_64(uint8_t bytes[8], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_inv_72_64(bytes) ^ ecc;
+
+  correct_bytes(bytes, 8, syndrome, kSyndromesInv72_64, 64);
+  return hsiao_err(syndrome);
+}
+
+void enc_secded_inv_72_64_batch(const uint64_t *words, uint8_t *ecc,
+                                size_t num_words) {
+  static enc_batch_tables_t tables;
+  enc_batch(&tables, enc_secded_inv_72_64, words, sizeof(*words), ecc,
+            num_words);
+}
+
+uint8_t enc_secded_inv_hamming_22_16(const uint8_t bytes[2]) {
+  uint16_t word = ((uint16_t)bytes[0] << 0) | ((uint16_t)bytes[1] << 8);
+
+  return (calc_parity(word & 0xad5b, false) << 0) |
+         (calc_parity(word & 0x366d, true) << 1) |
+         (calc_parity(word & 0xc78e, false) << 2) |
+         (calc_parity(word & 0x7f0, true) << 3) |
+         (calc_parity(word & 0xf800, false) << 4) |
+         (calc_parity(word & 0x5cb7, true) << 5);
+}
+
+static const uint8_t kSyndromesInvHamming22_16[16] = {
+    0x23, 0x25, 0x26, 0x27, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x31,
+    0x32, 0x33, 0x34, 0x35};
+
+uint8_t dec_secded_inv_hamming_22_16(uint8_t bytes[2], uint8_t ecc) {
+  uint8_t syndrome = (enc_secded_inv_hamming_22_16(bytes) ^ ecc) & 0x3f;
+  syndrome ^= calc_parity(syndrome & 0x1f, false) << 5;
+
+  correct_bytes(bytes, 2, syndrome, kSyndromesInvHamming22_16, 16);
+  return hamming_err(syndrome, 6);
+}
+
+void enc_secded_inv_hamming_22_16_batch(const uint16_t *words, uint8_t *ecc,
+                                        size_t num_words) {
+  static enc_batch_tables_t tables;
+  enc_batch(&tables, enc_secded_inv_hamming_22_16, words, sizeof(*words), ecc,
+            num_words);
+}
+
+uint8_t enc_secded_inv_hamming_39_32(const uint8_t bytes[4]) {
+  uint32_t word = ((uint32_t)bytes[0] << 0) | ((uint32_t)bytes[1] << 8) |
+                  ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+
+  return (calc_parity(word & 0x56aaad5b, false) << 0) |
+         (calc_parity(word & 0x9b33366d, true) << 1) |
+         (calc_parity(word & 0xe3c3c78e, false) << 2) |
+         (calc_parity(word & 0x3fc07f0, true) << 3) |
+         (calc_parity(word & 0x3fff800, false) << 4) |
+         (calc_parity(word & 0xfc000000, true) << 5) |
+         (calc_parity(word & 0x2da65cb7, false) << 6);
+}
+
+static const uint8_t kSyndromesInvHamming39_32[32] = {
+    0x43, 0x45, 0x46, 0x47, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f, 0x51,
+    0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x5b, 0x5c, 0x5d,
+    0x5e, 0x5f, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66};
+
+uint8_t dec_secded_inv_hamming_39_32(uint8_t bytes[4], uint8_t ecc) {
+  uint8_t syndrome = (enc_secded_inv_hamming_39_32(bytes) ^ ecc) & 0x7f;
+  syndrome ^= calc_parity(syndrome & 0x3f, false) << 6;
+
+  correct_bytes(bytes, 4, syndrome, kSyndromesInvHamming39_32, 32);
+  return hamming_err(syndrome, 7);
+}
+
+void enc_secded_inv_hamming_39_32_batch(const uint32_t *words, uint8_t *ecc,
+                                        size_t num_words) {
+  static enc_batch_tables_t tables;
+  enc_batch(&tables, enc_secded_inv_hamming_39_32, words, sizeof(*words), ecc,
+            num_words);
+}
+
+uint8_t enc_secded_inv_hamming_72_64(const uint8_t bytes[8]) {
+  uint64_t word = ((uint64_t)bytes[0] << 0) | ((uint64_t)bytes[1] << 8) |
+                  ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24) |
+                  ((uint64_t)bytes[4] << 32) | ((uint64_t)bytes[5] << 40) |
+                  ((uint64_t)bytes[6] << 48) | ((uint64_t)bytes[7] << 56);
+
+  return (calc_parity(word & 0xab55555556aaad5b, false) << 0) |
+         (calc_parity(word & 0xcd9999999b33366d, true) << 1) |
+         (calc_parity(word & 0xf1e1e1e1e3c3c78e, false) << 2) |
+         (calc_parity(word & 0x1fe01fe03fc07f0, true) << 3) |
+         (calc_parity(word & 0x1fffe0003fff800, false) << 4) |
+         (calc_parity(word & 0x1fffffffc000000, true) << 5) |
+         (calc_parity(word & 0xfe00000000000000, false) << 6) |
+         (calc_parity(word & 0x972cd2d32da65cb7, true) << 7);
+}
+
+static const uint8_t kSyndromesInvHamming72_64[64] = {
+    0x83, 0x85, 0x86, 0x87, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f, 0x91,
+    0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d,
+    0x9e, 0x9f, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa,
+    0xab, 0xac, 0xad, 0xae, 0xaf, 0xb0, 0xb1, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6,
+    0xb7, 0xb8, 0xb9, 0xba, 0xbb, 0xbc, 0xbd, 0xbe, 0xbf, 0xc1, 0xc2, 0xc3,
+    0xc4, 0xc5, 0xc6, 0xc7};
+
+uint8_t dec_secded_inv_hamming_72_64(uint8_t bytes[8], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_inv_hamming_72_64(bytes) ^ ecc;
+  syndrome ^= calc_parity(syndrome & 0x7f, false) << 7;
+
+  correct_bytes(bytes, 8, syndrome, kSyndromesInvHamming72_64, 64);
+  return hamming_err(syndrome, 8);
+}
+
+void enc_secded_inv_hamming_72_64_batch(const uint64_t *words, uint8_t *ecc,
+                                        size_t num_words) {
+  static enc_batch_tables_t tables;
+  enc_batch(&tables, enc_secded_inv_hamming_72_64, words, sizeof(*words), ecc,
+            num_words);
+}
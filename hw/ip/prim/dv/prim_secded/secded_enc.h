@@ -2,32 +2,97 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 //
-// SECDED encode code generated by
+// SECDED encode and decode code generated by
 // util/design/secded_gen.py from util/design/data/secded_cfg.hjson
 
 #ifndef OPENTITAN_HW_IP_PRIM_DV_PRIM_SECDED_SECDED_ENC_H_
 #define OPENTITAN_HW_IP_PRIM_DV_PRIM_SECDED_SECDED_ENC_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif  // __cplusplus
 
-// Integrity encode functions for varying bit widths matching the functionality
-// of the RTL modules of the same name. Each takes an array of bytes in
-// little-endian order and returns the calculated integrity bits.
+// Integrity encode and decode functions for varying bit widths matching the
+// functionality of the RTL modules of the same name.
+//
+// The enc_* functions take an array of bytes in little-endian order and return
+// the calculated integrity bits.
+//
+// The dec_* functions take the same bytes and the integrity bits read with
+// them. They correct a single bit error in the bytes in place and return the
+// error status like the RTL decoder: bit 0 is set for a single error and bit 1
+// for a double error.
+//
+// The enc_*_batch functions calculate the integrity bits of each of an array
+// of words, using AVX2 where the host supports it.
 
 uint8_t enc_secded_22_16(const uint8_t bytes[2]);
+uint8_t dec_secded_22_16(uint8_t bytes[2], uint8_t ecc);
+void enc_secded_22_16_batch(const uint16_t *words, uint8_t *ecc,
+                            size_t num_words);
 uint8_t enc_secded_28_22(const uint8_t bytes[3]);
+uint8_t dec_secded_28_22(uint8_t bytes[3], uint8_t ecc);
+void enc_secded_28_22_batch(const uint32_t *words, uint8_t *ecc,
+                            size_t num_words);
 uint8_t enc_secded_39_32(const uint8_t bytes[4]);
+uint8_t dec_secded_39_32(uint8_t bytes[4], uint8_t ecc);
+void enc_secded_39_32_batch(const uint32_t *words, uint8_t *ecc,
+                            size_t num_words);
 uint8_t enc_secded_64_57(const uint8_t bytes[8]);
+uint8_t dec_secded_64_57(uint8_t bytes[8], uint8_t ecc);
+void enc_secded_64_57_batch(const uint64_t *words, uint8_t *ecc,
+                            size_t num_words);
 uint8_t enc_secded_72_64(const uint8_t bytes[8]);
+uint8_t dec_secded_72_64(uint8_t bytes[8], uint8_t ecc);
+void enc_secded_72_64_batch(const uint64_t *words, uint8_t *ecc,
+                            size_t num_words);
+uint8_t enc_secded_hamming_22_16(const uint8_t bytes[2]);
+uint8_t dec_secded_hamming_22_16(uint8_t bytes[2], uint8_t ecc);
+void enc_secded_hamming_22_16_batch(const uint16_t *words, uint8_t *ecc,
+                                    size_t num_words);
+uint8_t enc_secded_hamming_39_32(const uint8_t bytes[4]);
+uint8_t dec_secded_hamming_39_32(uint8_t bytes[4], uint8_t ecc);
+void enc_secded_hamming_39_32_batch(const uint32_t *words, uint8_t *ecc,
+                                    size_t num_words);
+uint8_t enc_secded_hamming_72_64(const uint8_t bytes[8]);
+uint8_t dec_secded_hamming_72_64(uint8_t bytes[8], uint8_t ecc);
+void enc_secded_hamming_72_64_batch(const uint64_t *words, uint8_t *ecc,
+                                    size_t num_words);
 uint8_t enc_secded_inv_22_16(const uint8_t bytes[2]);
+uint8_t dec_secded_inv_22_16(uint8_t bytes[2], uint8_t ecc);
+void enc_secded_inv_22_16_batch(const uint16_t *words, uint8_t *ecc,
+                                size_t num_words);
 uint8_t enc_secded_inv_28_22(const uint8_t bytes[3]);
+uint8_t dec_secded_inv_28_22(uint8_t bytes[3], uint8_t ecc);
+void enc_secded_inv_28_22_batch(const uint32_t *words, uint8_t *ecc,
+                                size_t num_words);
 uint8_t enc_secded_inv_39_32(const uint8_t bytes[4]);
+uint8_t dec_secded_inv_39_32(uint8_t bytes[4], uint8_t ecc);
+void enc_secded_inv_39_32_batch(const uint32_t *words, uint8_t *ecc,
+                                size_t num_words);
 uint8_t enc_secded_inv_64_57(const uint8_t bytes[8]);
+uint8_t dec_secded_inv_64_57(uint8_t bytes[8], uint8_t ecc);
+void enc_secded_inv_64_57_batch(const uint64_t *words, uint8_t *ecc,
+                                size_t num_words);
 uint8_t enc_secded_inv_72_64(const uint8_t bytes[8]);
+uint8_t dec_secded_inv_72_64(uint8_t bytes[8], uint8_t ecc);
+void enc_secded_inv_72_64_batch(const uint64_t *words, uint8_t *ecc,
+                                size_t num_words);
+uint8_t enc_secded_inv_hamming_22_16(const uint8_t bytes[2]);
+uint8_t dec_secded_inv_hamming_22_16(uint8_t bytes[2], uint8_t ecc);
+void enc_secded_inv_hamming_22_16_batch(const uint16_t *words, uint8_t *ecc,
+                                        size_t num_words);
+uint8_t enc_secded_inv_hamming_39_32(const uint8_t bytes[4]);
+uint8_t dec_secded_inv_hamming_39_32(uint8_t bytes[4], uint8_t ecc);
+void enc_secded_inv_hamming_39_32_batch(const uint32_t *words, uint8_t *ecc,
+                                        size_t num_words);
+uint8_t enc_secded_inv_hamming_72_64(const uint8_t bytes[8]);
+uint8_t dec_secded_inv_hamming_72_64(uint8_t bytes[8], uint8_t ecc);
+void enc_secded_inv_hamming_72_64_batch(const uint64_t *words, uint8_t *ecc,
+                                        size_t num_words);
 
 #ifdef __cplusplus
 }  // extern "C"
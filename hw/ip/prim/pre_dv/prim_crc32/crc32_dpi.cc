@@ -0,0 +1,36 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdint.h>
+#include <svdpi.h>
+
+// Symlink to sw/device/lib/base/crc32_host.h, the host CRC32 implementation of
+// the software.
+#include "crc32_host.h"
+
+extern "C" {
+uint32_t c_dpi_crc32(uint32_t crc, const svOpenArrayHandle data);
+}
+
+/**
+ * Adds `data` to a CRC32, as prim_crc32 does for a word with the bytes in
+ * `data`.
+ *
+ * @param crc Current CRC32, as output by prim_crc32.
+ * @param data Bytes to add, starting at the lowest index.
+ * @return Updated CRC32.
+ */
+uint32_t c_dpi_crc32(uint32_t crc, const svOpenArrayHandle data) {
+  uint8_t buf[64];
+  size_t len = 0;
+  uint32_t state = ~crc;
+  for (int i = svLow(data, 1); i <= svHigh(data, 1); ++i) {
+    buf[len++] = *static_cast<const uint8_t *>(svGetArrElemPtr1(data, i));
+    if (len == sizeof(buf)) {
+      state = crc32_host_add(state, buf, len);
+      len = 0;
+    }
+  }
+  return ~crc32_host_add(state, buf, len);
+}
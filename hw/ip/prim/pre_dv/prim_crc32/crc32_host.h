@@ -0,0 +1 @@
+../../../../../sw/device/lib/base/crc32_host.h
\ No newline at end of file
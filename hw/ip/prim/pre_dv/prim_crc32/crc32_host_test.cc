@@ -0,0 +1,124 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Checks the CRC32 kernels of crc32_host.h against a bit-by-bit reference,
+// which is how the host build of sw/device/lib/base/crc32.c used to compute
+// CRC32, and with --bench compares their throughput.
+//
+// Build and run from this directory with:
+//   g++ -std=c++14 -O2 crc32_host_test.cc -o crc32_host_test
+//   ./crc32_host_test [--bench]
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "crc32_host.h"
+
+typedef uint32_t (*crc32_kernel_t)(uint32_t state, const void *buf,
+                                   size_t len);
+
+// The previous host implementation of crc32_add().
+static uint32_t crc32_bitwise(uint32_t state, const void *buf, size_t len) {
+  const uint8_t *data = static_cast<const uint8_t *>(buf);
+  for (size_t i = 0; i < len; ++i) {
+    state ^= data[i];
+    for (int bit = 0; bit < 8; ++bit) {
+      state = (state >> 1) ^ (kCrc32HostPoly & (0u - (state & 1)));
+    }
+  }
+  return state;
+}
+
+struct Kernel {
+  const char *name;
+  crc32_kernel_t fn;
+};
+
+static std::vector<Kernel> get_kernels() {
+  std::vector<Kernel> kernels = {
+      {"bytewise", crc32_host_add_bytewise},
+      {"slice8", crc32_host_add_slice8},
+  };
+#if CRC32_HOST_PCLMUL
+  if (crc32_host_has_pclmul()) {
+    kernels.push_back({"pclmul", crc32_host_add_pclmul});
+  } else {
+    printf("Skipping pclmul: not supported by this host\n");
+  }
+#endif
+  kernels.push_back({"dispatch", crc32_host_add});
+  return kernels;
+}
+
+static int run_tests() {
+  std::mt19937 rng(1);
+  std::vector<uint8_t> buf(4096 + 16);
+  for (auto &byte : buf) {
+    byte = rng();
+  }
+
+  int failures = 0;
+  if (~crc32_host_add(UINT32_MAX, "123456789", 9) != 0xcbf43926) {
+    printf("FAIL: check value\n");
+    ++failures;
+  }
+
+  for (const Kernel &kernel : get_kernels()) {
+    for (size_t offset = 0; offset < 16; ++offset) {
+      for (size_t len = 0; len <= 4096; len += len < 300 ? 1 : 97) {
+        const uint32_t state = rng();
+        const uint32_t expected = crc32_bitwise(state, &buf[offset], len);
+        if (kernel.fn(state, &buf[offset], len) != expected) {
+          printf("FAIL: %s at offset %zu, length %zu\n", kernel.name, offset,
+                 len);
+          ++failures;
+        }
+      }
+    }
+  }
+
+  if (failures) {
+    printf("%d failures\n", failures);
+    return 1;
+  }
+  printf("PASS\n");
+  return 0;
+}
+
+// Time each kernel on buffers of a few sizes.
+static void run_bench() {
+  std::vector<Kernel> kernels = get_kernels();
+  kernels.insert(kernels.begin(), {"bitwise", crc32_bitwise});
+
+  for (size_t len : {64, 1024, 65536}) {
+    std::vector<uint8_t> buf(len, 0xa5);
+    const size_t total = 64 << 20;
+    printf("%zu byte buffers:\n", len);
+    for (const Kernel &kernel : kernels) {
+      // The bitwise kernel is much slower, so give it less data.
+      const size_t iters =
+          (kernel.fn == crc32_bitwise ? total / 16 : total) / len;
+      uint32_t state = UINT32_MAX;
+      auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < iters; ++i) {
+        state = kernel.fn(state, buf.data(), len);
+      }
+      std::chrono::duration<double> time =
+          std::chrono::steady_clock::now() - start;
+      printf("  %-10s %8.1f MB/s (%08x)\n", kernel.name,
+             iters * len / time.count() / 1e6, state);
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+    run_bench();
+    return 0;
+  }
+  return run_tests();
+}
@@ -6,11 +6,21 @@ module prim_crc32_sim (
   input IO_CLK,
   input IO_RST_N
 );
-  logic [47:0] test_crc_in;
+  localparam int unsigned BytesPerWord = 6;
+
+  // Reference model, see crc32_dpi.cc.
+  import "DPI-C" function int unsigned c_dpi_crc32(
+    input int unsigned crc,
+    input byte unsigned data[]
+  );
+
+  logic [BytesPerWord*8-1:0] test_crc_in;
   logic [31:0] test_data;
   logic [31:0] crc_out;
+  logic [31:0] crc_exp;
   logic [31:0] cnt;
   logic        set_crc;
+  byte unsigned test_crc_in_bytes[BytesPerWord];
 
   assign test_crc_in = {cnt[7:0], cnt[7:0], test_data};
 
@@ -29,13 +39,34 @@ module prim_crc32_sim (
         cnt <= cnt + 32'd1;
 
         $display("%08x", crc_out);
+        if (crc_out != crc_exp) begin
+          $display("ERROR: CRC mismatch, expected %08x", crc_exp);
+          $stop();
+        end
       end else begin
         $finish();
       end
     end
   end
 
-  prim_crc32 #(.BytesPerWord(6)) dut (
+  // Compute the expected CRC along with the DUT.
+  always_comb begin
+    for (int i = 0; i < BytesPerWord; i++) begin
+      test_crc_in_bytes[i] = test_crc_in[i * 8 +: 8];
+    end
+  end
+
+  always @(posedge IO_CLK or negedge IO_RST_N) begin
+    if (!IO_RST_N) begin
+      crc_exp <= '0;
+    end else if (set_crc) begin
+      crc_exp <= '0;
+    end else begin
+      crc_exp <= c_dpi_crc32(crc_exp, test_crc_in_bytes);
+    end
+  end
+
+  prim_crc32 #(.BytesPerWord(BytesPerWord)) dut (
     .clk_i(IO_CLK),
     .rst_ni(IO_RST_N),
 
@@ -4,8 +4,6 @@
 
 #include "sw/device/lib/base/crc32.h"
 
-#include <stdbool.h>
-
 #include "sw/device/lib/base/macros.h"
 #include "sw/device/lib/base/memory.h"
 
@@ -32,41 +30,22 @@ static uint32_t crc32_internal_add32(uint32_t ctx, uint32_t word) {
   return ctx;
 }
 #else
-enum {
-  /**
-   * CRC32 polynomial.
-   */
-  kCrc32Poly = 0xedb88320,
-};
+#include "sw/device/lib/base/crc32_host.h"
 
 /**
- * Computes the CRC32 of a buffer as expected by Python's `zlib.crc32()`. The
- * implementation below is basically a simplified, i.e. byte-by-byte and without
- * a lookup table, version of zlib's crc32, which also matches IEEE 802.3
- * CRC-32. See
- * https://github.com/madler/zlib/blob/2fa463bacfff79181df1a5270fb67cc679a53e71/crc32.c,
- * lines 111-112 and 276-279.
+ * Computes the CRC32 of a buffer as expected by Python's `zlib.crc32()`, which
+ * also matches IEEE 802.3 CRC-32, with the table-driven kernels of
+ * crc32_host.h.
  */
 OT_WARN_UNUSED_RESULT
 static uint32_t crc32_internal_add8(uint32_t ctx, uint8_t byte) {
-  ctx ^= byte;
-  for (size_t i = 0; i < 8; ++i) {
-    bool lsb = ctx & 1;
-    ctx >>= 1;
-    if (lsb) {
-      ctx ^= kCrc32Poly;
-    }
-  }
-  return ctx;
+  return crc32_host_add_bytewise(ctx, &byte, sizeof(byte));
 }
 
 OT_WARN_UNUSED_RESULT
 static uint32_t crc32_internal_add32(uint32_t ctx, uint32_t word) {
-  char *bytes = (char *)&word;
-  for (size_t i = 0; i < sizeof(uint32_t); ++i) {
-    ctx = crc32_internal_add8(ctx, bytes[i]);
-  }
-  return ctx;
+  // `word` is added in memory order, like on the device.
+  return crc32_host_add_bytewise(ctx, &word, sizeof(word));
 }
 #endif
 
@@ -81,6 +60,7 @@ void crc32_add32(uint32_t *ctx, uint32_t word) {
 }
 
 void crc32_add(uint32_t *ctx, const void *buf, size_t len) {
+#ifdef OT_PLATFORM_RV32
   const char *data = buf;
   uint32_t state = *ctx;
   // Unaligned head.
@@ -97,6 +77,10 @@ void crc32_add(uint32_t *ctx, const void *buf, size_t len) {
     state = crc32_internal_add8(state, *data);
   }
   *ctx = state;
+#else
+  // The host kernels handle any alignment and process several words at a time.
+  *ctx = crc32_host_add(*ctx, buf, len);
+#endif
 }
 
 uint32_t crc32_finish(const uint32_t *ctx) { return *ctx ^ UINT32_MAX; }
@@ -5,7 +5,9 @@
 #include "sw/device/lib/base/crc32.h"
 
 #include <cstring>
+#include <random>
 #include <stdint.h>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -87,5 +89,43 @@ TEST_F(CrcTest, Crc32Add32) {
   EXPECT_EQ(crc32_finish(&ctx), kExpCrc);
 }
 
+// Bit-by-bit CRC32 without lookup tables, as a reference for buffers that are
+// long enough to exercise the word-parallel host kernels.
+uint32_t BitwiseCrc32(const uint8_t *buf, size_t len) {
+  uint32_t crc = UINT32_MAX;
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= buf[i];
+    for (size_t bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+    }
+  }
+  return crc ^ UINT32_MAX;
+}
+
+TEST_F(CrcTest, LongBuffers) {
+  std::mt19937 rng(1);
+  std::vector<uint8_t> buf(2048 + 16);
+  for (auto &byte : buf) {
+    byte = rng();
+  }
+
+  for (size_t offset = 0; offset < 16; ++offset) {
+    for (size_t len : {7, 8, 15, 16, 63, 64, 65, 127, 128, 200, 1000, 2048}) {
+      const uint8_t *data = &buf[offset];
+      const uint32_t exp_crc = BitwiseCrc32(data, len);
+      EXPECT_EQ(crc32(data, len), exp_crc)
+          << "offset " << offset << ", length " << len;
+
+      // Split the buffer at an odd position.
+      uint32_t ctx;
+      crc32_init(&ctx);
+      crc32_add(&ctx, data, len / 3);
+      crc32_add(&ctx, data + len / 3, len - len / 3);
+      EXPECT_EQ(crc32_finish(&ctx), exp_crc)
+          << "offset " << offset << ", length " << len;
+    }
+  }
+}
+
 }  // namespace
 }  // namespace crc32_unittest
@@ -58,6 +58,51 @@ static uint32_t repeat_byte_to_u32(uint8_t byte) {
   return word << 24 | word << 16 | word << 8 | word;
 }
 
+enum {
+  /**
+   * Number of words moved per iteration of the unrolled copy and set loops.
+   *
+   * Every loop iteration costs Ibex a taken branch and the index updates, so
+   * the loops over the word-aligned body handle this many words at once and
+   * only fall back to one word per iteration for the remainder.
+   */
+  kUnrollWords = 8,
+  kUnrollBytes = kUnrollWords * sizeof(uint32_t),
+  /**
+   * Number of words per iteration of the unrolled compare and shift-and-merge
+   * loops, which need more registers per word.
+   */
+  kShortUnrollWords = 4,
+  kShortUnrollBytes = kShortUnrollWords * sizeof(uint32_t),
+};
+
+/**
+ * Reads the bytes of `src8` from `offset` up to the next word boundary.
+ *
+ * This is the first half-word of the shift-and-merge loops, which copy or
+ * compare a buffer that is not aligned relative to the other one by reading
+ * it in whole aligned words and merging each two consecutive words into the
+ * word for the other buffer.
+ *
+ * @param src8 The misaligned buffer.
+ * @param offset Offset into `src8`, which must not be word-aligned.
+ * @param[out] out_shift The number of bits read, i.e. the shift with which the
+ *                       next aligned word has to be merged.
+ * @return The bytes read, in the least significant bits.
+ */
+static uint32_t read_partial_word(const unsigned char *src8, size_t offset,
+                                  uint32_t *out_shift) {
+  const size_t misalignment =
+      OT_UNSIGNED(misalignment32_of((uintptr_t)&src8[offset]));
+  const size_t num_bytes = sizeof(uint32_t) - misalignment;
+  uint32_t word = 0;
+  for (size_t i = 0; i < num_bytes; ++i) {
+    word |= (uint32_t)src8[offset + i] << (8 * i);
+  }
+  *out_shift = (uint32_t)(8 * num_bytes);
+  return word;
+}
+
 void *OT_PREFIX_IF_NOT_RV32(memcpy)(void *restrict dest,
                                     const void *restrict src, size_t len) {
   if (dest == NULL || src == NULL) {
@@ -65,15 +110,65 @@ void *OT_PREFIX_IF_NOT_RV32(memcpy)(void *restrict dest,
   }
   unsigned char *dest8 = (unsigned char *)dest;
   const unsigned char *src8 = (const unsigned char *)src;
+  // Only `dest` is aligned here; `src` may still be misaligned relative to it.
   size_t body_offset, tail_offset;
-  compute_alignment(dest, src, len, &body_offset, &tail_offset);
+  compute_alignment(dest, NULL, len, &body_offset, &tail_offset);
   size_t i = 0;
   for (; i < body_offset; ++i) {
     dest8[i] = src8[i];
   }
-  for (; i < tail_offset; i += sizeof(uint32_t)) {
-    uint32_t word = read_32(&src8[i]);
-    write_32(word, &dest8[i]);
+  static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+                "memcpy assumes that the system is little endian.");
+  if (misalignment32_of((uintptr_t)&src8[i]) == 0) {
+    for (; i + kUnrollBytes <= tail_offset; i += kUnrollBytes) {
+      // Issue all loads before the stores so that they can be pipelined.
+      const uint32_t word0 = read_32(&src8[i]);
+      const uint32_t word1 = read_32(&src8[i + 4]);
+      const uint32_t word2 = read_32(&src8[i + 8]);
+      const uint32_t word3 = read_32(&src8[i + 12]);
+      const uint32_t word4 = read_32(&src8[i + 16]);
+      const uint32_t word5 = read_32(&src8[i + 20]);
+      const uint32_t word6 = read_32(&src8[i + 24]);
+      const uint32_t word7 = read_32(&src8[i + 28]);
+      write_32(word0, &dest8[i]);
+      write_32(word1, &dest8[i + 4]);
+      write_32(word2, &dest8[i + 8]);
+      write_32(word3, &dest8[i + 12]);
+      write_32(word4, &dest8[i + 16]);
+      write_32(word5, &dest8[i + 20]);
+      write_32(word6, &dest8[i + 24]);
+      write_32(word7, &dest8[i + 28]);
+    }
+    for (; i < tail_offset; i += sizeof(uint32_t)) {
+      uint32_t word = read_32(&src8[i]);
+      write_32(word, &dest8[i]);
+    }
+  } else if (i + 2 * sizeof(uint32_t) <= len) {
+    // Each word of `dest` is made of the upper bytes of one aligned word of
+    // `src` and the lower bytes of the next one. `j` is the offset of the next
+    // aligned word of `src`, which must lie entirely within `src`.
+    uint32_t shift;
+    uint32_t carry = read_partial_word(src8, i, &shift);
+    const uint32_t carry_shift = 32 - shift;
+    size_t j = i + shift / 8;
+    for (; j + kShortUnrollBytes <= len;
+         i += kShortUnrollBytes, j += kShortUnrollBytes) {
+      const uint32_t word0 = read_32(&src8[j]);
+      const uint32_t word1 = read_32(&src8[j + 4]);
+      const uint32_t word2 = read_32(&src8[j + 8]);
+      const uint32_t word3 = read_32(&src8[j + 12]);
+      write_32(carry | word0 << shift, &dest8[i]);
+      write_32(word0 >> carry_shift | word1 << shift, &dest8[i + 4]);
+      write_32(word1 >> carry_shift | word2 << shift, &dest8[i + 8]);
+      write_32(word2 >> carry_shift | word3 << shift, &dest8[i + 12]);
+      carry = word3 >> carry_shift;
+    }
+    for (; j + sizeof(uint32_t) <= len;
+         i += sizeof(uint32_t), j += sizeof(uint32_t)) {
+      const uint32_t word = read_32(&src8[j]);
+      write_32(carry | word << shift, &dest8[i]);
+      carry = word >> carry_shift;
+    }
   }
   for (; i < len; ++i) {
     dest8[i] = src8[i];
@@ -92,6 +187,16 @@ void *OT_PREFIX_IF_NOT_RV32(memset)(void *dest, int value, size_t len) {
     dest8[i] = value8;
   }
   const uint32_t value32 = repeat_byte_to_u32(value8);
+  for (; i + kUnrollBytes <= tail_offset; i += kUnrollBytes) {
+    write_32(value32, &dest8[i]);
+    write_32(value32, &dest8[i + 4]);
+    write_32(value32, &dest8[i + 8]);
+    write_32(value32, &dest8[i + 12]);
+    write_32(value32, &dest8[i + 16]);
+    write_32(value32, &dest8[i + 20]);
+    write_32(value32, &dest8[i + 24]);
+    write_32(value32, &dest8[i + 28]);
+  }
   for (; i < tail_offset; i += sizeof(uint32_t)) {
     write_32(value32, &dest8[i]);
   }
@@ -107,12 +212,29 @@ enum {
   kMemCmpGt = 42,
 };
 
+/**
+ * Compares two words loaded from memory in byte-wise lexicographic order.
+ */
+static int compare_words(uint32_t word_left, uint32_t word_right) {
+  static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+                "memcmp assumes that the system is little endian.");
+  word_left = __builtin_bswap32(word_left);
+  word_right = __builtin_bswap32(word_right);
+  if (word_left < word_right) {
+    return kMemCmpLt;
+  } else if (word_left > word_right) {
+    return kMemCmpGt;
+  }
+  return kMemCmpEq;
+}
+
 int OT_PREFIX_IF_NOT_RV32(memcmp)(const void *lhs, const void *rhs,
                                   size_t len) {
   const unsigned char *lhs8 = (const unsigned char *)lhs;
   const unsigned char *rhs8 = (const unsigned char *)rhs;
+  // Only `lhs` is aligned here; `rhs` may still be misaligned relative to it.
   size_t body_offset, tail_offset;
-  compute_alignment(lhs, rhs, len, &body_offset, &tail_offset);
+  compute_alignment(lhs, NULL, len, &body_offset, &tail_offset);
   size_t i = 0;
   for (; i < body_offset; ++i) {
     if (lhs8[i] < rhs8[i]) {
@@ -121,19 +243,51 @@ int OT_PREFIX_IF_NOT_RV32(memcmp)(const void *lhs, const void *rhs,
       return kMemCmpGt;
     }
   }
-  for (; i < tail_offset; i += sizeof(uint32_t)) {
+  if (misalignment32_of((uintptr_t)&rhs8[i]) == 0) {
+    // Skip over equal blocks of words, leaving the word-wise loop below to
+    // find the first differing word of a block.
+    for (; i + kShortUnrollBytes <= tail_offset; i += kShortUnrollBytes) {
 #if OT_BUILD_FOR_STATIC_ANALYZER
-    assert(&lhs8[i] != NULL);
-    assert(&rhs8[i] != NULL);
+      assert(&lhs8[i] != NULL);
+      assert(&rhs8[i] != NULL);
 #endif
-    uint32_t word_left = __builtin_bswap32(read_32(&lhs8[i]));
-    uint32_t word_right = __builtin_bswap32(read_32(&rhs8[i]));
-    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
-                  "memcmp assumes that the system is little endian.");
-    if (word_left < word_right) {
-      return kMemCmpLt;
-    } else if (word_left > word_right) {
-      return kMemCmpGt;
+      const uint32_t diff = (read_32(&lhs8[i]) ^ read_32(&rhs8[i])) |
+                            (read_32(&lhs8[i + 4]) ^ read_32(&rhs8[i + 4])) |
+                            (read_32(&lhs8[i + 8]) ^ read_32(&rhs8[i + 8])) |
+                            (read_32(&lhs8[i + 12]) ^ read_32(&rhs8[i + 12]));
+      if (diff != 0) {
+        break;
+      }
+    }
+    for (; i < tail_offset; i += sizeof(uint32_t)) {
+#if OT_BUILD_FOR_STATIC_ANALYZER
+      assert(&lhs8[i] != NULL);
+      assert(&rhs8[i] != NULL);
+#endif
+      const int result = compare_words(read_32(&lhs8[i]), read_32(&rhs8[i]));
+      if (result != kMemCmpEq) {
+        return result;
+      }
+    }
+  } else if (i + 2 * sizeof(uint32_t) <= len) {
+    // Merge the words of `rhs` like the misaligned case of `memcpy()`.
+    uint32_t shift;
+    uint32_t carry = read_partial_word(rhs8, i, &shift);
+    const uint32_t carry_shift = 32 - shift;
+    size_t j = i + shift / 8;
+    for (; j + sizeof(uint32_t) <= len;
+         i += sizeof(uint32_t), j += sizeof(uint32_t)) {
+#if OT_BUILD_FOR_STATIC_ANALYZER
+      assert(&lhs8[i] != NULL);
+      assert(&rhs8[j] != NULL);
+#endif
+      const uint32_t word = read_32(&rhs8[j]);
+      const uint32_t word_right = carry | word << shift;
+      carry = word >> carry_shift;
+      const uint32_t word_left = read_32(&lhs8[i]);
+      if (word_left != word_right) {
+        return compare_words(word_left, word_right);
+      }
     }
   }
   for (; i < len; ++i) {
@@ -160,6 +314,21 @@ int memrcmp(const void *lhs, const void *rhs, size_t len) {
       return kMemCmpGt;
     }
   }
+  // Skip over equal blocks of words, as in `memcmp()`.
+  for (; end >= body_offset + kShortUnrollBytes; end -= kShortUnrollBytes) {
+    const size_t i = end - kShortUnrollBytes;
+#if OT_BUILD_FOR_STATIC_ANALYZER
+    assert(&lhs8[i] != NULL);
+    assert(&rhs8[i] != NULL);
+#endif
+    const uint32_t diff = (read_32(&lhs8[i]) ^ read_32(&rhs8[i])) |
+                          (read_32(&lhs8[i + 4]) ^ read_32(&rhs8[i + 4])) |
+                          (read_32(&lhs8[i + 8]) ^ read_32(&rhs8[i + 8])) |
+                          (read_32(&lhs8[i + 12]) ^ read_32(&rhs8[i + 12]));
+    if (diff != 0) {
+      break;
+    }
+  }
   for (; end > body_offset; end -= sizeof(uint32_t)) {
     const size_t i = end - sizeof(uint32_t);
 #if OT_BUILD_FOR_STATIC_ANALYZER
@@ -2,6 +2,7 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 
+#include <stdalign.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -142,62 +143,68 @@ OTTF_DEFINE_TEST_CONFIG();
 //
 // If you observe the cycle count is smaller the hardcoded expectation, that's
 // probably a good thing; consider updating the expectation!
+//
+// The memcpy, memset, memcmp and memrcmp limits have not been measured for
+// their unrolled implementations yet. Like the limits of `kSweepTests` below,
+// they are derived from the instruction counts of the new loops, and sit
+// between those and the measurements of the previous, one word per iteration
+// loops, so that reverting the unrolling fails the test.
 static const perf_test_t kPerfTests[] = {
     {
         .label = "memcpy",
         .setup_buf1 = &fill_buf_deterministic_values,
         .setup_buf2 = &fill_buf_deterministic_values,
         .func = &test_memcpy,
-        .expected_max_num_cycles = 33270,
+        .expected_max_num_cycles = 20000,
     },
     {
         .label = "memcpy_zeroes",
         .setup_buf1 = &fill_buf_deterministic_values,
         .setup_buf2 = &fill_buf_zeroes,
         .func = &test_memcpy,
-        .expected_max_num_cycles = 33270,
+        .expected_max_num_cycles = 20000,
     },
     {
         .label = "memset",
         .setup_buf1 = &fill_buf_zeroes,
         .setup_buf2 = &fill_buf_deterministic_values,
         .func = &test_memset,
-        .expected_max_num_cycles = 23200,
+        .expected_max_num_cycles = 14000,
     },
     {
         .label = "memset_zeroes",
         .setup_buf1 = &fill_buf_zeroes,
         .setup_buf2 = &fill_buf_zeroes,
         .func = &test_memset,
-        .expected_max_num_cycles = 23200,
+        .expected_max_num_cycles = 14000,
     },
     {
         .label = "memcmp_pathological",
         .setup_buf1 = &fill_buf_zeroes_then_one,
         .setup_buf2 = &fill_buf_zeroes,
         .func = &test_memcmp,
-        .expected_max_num_cycles = 110740,
+        .expected_max_num_cycles = 40000,
     },
     {
         .label = "memcmp_zeroes",
         .setup_buf1 = &fill_buf_zeroes,
         .setup_buf2 = &fill_buf_zeroes,
         .func = &test_memcmp,
-        .expected_max_num_cycles = 110740,
+        .expected_max_num_cycles = 40000,
     },
     {
         .label = "memrcmp_pathological",
         .setup_buf1 = &fill_buf_zeroes,
         .setup_buf2 = &fill_buf_one_then_zeroes,
         .func = &test_memrcmp,
-        .expected_max_num_cycles = 50740,
+        .expected_max_num_cycles = 40000,
     },
     {
         .label = "memrcmp_zeroes",
         .setup_buf1 = &fill_buf_zeroes,
         .setup_buf2 = &fill_buf_zeroes,
         .func = &test_memrcmp,
-        .expected_max_num_cycles = 50850,
+        .expected_max_num_cycles = 40000,
     },
     {
         .label = "memchr_pathological",
@@ -215,8 +222,159 @@ static const perf_test_t kPerfTests[] = {
     },
 };
 
-static uint8_t buf1[kBufLen];
-static uint8_t buf2[kBufLen];
+static alignas(uint32_t) uint8_t buf1[kBufLen];
+static alignas(uint32_t) uint8_t buf2[kBufLen];
+
+enum {
+  /**
+   * Largest buffer size of the sweep below.
+   *
+   * Two buffers of this size, plus room for their offsets, must fit into main
+   * SRAM next to the OTTF, which leaves no room for 64 KiB buffers.
+   */
+  kSweepMaxLen = 16384,
+  kSweepBufLen = kSweepMaxLen + sizeof(uint32_t),
+  kSweepNumRuns = 2,
+  kSweepNumLens = 7,
+  kSweepNumOffsets = 4,
+};
+
+typedef struct sweep_test {
+  // A human-readable name for this particular test, e.g. "memcpy".
+  const char *label;
+
+  // Setup functions as in `perf_test_t`.
+  void (*setup_buf1)(uint8_t *, size_t);
+  void (*setup_buf2)(uint8_t *, size_t);
+
+  // The function under test, as in `perf_test_t`.
+  void (*func)(uint8_t *buf1, uint8_t *buf2, size_t len);
+
+  // The maximum average number of CPU cycles per call, for each entry of
+  // `kSweepOffsets` and `kSweepLens`.
+  uint32_t max_num_cycles[kSweepNumOffsets][kSweepNumLens];
+} sweep_test_t;
+
+// Buffer sizes of the sweep, in bytes.
+static const size_t kSweepLens[kSweepNumLens] = {
+    4, 16, 64, 256, 1024, 4096, kSweepMaxLen};
+
+// Offsets of the sweep's buffers from a word-aligned address: aligned,
+// misaligned by the same amount, and misaligned relative to each other.
+static const size_t kSweepOffsets[kSweepNumOffsets][2] = {
+    {0, 0}, {3, 3}, {0, 1}, {2, 1}};
+
+// Like the limits of `kPerfTests` for the unrolled functions, these are
+// derived from the instruction counts of the kernels at about 2.5 cycles per
+// instruction, plus a fixed cost for the call and the unaligned head and tail.
+// Per KiB, that is 1800 cycles for memcpy (3000 if the buffers are misaligned
+// relative to each other), 1200 for memset, and 3600 for memcmp and memrcmp
+// (6500 and 20000 if misaligned; memrcmp compares those byte by byte). A
+// revert to one word, or for misaligned buffers one byte, per iteration
+// exceeds them. Consider tightening them after measuring.
+static const sweep_test_t kSweepTests[] = {
+    {
+        .label = "memcpy",
+        .setup_buf1 = &fill_buf_zeroes,
+        .setup_buf2 = &fill_buf_deterministic_values,
+        .func = &test_memcpy,
+        .max_num_cycles =
+            {
+                {260, 280, 370, 700, 2050, 7450, 29050},
+                {260, 280, 370, 700, 2050, 7450, 29050},
+                {270, 300, 440, 1000, 3250, 12250, 48250},
+                {270, 300, 440, 1000, 3250, 12250, 48250},
+            },
+    },
+    {
+        .label = "memset",
+        .setup_buf1 = &fill_buf_zeroes,
+        .setup_buf2 = &fill_buf_deterministic_values,
+        .func = &test_memset,
+        .max_num_cycles =
+            {
+                {210, 220, 280, 500, 1400, 5000, 19400},
+                {210, 220, 280, 500, 1400, 5000, 19400},
+                {210, 220, 280, 500, 1400, 5000, 19400},
+                {210, 220, 280, 500, 1400, 5000, 19400},
+            },
+    },
+    {
+        .label = "memcmp_zeroes",
+        .setup_buf1 = &fill_buf_zeroes,
+        .setup_buf2 = &fill_buf_zeroes,
+        .func = &test_memcmp,
+        .max_num_cycles =
+            {
+                {270, 310, 480, 1150, 3850, 14650, 57850},
+                {270, 310, 480, 1150, 3850, 14650, 57850},
+                {280, 360, 660, 1880, 6750, 26250, 104250},
+                {280, 360, 660, 1880, 6750, 26250, 104250},
+            },
+    },
+    {
+        .label = "memrcmp_zeroes",
+        .setup_buf1 = &fill_buf_zeroes,
+        .setup_buf2 = &fill_buf_zeroes,
+        .func = &test_memrcmp,
+        .max_num_cycles =
+            {
+                {270, 310, 480, 1150, 3850, 14650, 57850},
+                {270, 310, 480, 1150, 3850, 14650, 57850},
+                {330, 570, 1500, 5250, 20250, 80250, 320250},
+                {330, 570, 1500, 5250, 20250, 80250, 320250},
+            },
+    },
+};
+
+static alignas(uint32_t) uint8_t sweep_buf1[kSweepBufLen];
+static alignas(uint32_t) uint8_t sweep_buf2[kSweepBufLen];
+
+// Run the given `sweep_test_t` for every buffer size and offset, and return
+// whether all of them stayed within their limit.
+static bool sweep_test_run(const sweep_test_t *test) {
+  CHECK(test->setup_buf1 != NULL);
+  CHECK(test->setup_buf2 != NULL);
+  CHECK(test->func != NULL);
+
+  bool all_expectations_match = true;
+  for (size_t i = 0; i < ARRAYSIZE(kSweepOffsets); ++i) {
+    const size_t offset1 = kSweepOffsets[i][0];
+    const size_t offset2 = kSweepOffsets[i][1];
+
+    for (size_t j = 0; j < ARRAYSIZE(kSweepLens); ++j) {
+      const size_t len = kSweepLens[j];
+      uint64_t num_cycles = 0;
+      for (size_t run = 0; run < kSweepNumRuns; ++run) {
+        test->setup_buf1(&sweep_buf1[offset1], len);
+        test->setup_buf2(&sweep_buf2[offset2], len);
+
+        uint64_t start_cycles = ibex_mcycle_read();
+        test->func(&sweep_buf1[offset1], &sweep_buf2[offset2], len);
+        uint64_t end_cycles = ibex_mcycle_read();
+        num_cycles += end_cycles - start_cycles;
+      }
+
+      CHECK(num_cycles < UINT32_MAX);
+      const uint32_t avg_num_cycles = (uint32_t)(num_cycles / kSweepNumRuns);
+      const uint32_t expected_max_num_cycles = test->max_num_cycles[i][j];
+      if (avg_num_cycles > expected_max_num_cycles) {
+        all_expectations_match = false;
+        LOG_WARNING(
+            "%s (%d bytes, offsets %d/%d):\n"
+            "  Expected:        %10d cycles\n"
+            "  Actual:          %10d cycles\n",
+            test->label, (uint32_t)len, (uint32_t)offset1, (uint32_t)offset2,
+            expected_max_num_cycles, avg_num_cycles);
+      } else {
+        LOG_INFO("%s (%d bytes, offsets %d/%d): %d cycles", test->label,
+                 (uint32_t)len, (uint32_t)offset1, (uint32_t)offset2,
+                 avg_num_cycles);
+      }
+    }
+  }
+  return all_expectations_match;
+}
 
 bool test_main(void) {
   bool all_expectations_match = true;
@@ -247,5 +405,10 @@ bool test_main(void) {
           percent_change);
     }
   }
+  for (size_t i = 0; i < ARRAYSIZE(kSweepTests); ++i) {
+    if (!sweep_test_run(&kSweepTests[i])) {
+      all_expectations_match = false;
+    }
+  }
   return all_expectations_match;
 }
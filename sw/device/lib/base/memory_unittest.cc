@@ -98,6 +98,7 @@ INSTANTIATE_TEST_SUITE_P(MemChr, MemChrTest,
 
 using ::testing::Each;
 using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
 
 TEST_P(MemCpyTest, Simple) {
   auto memcpy_func = GetParam();
@@ -193,6 +194,32 @@ TEST_P(MemCpyTest, VaryDestAlignment) {
   }
 }
 
+TEST_P(MemCpyTest, VaryRelativeAlignment) {
+  auto memcpy_func = GetParam();
+
+  alignas(uint32_t) uint8_t src[128];
+  for (size_t i = 0; i < sizeof(src); ++i) {
+    src[i] = static_cast<uint8_t>(i * 7 + 1);
+  }
+
+  for (size_t dest_offset = 0; dest_offset < 8; ++dest_offset) {
+    for (size_t src_offset = 0; src_offset < 8; ++src_offset) {
+      for (size_t len = 0; len <= 100; ++len) {
+        SCOPED_TRACE(testing::Message()
+                     << "dest_offset=" << dest_offset
+                     << ", src_offset=" << src_offset << ", len=" << len);
+
+        alignas(uint32_t) uint8_t dest[128] = {0};
+        memcpy_func(&dest[dest_offset], &src[src_offset], len);
+
+        std::vector<uint8_t> expected(sizeof(dest), 0);
+        std::copy_n(&src[src_offset], len, &expected[dest_offset]);
+        EXPECT_THAT(dest, ElementsAreArray(expected));
+      }
+    }
+  }
+}
+
 TEST_P(MemCmpTest, NullParam) {
   auto memcmp_func = GetParam();
 
@@ -264,6 +291,37 @@ TEST_P(MemCmpTest, DoesNotUseSystemEndianness) {
   }
 }
 
+TEST_P(MemCmpTest, DifferenceAtEachPosition) {
+  auto memcmp_func = GetParam();
+
+  alignas(uint32_t) uint8_t lhs[80];
+  alignas(uint32_t) uint8_t rhs[80];
+  constexpr size_t kLen = 64;
+
+  for (size_t lhs_offset = 0; lhs_offset < 4; ++lhs_offset) {
+    for (size_t rhs_offset = 0; rhs_offset < 4; ++rhs_offset) {
+      for (size_t pos = 0; pos < kLen; ++pos) {
+        SCOPED_TRACE(testing::Message()
+                     << "lhs_offset=" << lhs_offset
+                     << ", rhs_offset=" << rhs_offset << ", pos=" << pos);
+
+        // Use distinct bytes so that a word-wise comparison in the wrong byte
+        // order would give the wrong result.
+        for (size_t i = 0; i < kLen; ++i) {
+          lhs[lhs_offset + i] = static_cast<uint8_t>(i + 16);
+          rhs[rhs_offset + i] = static_cast<uint8_t>(i + 16);
+        }
+        EXPECT_EQ(memcmp_func(&lhs[lhs_offset], &rhs[rhs_offset], kLen), 0);
+
+        lhs[lhs_offset + pos] = 0xff;
+        EXPECT_GT(memcmp_func(&lhs[lhs_offset], &rhs[rhs_offset], kLen), 0);
+        EXPECT_LT(memcmp_func(&rhs[rhs_offset], &lhs[lhs_offset], kLen), 0);
+        EXPECT_EQ(memcmp_func(&lhs[lhs_offset], &rhs[rhs_offset], pos), 0);
+      }
+    }
+  }
+}
+
 TEST_P(MemSetTest, Simple) {
   auto memset_func = GetParam();
 
@@ -246,6 +246,44 @@ status_t aes_decrypt_begin(const aes_key_t key, const aes_block_t *iv) {
   return aes_begin(key, iv, kHardenedBoolFalse);
 }
 
+/**
+ * Writes one block of input to the AES hardware.
+ *
+ * Waits until the hardware is ready to accept input.
+ *
+ * @param src Input block; need not be word-aligned.
+ * @return result, OK or error.
+ */
+static status_t aes_write_input(const uint8_t *src) {
+  HARDENED_TRY(spin_until(AES_STATUS_INPUT_READY_BIT));
+
+  uint32_t offset = kBase + AES_DATA_IN_0_REG_OFFSET;
+  for (size_t i = 0; i < kAesBlockNumWords; ++i) {
+    abs_mmio_write32(offset + i * sizeof(uint32_t),
+                     read_32(src + i * sizeof(uint32_t)));
+  }
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Reads one block of output from the AES hardware.
+ *
+ * Waits until the hardware has valid output.
+ *
+ * @param[out] dest Output block; need not be word-aligned.
+ * @return result, OK or error.
+ */
+static status_t aes_read_output(uint8_t *dest) {
+  HARDENED_TRY(spin_until(AES_STATUS_OUTPUT_VALID_BIT));
+
+  uint32_t offset = kBase + AES_DATA_OUT_0_REG_OFFSET;
+  for (size_t i = 0; i < kAesBlockNumWords; ++i) {
+    write_32(abs_mmio_read32(offset + i * sizeof(uint32_t)),
+             dest + i * sizeof(uint32_t));
+  }
+  return OTCRYPTO_OK;
+}
+
 status_t aes_update(aes_block_t *dest, const aes_block_t *src) {
   if (dest != NULL) {
     // Check that either the output is valid or AES is busy, to avoid spinning
@@ -256,27 +294,40 @@ status_t aes_update(aes_block_t *dest, const aes_block_t *src) {
         !bitfield_bit32_read(reg, AES_STATUS_OUTPUT_VALID_BIT)) {
       return OTCRYPTO_RECOV_ERR;
     }
-
-    HARDENED_TRY(spin_until(AES_STATUS_OUTPUT_VALID_BIT));
-
-    uint32_t offset = kBase + AES_DATA_OUT_0_REG_OFFSET;
-    for (size_t i = 0; i < ARRAYSIZE(dest->data); ++i) {
-      dest->data[i] = abs_mmio_read32(offset + i * sizeof(uint32_t));
-    }
   }
 
+  // Write the new input before reading the pending output. The hardware
+  // accepts the input as soon as it has started on the previous block, and
+  // starts on the new one as soon as the previous output is read.
   if (src != NULL) {
-    HARDENED_TRY(spin_until(AES_STATUS_INPUT_READY_BIT));
+    HARDENED_TRY(aes_write_input((const uint8_t *)src->data));
+  }
 
-    uint32_t offset = kBase + AES_DATA_IN_0_REG_OFFSET;
-    for (size_t i = 0; i < ARRAYSIZE(src->data); ++i) {
-      abs_mmio_write32(offset + i * sizeof(uint32_t), src->data[i]);
-    }
+  if (dest != NULL) {
+    HARDENED_TRY(aes_read_output((uint8_t *)dest->data));
   }
 
   return OTCRYPTO_OK;
 }
 
+status_t aes_update_blocks(uint8_t *dest, const uint8_t *src,
+                           size_t num_blocks) {
+  if (num_blocks == 0) {
+    return OTCRYPTO_OK;
+  }
+
+  // Keep one block in flight: write input i + 1 while block i is processed,
+  // then read output i.
+  HARDENED_TRY(aes_write_input(src));
+  size_t i = 1;
+  for (; launder32(i) < num_blocks; ++i) {
+    HARDENED_TRY(aes_write_input(src + i * kAesBlockNumBytes));
+    HARDENED_TRY(aes_read_output(dest + (i - 1) * kAesBlockNumBytes));
+  }
+  HARDENED_CHECK_EQ(i, num_blocks);
+  return aes_read_output(dest + (num_blocks - 1) * kAesBlockNumBytes);
+}
+
 status_t aes_end(aes_block_t *iv) {
   uint32_t ctrl_reg = AES_CTRL_SHADOWED_REG_RESVAL;
   ctrl_reg = bitfield_bit32_write(ctrl_reg,
@@ -122,6 +122,9 @@ status_t aes_decrypt_begin(const aes_key_t key, const aes_block_t *iv);
  * 2. The contents of `dest` are filled with the hardware's output (again,
  *    unless it is null). `dest` may overlap with `src`.
  *
+ * Because the input is written before the output is read, the hardware works
+ * on the new block while software handles the previous one.
+ *
  * Operation of the driver will look something like this:
  * ```
  * aes_encrypt_begin(...);
@@ -140,6 +143,34 @@ status_t aes_decrypt_begin(const aes_key_t key, const aes_block_t *iv);
 OT_WARN_UNUSED_RESULT
 status_t aes_update(aes_block_t *dest, const aes_block_t *src);
 
+/**
+ * Runs several consecutive blocks through the AES hardware.
+ *
+ * Equivalent to:
+ * ```
+ * aes_update(NULL, src[0]);
+ * aes_update(dest[0], src[1]);
+ * // ...
+ * aes_update(dest[num_blocks - 2], src[num_blocks - 1]);
+ * aes_update(dest[num_blocks - 1], NULL);
+ * ```
+ * so the hardware processes one block while software writes the next input
+ * and reads the previous output. No output may be pending when this function
+ * is called, and none is pending afterwards; it can be called several times
+ * between `aes_*_begin` and `aes_end`.
+ *
+ * The buffers need not be word-aligned. `dest` may be equal to `src`, but the
+ * buffers may not otherwise overlap.
+ *
+ * @param[out] dest Output buffer, `num_blocks` blocks.
+ * @param src Input buffer, `num_blocks` blocks.
+ * @param num_blocks Number of blocks to process.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t aes_update_blocks(uint8_t *dest, const uint8_t *src,
+                           size_t num_blocks);
+
 /**
  * Completes an AES session by clearing control settings and key material.
  *
@@ -0,0 +1,105 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/crypto/drivers/aes.h"
+#include "sw/device/lib/crypto/drivers/entropy.h"
+#include "sw/device/lib/crypto/impl/status.h"
+#include "sw/device/lib/runtime/ibex.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+OTTF_DEFINE_TEST_CONFIG();
+
+enum {
+  kNumBlocks = 256,
+  kNumBytes = kNumBlocks * kAesBlockNumBytes,
+};
+
+static const uint32_t kKeyShare0[8] = {
+    0x16157e2b, 0xa6d2ae28, 0x8815f7ab, 0x3c4fcf09,
+    0x16157e2b, 0xa6d2ae28, 0x8815f7ab, 0x3c4fcf09,
+};
+static const uint32_t kKeyShare1[8] = {0};
+
+static const aes_block_t kIv = {
+    .data = {0xf3f2f1f0, 0xf7f6f5f4, 0xfbfaf9f8, 0xfffefdfc},
+};
+
+static uint8_t input[kNumBytes];
+static uint8_t output_serial[kNumBytes];
+static uint8_t output_pipelined[kNumBytes];
+
+/**
+ * Processes `input` one block at a time, waiting for each output block before
+ * writing the next input.
+ */
+static status_t run_serial(aes_key_t key, uint32_t *cycles) {
+  uint64_t start_cycles = ibex_mcycle_read();
+  TRY(aes_encrypt_begin(key, &kIv));
+  for (size_t i = 0; i < kNumBlocks; ++i) {
+    aes_block_t block;
+    memcpy(block.data, &input[i * kAesBlockNumBytes], kAesBlockNumBytes);
+    TRY(aes_update(/*dest=*/NULL, &block));
+    TRY(aes_update(&block, /*src=*/NULL));
+    memcpy(&output_serial[i * kAesBlockNumBytes], block.data,
+           kAesBlockNumBytes);
+  }
+  TRY(aes_end(NULL));
+  *cycles = (uint32_t)(ibex_mcycle_read() - start_cycles);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Processes `input` with the pipelined multi-block update.
+ */
+static status_t run_pipelined(aes_key_t key, uint32_t *cycles) {
+  uint64_t start_cycles = ibex_mcycle_read();
+  TRY(aes_encrypt_begin(key, &kIv));
+  TRY(aes_update_blocks(output_pipelined, input, kNumBlocks));
+  TRY(aes_end(NULL));
+  *cycles = (uint32_t)(ibex_mcycle_read() - start_cycles);
+  return OTCRYPTO_OK;
+}
+
+static status_t run_mode(aes_cipher_mode_t mode, const char *name) {
+  aes_key_t key = {
+      .mode = mode,
+      .sideload = kHardenedBoolFalse,
+      .key_len = ARRAYSIZE(kKeyShare0),
+      .key_shares = {kKeyShare0, kKeyShare1},
+  };
+
+  uint32_t serial_cycles;
+  uint32_t pipelined_cycles;
+  TRY(run_serial(key, &serial_cycles));
+  TRY(run_pipelined(key, &pipelined_cycles));
+  CHECK_ARRAYS_EQ(output_pipelined, output_serial, kNumBytes);
+
+  // Log hundredths of a cycle per byte, since LOG_INFO has no floats.
+  LOG_INFO("AES-256-%s, %d bytes: serial %d.%02d cycles/byte, "
+           "pipelined %d.%02d cycles/byte.",
+           name, kNumBytes, serial_cycles / kNumBytes,
+           (serial_cycles * 100 / kNumBytes) % 100,
+           pipelined_cycles / kNumBytes,
+           (pipelined_cycles * 100 / kNumBytes) % 100);
+  return OTCRYPTO_OK;
+}
+
+bool test_main(void) {
+  CHECK_STATUS_OK(entropy_complex_init());
+  for (size_t i = 0; i < ARRAYSIZE(input); ++i) {
+    input[i] = i & UINT8_MAX;
+  }
+
+  CHECK_STATUS_OK(run_mode(kAesCipherModeEcb, "ECB"));
+  CHECK_STATUS_OK(run_mode(kAesCipherModeCbc, "CBC"));
+  CHECK_STATUS_OK(run_mode(kAesCipherModeCtr, "CTR"));
+  return true;
+}
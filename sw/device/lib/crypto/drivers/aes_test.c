@@ -111,11 +111,40 @@ static status_t run_aes_test(void) {
   return OTCRYPTO_OK;
 }
 
+static status_t run_aes_blocks_test(void) {
+  const uint32_t share0[8] = {kSecretKey[0], kSecretKey[1], kSecretKey[2],
+                              kSecretKey[3], 0, 0, 0, 0};
+  const uint32_t share1[8] = {0};
+  aes_key_t key = {
+      .mode = kAesCipherModeCtr,
+      .sideload = kHardenedBoolFalse,
+      .key_len = 4,
+      .key_shares = {share0, share1},
+  };
+
+  // Run the first block on its own and the rest in one call, in place, to
+  // check that calls can be chained within one operation.
+  aes_block_t blocks[ARRAYSIZE(kPlaintext)];
+  memcpy(blocks, kPlaintext, sizeof(blocks));
+  TRY(aes_encrypt_begin(key, &kIv));
+  TRY(aes_update_blocks((uint8_t *)blocks, (const uint8_t *)blocks, 1));
+  TRY(aes_update_blocks((uint8_t *)&blocks[1], (const uint8_t *)&blocks[1],
+                        ARRAYSIZE(blocks) - 1));
+  aes_block_t final_iv;
+  TRY(aes_end(&final_iv));
+
+  CHECK_ARRAYS_EQ((uint32_t *)blocks, (uint32_t *)kCiphertext,
+                  sizeof(blocks) / (sizeof(uint32_t)));
+  CHECK_ARRAYS_EQ(final_iv.data, kFinalIv.data, kAesBlockNumWords);
+  return OTCRYPTO_OK;
+}
+
 OTTF_DEFINE_TEST_CONFIG();
 
 bool test_main(void) {
   CHECK_STATUS_OK(entropy_complex_init());
   CHECK_STATUS_OK(run_aes_test());
+  CHECK_STATUS_OK(run_aes_blocks_test());
 
   return true;
 }
@@ -36,6 +36,11 @@ enum {
   kEntropyCsrngBitsBufferNumWords = 4,
 };
 
+/**
+ * Current SW CSRNG seed epoch; see `entropy_csrng_seed_epoch`.
+ */
+static uint32_t csrng_seed_epoch = 0;
+
 /**
  * Supported CSRNG application commands.
  * See https://docs.opentitan.org/hw/ip/csrng/doc/#command-header for
@@ -827,6 +832,7 @@ static status_t edn_check(const edn_config_t *config) {
 
 status_t entropy_complex_init(void) {
   entropy_complex_stop_all();
+  csrng_seed_epoch++;
 
   const entropy_complex_config_t *config =
       &kEntropyComplexConfigs[kEntropyComplexConfigIdContinuous];
@@ -856,6 +862,7 @@ status_t entropy_complex_check(void) {
 status_t entropy_csrng_instantiate(
     hardened_bool_t disable_trng_input,
     const entropy_seed_material_t *seed_material) {
+  csrng_seed_epoch++;
   return csrng_send_app_cmd(kBaseCsrng,
                             (entropy_csrng_cmd_t){
                                 .id = kEntropyDrbgOpInstantiate,
@@ -868,6 +875,7 @@ status_t entropy_csrng_instantiate(
 
 status_t entropy_csrng_reseed(hardened_bool_t disable_trng_input,
                               const entropy_seed_material_t *seed_material) {
+  csrng_seed_epoch++;
   return csrng_send_app_cmd(kBaseCsrng,
                             (entropy_csrng_cmd_t){
                                 .id = kEntropyDrbgOpReseed,
@@ -948,6 +956,7 @@ status_t entropy_csrng_generate(const entropy_seed_material_t *seed_material,
 }
 
 status_t entropy_csrng_uninstantiate(void) {
+  csrng_seed_epoch++;
   return csrng_send_app_cmd(kBaseCsrng,
                             (entropy_csrng_cmd_t){
                                 .id = kEntropyDrbgOpUninstantiate,
@@ -956,3 +965,5 @@ status_t entropy_csrng_uninstantiate(void) {
                             },
                             kEntropyCsrngSendAppCmdTypeCsrng, true);
 }
+
+uint32_t entropy_csrng_seed_epoch(void) { return csrng_seed_epoch; }
@@ -217,6 +217,18 @@ status_t entropy_csrng_generate(const entropy_seed_material_t *seed_material,
 OT_WARN_UNUSED_RESULT
 status_t entropy_csrng_uninstantiate(void);
 
+/**
+ * Get a counter that changes whenever the SW CSRNG gets a new seed.
+ *
+ * The counter advances on every instantiate, reseed or uninstantiate command
+ * sent to the SW CSRNG, and when the entropy complex is reconfigured. Callers
+ * that buffer SW CSRNG output can compare values to detect output generated
+ * before the current seed.
+ *
+ * @return Current seed epoch.
+ */
+uint32_t entropy_csrng_seed_epoch(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,6 +8,7 @@
 #include "sw/device/lib/base/bitfield.h"
 #include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/crypto/drivers/entropy.h"
+#include "sw/device/lib/crypto/drivers/kmac.h"
 #include "sw/device/lib/crypto/impl/status.h"
 #include "sw/device/lib/runtime/hart.h"
 
@@ -139,7 +140,9 @@ static status_t keymgr_wait_until_done(void) {
 status_t keymgr_generate_key_sw(keymgr_diversification_t diversification,
                                 keymgr_output_t *key) {
   // Ensure that the entropy complex has been initialized and keymgr is idle.
+  // Keymgr also needs the KMAC block, which a stream may hold.
   HARDENED_TRY(entropy_complex_check());
+  HARDENED_TRY(kmac_stream_check_inactive());
   HARDENED_TRY(keymgr_is_idle());
 
   // Set the control register to generate a software-visible key.
@@ -167,7 +170,9 @@ status_t keymgr_generate_key_sw(keymgr_diversification_t diversification,
 
 status_t keymgr_generate_key_aes(keymgr_diversification_t diversification) {
   // Ensure that the entropy complex has been initialized and keymgr is idle.
+  // Keymgr also needs the KMAC block, which a stream may hold.
   HARDENED_TRY(entropy_complex_check());
+  HARDENED_TRY(kmac_stream_check_inactive());
   HARDENED_TRY(keymgr_is_idle());
 
   // Set the control register to generate an AES key.
@@ -180,7 +185,9 @@ status_t keymgr_generate_key_aes(keymgr_diversification_t diversification) {
 
 status_t keymgr_generate_key_kmac(keymgr_diversification_t diversification) {
   // Ensure that the entropy complex has been initialized and keymgr is idle.
+  // Keymgr also needs the KMAC block, which a stream may hold.
   HARDENED_TRY(entropy_complex_check());
+  HARDENED_TRY(kmac_stream_check_inactive());
   HARDENED_TRY(keymgr_is_idle());
 
   // Set the control register to generate a KMAC key.
@@ -193,7 +200,9 @@ status_t keymgr_generate_key_kmac(keymgr_diversification_t diversification) {
 
 status_t keymgr_generate_key_otbn(keymgr_diversification_t diversification) {
   // Ensure that the entropy complex has been initialized and keymgr is idle.
+  // Keymgr also needs the KMAC block, which a stream may hold.
   HARDENED_TRY(entropy_complex_check());
+  HARDENED_TRY(kmac_stream_check_inactive());
   HARDENED_TRY(keymgr_is_idle());
 
   // Set the control register to generate an OTBN key.
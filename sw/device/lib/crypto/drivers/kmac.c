@@ -152,6 +152,16 @@ OT_ASSERT_ENUM_VALUE(ARRAYSIZE(prefix_offsets), KMAC_PREFIX_MULTIREG_COUNT);
 // Ensure each PREFIX register is 4 bytes
 OT_ASSERT_ENUM_VALUE(32, KMAC_PREFIX_PREFIX_FIELD_WIDTH);
 
+/**
+ * ID of the stream that holds the KMAC block, or 0 if there is none.
+ */
+static uint32_t active_stream_id = 0;
+
+/**
+ * Last ID handed out to a stream.
+ */
+static uint32_t last_stream_id = 0;
+
 /**
  * Return the rate (in bytes) for given security strength.
  *
@@ -467,6 +477,8 @@ static status_t kmac_set_prefix_regs(const unsigned char *func_name,
  * `kHardenedBoolFalse` or `kHardenedBoolTrue`. It is recommended to set it to
  * `kHardenedBoolFalse` for consistency.
  *
+ * Returns `OTCRYPTO_RECOV_ERR` while a stream holds the KMAC block.
+ *
  * @param operation The chosen operation, see kmac_operation_t struct.
  * @param security_str Security strength for KMAC (128 or 256).
  * @param hw_backed Whether the key comes from the sideload port.
@@ -476,6 +488,11 @@ OT_WARN_UNUSED_RESULT
 static status_t kmac_init(kmac_operation_t operation,
                           kmac_security_str_t security_str,
                           hardened_bool_t hw_backed) {
+  // The Keccak state of a stream cannot be saved, so the block stays reserved
+  // until the stream ends.
+  if (launder32(active_stream_id) != 0) {
+    return OTCRYPTO_RECOV_ERR;
+  }
   HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_IDLE_BIT, 1));
 
   // If the operation is KMAC, ensure that the entropy complex has been
@@ -580,59 +597,96 @@ static status_t kmac_write_key_block(kmac_blinded_key_t *key) {
 }
 
 /**
- * Common routine for feeding message blocks during SHA/SHAKE/cSHAKE/KMAC.
+ * Issue a command to the KMAC block.
  *
- * Before running this, the operation type must be configured with kmac_init.
- * Then, we can use this function to feed various bytes of data to the KMAC
- * core. Note that this is a one-shot implementation, and it does not support
- * streaming mode.
- *
- * This routine does not check input parameters for consistency. For instance,
- * one can invoke SHA-3_224 with digest_len=32, which will produce 256 bits of
- * digest. The caller is responsible for ensuring that the digest length and
- * mode are consistent.
+ * @param cmd Value of the `CMD.cmd` field.
+ */
+static void kmac_issue_command(uint32_t cmd) {
+  uint32_t cmd_reg = KMAC_CMD_REG_RESVAL;
+  cmd_reg = bitfield_field32_write(cmd_reg, KMAC_CMD_CMD_FIELD, cmd);
+  abs_mmio_write32(kKmacBaseAddr + KMAC_CMD_REG_OFFSET, cmd_reg);
+}
+
+/**
+ * Issue the start command and wait until the KMAC block absorbs messages.
  *
- * The caller must ensure that `message_len` bytes (rounded up to the next 32b
- * word) are allocated at the location pointed to by `message`, and similarly
- * that `digest_len_words` 32-bit words are allocated at the location pointed
- * to by `digest`.
+ * Before running this, the operation type must be configured with kmac_init.
  *
- * @param operation The operation type.
- * @param message Input message string.
- * @param message_len Message length in bytes.
- * @param digest The struct to which the result will be written.
- * @param digest_len_words Requested digest length in 32-bit words.
  * @return Error code.
  */
 OT_WARN_UNUSED_RESULT
-static status_t kmac_process_msg_blocks(kmac_operation_t operation,
-                                        const uint8_t *message,
-                                        size_t message_len, uint32_t *digest,
-                                        size_t digest_len_words) {
+static status_t kmac_start(void) {
   // Block until KMAC is idle.
   HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_IDLE_BIT, 1));
 
   // Issue the start command, so that messages written to MSG_FIFO are forwarded
   // to Keccak
-  uint32_t cmd_reg = KMAC_CMD_REG_RESVAL;
-  cmd_reg = bitfield_field32_write(cmd_reg, KMAC_CMD_CMD_FIELD,
-                                   KMAC_CMD_CMD_VALUE_START);
-  abs_mmio_write32(kKmacBaseAddr + KMAC_CMD_REG_OFFSET, cmd_reg);
-  HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_ABSORB_BIT, 1));
+  kmac_issue_command(KMAC_CMD_CMD_VALUE_START);
+  return wait_status_bit(KMAC_STATUS_SHA3_ABSORB_BIT, 1);
+}
 
+/**
+ * Wait until the message FIFO has free entries.
+ *
+ * @param[out] free_words Number of 32-bit words that fit into the FIFO.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t wait_fifo_free_words(size_t *free_words) {
+  while (true) {
+    uint32_t reg = abs_mmio_read32(kKmacBaseAddr + KMAC_STATUS_REG_OFFSET);
+    if (bitfield_bit32_read(reg, KMAC_STATUS_ALERT_FATAL_FAULT_BIT)) {
+      return OTCRYPTO_FATAL_ERR;
+    }
+    if (bitfield_bit32_read(reg, KMAC_STATUS_ALERT_RECOV_CTRL_UPDATE_ERR_BIT)) {
+      return OTCRYPTO_RECOV_ERR;
+    }
+    uint32_t fifo_depth =
+        bitfield_field32_read(reg, KMAC_STATUS_FIFO_DEPTH_FIELD);
+    if (fifo_depth < KMAC_PARAM_NUM_ENTRIES_MSG_FIFO) {
+      *free_words = (KMAC_PARAM_NUM_ENTRIES_MSG_FIFO - fifo_depth) *
+                    KMAC_PARAM_NUM_BYTES_MSG_FIFO_ENTRY / sizeof(uint32_t);
+      return OTCRYPTO_OK;
+    }
+  }
+}
+
+/**
+ * Write message bytes to the message FIFO.
+ *
+ * The KMAC block must be in the absorb state. Full words are written in bursts
+ * that fill the free FIFO entries, so that the status register is read once
+ * per burst rather than once per word.
+ *
+ * The caller must ensure that `message_len` bytes are allocated at the
+ * location pointed to by `message`.
+ *
+ * @param message Input message string.
+ * @param message_len Message length in bytes.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_absorb(const uint8_t *message, size_t message_len) {
   // Begin by writing a one byte at a time until the data is aligned.
   size_t i = 0;
-  for (; misalignment32_of((uintptr_t)(&message[i])) > 0 && i < message_len;
+  for (; i < message_len && misalignment32_of((uintptr_t)(&message[i])) > 0;
        i++) {
     HARDENED_TRY(wait_status_bit(KMAC_STATUS_FIFO_FULL_BIT, 0));
     abs_mmio_write8(kKmacBaseAddr + KMAC_MSG_FIFO_REG_OFFSET, message[i]);
   }
 
-  // Write one word at a time as long as there is a full word available.
-  for (; i + sizeof(uint32_t) <= message_len; i += sizeof(uint32_t)) {
-    HARDENED_TRY(wait_status_bit(KMAC_STATUS_FIFO_FULL_BIT, 0));
-    uint32_t next_word = read_32(&message[i]);
-    abs_mmio_write32(kKmacBaseAddr + KMAC_MSG_FIFO_REG_OFFSET, next_word);
+  // Write as many full words as fit into the FIFO at a time.
+  while (i + sizeof(uint32_t) <= message_len) {
+    size_t free_words;
+    HARDENED_TRY(wait_fifo_free_words(&free_words));
+    size_t burst_words = (message_len - i) / sizeof(uint32_t);
+    if (burst_words > free_words) {
+      burst_words = free_words;
+    }
+    for (; burst_words > 0; burst_words--, i += sizeof(uint32_t)) {
+      uint32_t next_word = read_32(&message[i]);
+      abs_mmio_write32(kKmacBaseAddr + KMAC_MSG_FIFO_REG_OFFSET, next_word);
+    }
   }
 
   // For the last few bytes, we need to write one byte at a time again.
@@ -641,6 +695,21 @@ static status_t kmac_process_msg_blocks(kmac_operation_t operation,
     abs_mmio_write8(kKmacBaseAddr + KMAC_MSG_FIFO_REG_OFFSET, message[i]);
   }
 
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Finish absorbing and wait until the output can be squeezed.
+ *
+ * For KMAC, this first absorbs `right_encode(digest_len_words * 32)`.
+ *
+ * @param operation The operation type.
+ * @param digest_len_words Requested digest length in 32-bit words.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_process(kmac_operation_t operation,
+                             size_t digest_len_words) {
   // If operation=KMAC, then we need to write `right_encode(digest->len)`
   if (operation == kKmacOperationKMAC) {
     uint32_t digest_len_bits = 8 * sizeof(uint32_t) * digest_len_words;
@@ -657,71 +726,149 @@ static status_t kmac_process_msg_blocks(kmac_operation_t operation,
     uint8_t bytes_written;
     HARDENED_TRY(little_endian_encode(digest_len_bits, buf, &bytes_written));
     buf[bytes_written] = bytes_written;
-    uint8_t *fifo_dst = (uint8_t *)(kKmacBaseAddr + KMAC_MSG_FIFO_REG_OFFSET);
-    memcpy(fifo_dst, buf, bytes_written + 1);
+    HARDENED_TRY(kmac_absorb(buf, bytes_written + 1));
   }
 
   // Issue the process command, so that squeezing phase can start
-  cmd_reg = KMAC_CMD_REG_RESVAL;
-  cmd_reg = bitfield_field32_write(cmd_reg, KMAC_CMD_CMD_FIELD,
-                                   KMAC_CMD_CMD_VALUE_PROCESS);
-  abs_mmio_write32(kKmacBaseAddr + KMAC_CMD_REG_OFFSET, cmd_reg);
+  kmac_issue_command(KMAC_CMD_CMD_VALUE_PROCESS);
 
   // Wait until squeezing is done
-  HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_SQUEEZE_BIT, 1));
-
-  uint32_t cfg_reg =
-      abs_mmio_read32(kKmacBaseAddr + KMAC_CFG_SHADOWED_REG_OFFSET);
-  uint32_t keccak_str =
-      bitfield_field32_read(cfg_reg, KMAC_CFG_SHADOWED_KSTRENGTH_FIELD);
-  size_t keccak_rate_words;
-  HARDENED_TRY(kmac_get_keccak_rate_words(keccak_str, &keccak_rate_words));
+  return wait_status_bit(KMAC_STATUS_SHA3_SQUEEZE_BIT, 1);
+}
 
-  // Finally, we can read the two shares of digest and XOR them.
+/**
+ * Read output words from the Keccak state.
+ *
+ * The KMAC block must be in the squeeze state. Reading continues at word
+ * `*offset` of the current state; once the whole rate has been read, `CMD.RUN`
+ * generates the next state before more words are read.
+ *
+ * The caller must ensure that `digest_len_words` 32-bit words are allocated at
+ * the location pointed to by `digest`.
+ *
+ * @param[in,out] offset Words of the current state that were already read.
+ * @param keccak_rate_words Keccak rate in 32-bit words.
+ * @param[out] digest Output buffer.
+ * @param digest_len_words Number of words to read.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_squeeze(size_t *offset, size_t keccak_rate_words,
+                             uint32_t *digest, size_t digest_len_words) {
   size_t idx = 0;
-
   while (launder32(idx) < digest_len_words) {
-    // Since we always read in increments of the Keccak rate, the index at
-    // start should always be a multiple of the rate.
-    HARDENED_CHECK_EQ(idx % keccak_rate_words, 0);
+    // If all words of the current state were read, issue `CMD.RUN` to
+    // generate more state.
+    if (launder32(*offset) == keccak_rate_words) {
+      HARDENED_CHECK_EQ(*offset, keccak_rate_words);
+      kmac_issue_command(KMAC_CMD_CMD_VALUE_RUN);
+      *offset = 0;
+    }
 
     // Poll the status register until in the 'squeeze' state.
     HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_SQUEEZE_BIT, 1));
 
-    // Read words from the state registers (either `digest_len_words` or the
-    // maximum number of words available).
-    size_t offset = 0;
-    for (; launder32(idx) < digest_len_words && offset < keccak_rate_words;
-         offset++) {
+    // Read the two shares of the state and XOR them (either the remaining
+    // `digest_len_words` or the remaining words of the state).
+    for (; launder32(idx) < digest_len_words && *offset < keccak_rate_words;
+         (*offset)++) {
       uint32_t share0 =
-          abs_mmio_read32(kKmacStateShare0Addr + offset * sizeof(uint32_t));
+          abs_mmio_read32(kKmacStateShare0Addr + *offset * sizeof(uint32_t));
       uint32_t share1 =
-          abs_mmio_read32(kKmacStateShare1Addr + offset * sizeof(uint32_t));
+          abs_mmio_read32(kKmacStateShare1Addr + *offset * sizeof(uint32_t));
       digest[idx] = share0 ^ share1;
       ++idx;
     }
-
-    // If we read all the remaining words and still need more digest, issue
-    // `CMD.RUN` to generate more state.
-    if (launder32(offset) == keccak_rate_words && idx < digest_len_words) {
-      HARDENED_CHECK_EQ(offset, keccak_rate_words);
-      cmd_reg = KMAC_CMD_REG_RESVAL;
-      cmd_reg = bitfield_field32_write(cmd_reg, KMAC_CMD_CMD_FIELD,
-                                       KMAC_CMD_CMD_VALUE_RUN);
-      abs_mmio_write32(kKmacBaseAddr + KMAC_CMD_REG_OFFSET, cmd_reg);
-    }
   }
   HARDENED_CHECK_EQ(idx, digest_len_words);
+  return OTCRYPTO_OK;
+}
 
+/**
+ * Release the KMAC block after squeezing, so that it goes back to idle mode.
+ *
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_done(void) {
   // Poll the status register until in the 'squeeze' state.
   HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_SQUEEZE_BIT, 1));
+  kmac_issue_command(KMAC_CMD_CMD_VALUE_DONE);
+  return OTCRYPTO_OK;
+}
 
-  // Release the KMAC core, so that it goes back to idle mode
-  cmd_reg = KMAC_CMD_REG_RESVAL;
-  cmd_reg = bitfield_field32_write(cmd_reg, KMAC_CMD_CMD_FIELD,
-                                   KMAC_CMD_CMD_VALUE_DONE);
-  abs_mmio_write32(kKmacBaseAddr + KMAC_CMD_REG_OFFSET, cmd_reg);
+/**
+ * Common routine for feeding message blocks during SHA/SHAKE/cSHAKE/KMAC.
+ *
+ * Before running this, the operation type must be configured with kmac_init.
+ * Then, we can use this function to feed various bytes of data to the KMAC
+ * core. Note that this is a one-shot implementation; see `kmac_stream_t` for
+ * streaming.
+ *
+ * This routine does not check input parameters for consistency. For instance,
+ * one can invoke SHA-3_224 with digest_len=32, which will produce 256 bits of
+ * digest. The caller is responsible for ensuring that the digest length and
+ * mode are consistent.
+ *
+ * The caller must ensure that `message_len` bytes (rounded up to the next 32b
+ * word) are allocated at the location pointed to by `message`, and similarly
+ * that `digest_len_words` 32-bit words are allocated at the location pointed
+ * to by `digest`.
+ *
+ * @param operation The operation type.
+ * @param message Input message string.
+ * @param message_len Message length in bytes.
+ * @param digest The struct to which the result will be written.
+ * @param digest_len_words Requested digest length in 32-bit words.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_process_msg_blocks(kmac_operation_t operation,
+                                        const uint8_t *message,
+                                        size_t message_len, uint32_t *digest,
+                                        size_t digest_len_words) {
+  HARDENED_TRY(kmac_start());
+  HARDENED_TRY(kmac_absorb(message, message_len));
+  HARDENED_TRY(kmac_process(operation, digest_len_words));
+
+  uint32_t cfg_reg =
+      abs_mmio_read32(kKmacBaseAddr + KMAC_CFG_SHADOWED_REG_OFFSET);
+  uint32_t keccak_str =
+      bitfield_field32_read(cfg_reg, KMAC_CFG_SHADOWED_KSTRENGTH_FIELD);
+  size_t keccak_rate_words;
+  HARDENED_TRY(kmac_get_keccak_rate_words(keccak_str, &keccak_rate_words));
+
+  size_t offset = 0;
+  HARDENED_TRY(
+      kmac_squeeze(&offset, keccak_rate_words, digest, digest_len_words));
+
+  return kmac_done();
+}
 
+/**
+ * Load the key for a KMAC operation.
+ *
+ * Software keys are written to the key registers; for sideloaded keys, only
+ * the arguments are checked.
+ *
+ * @param key The input key passed as a struct.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_load_key(kmac_blinded_key_t *key) {
+  if (key->hw_backed == kHardenedBoolTrue) {
+    if (key->share0 != NULL || key->share1 != NULL ||
+        key->len != kKmacSideloadKeyLength / 8) {
+      return OTCRYPTO_BAD_ARGS;
+    }
+  } else if (key->hw_backed == kHardenedBoolFalse) {
+    if (key->share0 == NULL || key->share1 == NULL) {
+      return OTCRYPTO_BAD_ARGS;
+    }
+    HARDENED_TRY(kmac_write_key_block(key));
+  } else {
+    return OTCRYPTO_BAD_ARGS;
+  }
   return OTCRYPTO_OK;
 }
 
@@ -818,20 +965,7 @@ status_t kmac_kmac_128(kmac_blinded_key_t *key, const uint8_t *message,
   HARDENED_TRY(
       kmac_init(kKmacOperationKMAC, kKmacSecurityStrength128, key->hw_backed));
 
-  if (key->hw_backed == kHardenedBoolTrue) {
-    if (key->share0 != NULL || key->share1 != NULL ||
-        key->len != kKmacSideloadKeyLength / 8) {
-      return OTCRYPTO_BAD_ARGS;
-    }
-  } else if (key->hw_backed == kHardenedBoolFalse) {
-    if (key->share0 == NULL || key->share1 == NULL) {
-      return OTCRYPTO_BAD_ARGS;
-    }
-    HARDENED_TRY(kmac_write_key_block(key));
-  } else {
-    return OTCRYPTO_BAD_ARGS;
-  }
-
+  HARDENED_TRY(kmac_load_key(key));
   HARDENED_TRY(kmac_write_prefix_block(kKmacOperationKMAC, /*func_name=*/NULL,
                                        /*func_name_len=*/0, cust_str,
                                        cust_str_len));
@@ -847,24 +981,263 @@ status_t kmac_kmac_256(kmac_blinded_key_t *key, const uint8_t *message,
   HARDENED_TRY(
       kmac_init(kKmacOperationKMAC, kKmacSecurityStrength256, key->hw_backed));
 
-  if (key->hw_backed == kHardenedBoolTrue) {
-    if (key->share0 != NULL || key->share1 != NULL ||
-        key->len != kKmacSideloadKeyLength / 8) {
-      return OTCRYPTO_BAD_ARGS;
-    }
-  } else if (key->hw_backed == kHardenedBoolFalse) {
-    if (key->share0 == NULL || key->share1 == NULL) {
-      return OTCRYPTO_BAD_ARGS;
-    }
-    HARDENED_TRY(kmac_write_key_block(key));
-  } else {
+  HARDENED_TRY(kmac_load_key(key));
+  HARDENED_TRY(kmac_write_prefix_block(kKmacOperationKMAC, /*func_name=*/NULL,
+                                       /*func_name_len=*/0, cust_str,
+                                       cust_str_len));
+
+  return kmac_process_msg_blocks(kKmacOperationKMAC, message, message_len,
+                                 digest, digest_len);
+}
+
+/**
+ * Start a stream once the KMAC block is configured.
+ *
+ * @param[out] stream Stream state.
+ * @param operation The operation type.
+ * @param security_str Security strength of the operation.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_stream_begin(kmac_stream_t *stream,
+                                  kmac_operation_t operation,
+                                  kmac_security_str_t security_str) {
+  size_t keccak_rate_words;
+  HARDENED_TRY(kmac_get_keccak_rate_words(security_str, &keccak_rate_words));
+  HARDENED_TRY(kmac_start());
+
+  last_stream_id++;
+  if (last_stream_id == 0) {
+    last_stream_id = 1;
+  }
+  active_stream_id = last_stream_id;
+
+  stream->id = active_stream_id;
+  stream->operation = operation;
+  stream->keccak_rate_words = keccak_rate_words;
+  stream->squeeze_offset = 0;
+  stream->squeezing = kHardenedBoolFalse;
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Start a SHA-3 or SHAKE stream.
+ *
+ * @param[out] stream Stream state.
+ * @param operation `kKmacOperationSHA3` or `kKmacOperationSHAKE`.
+ * @param security_str Security strength of the operation.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_keccak_start(kmac_stream_t *stream,
+                                  kmac_operation_t operation,
+                                  kmac_security_str_t security_str) {
+  if (stream == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_TRY(
+      kmac_init(operation, security_str, /*hw_backed=*/kHardenedBoolFalse));
+  return kmac_stream_begin(stream, operation, security_str);
+}
+
+/**
+ * Start a cSHAKE stream.
+ *
+ * @param[out] stream Stream state.
+ * @param security_str Security strength of the operation.
+ * @param func_name The function name.
+ * @param func_name_len The function name length.
+ * @param cust_str The customization string.
+ * @param cust_str_len The customization string length.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_cshake_start(kmac_stream_t *stream,
+                                  kmac_security_str_t security_str,
+                                  const unsigned char *func_name,
+                                  size_t func_name_len,
+                                  const unsigned char *cust_str,
+                                  size_t cust_str_len) {
+  if (stream == NULL) {
     return OTCRYPTO_BAD_ARGS;
   }
+  HARDENED_TRY(kmac_init(kKmacOperationCSHAKE, security_str,
+                         /*hw_backed=*/kHardenedBoolFalse));
+  HARDENED_TRY(kmac_write_prefix_block(kKmacOperationCSHAKE, func_name,
+                                       func_name_len, cust_str, cust_str_len));
+  return kmac_stream_begin(stream, kKmacOperationCSHAKE, security_str);
+}
 
+/**
+ * Start a KMAC stream.
+ *
+ * @param[out] stream Stream state.
+ * @param security_str Security strength of the operation.
+ * @param key The KMAC key.
+ * @param cust_str The customization string.
+ * @param cust_str_len The customization string length.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_kmac_start(kmac_stream_t *stream,
+                                kmac_security_str_t security_str,
+                                kmac_blinded_key_t *key,
+                                const unsigned char *cust_str,
+                                size_t cust_str_len) {
+  if (stream == NULL || key == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_TRY(kmac_init(kKmacOperationKMAC, security_str, key->hw_backed));
+  HARDENED_TRY(kmac_load_key(key));
   HARDENED_TRY(kmac_write_prefix_block(kKmacOperationKMAC, /*func_name=*/NULL,
                                        /*func_name_len=*/0, cust_str,
                                        cust_str_len));
+  return kmac_stream_begin(stream, kKmacOperationKMAC, security_str);
+}
 
-  return kmac_process_msg_blocks(kKmacOperationKMAC, message, message_len,
-                                 digest, digest_len);
+status_t kmac_sha3_224_start(kmac_stream_t *stream) {
+  return kmac_keccak_start(stream, kKmacOperationSHA3,
+                           kKmacSecurityStrength224);
+}
+
+status_t kmac_sha3_256_start(kmac_stream_t *stream) {
+  return kmac_keccak_start(stream, kKmacOperationSHA3,
+                           kKmacSecurityStrength256);
+}
+
+status_t kmac_sha3_384_start(kmac_stream_t *stream) {
+  return kmac_keccak_start(stream, kKmacOperationSHA3,
+                           kKmacSecurityStrength384);
+}
+
+status_t kmac_sha3_512_start(kmac_stream_t *stream) {
+  return kmac_keccak_start(stream, kKmacOperationSHA3,
+                           kKmacSecurityStrength512);
+}
+
+status_t kmac_shake_128_start(kmac_stream_t *stream) {
+  return kmac_keccak_start(stream, kKmacOperationSHAKE,
+                           kKmacSecurityStrength128);
+}
+
+status_t kmac_shake_256_start(kmac_stream_t *stream) {
+  return kmac_keccak_start(stream, kKmacOperationSHAKE,
+                           kKmacSecurityStrength256);
+}
+
+status_t kmac_cshake_128_start(kmac_stream_t *stream,
+                               const unsigned char *func_name,
+                               size_t func_name_len,
+                               const unsigned char *cust_str,
+                               size_t cust_str_len) {
+  return kmac_cshake_start(stream, kKmacSecurityStrength128, func_name,
+                           func_name_len, cust_str, cust_str_len);
+}
+
+status_t kmac_cshake_256_start(kmac_stream_t *stream,
+                               const unsigned char *func_name,
+                               size_t func_name_len,
+                               const unsigned char *cust_str,
+                               size_t cust_str_len) {
+  return kmac_cshake_start(stream, kKmacSecurityStrength256, func_name,
+                           func_name_len, cust_str, cust_str_len);
+}
+
+status_t kmac_kmac_128_start(kmac_stream_t *stream, kmac_blinded_key_t *key,
+                             const unsigned char *cust_str,
+                             size_t cust_str_len) {
+  return kmac_kmac_start(stream, kKmacSecurityStrength128, key, cust_str,
+                         cust_str_len);
+}
+
+status_t kmac_kmac_256_start(kmac_stream_t *stream, kmac_blinded_key_t *key,
+                             const unsigned char *cust_str,
+                             size_t cust_str_len) {
+  return kmac_kmac_start(stream, kKmacSecurityStrength256, key, cust_str,
+                         cust_str_len);
+}
+
+/**
+ * Check that a stream holds the KMAC block.
+ *
+ * @param stream Stream state.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_stream_check(const kmac_stream_t *stream) {
+  if (stream == NULL || stream->id == 0 ||
+      launder32(stream->id) != active_stream_id) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(stream->id, active_stream_id);
+  return OTCRYPTO_OK;
+}
+
+status_t kmac_stream_absorb(kmac_stream_t *stream, const uint8_t *message,
+                            size_t message_len) {
+  HARDENED_TRY(kmac_stream_check(stream));
+  if (stream->squeezing != kHardenedBoolFalse ||
+      (message == NULL && message_len != 0)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  return kmac_absorb(message, message_len);
+}
+
+status_t kmac_stream_squeeze(kmac_stream_t *stream, uint32_t *digest,
+                             size_t digest_len_words) {
+  HARDENED_TRY(kmac_stream_check(stream));
+  if (digest == NULL && digest_len_words != 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  if (launder32(stream->squeezing) == kHardenedBoolFalse) {
+    HARDENED_CHECK_EQ(stream->squeezing, kHardenedBoolFalse);
+    HARDENED_TRY(kmac_process(stream->operation, digest_len_words));
+    stream->squeezing = kHardenedBoolTrue;
+  } else if (stream->squeezing != kHardenedBoolTrue ||
+             stream->operation == kKmacOperationKMAC) {
+    // The KMAC output length is fixed by the first squeeze.
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  size_t offset = stream->squeeze_offset;
+  if (offset > stream->keccak_rate_words) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_TRY(kmac_squeeze(&offset, stream->keccak_rate_words, digest,
+                            digest_len_words));
+  stream->squeeze_offset = offset;
+  return OTCRYPTO_OK;
+}
+
+status_t kmac_stream_end(kmac_stream_t *stream) {
+  HARDENED_TRY(kmac_stream_check(stream));
+
+  // Release the block first so that it is not left reserved if finishing the
+  // stream fails.
+  active_stream_id = 0;
+  stream->id = 0;
+
+  // The block only accepts the done command in the squeeze state, so finish
+  // absorbing first if the stream is abandoned early.
+  status_t result = OTCRYPTO_OK;
+  if (stream->squeezing != kHardenedBoolTrue) {
+    result = kmac_process(stream->operation, /*digest_len_words=*/0);
+  }
+  if (launder32(OT_UNSIGNED(result.value)) != kHardenedBoolTrue) {
+    // Still issue the done command; the next operation waits for the block to
+    // be idle before using it.
+    kmac_issue_command(KMAC_CMD_CMD_VALUE_DONE);
+    return result;
+  }
+  HARDENED_CHECK_EQ(result.value, kHardenedBoolTrue);
+  return kmac_done();
+}
+
+status_t kmac_stream_check_inactive(void) {
+  if (launder32(active_stream_id) != 0) {
+    return OTCRYPTO_RECOV_ERR;
+  }
+  HARDENED_CHECK_EQ(active_stream_id, 0);
+  return OTCRYPTO_OK;
 }
@@ -57,6 +57,27 @@ typedef struct kmac_blinded_key {
   hardened_bool_t hw_backed;
 } kmac_blinded_key_t;
 
+/**
+ * State of a streaming operation on the KMAC block.
+ *
+ * The KMAC block cannot save and restore its Keccak state, so a stream holds
+ * the block from its `kmac_*_start()` call until `kmac_stream_end()`. In
+ * between, all other KMAC driver operations return `OTCRYPTO_RECOV_ERR`. The
+ * struct only holds the driver's bookkeeping and may be copied.
+ */
+typedef struct kmac_stream {
+  // Identifies the stream that holds the block; 0 once the stream ended.
+  uint32_t id;
+  // Operation of the stream (internal to the driver).
+  uint32_t operation;
+  // Keccak rate in 32-bit words.
+  uint32_t keccak_rate_words;
+  // Number of words of the current Keccak state that were squeezed.
+  uint32_t squeeze_offset;
+  // Whether the message is complete and output is being squeezed.
+  hardened_bool_t squeezing;
+} kmac_stream_t;
+
 /**
  * Check whether given key length is valid for KMAC.
 
@@ -285,6 +306,192 @@ status_t kmac_kmac_256(kmac_blinded_key_t *key, const uint8_t *message,
                        size_t cust_str_len, uint32_t *digest,
                        size_t digest_len);
 
+/**
+ * Start a streaming SHA-3-224 operation.
+ *
+ * @param[out] stream Stream state.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_sha3_224_start(kmac_stream_t *stream);
+
+/**
+ * Start a streaming SHA-3-256 operation.
+ *
+ * @param[out] stream Stream state.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_sha3_256_start(kmac_stream_t *stream);
+
+/**
+ * Start a streaming SHA-3-384 operation.
+ *
+ * @param[out] stream Stream state.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_sha3_384_start(kmac_stream_t *stream);
+
+/**
+ * Start a streaming SHA-3-512 operation.
+ *
+ * @param[out] stream Stream state.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_sha3_512_start(kmac_stream_t *stream);
+
+/**
+ * Start a streaming SHAKE-128 operation.
+ *
+ * @param[out] stream Stream state.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_shake_128_start(kmac_stream_t *stream);
+
+/**
+ * Start a streaming SHAKE-256 operation.
+ *
+ * @param[out] stream Stream state.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_shake_256_start(kmac_stream_t *stream);
+
+/**
+ * Start a streaming cSHAKE-128 operation.
+ *
+ * The combined length of `func_name` and `cust_str` must not exceed
+ * `kKmacPrefixMaxSize`.
+ *
+ * @param[out] stream Stream state.
+ * @param func_name The function name.
+ * @param func_name_len The function name length in bytes.
+ * @param cust_str The customization string.
+ * @param cust_str_len The customization string length in bytes.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_cshake_128_start(kmac_stream_t *stream,
+                               const unsigned char *func_name,
+                               size_t func_name_len,
+                               const unsigned char *cust_str,
+                               size_t cust_str_len);
+
+/**
+ * Start a streaming cSHAKE-256 operation.
+ *
+ * The combined length of `func_name` and `cust_str` must not exceed
+ * `kKmacPrefixMaxSize`.
+ *
+ * @param[out] stream Stream state.
+ * @param func_name The function name.
+ * @param func_name_len The function name length in bytes.
+ * @param cust_str The customization string.
+ * @param cust_str_len The customization string length in bytes.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_cshake_256_start(kmac_stream_t *stream,
+                               const unsigned char *func_name,
+                               size_t func_name_len,
+                               const unsigned char *cust_str,
+                               size_t cust_str_len);
+
+/**
+ * Start a streaming KMAC-128 operation.
+ *
+ * The key is handled as for `kmac_kmac_128()`. The output of a KMAC stream
+ * must be squeezed with a single call to `kmac_stream_squeeze()`, since its
+ * length is part of the computation.
+ *
+ * @param[out] stream Stream state.
+ * @param key The KMAC key.
+ * @param cust_str The customization string.
+ * @param cust_str_len The customization string length in bytes.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_kmac_128_start(kmac_stream_t *stream, kmac_blinded_key_t *key,
+                             const unsigned char *cust_str,
+                             size_t cust_str_len);
+
+/**
+ * Start a streaming KMAC-256 operation.
+ *
+ * The key is handled as for `kmac_kmac_256()`. The output of a KMAC stream
+ * must be squeezed with a single call to `kmac_stream_squeeze()`, since its
+ * length is part of the computation.
+ *
+ * @param[out] stream Stream state.
+ * @param key The KMAC key.
+ * @param cust_str The customization string.
+ * @param cust_str_len The customization string length in bytes.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_kmac_256_start(kmac_stream_t *stream, kmac_blinded_key_t *key,
+                             const unsigned char *cust_str,
+                             size_t cust_str_len);
+
+/**
+ * Absorb message bytes into a stream.
+ *
+ * Must not be called once output has been squeezed from the stream.
+ *
+ * @param stream Stream state.
+ * @param message The input message.
+ * @param message_len The input message length in bytes.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_stream_absorb(kmac_stream_t *stream, const uint8_t *message,
+                            size_t message_len);
+
+/**
+ * Squeeze output words from a stream.
+ *
+ * The first call completes the message. For SHA-3, SHAKE and cSHAKE, later
+ * calls continue the output where the previous call stopped, so a SHA-3 digest
+ * or an XOF output can be read in pieces.
+ *
+ * The caller must ensure that `digest_len` words are allocated at the location
+ * pointed to by `digest`.
+ *
+ * @param stream Stream state.
+ * @param[out] digest Output buffer.
+ * @param digest_len Number of 32-bit words to squeeze.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_stream_squeeze(kmac_stream_t *stream, uint32_t *digest,
+                             size_t digest_len);
+
+/**
+ * End a stream and release the KMAC block.
+ *
+ * May be called at any point after the stream started, also to abandon it.
+ * The block is released even if finishing the stream returns an error.
+ *
+ * @param stream Stream state.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_stream_end(kmac_stream_t *stream);
+
+/**
+ * Check that no stream holds the KMAC block.
+ *
+ * Keymgr derives keys with the KMAC block, and waits forever for it while a
+ * stream holds it. Keymgr operations must check this before they start.
+ *
+ * @return OK if no stream is active, `OTCRYPTO_RECOV_ERR` otherwise.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_stream_check_inactive(void);
+
 #ifdef __cplusplus
 }
 #endif
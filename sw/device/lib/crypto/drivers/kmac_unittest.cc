@@ -0,0 +1,152 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/crypto/drivers/kmac.h"
+
+#include <array>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/bitfield.h"
+#include "sw/device/lib/base/mock_abs_mmio.h"
+#include "sw/device/lib/crypto/impl/status.h"
+
+#include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
+#include "kmac_regs.h"  // Generated.
+
+namespace kmac_unittest {
+namespace {
+using ::testing::_;
+using ::testing::Invoke;
+
+constexpr uint32_t kBase = TOP_EARLGREY_KMAC_BASE_ADDR;
+
+/**
+ * Minimal model of the KMAC block's command state machine.
+ *
+ * Only tracks the idle/absorb/squeeze states seen through the status register,
+ * and can report a recoverable error to make the driver fail mid-stream.
+ */
+class KmacStreamTest : public testing::Test {
+ protected:
+  enum class State { kIdle, kAbsorb, kSqueeze };
+
+  void SetUp() override {
+    ON_CALL(mmio_, Read32(_))
+        .WillByDefault(Invoke(this, &KmacStreamTest::Read32));
+    ON_CALL(mmio_, Write32(_, _))
+        .WillByDefault(Invoke(this, &KmacStreamTest::Write32));
+  }
+
+  uint32_t Read32(uint32_t addr) {
+    if (addr != kBase + KMAC_STATUS_REG_OFFSET) {
+      // Configuration and state registers; the values don't matter here.
+      return 0;
+    }
+    uint32_t reg = 0;
+    reg = bitfield_bit32_write(reg, KMAC_STATUS_SHA3_IDLE_BIT,
+                               state_ == State::kIdle);
+    reg = bitfield_bit32_write(reg, KMAC_STATUS_SHA3_ABSORB_BIT,
+                               state_ == State::kAbsorb);
+    reg = bitfield_bit32_write(reg, KMAC_STATUS_SHA3_SQUEEZE_BIT,
+                               state_ == State::kSqueeze);
+    reg = bitfield_bit32_write(
+        reg, KMAC_STATUS_ALERT_RECOV_CTRL_UPDATE_ERR_BIT, error_);
+    return reg;
+  }
+
+  void Write32(uint32_t addr, uint32_t value) {
+    if (addr != kBase + KMAC_CMD_REG_OFFSET) {
+      return;
+    }
+    switch (bitfield_field32_read(value, KMAC_CMD_CMD_FIELD)) {
+      case KMAC_CMD_CMD_VALUE_START:
+        state_ = State::kAbsorb;
+        break;
+      case KMAC_CMD_CMD_VALUE_PROCESS:
+        // A block that reports an error doesn't finish absorbing.
+        if (!error_) {
+          state_ = State::kSqueeze;
+        }
+        break;
+      case KMAC_CMD_CMD_VALUE_DONE:
+        state_ = State::kIdle;
+        ++num_done_;
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Run a complete SHA3-256 hash, as a caller would after an error.
+  void ExpectHashWorks() {
+    kmac_stream_t stream;
+    ASSERT_TRUE(status_ok(kmac_sha3_256_start(&stream)));
+    ASSERT_TRUE(status_ok(kmac_stream_absorb(&stream, kMessage.data(),
+                                             kMessage.size())));
+    std::array<uint32_t, kSha3_256DigestWords> digest;
+    ASSERT_TRUE(status_ok(
+        kmac_stream_squeeze(&stream, digest.data(), digest.size())));
+    ASSERT_TRUE(status_ok(kmac_stream_end(&stream)));
+    EXPECT_EQ(state_, State::kIdle);
+  }
+
+  static constexpr std::array<uint8_t, 3> kMessage = {'a', 'b', 'c'};
+
+  rom_test::NiceMockAbsMmio mmio_;
+  State state_ = State::kIdle;
+  bool error_ = false;
+  int num_done_ = 0;
+};
+
+TEST_F(KmacStreamTest, BlockReservedUntilStreamEnds) {
+  kmac_stream_t stream;
+  ASSERT_TRUE(status_ok(kmac_sha3_256_start(&stream)));
+
+  kmac_stream_t other_stream;
+  EXPECT_FALSE(status_ok(kmac_sha3_256_start(&other_stream)));
+
+  ASSERT_TRUE(status_ok(kmac_stream_end(&stream)));
+  ExpectHashWorks();
+}
+
+TEST_F(KmacStreamTest, SqueezeErrorThenEnd) {
+  kmac_stream_t stream;
+  ASSERT_TRUE(status_ok(kmac_sha3_256_start(&stream)));
+  ASSERT_TRUE(status_ok(
+      kmac_stream_absorb(&stream, kMessage.data(), kMessage.size())));
+
+  error_ = true;
+  std::array<uint32_t, kSha3_256DigestWords> digest;
+  EXPECT_FALSE(status_ok(
+      kmac_stream_squeeze(&stream, digest.data(), digest.size())));
+
+  // Ending the stream fails too while the block reports the error, but still
+  // releases the block and tells it to finish.
+  EXPECT_FALSE(status_ok(kmac_stream_end(&stream)));
+  EXPECT_EQ(num_done_, 1);
+
+  // The stream is gone, so it can't be ended twice.
+  EXPECT_FALSE(status_ok(kmac_stream_end(&stream)));
+
+  error_ = false;
+  ExpectHashWorks();
+}
+
+TEST_F(KmacStreamTest, ErrorWhileEndingAbandonedStream) {
+  kmac_stream_t stream;
+  ASSERT_TRUE(status_ok(kmac_sha3_256_start(&stream)));
+  ASSERT_TRUE(status_ok(
+      kmac_stream_absorb(&stream, kMessage.data(), kMessage.size())));
+
+  error_ = true;
+  EXPECT_FALSE(status_ok(kmac_stream_end(&stream)));
+  EXPECT_EQ(num_done_, 1);
+
+  error_ = false;
+  ExpectHashWorks();
+}
+
+}  // namespace
+}  // namespace kmac_unittest
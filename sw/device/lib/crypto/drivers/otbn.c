@@ -63,6 +63,29 @@ typedef enum otbn_status {
   kOtbnStatusLocked = 0xFF,
 } otbn_status_t;
 
+/**
+ * The application that was last loaded into IMEM.
+ *
+ * Any value of `valid` other than `kHardenedBoolTrue`, including the initial
+ * zero, means that the IMEM contents are unknown.
+ */
+static struct {
+  hardened_bool_t valid;
+  const uint32_t *imem_start;
+  const uint32_t *imem_end;
+  uint32_t checksum;
+  /**
+   * Value of the LOAD_CHECKSUM register after writing IMEM, i.e. the starting
+   * point for the checksum of the DMEM data.
+   */
+  uint32_t imem_checksum;
+} resident_app;
+
+/**
+ * Statistics of `otbn_load_app()`.
+ */
+static otbn_app_cache_stats_t app_cache_stats;
+
 /**
  * Ensures that a memory access fits within the given memory size.
  *
@@ -206,6 +229,9 @@ status_t otbn_busy_wait_for_done(void) {
     return res;
   }
 
+  // OTBN may have wiped its memories; load the app again next time.
+  otbn_app_cache_invalidate();
+
   // If OTBN is idle (not locked), then return a recoverable error.
   if (launder32(status) == kOtbnStatusIdle) {
     HARDENED_CHECK_EQ(status, kOtbnStatusIdle);
@@ -226,6 +252,7 @@ uint32_t otbn_instruction_count_get(void) {
 }
 
 status_t otbn_imem_sec_wipe(void) {
+  otbn_app_cache_invalidate();
   HARDENED_TRY(entropy_complex_check());
   HARDENED_TRY(otbn_assert_idle());
   abs_mmio_write32(kBase + OTBN_CMD_REG_OFFSET, kOtbnCmdSecWipeImem);
@@ -286,6 +313,53 @@ static status_t check_app_address_ranges(const otbn_app_t *app) {
   return OTCRYPTO_OK;
 }
 
+void otbn_app_cache_invalidate(void) {
+  resident_app.valid = kHardenedBoolFalse;
+}
+
+void otbn_app_cache_stats_get(otbn_app_cache_stats_t *stats) {
+  *stats = app_cache_stats;
+}
+
+/**
+ * Checks whether the given application is resident in IMEM.
+ *
+ * Besides comparing the application to the one that was last loaded, this
+ * reads IMEM back and compares it to the application image, so that the
+ * application is only reused if IMEM still holds exactly its code.
+ *
+ * @param app The application to check.
+ * @return `kHardenedBoolTrue` if the application does not need to be written
+ *         to IMEM again.
+ */
+static hardened_bool_t app_is_resident(const otbn_app_t *app) {
+  if (launder32(resident_app.valid) != kHardenedBoolTrue ||
+      resident_app.imem_start != app->imem_start ||
+      resident_app.imem_end != app->imem_end ||
+      resident_app.checksum != app->checksum) {
+    return kHardenedBoolFalse;
+  }
+  HARDENED_CHECK_EQ(resident_app.valid, kHardenedBoolTrue);
+
+  const size_t imem_num_words = (size_t)(app->imem_end - app->imem_start);
+  const uint32_t imem_start_addr = kBase + OTBN_IMEM_REG_OFFSET;
+  uint32_t diff = 0;
+  size_t i = 0;
+  for (; launder32(i) < imem_num_words; i++) {
+    HARDENED_CHECK_LT(i, imem_num_words);
+    diff |= abs_mmio_read32(imem_start_addr + i * sizeof(uint32_t)) ^
+            app->imem_start[i];
+  }
+  HARDENED_CHECK_EQ(i, imem_num_words);
+
+  if (launder32(diff) != 0) {
+    app_cache_stats.imem_check_failures++;
+    return kHardenedBoolFalse;
+  }
+  HARDENED_CHECK_EQ(diff, 0);
+  return kHardenedBoolTrue;
+}
+
 status_t otbn_load_app(const otbn_app_t app) {
   HARDENED_TRY(check_app_address_ranges(&app));
 
@@ -296,35 +370,51 @@ status_t otbn_load_app(const otbn_app_t app) {
   const size_t data_num_words =
       (size_t)(app.dmem_data_end - app.dmem_data_start);
 
-  HARDENED_TRY(otbn_imem_sec_wipe());
-  HARDENED_TRY(otbn_dmem_sec_wipe());
-
-  // Reset the LOAD_CHECKSUM register.
-  abs_mmio_write32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET, 0);
-
   // Ensure that the IMEM section fits in IMEM and the data section fits in
   // DMEM.
   HARDENED_TRY(check_offset_len(app.dmem_data_start_addr, data_num_words,
                                 kOtbnDMemSizeBytes));
-
-  // Write to IMEM. Always starts at zero on the OTBN side.
-  otbn_addr_t imem_offset = 0;
-  HARDENED_TRY(
-      check_offset_len(imem_offset, imem_num_words, kOtbnIMemSizeBytes));
-  uint32_t imem_start_addr = kBase + OTBN_IMEM_REG_OFFSET + imem_offset;
-  uint32_t i = 0;
-  for (; launder32(i) < imem_num_words; i++) {
-    HARDENED_CHECK_LT(i, imem_num_words);
-    abs_mmio_write32(imem_start_addr + i * sizeof(uint32_t), app.imem_start[i]);
+  HARDENED_TRY(check_offset_len(0, imem_num_words, kOtbnIMemSizeBytes));
+
+  hardened_bool_t resident = app_is_resident(&app);
+  if (launder32(resident) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(resident, kHardenedBoolTrue);
+
+    // Only DMEM needs to be reinitialized. Continue the checksum from where
+    // the IMEM write left it when the app was loaded.
+    HARDENED_TRY(otbn_dmem_sec_wipe());
+    abs_mmio_write32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET,
+                     resident_app.imem_checksum);
+    app_cache_stats.reloads_avoided++;
+  } else {
+    HARDENED_TRY(otbn_imem_sec_wipe());
+    HARDENED_TRY(otbn_dmem_sec_wipe());
+
+    // Reset the LOAD_CHECKSUM register.
+    abs_mmio_write32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET, 0);
+
+    // Write to IMEM. Always starts at zero on the OTBN side.
+    uint32_t imem_start_addr = kBase + OTBN_IMEM_REG_OFFSET;
+    uint32_t i = 0;
+    for (; launder32(i) < imem_num_words; i++) {
+      HARDENED_CHECK_LT(i, imem_num_words);
+      abs_mmio_write32(imem_start_addr + i * sizeof(uint32_t),
+                       app.imem_start[i]);
+    }
+    HARDENED_CHECK_EQ(i, imem_num_words);
+
+    resident_app.imem_start = app.imem_start;
+    resident_app.imem_end = app.imem_end;
+    resident_app.checksum = app.checksum;
+    resident_app.imem_checksum =
+        abs_mmio_read32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET);
+    app_cache_stats.loads++;
   }
-  HARDENED_CHECK_EQ(i, imem_num_words);
 
   // Write the data portion to DMEM.
   otbn_addr_t data_offset = app.dmem_data_start_addr;
-  HARDENED_TRY(
-      check_offset_len(data_offset, data_num_words, kOtbnDMemSizeBytes));
   uint32_t data_start_addr = kBase + OTBN_DMEM_REG_OFFSET + data_offset;
-  i = 0;
+  uint32_t i = 0;
   for (; launder32(i) < data_num_words; i++) {
     HARDENED_CHECK_LT(i, data_num_words);
     abs_mmio_write32(data_start_addr + i * sizeof(uint32_t),
@@ -335,9 +425,13 @@ status_t otbn_load_app(const otbn_app_t app) {
   // Ensure that the checksum matches expectations.
   uint32_t checksum = abs_mmio_read32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET);
   if (launder32(checksum) != app.checksum) {
+    otbn_app_cache_invalidate();
     return OTCRYPTO_FATAL_ERR;
   }
   HARDENED_CHECK_EQ(checksum, app.checksum);
 
+  // Only now is the app known to be intact in IMEM.
+  resident_app.valid = kHardenedBoolTrue;
+
   return OTCRYPTO_OK;
 }
@@ -92,6 +92,26 @@ typedef struct otbn_app {
   const uint32_t checksum;
 } otbn_app_t;
 
+/**
+ * Statistics of the resident application tracking in `otbn_load_app()`.
+ */
+typedef struct otbn_app_cache_stats {
+  /**
+   * Number of times an application was written to IMEM.
+   */
+  uint32_t loads;
+  /**
+   * Number of times an application was found to be resident in IMEM already,
+   * so that only its DMEM data had to be written.
+   */
+  uint32_t reloads_avoided;
+  /**
+   * Number of times the last loaded application was requested again but IMEM
+   * no longer matched its image, so that it had to be written again.
+   */
+  uint32_t imem_check_failures;
+} otbn_app_cache_stats_t;
+
 /**
  * Generate the prefix to add to an OTBN symbol name used on the Ibex side
  *
@@ -282,7 +302,8 @@ uint32_t otbn_instruction_count_get(void);
  * Wipe IMEM securely.
  *
  * This function returns an error if called when OTBN is not idle, and blocks
- * until the secure wipe is complete.
+ * until the secure wipe is complete. The next `otbn_load_app()` always loads
+ * the application again.
  *
  * @return Result of the operation.
  */
@@ -317,6 +338,13 @@ status_t otbn_set_ctrl_software_errs_fatal(bool enable);
  * Load the application image with both instruction and data segments into
  * OTBN.
  *
+ * If the application is the one that was loaded last, and IMEM still matches
+ * its image when read back, then IMEM is neither wiped nor written again. DMEM
+ * is always wiped and its data segment written, so the application starts
+ * from the same state either way. Wiping IMEM with `otbn_imem_sec_wipe()` or
+ * an error reported by `otbn_busy_wait_for_done()` makes the next call load
+ * the application again.
+ *
  * This function will return an error if called when OTBN is not idle.
  *
  * @param ctx The context object.
@@ -325,6 +353,21 @@ status_t otbn_set_ctrl_software_errs_fatal(bool enable);
  */
 status_t otbn_load_app(const otbn_app_t app);
 
+/**
+ * Forgets which application is resident in IMEM.
+ *
+ * The next `otbn_load_app()` loads the application again. Call this after
+ * writing to IMEM other than through this driver, e.g. through a DIF.
+ */
+void otbn_app_cache_invalidate(void);
+
+/**
+ * Gets the statistics of the resident application tracking.
+ *
+ * @param[out] stats Statistics since reset.
+ */
+void otbn_app_cache_stats_get(otbn_app_cache_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,111 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/crypto/drivers/otbn.h"
+
+#include "sw/device/lib/base/abs_mmio.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/crypto/drivers/entropy.h"
+#include "sw/device/lib/crypto/impl/sha2/sha256.h"
+#include "sw/device/lib/crypto/impl/status.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+#include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
+#include "otbn_regs.h"  // Generated.
+
+// Module ID for status codes.
+#define MODULE_ID MAKE_MODULE_ID('t', 's', 't')
+
+// Message to hash with the OTBN SHA-256 app.
+static const uint8_t kMessage[] = "Resident OTBN application test message";
+
+/**
+ * Hashes `kMessage` and checks the statistics change as expected.
+ *
+ * @param loads_expected Whether the app is expected to be written to IMEM.
+ * @param[out] digest The digest of `kMessage`.
+ * @return OK if the hash was computed and the statistics match.
+ */
+static status_t hash_and_check_stats(bool loads_expected, uint32_t *digest) {
+  otbn_app_cache_stats_t before;
+  otbn_app_cache_stats_get(&before);
+  TRY(sha256(kMessage, sizeof(kMessage), digest));
+  otbn_app_cache_stats_t after;
+  otbn_app_cache_stats_get(&after);
+
+  LOG_INFO("Loads: %d, reloads avoided: %d, IMEM check failures: %d",
+           after.loads, after.reloads_avoided, after.imem_check_failures);
+  if (loads_expected) {
+    TRY_CHECK(after.loads > before.loads);
+  } else {
+    TRY_CHECK(after.loads == before.loads);
+    TRY_CHECK(after.reloads_avoided > before.reloads_avoided);
+  }
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Checks that running the same app again does not load it again, and that
+ * it still computes the same result.
+ */
+static status_t resident_app_test(void) {
+  TRY(otbn_imem_sec_wipe());
+  uint32_t digest_loaded[kSha256DigestWords];
+  TRY(hash_and_check_stats(/*loads_expected=*/true, digest_loaded));
+  uint32_t digest_resident[kSha256DigestWords];
+  TRY(hash_and_check_stats(/*loads_expected=*/false, digest_resident));
+  TRY_CHECK_ARRAYS_EQ(digest_resident, digest_loaded, kSha256DigestWords);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Checks that wiping IMEM makes the app load again.
+ */
+static status_t imem_wipe_test(void) {
+  uint32_t digest_before[kSha256DigestWords];
+  TRY(hash_and_check_stats(/*loads_expected=*/false, digest_before));
+  TRY(otbn_imem_sec_wipe());
+  uint32_t digest_after[kSha256DigestWords];
+  TRY(hash_and_check_stats(/*loads_expected=*/true, digest_after));
+  TRY_CHECK_ARRAYS_EQ(digest_after, digest_before, kSha256DigestWords);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Checks that the app loads again if IMEM was modified behind the driver's
+ * back.
+ */
+static status_t imem_modified_test(void) {
+  uint32_t digest_before[kSha256DigestWords];
+  TRY(hash_and_check_stats(/*loads_expected=*/false, digest_before));
+
+  otbn_app_cache_stats_t before;
+  otbn_app_cache_stats_get(&before);
+  const uint32_t imem_addr = TOP_EARLGREY_OTBN_BASE_ADDR + OTBN_IMEM_REG_OFFSET;
+  abs_mmio_write32(imem_addr, abs_mmio_read32(imem_addr) ^ 1);
+
+  uint32_t digest_after[kSha256DigestWords];
+  TRY(hash_and_check_stats(/*loads_expected=*/true, digest_after));
+  TRY_CHECK_ARRAYS_EQ(digest_after, digest_before, kSha256DigestWords);
+
+  otbn_app_cache_stats_t after;
+  otbn_app_cache_stats_get(&after);
+  TRY_CHECK(after.imem_check_failures == before.imem_check_failures + 1);
+  return OTCRYPTO_OK;
+}
+
+OTTF_DEFINE_TEST_CONFIG();
+
+bool test_main(void) {
+  static status_t result;
+
+  CHECK_STATUS_OK(entropy_complex_init());
+  EXECUTE_TEST(result, resident_app_test);
+  EXECUTE_TEST(result, imem_wipe_test);
+  EXECUTE_TEST(result, imem_modified_test);
+
+  return status_ok(result);
+}
@@ -355,41 +355,26 @@ otcrypto_status_t otcrypto_aes(const otcrypto_blinded_key_t *key,
       return OTCRYPTO_BAD_ARGS;
   }
 
-  // Perform the cipher operation for all full blocks (excluding last block).
-  // The input and output are offset by one, so if unrolled this loop would
-  // look like:
-  //   aes_update(NULL, input[0]);
-  //   aes_update(output[0], input[1]);
-  //   aes_update(output[1], input[2]);
-  //   ...
-  // See the AES driver for details.
-  aes_block_t block_in;
-  aes_block_t block_out;
-  size_t i;
-  for (i = 0; launder32(i) < input_nblocks; i++) {
-    HARDENED_TRY(get_block(cipher_input, aes_padding, i, &block_in));
-
-    // Call the AES cipher and copy data to output buffer if needed.
-    if (launder32(i) == 0) {
-      HARDENED_CHECK_EQ(i, 0);
-      HARDENED_TRY(aes_update(/*dest=*/NULL, &block_in));
-    } else {
-      HARDENED_TRY(aes_update(&block_out, &block_in));
-      // TODO(#17711) Change to `hardened_memcpy`.
-      memcpy(&cipher_output.data[(i - 1) * kAesBlockNumBytes], block_out.data,
-             kAesBlockNumBytes);
-    }
+  // Run all full input blocks straight from the input to the output buffer.
+  // The driver keeps the next input block loaded while the hardware works on
+  // the current one; see `aes_update_blocks` for details.
+  size_t num_full_blocks = cipher_input.len / kAesBlockNumBytes;
+  HARDENED_CHECK_LE(num_full_blocks, input_nblocks);
+  HARDENED_TRY(aes_update_blocks(cipher_output.data, cipher_input.data,
+                                 num_full_blocks));
+
+  // Process the final padded block, if there is one.
+  if (launder32(num_full_blocks) < input_nblocks) {
+    HARDENED_CHECK_EQ(num_full_blocks + 1, input_nblocks);
+    aes_block_t block;
+    HARDENED_TRY(get_block(cipher_input, aes_padding, num_full_blocks, &block));
+    HARDENED_TRY(aes_update_blocks(
+        &cipher_output.data[num_full_blocks * kAesBlockNumBytes],
+        (const uint8_t *)block.data, 1));
+  } else {
+    HARDENED_CHECK_EQ(num_full_blocks, input_nblocks);
   }
 
-  // Check that the loop ran for the correct number of iterations.
-  HARDENED_CHECK_EQ(i, input_nblocks);
-
-  // Retrieve the output from the final block (providing no input).
-  HARDENED_TRY(aes_update(&block_out, /*src=*/NULL));
-  // TODO(#17711) Change to `hardened_memcpy`.
-  memcpy(&cipher_output.data[(input_nblocks - 1) * kAesBlockNumBytes],
-         block_out.data, kAesBlockNumBytes);
-
   // Deinitialize the AES block and update the IV (in ECB mode, skip the IV).
   if (aes_mode == launder32(kAesCipherModeEcb)) {
     HARDENED_TRY(aes_end(NULL));
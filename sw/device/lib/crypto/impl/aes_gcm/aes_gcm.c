@@ -70,6 +70,50 @@ static status_t aes_encrypt_block(const aes_key_t key, const aes_block_t *iv,
   return aes_end(NULL);
 }
 
+/**
+ * Run GCTR on consecutive full blocks of input.
+ *
+ * The AES hardware's CTR mode increments the whole 128-bit counter block, but
+ * GCTR only increments its last 32 bits. The blocks are therefore processed in
+ * runs that end where those 32 bits wrap around, each run being one hardware
+ * CTR operation with the blocks pipelined through the AES unit.
+ *
+ * Updates the IV in-place. `output` may be equal to `input`, but the buffers
+ * may not otherwise overlap.
+ *
+ * @param key The AES key
+ * @param iv Initialization vector, 128 bits
+ * @param num_blocks Number of blocks to process
+ * @param input Input buffer, `num_blocks` blocks
+ * @param[out] output Output buffer, `num_blocks` blocks
+ */
+OT_WARN_UNUSED_RESULT
+static status_t gctr_process_blocks(const aes_key_t key, aes_block_t *iv,
+                                    size_t num_blocks, const uint8_t *input,
+                                    uint8_t *output) {
+  while (num_blocks > 0) {
+    // Number of blocks before the 32-bit counter wraps; 0 means 2^32.
+    uint32_t ctr = __builtin_bswap32(iv->data[kAesBlockNumWords - 1]);
+    uint32_t blocks_to_wrap = 0u - ctr;
+    size_t run_len = num_blocks;
+    if (blocks_to_wrap != 0 && blocks_to_wrap < run_len) {
+      run_len = blocks_to_wrap;
+    }
+
+    HARDENED_TRY(aes_encrypt_begin(key, iv));
+    HARDENED_TRY(aes_update_blocks(output, input, run_len));
+    HARDENED_TRY(aes_end(NULL));
+
+    // Advance the IV past the blocks just processed (inc32 `run_len` times).
+    iv->data[kAesBlockNumWords - 1] =
+        __builtin_bswap32(ctr + (uint32_t)run_len);
+    input += run_len * kAesBlockNumBytes;
+    output += run_len * kAesBlockNumBytes;
+    num_blocks -= run_len;
+  }
+  return OTCRYPTO_OK;
+}
+
 /**
  * Run GCTR on exactly one block of input.
  *
@@ -83,9 +127,8 @@ static status_t aes_encrypt_block(const aes_key_t key, const aes_block_t *iv,
 OT_WARN_UNUSED_RESULT
 static status_t gctr_process_block(const aes_key_t key, aes_block_t *iv,
                                    aes_block_t *input, aes_block_t *output) {
-  HARDENED_TRY(aes_encrypt_block(key, iv, input, output));
-  block_inc32(iv);
-  return OTCRYPTO_OK;
+  return gctr_process_blocks(key, iv, 1, (const uint8_t *)input->data,
+                             (uint8_t *)output->data);
 }
 
 /**
@@ -127,35 +170,33 @@ static status_t aes_gcm_gctr(const aes_key_t key, aes_block_t *iv,
     return OTCRYPTO_BAD_ARGS;
   }
 
+  *output_len = 0;
   if (input_len < kAesBlockNumBytes - partial_len) {
     // Not enough data for a full block; copy into the partial block.
     unsigned char *partial_bytes = (unsigned char *)partial->data;
     memcpy(partial_bytes + partial_len, input, input_len);
   } else {
-    // Construct a block from the partial data and the start of the new data.
-    unsigned char *partial_bytes = (unsigned char *)partial->data;
-    memcpy(partial_bytes + partial_len, input, kAesBlockNumBytes - partial_len);
-    input += kAesBlockNumBytes - partial_len;
-    input_len -= kAesBlockNumBytes - partial_len;
-
-    // Process the block.
-    aes_block_t block_out;
-    HARDENED_TRY(gctr_process_block(key, iv, partial, &block_out));
-    memcpy(output, block_out.data, kAesBlockNumBytes);
-    output += kAesBlockNumBytes;
-    *output_len = kAesBlockNumBytes;
-
-    // Process any remaining full blocks of input.
-    while (input_len >= kAesBlockNumBytes) {
-      memcpy(partial->data, input, kAesBlockNumBytes);
-      HARDENED_TRY(gctr_process_block(key, iv, partial, &block_out));
-      memcpy(output, block_out.data, kAesBlockNumBytes);
+    if (partial_len != 0) {
+      // Complete the partial block with the start of the new data and
+      // process it.
+      unsigned char *partial_bytes = (unsigned char *)partial->data;
+      memcpy(partial_bytes + partial_len, input,
+             kAesBlockNumBytes - partial_len);
+      input += kAesBlockNumBytes - partial_len;
+      input_len -= kAesBlockNumBytes - partial_len;
+      HARDENED_TRY(gctr_process_blocks(key, iv, 1, partial_bytes, output));
       output += kAesBlockNumBytes;
-      *output_len += kAesBlockNumBytes;
-      input += kAesBlockNumBytes;
-      input_len -= kAesBlockNumBytes;
+      *output_len = kAesBlockNumBytes;
     }
 
+    // Process all remaining full blocks of input directly from the input
+    // buffer.
+    size_t num_blocks = input_len / kAesBlockNumBytes;
+    HARDENED_TRY(gctr_process_blocks(key, iv, num_blocks, input, output));
+    input += num_blocks * kAesBlockNumBytes;
+    input_len -= num_blocks * kAesBlockNumBytes;
+    *output_len += num_blocks * kAesBlockNumBytes;
+
     // Copy any remaining input into the partial block.
     memcpy(partial->data, input, input_len);
   }
@@ -197,7 +238,7 @@ static status_t aes_gcm_hash_subkey(const aes_key_t key, ghash_context_t *ctx) {
  *
  * @param iv_len IV length in 32-bit words
  * @param iv IV value
- * @param ctx GHASH context with product table for hash subkey H
+ * @param ctx GHASH context with powers of the hash subkey H
  * @param[out] j0 Destination for the output counter block
  * @return OK or error
  */
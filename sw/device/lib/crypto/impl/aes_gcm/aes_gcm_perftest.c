@@ -0,0 +1,77 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/crypto/drivers/aes.h"
+#include "sw/device/lib/crypto/drivers/entropy.h"
+#include "sw/device/lib/crypto/impl/aes_gcm/aes_gcm.h"
+#include "sw/device/lib/runtime/ibex.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+OTTF_DEFINE_TEST_CONFIG();
+
+enum {
+  kNumBytes = 4096,
+  kTagNumWords = 4,
+};
+
+// Key and IV from test case 16 of the GCM specification.
+static const uint32_t kKeyShare0[8] = {
+    0x92e9fffe, 0x1c736586, 0x948f6a6d, 0x08833067,
+    0x92e9fffe, 0x1c736586, 0x948f6a6d, 0x08833067,
+};
+static const uint32_t kKeyShare1[8] = {0};
+static const uint32_t kIv[3] = {0xbebafeca, 0xaddbcefa, 0x88f8cade};
+
+static uint8_t plaintext[kNumBytes];
+static uint8_t ciphertext[kNumBytes];
+static uint8_t recovered[kNumBytes];
+
+/**
+ * Logs a cycle count as hundredths of a cycle per byte.
+ */
+static void log_cycles_per_byte(const char *name, uint64_t cycles) {
+  CHECK(cycles <= UINT32_MAX);
+  uint32_t cycles32 = (uint32_t)cycles;
+  LOG_INFO("AES-256-GCM %s, %d bytes: %d cycles, %d.%02d cycles/byte.", name,
+           kNumBytes, cycles32, cycles32 / kNumBytes,
+           (cycles32 * 100 / kNumBytes) % 100);
+}
+
+bool test_main(void) {
+  CHECK_STATUS_OK(entropy_complex_init());
+  for (size_t i = 0; i < ARRAYSIZE(plaintext); ++i) {
+    plaintext[i] = i & UINT8_MAX;
+  }
+
+  aes_key_t key = {
+      .mode = kAesCipherModeCtr,
+      .sideload = kHardenedBoolFalse,
+      .key_len = ARRAYSIZE(kKeyShare0),
+      .key_shares = {kKeyShare0, kKeyShare1},
+  };
+
+  uint32_t tag[kTagNumWords];
+  uint64_t start_cycles = ibex_mcycle_read();
+  CHECK_STATUS_OK(aes_gcm_encrypt(key, ARRAYSIZE(kIv), kIv, kNumBytes,
+                                  plaintext, /*aad_len=*/0, /*aad=*/NULL,
+                                  kTagNumWords, tag, ciphertext));
+  log_cycles_per_byte("encrypt", ibex_mcycle_read() - start_cycles);
+
+  hardened_bool_t success;
+  start_cycles = ibex_mcycle_read();
+  CHECK_STATUS_OK(aes_gcm_decrypt(key, ARRAYSIZE(kIv), kIv, kNumBytes,
+                                  ciphertext, /*aad_len=*/0, /*aad=*/NULL,
+                                  kTagNumWords, tag, recovered, &success));
+  log_cycles_per_byte("decrypt", ibex_mcycle_read() - start_cycles);
+
+  CHECK(success == kHardenedBoolTrue);
+  CHECK_ARRAYS_EQ(recovered, plaintext, kNumBytes);
+  return true;
+}
@@ -10,158 +10,223 @@
 // Module ID for status codes.
 #define MODULE_ID MAKE_MODULE_ID('g', 'h', 'a')
 
-enum {
+/**
+ * An element of the GCM Galois field in the internal representation.
+ *
+ * NIST represents field elements as bit strings in which the first bit is the
+ * coefficient of x^0. Reading a block as a big-endian 128-bit integer
+ * therefore puts the coefficient of x^i at bit (127 - i), i.e. the integer is
+ * the bit-reflected polynomial. Carry-less multiplication of two reflected
+ * operands yields the reflected product shifted right by one bit, so field
+ * multiplication needs byte swaps but no bit reversals.
+ */
+typedef struct ghash_elem {
   /**
-   * Log2 of the number of bytes in an AES block.
+   * Least significant 64 bits of the reflected polynomial (x^64..x^127).
    */
-  kGhashBlockLog2NumBytes = 4,
+  uint64_t lo;
   /**
-   * Number of windows for Galois field pre-computed tables.
-   *
-   * We suse 4-bit windows, so the number of windows is 2x the number of bytes
-   * in a block.
+   * Most significant 64 bits of the reflected polynomial (x^0..x^63).
    */
-  kNumWindows = kGhashBlockNumBytes << 1,
-};
-static_assert(kGhashBlockNumBytes == (1 << kGhashBlockLog2NumBytes),
-              "kGhashBlockLog2NumBytes does not match kGhashBlockNumBytes");
+  uint64_t hi;
+} ghash_elem_t;
 
 /**
- * Precomputed modular reduction constants for Galois field multiplication.
+ * Unreduced 255-bit product of two field elements, as a 256-bit integer.
  *
- * This implementation uses 4-bit windows. The bytes here represent 12-bit
- * little-endian values.
+ * Products can be added (XORed) before a single reduction.
+ */
+typedef struct ghash_wide {
+  uint64_t w[4];
+} ghash_wide_t;
+
+/**
+ * Carry-less multiplication of two 32-bit words.
  *
- * The entry with index i in this table is equal to i * 0xe1, where the bytes i
- * and 0xe1 are interpreted as polynomials in the GCM Galois field. For
- * example, 0xe1 = 0b1110_0001 is the degree-8 polynomial x^8 + x^2 + x + 1.
+ * On the device, this uses the `clmul` and `clmulh` instructions of the Zbc
+ * bitmanip extension, which Ibex implements. The host version computes the
+ * same product without data-dependent branches or memory accesses.
  *
- * The field modulus for GCM is 2^128 + x^8 + x^2 + x + 1. Therefore, if a
- * field element is shifted, it can be reduced by multiplying the high bits
- * (128 and above) by 0xe1 and adding them to the low bits.
+ * @param a First operand.
+ * @param b Second operand.
+ * @return 64-bit carry-less product of `a` and `b`.
+ */
+OT_WARN_UNUSED_RESULT
+static inline uint64_t clmul32(uint32_t a, uint32_t b) {
+#ifdef OT_PLATFORM_RV32
+  uint32_t lo;
+  uint32_t hi;
+  asm(".option push;"
+      ".option arch, +zbc;"
+      "clmul %0, %2, %3;"
+      "clmulh %1, %2, %3;"
+      ".option pop;"
+      : "=&r"(lo), "=r"(hi)
+      : "r"(a), "r"(b));
+  return ((uint64_t)hi << 32) | lo;
+#else
+  uint64_t result = 0;
+  for (size_t i = 0; i < 32; ++i) {
+    uint64_t mask = 0 - (uint64_t)((b >> i) & 1);
+    result ^= ((uint64_t)a << i) & mask;
+  }
+  return result;
+#endif
+}
+
+/**
+ * Carry-less multiplication of two 64-bit words (Karatsuba).
  *
- * There is a size/speed tradeoff in window size. For 8-bit windows, GHASH
- * becomes significantly faster, but the overhead for computing the product
- * table of a given hash subkey becomes higher, so larger windows are slower
- * for smaller inputs but faster for large inputs.
+ * @param a First operand.
+ * @param b Second operand.
+ * @param[out] lo Low 64 bits of the product.
+ * @param[out] hi High 64 bits of the product.
  */
-static const uint16_t kGFReduceTable[16] = {
-    0x0000, 0x201c, 0x4038, 0x6024, 0x8070, 0xa06c, 0xc048, 0xe054,
-    0x00e1, 0x20fd, 0x40d9, 0x60c5, 0x8091, 0xa08d, 0xc0a9, 0xe0b5};
+static inline void clmul64(uint64_t a, uint64_t b, uint64_t *lo,
+                           uint64_t *hi) {
+  uint32_t a0 = (uint32_t)a;
+  uint32_t a1 = (uint32_t)(a >> 32);
+  uint32_t b0 = (uint32_t)b;
+  uint32_t b1 = (uint32_t)(b >> 32);
+  uint64_t p0 = clmul32(a0, b0);
+  uint64_t p2 = clmul32(a1, b1);
+  uint64_t p1 = clmul32(a0 ^ a1, b0 ^ b1) ^ p0 ^ p2;
+  *lo = p0 ^ (p1 << 32);
+  *hi = p2 ^ (p1 >> 32);
+}
 
 /**
- * Performs a bitwise XOR of two blocks.
+ * Adds the unreduced product of two field elements to an accumulator.
  *
- * This operation corresponds to addition in the Galois field.
+ * Uses one level of Karatsuba on top of `clmul64`, i.e. nine 32-bit
+ * carry-less multiplications per product.
  *
- * @param x First operand block
- * @param y Second operand block
- * @param[out] out Buffer in which to store output; can be the same as one or
- * both operands.
+ * @param x First operand.
+ * @param y Second operand.
+ * @param acc Accumulator, updated in place.
  */
-static inline void block_xor(const ghash_block_t *x, const ghash_block_t *y,
-                             ghash_block_t *out) {
-  for (size_t i = 0; i < kGhashBlockNumWords; ++i) {
-    out->data[i] = x->data[i] ^ y->data[i];
-  }
+static inline void ghash_mul_acc(const ghash_elem_t *x, const ghash_elem_t *y,
+                                 ghash_wide_t *acc) {
+  uint64_t l0, l1, h0, h1, m0, m1;
+  clmul64(x->lo, y->lo, &l0, &l1);
+  clmul64(x->hi, y->hi, &h0, &h1);
+  clmul64(x->lo ^ x->hi, y->lo ^ y->hi, &m0, &m1);
+  m0 ^= l0 ^ h0;
+  m1 ^= l1 ^ h1;
+  acc->w[0] ^= l0;
+  acc->w[1] ^= l1 ^ m0;
+  acc->w[2] ^= h0 ^ m1;
+  acc->w[3] ^= h1;
 }
 
 /**
- * Logical right shift of an AES block.
+ * Reduces an unreduced product modulo the GCM field polynomial.
+ *
+ * The field modulus is x^128 + x^7 + x^2 + x + 1. After shifting the product
+ * left by one bit to undo the reflection offset, the upper 128 bits hold the
+ * coefficients of x^0..x^127 and the lower 128 bits those of x^128..x^255.
+ * The lower half is folded into the upper one by multiplying it with
+ * x^7 + x^2 + x + 1, which in the reflected representation is a sum of right
+ * shifts; the bits that those shifts move below bit 0 are folded in the same
+ * way first. See Gueron and Kounavis, "Intel Carry-Less Multiplication
+ * Instruction and its Usage for Computing the GCM Mode", algorithm 5.
  *
- * NIST represents AES blocks as big-endian, and a "right shift" in that
- * representation means shifting out the LSB. However, the processor is
- * little-endian, so we need to reverse the bytes before shifting.
+ * Runs in constant time.
  *
- * @param block Input AES block, modified in-place
- * @param nbits Number of bits to shift
+ * @param acc Unreduced product.
+ * @param[out] out Reduced field element.
  */
-static inline void block_shiftr(ghash_block_t *block, size_t nbits) {
-  // To perform a "right shift" with respect to the big-endian block
-  // representation, we traverse the words of the block and, for each word,
-  // reverse the bytes, save the new LSB as `carry`, shift right, set the MSB
-  // to the last block's carry, and then reverse the bytes back.
-  uint32_t carry = 0;
-  for (size_t i = 0; i < kGhashBlockNumWords; ++i) {
-    uint32_t rev = __builtin_bswap32(block->data[i]);
-    uint32_t next_carry = rev & ((1 << nbits) - 1);
-    rev >>= nbits;
-    rev |= carry << (32 - nbits);
-    carry = next_carry;
-    block->data[i] = __builtin_bswap32(rev);
-  }
+static inline void ghash_reduce(const ghash_wide_t *acc, ghash_elem_t *out) {
+  uint64_t x0 = acc->w[0] << 1;
+  uint64_t x1 = (acc->w[1] << 1) | (acc->w[0] >> 63);
+  uint64_t x2 = (acc->w[2] << 1) | (acc->w[1] >> 63);
+  uint64_t x3 = (acc->w[3] << 1) | (acc->w[2] >> 63);
+
+  uint64_t d = x1 ^ (x0 << 63) ^ (x0 << 62) ^ (x0 << 57);
+  out->lo = x2 ^ x0 ^ (x0 >> 1) ^ (d << 63) ^ (x0 >> 2) ^ (d << 62) ^
+            (x0 >> 7) ^ (d << 57);
+  out->hi = x3 ^ d ^ (d >> 1) ^ (d >> 2) ^ (d >> 7);
 }
 
 /**
- * Retrieve the byte at a given index from the block.
+ * Multiply two elements of the GCM Galois field.
  *
- * @param block Input cipher block
- * @param index Index of byte to retrieve (must be < `kGhashBlockNumBytes`)
- * @return Value of block[index]
+ * @param x First operand.
+ * @param y Second operand.
+ * @param[out] out Product; may be the same as either operand.
  */
-static inline uint8_t block_byte_get(const ghash_block_t *block, size_t index) {
-  return ((char *)block->data)[index];
+static void ghash_mul(const ghash_elem_t *x, const ghash_elem_t *y,
+                      ghash_elem_t *out) {
+  ghash_wide_t acc = {.w = {0}};
+  ghash_mul_acc(x, y, &acc);
+  ghash_reduce(&acc, out);
 }
 
 /**
- * Multiply an element of the GCM Galois field by the polynomial `x`.
+ * Convert 16 bytes in GHASH block order to the internal representation.
  *
- * This corresponds to a shift right in the bit representation, and then
- * reduction with the field modulus.
+ * @param bytes Input bytes; need not be word-aligned.
+ * @param[out] out Field element.
+ */
+static inline void ghash_elem_load(const uint8_t *bytes, ghash_elem_t *out) {
+  out->hi = ((uint64_t)__builtin_bswap32(read_32(bytes)) << 32) |
+            __builtin_bswap32(read_32(bytes + 4));
+  out->lo = ((uint64_t)__builtin_bswap32(read_32(bytes + 8)) << 32) |
+            __builtin_bswap32(read_32(bytes + 12));
+}
+
+/**
+ * Convert a field element to a GHASH block.
  *
- * Runs in constant time.
+ * @param x Field element.
+ * @param[out] block Output block.
+ */
+static inline void ghash_elem_store(const ghash_elem_t *x,
+                                    ghash_block_t *block) {
+  block->data[0] = __builtin_bswap32((uint32_t)(x->hi >> 32));
+  block->data[1] = __builtin_bswap32((uint32_t)x->hi);
+  block->data[2] = __builtin_bswap32((uint32_t)(x->lo >> 32));
+  block->data[3] = __builtin_bswap32((uint32_t)x->lo);
+}
+
+/**
+ * Retrieve a precomputed subkey power from the context.
  *
- * @param p Polynomial to be multiplied
- * @param[out] out Buffer for output
+ * @param ctx GHASH context.
+ * @param i Index of the power; entry i holds H^(i + 1).
+ * @param[out] out Field element.
  */
-static inline void galois_mulx(const ghash_block_t *p, ghash_block_t *out) {
-  // Get the very rightmost bit of the input block (coefficient of x^127).
-  uint8_t p127 = block_byte_get(p, kGhashBlockNumBytes - 1) & 1;
-  // Set the output to p >> 1.
-  memcpy(out->data, p->data, kGhashBlockNumBytes);
-  block_shiftr(out, 1);
-  // If the highest coefficient was 1, then subtract the polynomial that
-  // corresponds to (modulus - 2^128).
-  uint32_t mask = 0 - p127;
-  out->data[0] ^= (0xe1 & mask);
+static inline void subkey_power_get(const ghash_context_t *ctx, size_t i,
+                                    ghash_elem_t *out) {
+  const uint32_t *words = ctx->subkey_powers[i].data;
+  out->lo = ((uint64_t)words[1] << 32) | words[0];
+  out->hi = ((uint64_t)words[3] << 32) | words[2];
 }
 
 /**
- * Reverse the bits of a 4-bit number.
+ * Store a subkey power in the context.
  *
- * @param byte Input byte.
- * @return byte with lower 4 bits reversed and upper 4 unmodified.
+ * @param x Field element.
+ * @param i Index of the power; entry i holds H^(i + 1).
+ * @param ctx GHASH context.
  */
-static uint8_t reverse_bits(uint8_t byte) {
-  /* TODO: replace with rev.n (from 0.93 draft of bitmanip) once bitmanip
-   * extension is enabled. */
-  uint8_t out = 0;
-  for (size_t i = 0; i < 4; ++i) {
-    out <<= 1;
-    out |= (byte >> i) & 1;
-  }
-  return out;
+static inline void subkey_power_set(const ghash_elem_t *x, size_t i,
+                                    ghash_context_t *ctx) {
+  uint32_t *words = ctx->subkey_powers[i].data;
+  words[0] = (uint32_t)x->lo;
+  words[1] = (uint32_t)(x->lo >> 32);
+  words[2] = (uint32_t)x->hi;
+  words[3] = (uint32_t)(x->hi >> 32);
 }
 
 void ghash_init_subkey(const uint32_t *hash_subkey, ghash_context_t *ctx) {
-  // Initialize 0 * H = 0.
-  memset(ctx->tbl[0].data, 0, kGhashBlockNumBytes);
-  // Initialize 1 * H = H.
-  memcpy(ctx->tbl[0x8].data, hash_subkey, kGhashBlockNumBytes);
-
-  // To get remaining entries, we use a variant of "shift and add"; in
-  // polynomial terms, a shift is a multiplication by x. Note that, because the
-  // processor represents bytes with the MSB on the left and NIST uses a fully
-  // little-endian polynomial representation with the MSB on the right, we have
-  // to reverse the bits of the indices.
-  for (uint8_t i = 2; i < 16; i += 2) {
-    // Find the product corresponding to (i >> 1) * H and multiply by x to
-    // shift 1; this will be i * H.
-    galois_mulx(&ctx->tbl[reverse_bits(i >> 1)], &ctx->tbl[reverse_bits(i)]);
-
-    // Add H to i * H to get (i + 1) * H.
-    block_xor(&ctx->tbl[reverse_bits(i)], &ctx->tbl[0x8],
-              &ctx->tbl[reverse_bits(i + 1)]);
+  ghash_elem_t h;
+  ghash_elem_load((const uint8_t *)hash_subkey, &h);
+  ghash_elem_t power = h;
+  subkey_power_set(&power, 0, ctx);
+  for (size_t i = 1; i < kGhashNumSubkeyPowers; ++i) {
+    ghash_mul(&power, &h, &power);
+    subkey_power_set(&power, i, ctx);
   }
 }
 
@@ -170,80 +235,48 @@ void ghash_init(ghash_context_t *ctx) {
 }
 
 /**
- * Multiply the GHASH state by the hash subkey.
+ * Multi-block update function for GHASH.
  *
- * See NIST SP800-38D, section 6.3.
- *
- * The NIST documentation shows a very slow double-and-add algorithm, which
- * iterates through the first operand bit-by-bit. However, since the second
- * operand is always the hash subkey H, we can speed things up significantly
- * with precomputed tables.
+ * See NIST SP800-38D, section 6.4. For each block X_i, the state is updated to
+ * (state + X_i) * H. Four blocks at a time, this is equivalent to
+ *   state' = (state + X_1) * H^4 + X_2 * H^3 + X_3 * H^2 + X_4 * H,
+ * so the four products are added before a single modular reduction.
  *
  * This operation corresponds to multiplication in the Galois field with order
- * 2^128, modulo the polynomial x^128 +  x^8 + x^2 + x + 1
+ * 2^128, modulo the polynomial x^128 + x^7 + x^2 + x + 1.
  *
  * @param ctx GHASH context, updated in place.
+ * @param input Input blocks; need not be word-aligned.
+ * @param num_blocks Number of blocks to process.
  */
-static void galois_mul_state_key(ghash_context_t *ctx) {
-  // Initialize the multiplication result to 0.
-  ghash_block_t result;
-  memset(result.data, 0, kGhashBlockNumBytes);
-
-  // To compute the product, we iterate through the bytes of the input block,
-  // considering the most significant (in polynomial terms) first. For each
-  // byte b, we:
-  //   * multiply `result` by x^8 (shift all coefficients to the right)
-  //   * reduce the shifted `result` modulo the field modulus
-  //   * look up the product `b * H` and add it to `result`
-  //
-  // We can skip the shift and reduce steps on the first iteration, since
-  // `result` is 0.
-  for (size_t i = 0; i < kNumWindows; ++i) {
-    if (i != 0) {
-      // Save the most significant half-byte of `result` before shifting.
-      uint8_t overflow =
-          block_byte_get(&result, kGhashBlockNumBytes - 1) & 0x0f;
-      // Shift `result` to the right, discarding high bits.
-      block_shiftr(&result, 4);
-      // Look up the product of `overflow` and the low terms of the modulus in
-      // the precomputed table.
-      uint16_t reduce_term = kGFReduceTable[overflow];
-      // Add (xor) this product to the low bits to complete modular reduction.
-      // This works because (low + x^128 * high) is equivalent to (low + (x^128
-      // - modulus) * high).
-      result.data[0] ^= reduce_term;
-    }
+static void ghash_process_blocks(ghash_context_t *ctx, const uint8_t *input,
+                                 size_t num_blocks) {
+  ghash_elem_t state;
+  ghash_elem_load((const uint8_t *)ctx->state.data, &state);
 
-    // Add the product of the next window and H to `result`. We process the
-    // windows starting with the most significant polynomial terms, which means
-    // starting from the last byte and proceeding to the first.
-    uint8_t tbl_index = block_byte_get(&ctx->state, (kNumWindows - 1 - i) >> 1);
+  ghash_elem_t powers[kGhashNumSubkeyPowers];
+  for (size_t i = 0; i < kGhashNumSubkeyPowers; ++i) {
+    subkey_power_get(ctx, i, &powers[i]);
+  }
 
-    // Select the less significant 4 bits if i is even, or the more significant
-    // 4 bits if i is odd. This does not need to be constant time, since the
-    // values of i in this loop are constant.
-    if ((i & 1) == 1) {
-      tbl_index >>= 4;
-    } else {
-      tbl_index &= 0x0f;
+  while (num_blocks > 0) {
+    size_t n = num_blocks < kGhashNumSubkeyPowers ? 1 : kGhashNumSubkeyPowers;
+    ghash_wide_t acc = {.w = {0}};
+    for (size_t i = 0; i < n; ++i) {
+      ghash_elem_t x;
+      ghash_elem_load(input, &x);
+      if (i == 0) {
+        x.lo ^= state.lo;
+        x.hi ^= state.hi;
+      }
+      ghash_mul_acc(&x, &powers[n - 1 - i], &acc);
+      input += kGhashBlockNumBytes;
     }
-    block_xor(&result, &ctx->tbl[tbl_index], &result);
+    ghash_reduce(&acc, &state);
+    num_blocks -= n;
   }
 
-  memcpy(ctx->state.data, result.data, kGhashBlockNumBytes);
-}
-
-/**
- * Single-block update function for GHASH.
- *
- * @param ctx GHASH context.
- * @param block Block to incorporate.
- */
-static void ghash_process_block(ghash_context_t *ctx, ghash_block_t *block) {
-  // XOR `state` with the next input block.
-  block_xor(&ctx->state, block, &ctx->state);
-  // Multiply state by H in-place.
-  galois_mul_state_key(ctx);
+  ghash_elem_store(&state, &ctx->state);
 }
 
 void ghash_process_full_blocks(ghash_context_t *ctx, size_t partial_len,
@@ -262,15 +295,14 @@ void ghash_process_full_blocks(ghash_context_t *ctx, size_t partial_len,
     input_len -= kGhashBlockNumBytes - partial_len;
 
     // Process the block.
-    ghash_process_block(ctx, partial);
+    ghash_process_blocks(ctx, partial_bytes, 1);
 
-    // Process any remaining full blocks of input.
-    while (input_len >= kGhashBlockNumBytes) {
-      memcpy(partial->data, input, kGhashBlockNumBytes);
-      ghash_process_block(ctx, partial);
-      input += kGhashBlockNumBytes;
-      input_len -= kGhashBlockNumBytes;
-    }
+    // Process any remaining full blocks of input directly from the input
+    // buffer.
+    size_t num_blocks = input_len / kGhashBlockNumBytes;
+    ghash_process_blocks(ctx, input, num_blocks);
+    input += num_blocks * kGhashBlockNumBytes;
+    input_len -= num_blocks * kGhashBlockNumBytes;
 
     // Copy any remaining input into the partial block.
     memcpy(partial->data, input, input_len);
@@ -289,7 +321,7 @@ void ghash_update(ghash_context_t *ctx, size_t input_len,
   if (partial_len != 0) {
     unsigned char *partial_bytes = (unsigned char *)partial.data;
     memset(partial_bytes + partial_len, 0, kGhashBlockNumBytes - partial_len);
-    ghash_process_block(ctx, &partial);
+    ghash_process_blocks(ctx, partial_bytes, 1);
   }
 }
 
@@ -21,6 +21,13 @@ enum {
    * Size of a GHASH cipher block (128 bits) in words.
    */
   kGhashBlockNumWords = kGhashBlockNumBytes / sizeof(uint32_t),
+  /**
+   * Number of precomputed powers of the hash subkey.
+   *
+   * This is also the number of blocks that GHASH processes with a single
+   * modular reduction.
+   */
+  kGhashNumSubkeyPowers = 4,
 };
 
 /**
@@ -32,9 +39,12 @@ typedef struct ghash_block {
 
 typedef struct ghash_context {
   /**
-   * Precomputed product table for the hash subkey.
+   * Precomputed powers H, H^2, ..., H^4 of the hash subkey H.
+   *
+   * The powers are stored in the internal representation of `ghash.c`, not
+   * in the byte order of a GHASH block.
    */
-  ghash_block_t tbl[16];
+  ghash_block_t subkey_powers[kGhashNumSubkeyPowers];
   /**
    * Cipher block representing the current GHASH state.
    */
@@ -44,18 +54,18 @@ typedef struct ghash_context {
 /**
  * Precompute hash subkey information for GHASH.
  *
- * This routine will precompute a product table for the hash subkey for the
- * GHASH context. It will not set the state to 0; call `ghash_init` afterwards.
+ * This routine will precompute the powers of the hash subkey for the GHASH
+ * context. It will not set the state to 0; call `ghash_init` afterwards.
  *
  * This operation should only be called once per key, and afterwards the
  * context object can be used for multiple separate GHASH operations with that
  * key. The reason for separating this and `ghash_init` into two functions is
- * that computing the product table is computationally expensive, and some GCM
+ * that computing the powers takes several field multiplications, and some GCM
  * computations need to compute more than one separate GHASH operation.
  *
  * @param hash_subkey Subkey for the GHASH operation (`kGhashBlockNumWords`
  * words).
- * @param[out] ctx Context object with product table populated.
+ * @param[out] ctx Context object with the subkey powers populated.
  */
 void ghash_init_subkey(const uint32_t *hash_subkey, ghash_context_t *ctx);
 
@@ -63,7 +73,7 @@ void ghash_init_subkey(const uint32_t *hash_subkey, ghash_context_t *ctx);
  * Start a GHASH operation.
  *
  * This routine will initialize the GHASH state within the context object to
- * zero. It will not precompute the key product table; call `ghash_init_subkey`
+ * zero. It will not precompute the subkey powers; call `ghash_init_subkey`
  * first.
  *
  * @param[out] ctx Context object with GHASH state reset to zero.
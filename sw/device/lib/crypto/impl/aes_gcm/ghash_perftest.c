@@ -0,0 +1,76 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/crypto/impl/aes_gcm/ghash.h"
+#include "sw/device/lib/runtime/ibex.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+OTTF_DEFINE_TEST_CONFIG();
+
+// Hash subkey from test case 18 of the GCM specification.
+static const uint32_t kHashSubkey[kGhashBlockNumWords] = {
+    0x05f2beac,
+    0xebb8b479,
+    0xac9b88ce,
+    0xd7da3287,
+};
+
+// GHASH of the 4096-byte buffer filled in `test_main`.
+static const uint32_t kExpectedResult[kGhashBlockNumWords] = {
+    0xa88317b8,
+    0x1f903ed8,
+    0x617ed280,
+    0xe78bd963,
+};
+
+bool test_main(void) {
+  uint8_t buf[4096];
+  for (size_t i = 0; i < ARRAYSIZE(buf); ++i) {
+    buf[i] = i & UINT8_MAX;
+  }
+
+  const size_t kNumRepetitions = 10;
+  for (size_t i = 0; i < kNumRepetitions; ++i) {
+    ghash_context_t ctx;
+    uint64_t start_cycles = ibex_mcycle_read();
+    ghash_init_subkey(kHashSubkey, &ctx);
+    const uint64_t subkey_cycles = ibex_mcycle_read() - start_cycles;
+
+    start_cycles = ibex_mcycle_read();
+    ghash_init(&ctx);
+    ghash_update(&ctx, sizeof(buf), buf);
+    uint32_t result[kGhashBlockNumWords];
+    ghash_final(&ctx, result);
+    const uint64_t update_cycles = ibex_mcycle_read() - start_cycles;
+
+    CHECK(update_cycles <= UINT32_MAX);
+    LOG_INFO("GHASH subkey setup in %d cycles, %d bytes in %d cycles.",
+             (uint32_t)subkey_cycles, sizeof(buf), (uint32_t)update_cycles);
+
+    CHECK_ARRAYS_EQ(result, kExpectedResult, kGhashBlockNumWords);
+  }
+
+  // Also time one block at a time, as for short AES-GCM messages.
+  ghash_context_t ctx;
+  ghash_init_subkey(kHashSubkey, &ctx);
+  ghash_init(&ctx);
+  const uint64_t start_cycles = ibex_mcycle_read();
+  for (size_t i = 0; i < sizeof(buf); i += kGhashBlockNumBytes) {
+    ghash_update(&ctx, kGhashBlockNumBytes, &buf[i]);
+  }
+  const uint64_t block_cycles = ibex_mcycle_read() - start_cycles;
+  CHECK(block_cycles <= UINT32_MAX);
+  LOG_INFO("GHASH %d bytes one block at a time in %d cycles.", sizeof(buf),
+           (uint32_t)block_cycles);
+  uint32_t result[kGhashBlockNumWords];
+  ghash_final(&ctx, result);
+  CHECK_ARRAYS_EQ(result, kExpectedResult, kGhashBlockNumWords);
+  return true;
+}
@@ -4,6 +4,7 @@
 
 #include "sw/device/lib/crypto/impl/aes_gcm/ghash.h"
 
+#include <algorithm>
 #include <array>
 
 #include "gmock/gmock.h"
@@ -156,6 +157,59 @@ TEST(Ghash, McGrawViegaTestCase2) {
   EXPECT_THAT(result, testing::ElementsAreArray(exp_result));
 }
 
+TEST(Ghash, McGrawViegaTestCase3) {
+  // GHASH computation from test case 3 of:
+  // https://csrc.nist.rip/groups/ST/toolkit/BCM/documents/proposedmodes/gcm/gcm-spec.pdf
+  //
+  // The ciphertext is exactly four blocks long, so it is processed with a
+  // single aggregated reduction.
+  //
+  // H: b83b533708bf535d0aa6e52980d53b78
+  // A: empty
+  // C:
+  // 42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091473f5985
+  // GHASH(H,A,C): 7f1b32b81b820d02614f8895ac1d4eac
+  std::array<uint32_t, 4> H = {
+      0x37533bb8,
+      0x5d53bf08,
+      0x29e5a60a,
+      0x783bd580,
+  };
+  std::array<uint32_t, 0> A = {};
+  std::array<uint32_t, 16> C = {
+      0xc21e8342, 0x24747721, 0xb721724b, 0x9cd4d084, 0x2f21aae3, 0xe0a4022c,
+      0x237ec135, 0x2ea1ac29, 0xb214d521, 0x1c936654, 0x5a6a8f7d, 0x05aa84ac,
+      0x390ba31b, 0x97ac0a6a, 0x91e0583d, 0x85593f47,
+  };
+  std::array<uint32_t, 4> exp_result = {
+      0xb8321b7f,
+      0x020d821b,
+      0x95884f61,
+      0xac4e1dac,
+  };
+
+  // Encode bitlengths of A and C as big-endian 64-bit integers.
+  std::array<uint64_t, 2> bitlengths = {
+      A.size() * sizeof(uint32_t) * 8,
+      C.size() * sizeof(uint32_t) * 8,
+  };
+  bitlengths[0] = __builtin_bswap64(bitlengths[0]);
+  bitlengths[1] = __builtin_bswap64(bitlengths[1]);
+
+  // Compute GHASH(H, A, C).
+  ghash_context_t ctx;
+  ghash_init_subkey(H.data(), &ctx);
+  ghash_init(&ctx);
+  ghash_update(&ctx, A.size() * sizeof(uint32_t), (unsigned char *)A.data());
+  ghash_update(&ctx, C.size() * sizeof(uint32_t), (unsigned char *)C.data());
+  ghash_update(&ctx, bitlengths.size() * sizeof(uint64_t),
+               (unsigned char *)bitlengths.data());
+  uint32_t result[kGhashBlockNumWords];
+  ghash_final(&ctx, result);
+
+  EXPECT_THAT(result, testing::ElementsAreArray(exp_result));
+}
+
 TEST(Ghash, ContextReset) {
   // Run a test case twice to ensure that (a) the hash state is properly reset
   // by `init()`, so that the result is correct both times and (b) the hash
@@ -266,5 +320,46 @@ TEST(Ghash, McGrawViegaTestCase18) {
   EXPECT_THAT(result, testing::ElementsAreArray(exp_result));
 }
 
+TEST(Ghash, ProcessFullBlocksSplit) {
+  // Processing a message in pieces of any size, starting at any alignment,
+  // must give the same state as processing it at once. This mixes single
+  // blocks with aggregated groups of blocks.
+  std::array<uint32_t, 4> H = {
+      0x05f2beac,
+      0xebb8b479,
+      0xac9b88ce,
+      0xd7da3287,
+  };
+  std::array<uint8_t, 16 * 11 + 3> input;
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<uint8_t>(i * 37 + 11);
+  }
+  const size_t kMsgLen = 16 * 11;
+
+  for (size_t offset = 0; offset < 4; ++offset) {
+    ghash_context_t exp_ctx;
+    ghash_init_subkey(H.data(), &exp_ctx);
+    ghash_init(&exp_ctx);
+    ghash_update(&exp_ctx, kMsgLen, &input[offset]);
+
+    for (size_t piece_len = 1; piece_len <= kMsgLen; ++piece_len) {
+      ghash_context_t ctx;
+      ghash_init_subkey(H.data(), &ctx);
+      ghash_init(&ctx);
+      ghash_block_t partial = {.data = {0}};
+      size_t partial_len = 0;
+      for (size_t i = 0; i < kMsgLen; i += piece_len) {
+        size_t len = std::min(piece_len, kMsgLen - i);
+        ghash_process_full_blocks(&ctx, partial_len, &partial, len,
+                                  &input[offset + i]);
+        partial_len = (partial_len + len) % kGhashBlockNumBytes;
+      }
+      EXPECT_EQ(partial_len, 0);
+      EXPECT_THAT(ctx.state.data, ElementsAreArray(exp_ctx.state.data))
+          << "offset " << offset << ", piece length " << piece_len;
+    }
+  }
+}
+
 }  // namespace
 }  // namespace ghash_unittest
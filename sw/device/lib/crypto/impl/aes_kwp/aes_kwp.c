@@ -68,8 +68,10 @@ status_t aes_kwp_wrap(const aes_key_t kek, const uint32_t *plaintext,
       // Copy R[i] into the block (A should already be present).
       hardened_memcpy(block.data + kSemiblockWords,
                       ciphertext + i * kSemiblockWords, kSemiblockWords);
-      HARDENED_TRY(aes_update(/*dest=*/NULL, &block));
-      HARDENED_TRY(aes_update(&block, /*src=*/NULL));
+      // Each block depends on the previous output, so there is nothing to
+      // overlap; run the single block through the hardware.
+      HARDENED_TRY(aes_update_blocks((uint8_t *)block.data,
+                                     (const uint8_t *)block.data, 1));
 
       // Encode the index and XOR it with the first semiblock, creating A for
       // the next iteration.
@@ -133,8 +135,8 @@ status_t aes_kwp_unwrap(const aes_key_t kek, const uint32_t *ciphertext,
       // Copy R[i] into the block (A ^ t should already be present).
       hardened_memcpy(block.data + kSemiblockWords,
                       r + (i - 1) * kSemiblockWords, kSemiblockWords);
-      HARDENED_TRY(aes_update(/*dest=*/NULL, &block));
-      HARDENED_TRY(aes_update(&block, /*src=*/NULL));
+      HARDENED_TRY(aes_update_blocks((uint8_t *)block.data,
+                                     (const uint8_t *)block.data, 1));
 
       // Copy the last two words back into R[i].
       hardened_memcpy(r + (i - 1) * kSemiblockWords,
@@ -4,8 +4,10 @@
 
 #include "sw/device/lib/crypto/include/drbg.h"
 
+#include "sw/device/lib/base/hardened.h"
 #include "sw/device/lib/base/hardened_memory.h"
 #include "sw/device/lib/base/math.h"
+#include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/crypto/drivers/entropy.h"
 #include "sw/device/lib/crypto/impl/status.h"
 #include "sw/device/lib/crypto/include/datatypes.h"
@@ -13,6 +15,58 @@
 // Module ID for status codes.
 #define MODULE_ID MAKE_MODULE_ID('r', 'b', 'g')
 
+enum {
+  /**
+   * Number of words buffered by a DRBG output pool.
+   *
+   * This is a multiple of the CSRNG output block size (128 bits), so refills
+   * do not discard any output.
+   */
+  kDrbgPoolWords = 32,
+};
+
+/**
+ * Internal state of a DRBG output pool.
+ */
+typedef struct drbg_pool_state {
+  /**
+   * Buffered DRBG output.
+   */
+  uint32_t buffer[kDrbgPoolWords];
+  /**
+   * Index of the next unused word in `buffer` (`kDrbgPoolWords` if empty).
+   */
+  uint32_t offset;
+  /**
+   * SW CSRNG seed epoch when `buffer` was filled.
+   *
+   * Output pools discard buffered output from an older epoch instead of
+   * serving it after a reseed, including reseeds done elsewhere in the
+   * library.
+   */
+  uint32_t epoch;
+  /**
+   * Number of refills since the last reseed.
+   */
+  uint32_t refills;
+  /**
+   * Number of refills between automatic reseeds (0 to disable).
+   */
+  uint32_t reseed_interval;
+  /**
+   * Whether to reseed before every request.
+   */
+  hardened_bool_t prediction_resistance;
+  /**
+   * Whether the pool is initialized.
+   */
+  hardened_bool_t initialized;
+} drbg_pool_state_t;
+
+static_assert(sizeof(((otcrypto_drbg_pool_t *)NULL)->data) >=
+                  sizeof(drbg_pool_state_t),
+              "DRBG pool object must be big enough to hold the pool state.");
+
 /**
  * Construct seed material for the CSRNG.
  *
@@ -200,6 +254,137 @@ otcrypto_status_t otcrypto_drbg_manual_generate(
                   drbg_output);
 }
 
+/**
+ * Discard any buffered output in a DRBG output pool.
+ *
+ * @param state Pool state.
+ */
+static void pool_empty(drbg_pool_state_t *state) {
+  hardened_memshred(state->buffer, kDrbgPoolWords);
+  state->offset = kDrbgPoolWords;
+}
+
+/**
+ * Fill an empty DRBG output pool.
+ *
+ * Reseeds first if the pool's reseed interval has elapsed.
+ *
+ * @param state Pool state.
+ * @return Result status; OK or error
+ */
+static otcrypto_status_t pool_refill(drbg_pool_state_t *state) {
+  HARDENED_CHECK_EQ(state->offset, kDrbgPoolWords);
+  if (state->reseed_interval != 0 &&
+      state->refills >= state->reseed_interval) {
+    HARDENED_TRY(otcrypto_drbg_reseed(
+        (otcrypto_const_byte_buf_t){.data = NULL, .len = 0}));
+    state->refills = 0;
+  }
+
+  // The buffer stays marked as empty unless generation succeeds.
+  state->epoch = entropy_csrng_seed_epoch();
+  HARDENED_TRY(entropy_csrng_generate(&kEntropyEmptySeed, state->buffer,
+                                      kDrbgPoolWords,
+                                      /*fips_check=*/kHardenedBoolTrue));
+  state->offset = 0;
+  state->refills++;
+  return OTCRYPTO_OK;
+}
+
+otcrypto_status_t otcrypto_drbg_pool_init(
+    otcrypto_drbg_pool_t *pool, size_t reseed_interval,
+    hardened_bool_t prediction_resistance) {
+  if (pool == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  if (prediction_resistance != kHardenedBoolTrue &&
+      prediction_resistance != kHardenedBoolFalse) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  drbg_pool_state_t *state = (drbg_pool_state_t *)pool->data;
+  memset(pool->data, 0, sizeof(pool->data));
+  pool_empty(state);
+  state->epoch = entropy_csrng_seed_epoch();
+  state->refills = 0;
+  state->reseed_interval = (uint32_t)reseed_interval;
+  state->prediction_resistance = prediction_resistance;
+  state->initialized = kHardenedBoolTrue;
+  return OTCRYPTO_OK;
+}
+
+otcrypto_status_t otcrypto_drbg_pool_generate(
+    otcrypto_drbg_pool_t *pool, otcrypto_const_byte_buf_t additional_input,
+    otcrypto_word32_buf_t drbg_output) {
+  if (pool == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  drbg_pool_state_t *state = (drbg_pool_state_t *)pool->data;
+  if (launder32(state->initialized) != kHardenedBoolTrue ||
+      state->offset > kDrbgPoolWords) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(state->initialized, kHardenedBoolTrue);
+
+  if (launder32(state->prediction_resistance) == kHardenedBoolTrue) {
+    // Every request needs fresh entropy, so nothing can come from the buffer.
+    HARDENED_CHECK_EQ(state->prediction_resistance, kHardenedBoolTrue);
+    HARDENED_TRY(otcrypto_drbg_reseed(
+        (otcrypto_const_byte_buf_t){.data = NULL, .len = 0}));
+    return generate(/*fips_check=*/kHardenedBoolTrue, additional_input,
+                    drbg_output);
+  }
+  HARDENED_CHECK_EQ(state->prediction_resistance, kHardenedBoolFalse);
+
+  // Additional input only affects output generated with it, and large
+  // requests gain nothing from buffering; send both straight to the DRBG.
+  if (additional_input.len != 0 || drbg_output.len >= kDrbgPoolWords) {
+    return generate(/*fips_check=*/kHardenedBoolTrue, additional_input,
+                    drbg_output);
+  }
+  if (drbg_output.len == 0) {
+    // Nothing to do.
+    return OTCRYPTO_OK;
+  }
+  if (drbg_output.data == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Never serve output from before the last (re)seed.
+  if (state->epoch != entropy_csrng_seed_epoch()) {
+    pool_empty(state);
+    state->refills = 0;
+  }
+
+  uint32_t *dest = drbg_output.data;
+  size_t remaining = drbg_output.len;
+  while (remaining > 0) {
+    if (state->offset == kDrbgPoolWords) {
+      HARDENED_TRY(pool_refill(state));
+    }
+    size_t available = kDrbgPoolWords - state->offset;
+    size_t len = remaining < available ? remaining : available;
+    hardened_memcpy(dest, &state->buffer[state->offset], len);
+    // Shred the words that were handed out so they cannot be served twice.
+    hardened_memshred(&state->buffer[state->offset], len);
+    state->offset += len;
+    dest += len;
+    remaining -= len;
+  }
+  return OTCRYPTO_OK;
+}
+
+otcrypto_status_t otcrypto_drbg_pool_clear(otcrypto_drbg_pool_t *pool) {
+  if (pool == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  drbg_pool_state_t *state = (drbg_pool_state_t *)pool->data;
+  pool_empty(state);
+  hardened_memshred(pool->data, ARRAYSIZE(pool->data));
+  state->initialized = kHardenedBoolFalse;
+  return OTCRYPTO_OK;
+}
+
 otcrypto_status_t otcrypto_drbg_uninstantiate(void) {
   return entropy_csrng_uninstantiate();
 }
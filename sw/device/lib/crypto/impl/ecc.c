@@ -10,6 +10,8 @@
 #include "sw/device/lib/crypto/impl/ecc/ecdh_p384.h"
 #include "sw/device/lib/crypto/impl/ecc/ecdsa_p256.h"
 #include "sw/device/lib/crypto/impl/ecc/ecdsa_p384.h"
+#include "sw/device/lib/crypto/impl/ecc/ed25519.h"
+#include "sw/device/lib/crypto/impl/ecc/x25519.h"
 #include "sw/device/lib/crypto/impl/integrity.h"
 #include "sw/device/lib/crypto/impl/keyblob.h"
 #include "sw/device/lib/crypto/include/datatypes.h"
@@ -66,16 +68,17 @@ otcrypto_status_t otcrypto_ecdh(const otcrypto_blinded_key_t *private_key,
 
 otcrypto_status_t otcrypto_ed25519_keygen(
     otcrypto_blinded_key_t *private_key, otcrypto_unblinded_key_t *public_key) {
-  // TODO: Ed25519 is not yet implemented.
-  return OTCRYPTO_NOT_IMPLEMENTED;
+  HARDENED_TRY(otcrypto_ed25519_keygen_async_start(private_key));
+  return otcrypto_ed25519_keygen_async_finalize(private_key, public_key);
 }
 
 otcrypto_status_t otcrypto_ed25519_sign(
     const otcrypto_blinded_key_t *private_key,
     otcrypto_const_byte_buf_t input_message,
     otcrypto_eddsa_sign_mode_t sign_mode, otcrypto_word32_buf_t signature) {
-  // TODO: Ed25519 is not yet implemented.
-  return OTCRYPTO_NOT_IMPLEMENTED;
+  HARDENED_TRY(otcrypto_ed25519_sign_async_start(private_key, input_message,
+                                                 sign_mode, signature));
+  return otcrypto_ed25519_sign_async_finalize(signature);
 }
 
 otcrypto_status_t otcrypto_ed25519_verify(
@@ -83,21 +86,22 @@ otcrypto_status_t otcrypto_ed25519_verify(
     otcrypto_const_byte_buf_t input_message,
     otcrypto_eddsa_sign_mode_t sign_mode, otcrypto_const_word32_buf_t signature,
     hardened_bool_t *verification_result) {
-  // TODO: Ed25519 is not yet implemented.
-  return OTCRYPTO_NOT_IMPLEMENTED;
+  HARDENED_TRY(otcrypto_ed25519_verify_async_start(public_key, input_message,
+                                                   sign_mode, signature));
+  return otcrypto_ed25519_verify_async_finalize(verification_result);
 }
 
 otcrypto_status_t otcrypto_x25519_keygen(otcrypto_blinded_key_t *private_key,
                                          otcrypto_unblinded_key_t *public_key) {
-  // TODO: Connect X25519 operations to API.
-  return OTCRYPTO_NOT_IMPLEMENTED;
+  HARDENED_TRY(otcrypto_x25519_keygen_async_start(private_key));
+  return otcrypto_x25519_keygen_async_finalize(private_key, public_key);
 }
 
 otcrypto_status_t otcrypto_x25519(const otcrypto_blinded_key_t *private_key,
                                   const otcrypto_unblinded_key_t *public_key,
                                   otcrypto_blinded_key_t *shared_secret) {
-  // TODO: Connect X25519 operations to API.
-  return OTCRYPTO_NOT_IMPLEMENTED;
+  HARDENED_TRY(otcrypto_x25519_async_start(private_key, public_key));
+  return otcrypto_x25519_async_finalize(shared_secret);
 }
 
 /**
@@ -1243,30 +1247,248 @@ otcrypto_status_t otcrypto_ecdh_async_finalize(
   return keymgr_sideload_clear_otbn();
 }
 
+/**
+ * Check the lengths of private keys for Ed25519.
+ *
+ * Checks the length of caller-allocated buffers for an Ed25519 private key.
+ *
+ * If this check passes and `hw_backed` is false, it is safe to interpret
+ * `private_key->keyblob` as an `ed25519_masked_seed_t *`.
+ *
+ * @param private_key Private key struct to check.
+ * @return OK if the lengths are correct or BAD_ARGS otherwise.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t ed25519_private_key_length_check(
+    const otcrypto_blinded_key_t *private_key) {
+  if (private_key->keyblob == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Check the unmasked length.
+  if (launder32(private_key->config.key_length) != kEd25519Bytes) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(private_key->config.key_length, kEd25519Bytes);
+
+  // Check the single-share length.
+  if (launder32(keyblob_share_num_words(private_key->config)) !=
+      kEd25519MaskedSeedShareWords) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(keyblob_share_num_words(private_key->config),
+                    kEd25519MaskedSeedShareWords);
+
+  // Check the keyblob length.
+  if (launder32(private_key->keyblob_length) != sizeof(ed25519_masked_seed_t)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(private_key->keyblob_length, sizeof(ed25519_masked_seed_t));
+
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Check the lengths of public keys for Ed25519.
+ *
+ * If this check passes, it is safe to interpret public_key->key as an
+ * `ed25519_point_t *`.
+ *
+ * @param public_key Public key struct to check.
+ * @return OK if the lengths are correct or BAD_ARGS otherwise.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t ed25519_public_key_length_check(
+    const otcrypto_unblinded_key_t *public_key) {
+  if (launder32(public_key->key_length) != sizeof(ed25519_point_t)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(public_key->key_length, sizeof(ed25519_point_t));
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Check the length of a signature buffer for Ed25519.
+ *
+ * If this check passes on `signature.len`, it is safe to interpret
+ * `signature.data` as `ed25519_signature_t *`.
+ *
+ * @param len Length to check.
+ * @return OK if the lengths are correct or BAD_ARGS otherwise.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t ed25519_signature_length_check(size_t len) {
+  if (launder32(len) > UINT32_MAX / sizeof(uint32_t) ||
+      launder32(len) * sizeof(uint32_t) != sizeof(ed25519_signature_t)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(len * sizeof(uint32_t), sizeof(ed25519_signature_t));
+
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Check the message and signature mode for Ed25519.
+ *
+ * @param input_message Input message.
+ * @param sign_mode EdDSA mode (pure or prehashed).
+ * @param[out] prehashed Whether the message is a SHA-512 prehash.
+ * @return OK if the arguments are valid or BAD_ARGS otherwise.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t ed25519_sign_mode_check(otcrypto_const_byte_buf_t input_message,
+                                        otcrypto_eddsa_sign_mode_t sign_mode,
+                                        hardened_bool_t *prehashed) {
+  if (input_message.data == NULL && input_message.len != 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  switch (launder32(sign_mode)) {
+    case kOtcryptoEddsaSignModeEddsa:
+      HARDENED_CHECK_EQ(sign_mode, kOtcryptoEddsaSignModeEddsa);
+      *prehashed = kHardenedBoolFalse;
+      return OTCRYPTO_OK;
+    case kOtcryptoEddsaSignModeHashEddsa:
+      HARDENED_CHECK_EQ(sign_mode, kOtcryptoEddsaSignModeHashEddsa);
+      // The caller passes the SHA-512 digest of the message.
+      if (launder32(input_message.len) != kEd25519PrehashBytes) {
+        return OTCRYPTO_BAD_ARGS;
+      }
+      HARDENED_CHECK_EQ(input_message.len, kEd25519PrehashBytes);
+      *prehashed = kHardenedBoolTrue;
+      return OTCRYPTO_OK;
+    default:
+      return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Should never get here.
+  HARDENED_TRAP();
+  return OTCRYPTO_FATAL_ERR;
+}
+
 otcrypto_status_t otcrypto_ed25519_keygen_async_start(
     const otcrypto_blinded_key_t *private_key) {
-  // TODO: Ed25519 is not yet implemented.
-  return OTCRYPTO_NOT_IMPLEMENTED;
+  if (private_key == NULL || private_key->keyblob == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Check the key mode.
+  if (launder32(private_key->config.key_mode) != kOtcryptoKeyModeEd25519) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(private_key->config.key_mode, kOtcryptoKeyModeEd25519);
+
+  // Check that the entropy complex is initialized.
+  HARDENED_TRY(entropy_complex_check());
+
+  if (launder32(private_key->config.hw_backed) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(private_key->config.hw_backed, kHardenedBoolTrue);
+    // TODO: Sideloaded Ed25519 keys need the seed to be hashed, which the
+    // sideload path to OTBN does not support.
+    return OTCRYPTO_NOT_IMPLEMENTED;
+  } else if (launder32(private_key->config.hw_backed) == kHardenedBoolFalse) {
+    HARDENED_CHECK_EQ(private_key->config.hw_backed, kHardenedBoolFalse);
+    return ed25519_keygen_start();
+  }
+
+  // Invalid value for `hw_backed`.
+  return OTCRYPTO_BAD_ARGS;
 }
 
 otcrypto_status_t otcrypto_ed25519_keygen_async_finalize(
     otcrypto_blinded_key_t *private_key, otcrypto_unblinded_key_t *public_key) {
-  // TODO: Ed25519 is not yet implemented.
-  return OTCRYPTO_NOT_IMPLEMENTED;
+  // Check for any NULL pointers.
+  if (private_key == NULL || public_key == NULL ||
+      private_key->keyblob == NULL || public_key->key == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Check the key modes.
+  if (launder32(private_key->config.key_mode) != kOtcryptoKeyModeEd25519 ||
+      launder32(public_key->key_mode) != kOtcryptoKeyModeEd25519) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(private_key->config.key_mode, kOtcryptoKeyModeEd25519);
+  HARDENED_CHECK_EQ(public_key->key_mode, kOtcryptoKeyModeEd25519);
+
+  if (launder32(private_key->config.hw_backed) != kHardenedBoolFalse) {
+    // Only non-sideloaded keys can be started; see the start function.
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(private_key->config.hw_backed, kHardenedBoolFalse);
+
+  // Check the lengths of caller-allocated buffers.
+  HARDENED_TRY(ed25519_private_key_length_check(private_key));
+  HARDENED_TRY(ed25519_public_key_length_check(public_key));
+  ed25519_masked_seed_t *sk = (ed25519_masked_seed_t *)private_key->keyblob;
+  ed25519_point_t *pk = (ed25519_point_t *)public_key->key;
+
+  // Note: This operation wipes DMEM after retrieving the keys, so if an error
+  // occurs after this point then the keys would be unrecoverable. This should
+  // be the last potentially error-causing line before returning to the caller.
+  HARDENED_TRY(ed25519_keygen_finalize(sk, pk));
+
+  private_key->checksum = integrity_blinded_checksum(private_key);
+  public_key->checksum = integrity_unblinded_checksum(public_key);
+  return OTCRYPTO_OK;
 }
 
 otcrypto_status_t otcrypto_ed25519_sign_async_start(
     const otcrypto_blinded_key_t *private_key,
     otcrypto_const_byte_buf_t input_message,
     otcrypto_eddsa_sign_mode_t sign_mode, otcrypto_word32_buf_t signature) {
-  // TODO: Ed25519 is not yet implemented.
-  return OTCRYPTO_NOT_IMPLEMENTED;
+  if (private_key == NULL || private_key->keyblob == NULL ||
+      signature.data == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Check the integrity of the private key.
+  if (launder32(integrity_blinded_key_check(private_key)) !=
+      kHardenedBoolTrue) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(integrity_blinded_key_check(private_key),
+                    kHardenedBoolTrue);
+
+  // Check the private key mode.
+  if (launder32(private_key->config.key_mode) != kOtcryptoKeyModeEd25519) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(private_key->config.key_mode, kOtcryptoKeyModeEd25519);
+
+  if (launder32(private_key->config.hw_backed) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(private_key->config.hw_backed, kHardenedBoolTrue);
+    // TODO: Implement sideloaded signing (see keygen).
+    return OTCRYPTO_NOT_IMPLEMENTED;
+  } else if (launder32(private_key->config.hw_backed) != kHardenedBoolFalse) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(private_key->config.hw_backed, kHardenedBoolFalse);
+
+  // Check the lengths and the signature mode.
+  HARDENED_TRY(ed25519_private_key_length_check(private_key));
+  HARDENED_TRY(ed25519_signature_length_check(signature.len));
+  hardened_bool_t prehashed;
+  HARDENED_TRY(ed25519_sign_mode_check(input_message, sign_mode, &prehashed));
+  ed25519_masked_seed_t *sk = (ed25519_masked_seed_t *)private_key->keyblob;
+
+  // Start the asynchronous signature-generation routine.
+  return ed25519_sign_start(sk, input_message.data, input_message.len,
+                            prehashed);
 }
 
 otcrypto_status_t otcrypto_ed25519_sign_async_finalize(
     otcrypto_word32_buf_t signature) {
-  // TODO: Ed25519 is not yet implemented.
-  return OTCRYPTO_NOT_IMPLEMENTED;
+  if (signature.data == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_TRY(ed25519_signature_length_check(signature.len));
+  ed25519_signature_t *sig = (ed25519_signature_t *)signature.data;
+
+  // Note: This operation wipes DMEM, so if an error occurs after this point
+  // then the signature would be unrecoverable. This should be the last
+  // potentially error-causing line before returning to the caller.
+  return ed25519_sign_finalize(sig);
 }
 
 otcrypto_status_t otcrypto_ed25519_verify_async_start(
@@ -1274,37 +1496,272 @@ otcrypto_status_t otcrypto_ed25519_verify_async_start(
     otcrypto_const_byte_buf_t input_message,
     otcrypto_eddsa_sign_mode_t sign_mode,
     otcrypto_const_word32_buf_t signature) {
-  // TODO: Ed25519 is not yet implemented.
-  return OTCRYPTO_NOT_IMPLEMENTED;
+  if (public_key == NULL || public_key->key == NULL ||
+      signature.data == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Check the public key mode.
+  if (launder32(public_key->key_mode) != kOtcryptoKeyModeEd25519) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(public_key->key_mode, kOtcryptoKeyModeEd25519);
+
+  // Check the integrity of the public key.
+  if (launder32(integrity_unblinded_key_check(public_key)) !=
+      kHardenedBoolTrue) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(integrity_unblinded_key_check(public_key),
+                    kHardenedBoolTrue);
+
+  // Check the lengths and the signature mode.
+  HARDENED_TRY(ed25519_public_key_length_check(public_key));
+  HARDENED_TRY(ed25519_signature_length_check(signature.len));
+  hardened_bool_t prehashed;
+  HARDENED_TRY(ed25519_sign_mode_check(input_message, sign_mode, &prehashed));
+  ed25519_point_t *pk = (ed25519_point_t *)public_key->key;
+  ed25519_signature_t *sig = (ed25519_signature_t *)signature.data;
+
+  // Start the asynchronous signature-verification routine.
+  return ed25519_verify_start(sig, pk, input_message.data, input_message.len,
+                              prehashed);
 }
 
 otcrypto_status_t otcrypto_ed25519_verify_async_finalize(
     hardened_bool_t *verification_result) {
-  // TODO: Ed25519 is not yet implemented.
-  return OTCRYPTO_NOT_IMPLEMENTED;
+  if (verification_result == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  return ed25519_verify_finalize(verification_result);
+}
+
+/**
+ * Check the lengths of private keys for X25519.
+ *
+ * Checks the length of caller-allocated buffers for an X25519 private key.
+ *
+ * If this check passes and `hw_backed` is false, it is safe to interpret
+ * `private_key->keyblob` as an `x25519_masked_scalar_t *`.
+ *
+ * @param private_key Private key struct to check.
+ * @return OK if the lengths are correct or BAD_ARGS otherwise.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t x25519_private_key_length_check(
+    const otcrypto_blinded_key_t *private_key) {
+  if (private_key->keyblob == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  if (launder32(private_key->config.hw_backed) == kHardenedBoolTrue) {
+    // Skip the length check in this case; if the salt is the wrong length, the
+    // keyblob library will catch it before we sideload the key.
+    return OTCRYPTO_OK;
+  }
+  HARDENED_CHECK_NE(private_key->config.hw_backed, kHardenedBoolTrue);
+
+  // Check the unmasked length.
+  if (launder32(private_key->config.key_length) != kX25519Bytes) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(private_key->config.key_length, kX25519Bytes);
+
+  // Check the single-share length.
+  if (launder32(keyblob_share_num_words(private_key->config)) !=
+      kX25519MaskedScalarShareWords) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(keyblob_share_num_words(private_key->config),
+                    kX25519MaskedScalarShareWords);
+
+  // Check the keyblob length.
+  if (launder32(private_key->keyblob_length) !=
+      sizeof(x25519_masked_scalar_t)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(private_key->keyblob_length,
+                    sizeof(x25519_masked_scalar_t));
+
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Check the lengths of public keys for X25519.
+ *
+ * If this check passes, it is safe to interpret public_key->key as an
+ * `x25519_point_t *`.
+ *
+ * @param public_key Public key struct to check.
+ * @return OK if the lengths are correct or BAD_ARGS otherwise.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t x25519_public_key_length_check(
+    const otcrypto_unblinded_key_t *public_key) {
+  if (launder32(public_key->key_length) != sizeof(x25519_point_t)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(public_key->key_length, sizeof(x25519_point_t));
+  return OTCRYPTO_OK;
 }
 
 otcrypto_status_t otcrypto_x25519_keygen_async_start(
     const otcrypto_blinded_key_t *private_key) {
-  // TODO: X25519 is not yet implemented.
-  return OTCRYPTO_NOT_IMPLEMENTED;
+  if (private_key == NULL || private_key->keyblob == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Check the key mode.
+  if (launder32(private_key->config.key_mode) != kOtcryptoKeyModeX25519) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(private_key->config.key_mode, kOtcryptoKeyModeX25519);
+
+  // Check that the entropy complex is initialized.
+  HARDENED_TRY(entropy_complex_check());
+
+  if (launder32(private_key->config.hw_backed) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(private_key->config.hw_backed, kHardenedBoolTrue);
+    HARDENED_TRY(sideload_key_seed(private_key));
+    return x25519_sideload_keypair_start();
+  } else if (launder32(private_key->config.hw_backed) == kHardenedBoolFalse) {
+    HARDENED_CHECK_EQ(private_key->config.hw_backed, kHardenedBoolFalse);
+    return x25519_keypair_start();
+  }
+
+  // Invalid value for `hw_backed`.
+  return OTCRYPTO_BAD_ARGS;
 }
 
 otcrypto_status_t otcrypto_x25519_keygen_async_finalize(
     otcrypto_blinded_key_t *private_key, otcrypto_unblinded_key_t *public_key) {
-  // TODO: X25519 is not yet implemented.
-  return OTCRYPTO_NOT_IMPLEMENTED;
+  // Check for any NULL pointers.
+  if (private_key == NULL || public_key == NULL ||
+      private_key->keyblob == NULL || public_key->key == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Check the key modes.
+  if (launder32(private_key->config.key_mode) != kOtcryptoKeyModeX25519 ||
+      launder32(public_key->key_mode) != kOtcryptoKeyModeX25519) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(private_key->config.key_mode, kOtcryptoKeyModeX25519);
+  HARDENED_CHECK_EQ(public_key->key_mode, kOtcryptoKeyModeX25519);
+
+  // Check the lengths of caller-allocated buffers.
+  HARDENED_TRY(x25519_private_key_length_check(private_key));
+  HARDENED_TRY(x25519_public_key_length_check(public_key));
+  x25519_point_t *pk = (x25519_point_t *)public_key->key;
+
+  // Note: The `finalize` operations wipe DMEM after retrieving the keys, so if
+  // an error occurs after this point then the keys would be unrecoverable.
+  // The `finalize` call should be the last potentially error-causing line
+  // before returning to the caller.
+
+  if (launder32(private_key->config.hw_backed) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(private_key->config.hw_backed, kHardenedBoolTrue);
+    HARDENED_TRY(x25519_sideload_keypair_finalize(pk));
+  } else if (launder32(private_key->config.hw_backed) == kHardenedBoolFalse) {
+    HARDENED_CHECK_EQ(private_key->config.hw_backed, kHardenedBoolFalse);
+    x25519_masked_scalar_t *sk = (x25519_masked_scalar_t *)private_key->keyblob;
+    HARDENED_TRY(x25519_keypair_finalize(sk, pk));
+    private_key->checksum = integrity_blinded_checksum(private_key);
+  } else {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Prepare the public key.
+  public_key->checksum = integrity_unblinded_checksum(public_key);
+
+  // Clear the OTBN sideload slot (in case the seed was sideloaded).
+  return keymgr_sideload_clear_otbn();
 }
 
 otcrypto_status_t otcrypto_x25519_async_start(
     const otcrypto_blinded_key_t *private_key,
     const otcrypto_unblinded_key_t *public_key) {
-  // TODO: X25519 is not yet implemented.
-  return OTCRYPTO_NOT_IMPLEMENTED;
+  if (private_key == NULL || public_key == NULL || public_key->key == NULL ||
+      private_key->keyblob == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Check the integrity of the keys.
+  if (launder32(integrity_blinded_key_check(private_key)) !=
+          kHardenedBoolTrue ||
+      launder32(integrity_unblinded_key_check(public_key)) !=
+          kHardenedBoolTrue) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(integrity_blinded_key_check(private_key),
+                    kHardenedBoolTrue);
+  HARDENED_CHECK_EQ(integrity_unblinded_key_check(public_key),
+                    kHardenedBoolTrue);
+
+  // Check the key modes.
+  if (launder32(private_key->config.key_mode) != kOtcryptoKeyModeX25519 ||
+      launder32(public_key->key_mode) != kOtcryptoKeyModeX25519) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(private_key->config.key_mode, kOtcryptoKeyModeX25519);
+  HARDENED_CHECK_EQ(public_key->key_mode, kOtcryptoKeyModeX25519);
+
+  // Check the lengths of the keys.
+  HARDENED_TRY(x25519_private_key_length_check(private_key));
+  HARDENED_TRY(x25519_public_key_length_check(public_key));
+  x25519_point_t *pk = (x25519_point_t *)public_key->key;
+
+  if (launder32(private_key->config.hw_backed) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(private_key->config.hw_backed, kHardenedBoolTrue);
+    HARDENED_TRY(sideload_key_seed(private_key));
+    return x25519_sideload_shared_key_start(pk);
+  } else if (launder32(private_key->config.hw_backed) == kHardenedBoolFalse) {
+    HARDENED_CHECK_EQ(private_key->config.hw_backed, kHardenedBoolFalse);
+    x25519_masked_scalar_t *sk = (x25519_masked_scalar_t *)private_key->keyblob;
+    return x25519_shared_key_start(sk, pk);
+  }
+
+  // Invalid value for `hw_backed`.
+  return OTCRYPTO_BAD_ARGS;
 }
 
 otcrypto_status_t otcrypto_x25519_async_finalize(
     otcrypto_blinded_key_t *shared_secret) {
-  // TODO: X25519 is not yet implemented.
-  return OTCRYPTO_NOT_IMPLEMENTED;
+  if (shared_secret == NULL || shared_secret->keyblob == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  if (launder32(shared_secret->config.hw_backed) != kHardenedBoolFalse) {
+    // Shared keys cannot be sideloaded because they are software-generated.
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(shared_secret->config.hw_backed, kHardenedBoolFalse);
+
+  if (launder32(shared_secret->config.key_length) != kX25519Bytes) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(shared_secret->config.key_length, kX25519Bytes);
+
+  if (launder32(shared_secret->keyblob_length) !=
+      keyblob_num_words(shared_secret->config) * sizeof(uint32_t)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(
+      shared_secret->keyblob_length,
+      keyblob_num_words(shared_secret->config) * sizeof(uint32_t));
+
+  // Note: This operation wipes DMEM after retrieving the keys, so if an error
+  // occurs after this point then the keys would be unrecoverable. This should
+  // be the last potentially error-causing line before returning to the caller.
+  x25519_shared_key_t ss;
+  HARDENED_TRY(x25519_shared_key_finalize(&ss));
+
+  keyblob_from_shares(ss.share0, ss.share1, shared_secret->config,
+                      shared_secret->keyblob);
+
+  // Set the checksum.
+  shared_secret->checksum = integrity_blinded_checksum(shared_secret);
+
+  // Clear the OTBN sideload slot (in case the seed was sideloaded).
+  return keymgr_sideload_clear_otbn();
 }
@@ -0,0 +1,461 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/crypto/impl/ecc/ed25519.h"
+
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/hardened_memory.h"
+#include "sw/device/lib/crypto/drivers/entropy.h"
+#include "sw/device/lib/crypto/drivers/hmac.h"
+#include "sw/device/lib/crypto/drivers/otbn.h"
+
+// Module ID for status codes.
+#define MODULE_ID MAKE_MODULE_ID('e', '2', '5')
+
+OTBN_DECLARE_APP_SYMBOLS(run_ed25519);               // The OTBN Ed25519 app.
+OTBN_DECLARE_SYMBOL_ADDR(run_ed25519, mode);         // Application mode.
+OTBN_DECLARE_SYMBOL_ADDR(run_ed25519, ok);           // Verification status.
+OTBN_DECLARE_SYMBOL_ADDR(run_ed25519, seed0);        // Private key (share 0).
+OTBN_DECLARE_SYMBOL_ADDR(run_ed25519, seed1);        // Private key (share 1).
+OTBN_DECLARE_SYMBOL_ADDR(run_ed25519, scalar);       // Secret scalar s.
+OTBN_DECLARE_SYMBOL_ADDR(run_ed25519, hash_r);       // Nonce hash.
+OTBN_DECLARE_SYMBOL_ADDR(run_ed25519, hash_k);       // Challenge hash.
+OTBN_DECLARE_SYMBOL_ADDR(run_ed25519, enc_r);        // Signature R.
+OTBN_DECLARE_SYMBOL_ADDR(run_ed25519, sig_s);        // Signature S.
+OTBN_DECLARE_SYMBOL_ADDR(run_ed25519, enc_a);        // Public key.
+OTBN_DECLARE_SYMBOL_ADDR(run_ed25519, enc_r_check);  // Recovered R.
+
+static const otbn_app_t kOtbnAppEd25519 = OTBN_APP_T_INIT(run_ed25519);
+static const otbn_addr_t kOtbnVarEd25519Mode =
+    OTBN_ADDR_T_INIT(run_ed25519, mode);
+static const otbn_addr_t kOtbnVarEd25519Ok = OTBN_ADDR_T_INIT(run_ed25519, ok);
+static const otbn_addr_t kOtbnVarEd25519Seed0 =
+    OTBN_ADDR_T_INIT(run_ed25519, seed0);
+static const otbn_addr_t kOtbnVarEd25519Seed1 =
+    OTBN_ADDR_T_INIT(run_ed25519, seed1);
+static const otbn_addr_t kOtbnVarEd25519Scalar =
+    OTBN_ADDR_T_INIT(run_ed25519, scalar);
+static const otbn_addr_t kOtbnVarEd25519HashR =
+    OTBN_ADDR_T_INIT(run_ed25519, hash_r);
+static const otbn_addr_t kOtbnVarEd25519HashK =
+    OTBN_ADDR_T_INIT(run_ed25519, hash_k);
+static const otbn_addr_t kOtbnVarEd25519EncR =
+    OTBN_ADDR_T_INIT(run_ed25519, enc_r);
+static const otbn_addr_t kOtbnVarEd25519SigS =
+    OTBN_ADDR_T_INIT(run_ed25519, sig_s);
+static const otbn_addr_t kOtbnVarEd25519EncA =
+    OTBN_ADDR_T_INIT(run_ed25519, enc_a);
+static const otbn_addr_t kOtbnVarEd25519EncRCheck =
+    OTBN_ADDR_T_INIT(run_ed25519, enc_r_check);
+
+enum {
+  /*
+   * Mode is represented by a single word.
+   */
+  kOtbnEd25519ModeWords = 1,
+  /*
+   * Mode to compute a public key.
+   */
+  kOtbnEd25519ModeKeygen = 0x3d4,
+  /*
+   * Mode to run the first stage of signing.
+   */
+  kOtbnEd25519ModeSign = 0x15b,
+  /*
+   * Mode to verify a signature.
+   */
+  kOtbnEd25519ModeVerify = 0x727,
+  /*
+   * Mode to run the second stage of signing.
+   */
+  kOtbnEd25519ModeSignFinalize = 0x5e8,
+  /*
+   * Number of words in a SHA-512 digest.
+   */
+  kEd25519HashWords = 512 / 32,
+};
+
+/**
+ * Domain separation prefix dom2(1, "") for Ed25519ph (RFC 8032, section 2).
+ */
+static const uint8_t kEd25519phDom2[] = {
+    'S', 'i', 'g', 'E', 'd', '2', '5', '5', '1', '9', ' ', 'n',
+    'o', ' ', 'E', 'd', '2', '5', '5', '1', '9', ' ', 'c', 'o',
+    'l', 'l', 'i', 's', 'i', 'o', 'n', 's', 0x01, 0x00,
+};
+
+/**
+ * Start a SHA-512 computation, adding the dom2 prefix if needed.
+ *
+ * Also checks that the message length matches a SHA-512 digest if the
+ * message is prehashed.
+ *
+ * @param prehashed Whether this is an Ed25519ph operation.
+ * @param message_len Length of the message (or digest) in bytes.
+ * @param[out] ctx Hash context to initialize.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+static status_t hash_init(hardened_bool_t prehashed, size_t message_len,
+                          hmac_ctx_t *ctx) {
+  HARDENED_TRY(hmac_init(ctx, kHmacModeSha512, /*key=*/NULL));
+  if (launder32(prehashed) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(prehashed, kHardenedBoolTrue);
+    if (message_len != kEd25519PrehashBytes) {
+      return OTCRYPTO_BAD_ARGS;
+    }
+    return hmac_update(ctx, kEd25519phDom2, sizeof(kEd25519phDom2));
+  } else if (launder32(prehashed) != kHardenedBoolFalse) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(prehashed, kHardenedBoolFalse);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Finish a SHA-512 computation.
+ *
+ * @param ctx Hash context.
+ * @param[out] digest Buffer for the digest.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+static status_t hash_final(hmac_ctx_t *ctx,
+                           uint32_t digest[kEd25519HashWords]) {
+  hmac_digest_t hmac_digest = {
+      .len = kEd25519HashWords * sizeof(uint32_t),
+  };
+  HARDENED_TRY(hmac_final(ctx, &hmac_digest));
+  hardened_memcpy(digest, hmac_digest.digest, kEd25519HashWords);
+  hardened_memshred(hmac_digest.digest, kEd25519HashWords);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Compute SHA-512(dom2 || R || A || M), the challenge hash.
+ *
+ * @param enc_r Encoded commitment R.
+ * @param enc_a Encoded public key A.
+ * @param message Message (or digest).
+ * @param message_len Length of message in bytes.
+ * @param prehashed Whether this is an Ed25519ph operation.
+ * @param[out] digest Buffer for the digest.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+static status_t challenge_hash(const uint32_t enc_r[kEd25519Words],
+                               const uint32_t enc_a[kEd25519Words],
+                               const uint8_t *message, size_t message_len,
+                               hardened_bool_t prehashed,
+                               uint32_t digest[kEd25519HashWords]) {
+  hmac_ctx_t ctx;
+  HARDENED_TRY(hash_init(prehashed, message_len, &ctx));
+  HARDENED_TRY(hmac_update(&ctx, (const uint8_t *)enc_r, kEd25519Bytes));
+  HARDENED_TRY(hmac_update(&ctx, (const uint8_t *)enc_a, kEd25519Bytes));
+  HARDENED_TRY(hmac_update(&ctx, message, message_len));
+  return hash_final(&ctx, digest);
+}
+
+/**
+ * Compute SHA-512 of an unmasked private key seed.
+ *
+ * @param seed Private key seed.
+ * @param[out] digest Buffer for the digest.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+static status_t seed_hash(const uint32_t seed[kEd25519Words],
+                          uint32_t digest[kEd25519HashWords]) {
+  hmac_ctx_t ctx;
+  HARDENED_TRY(hmac_init(&ctx, kHmacModeSha512, /*key=*/NULL));
+  HARDENED_TRY(hmac_update(&ctx, (const uint8_t *)seed, kEd25519Bytes));
+  return hash_final(&ctx, digest);
+}
+
+/**
+ * Expand a private key seed (RFC 8032, section 5.1.5, steps 1 and 2).
+ *
+ * The lower half of the output is clamped to form the secret scalar s; the
+ * upper half is the nonce prefix. The caller must shred `digest` after use,
+ * also if this function fails.
+ *
+ * @param private_key Masked private key seed.
+ * @param[out] digest Buffer for the expanded key.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+static status_t expand_seed(const ed25519_masked_seed_t *private_key,
+                            uint32_t digest[kEd25519HashWords]) {
+  // Known limitation: the seed is only masked at rest. The HMAC block has no
+  // masked SHA-512 mode, so the seed is unmasked for the duration of the hash
+  // and shredded right after; the expanded key is likewise unmasked until it
+  // is handed to OTBN. This is documented on `otcrypto_ed25519_sign`.
+  uint32_t seed[kEd25519Words];
+  for (size_t i = 0; i < kEd25519Words; i++) {
+    seed[i] = private_key->share0[i] ^ private_key->share1[i];
+  }
+  status_t result = seed_hash(seed, digest);
+  hardened_memshred(seed, ARRAYSIZE(seed));
+  if (launder32(OT_UNSIGNED(result.value)) != kHardenedBoolTrue) {
+    return result;
+  }
+  HARDENED_CHECK_EQ(result.value, kHardenedBoolTrue);
+
+  // Clamp the scalar: clear the three lowest bits and the highest bit, and set
+  // the second-highest bit.
+  digest[0] &= ~(uint32_t)7;
+  digest[kEd25519Words - 1] &= 0x7fffffff;
+  digest[kEd25519Words - 1] |= 0x40000000;
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Load the Ed25519 app and set the mode.
+ *
+ * @param mode Mode to set.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+static status_t ed25519_load_mode(uint32_t mode) {
+  // Load the Ed25519 app. Fails if OTBN is non-idle.
+  HARDENED_TRY(otbn_load_app(kOtbnAppEd25519));
+  return otbn_dmem_write(kOtbnEd25519ModeWords, &mode, kOtbnVarEd25519Mode);
+}
+
+/**
+ * Generate a private key and start computing its public key.
+ *
+ * The caller must shred `seed` and `expanded` and wipe DMEM on failure.
+ *
+ * @param[out] seed Buffer for the private key seed.
+ * @param[out] expanded Buffer for the expanded private key.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+static status_t keygen_start(ed25519_masked_seed_t *seed,
+                             uint32_t expanded[kEd25519HashWords]) {
+  // Generate the seed shares. The seed is uniformly random, so two random
+  // shares give a valid private key directly.
+  HARDENED_TRY(entropy_csrng_uninstantiate());
+  HARDENED_TRY(entropy_csrng_instantiate(
+      /*disable_trng_input=*/kHardenedBoolFalse, &kEntropyEmptySeed));
+  HARDENED_TRY(entropy_csrng_generate(&kEntropyEmptySeed, seed->share0,
+                                      kEd25519Words,
+                                      /*fips_check=*/kHardenedBoolTrue));
+  HARDENED_TRY(entropy_csrng_generate(&kEntropyEmptySeed, seed->share1,
+                                      kEd25519Words,
+                                      /*fips_check=*/kHardenedBoolTrue));
+  HARDENED_TRY(entropy_csrng_uninstantiate());
+
+  // Derive the secret scalar.
+  HARDENED_TRY(expand_seed(seed, expanded));
+
+  HARDENED_TRY(ed25519_load_mode(kOtbnEd25519ModeKeygen));
+
+  // Set the secret scalar and park the seed shares in DMEM.
+  HARDENED_TRY(
+      otbn_dmem_write(kEd25519Words, expanded, kOtbnVarEd25519Scalar));
+  HARDENED_TRY(
+      otbn_dmem_write(kEd25519Words, seed->share0, kOtbnVarEd25519Seed0));
+  HARDENED_TRY(
+      otbn_dmem_write(kEd25519Words, seed->share1, kOtbnVarEd25519Seed1));
+
+  // Start the OTBN routine.
+  return otbn_execute();
+}
+
+status_t ed25519_keygen_start(void) {
+  ed25519_masked_seed_t seed;
+  uint32_t expanded[kEd25519HashWords];
+  status_t result = keygen_start(&seed, expanded);
+
+  // OTBN has its own copy of the secrets now, or failed before using them.
+  hardened_memshred(expanded, ARRAYSIZE(expanded));
+  hardened_memshred(seed.share0, ARRAYSIZE(seed.share0));
+  hardened_memshred(seed.share1, ARRAYSIZE(seed.share1));
+  if (launder32(OT_UNSIGNED(result.value)) != kHardenedBoolTrue) {
+    // Clear any secrets that were already written to DMEM.
+    (void)otbn_dmem_sec_wipe();
+    return result;
+  }
+  HARDENED_CHECK_EQ(result.value, kHardenedBoolTrue);
+  return OTCRYPTO_OK;
+}
+
+status_t ed25519_keygen_finalize(ed25519_masked_seed_t *private_key,
+                                 ed25519_point_t *public_key) {
+  // Spin here waiting for OTBN to complete.
+  HARDENED_TRY(otbn_busy_wait_for_done());
+
+  // Read the masked private key from OTBN dmem.
+  HARDENED_TRY(otbn_dmem_read(kEd25519Words, kOtbnVarEd25519Seed0,
+                              private_key->share0));
+  HARDENED_TRY(otbn_dmem_read(kEd25519Words, kOtbnVarEd25519Seed1,
+                              private_key->share1));
+  for (size_t i = kEd25519Words; i < kEd25519MaskedSeedShareWords; i++) {
+    private_key->share0[i] = 0;
+    private_key->share1[i] = 0;
+  }
+
+  // Read the public key from OTBN dmem.
+  HARDENED_TRY(
+      otbn_dmem_read(kEd25519Words, kOtbnVarEd25519EncA, public_key->enc));
+
+  // Wipe DMEM.
+  HARDENED_TRY(otbn_dmem_sec_wipe());
+
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Run the first stage of signing and start the second.
+ *
+ * The caller must shred `expanded` and `hash` and wipe DMEM on failure.
+ *
+ * @param private_key Masked private key seed.
+ * @param message Message (or digest).
+ * @param message_len Length of message in bytes.
+ * @param prehashed Whether this is an Ed25519ph operation.
+ * @param[out] expanded Buffer for the expanded private key.
+ * @param[out] hash Buffer for the nonce and challenge hashes.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+static status_t sign_start(const ed25519_masked_seed_t *private_key,
+                           const uint8_t *message, size_t message_len,
+                           hardened_bool_t prehashed,
+                           uint32_t expanded[kEd25519HashWords],
+                           uint32_t hash[kEd25519HashWords]) {
+  // Derive the secret scalar and nonce prefix.
+  HARDENED_TRY(expand_seed(private_key, expanded));
+
+  // Compute the nonce hash SHA-512(dom2 || prefix || M).
+  hmac_ctx_t ctx;
+  HARDENED_TRY(hash_init(prehashed, message_len, &ctx));
+  HARDENED_TRY(hmac_update(&ctx, (const uint8_t *)&expanded[kEd25519Words],
+                           kEd25519Bytes));
+  HARDENED_TRY(hmac_update(&ctx, message, message_len));
+  HARDENED_TRY(hash_final(&ctx, hash));
+
+  HARDENED_TRY(ed25519_load_mode(kOtbnEd25519ModeSign));
+
+  // Set the secret scalar and the nonce hash.
+  HARDENED_TRY(
+      otbn_dmem_write(kEd25519Words, expanded, kOtbnVarEd25519Scalar));
+  HARDENED_TRY(otbn_dmem_write(kEd25519HashWords, hash, kOtbnVarEd25519HashR));
+  hardened_memshred(expanded, kEd25519HashWords);
+  hardened_memshred(hash, kEd25519HashWords);
+
+  // Compute R and A; the challenge hash needs both.
+  HARDENED_TRY(otbn_execute());
+  HARDENED_TRY(otbn_busy_wait_for_done());
+  uint32_t enc_r[kEd25519Words];
+  uint32_t enc_a[kEd25519Words];
+  HARDENED_TRY(otbn_dmem_read(kEd25519Words, kOtbnVarEd25519EncR, enc_r));
+  HARDENED_TRY(otbn_dmem_read(kEd25519Words, kOtbnVarEd25519EncA, enc_a));
+
+  // Compute the challenge hash SHA-512(dom2 || R || A || M).
+  HARDENED_TRY(
+      challenge_hash(enc_r, enc_a, message, message_len, prehashed, hash));
+
+  // Run the second stage without reloading the app; the nonce is still in
+  // DMEM from the first stage.
+  uint32_t mode = kOtbnEd25519ModeSignFinalize;
+  HARDENED_TRY(
+      otbn_dmem_write(kOtbnEd25519ModeWords, &mode, kOtbnVarEd25519Mode));
+  HARDENED_TRY(otbn_dmem_write(kEd25519HashWords, hash, kOtbnVarEd25519HashK));
+
+  // Start the OTBN routine.
+  return otbn_execute();
+}
+
+status_t ed25519_sign_start(const ed25519_masked_seed_t *private_key,
+                            const uint8_t *message, size_t message_len,
+                            hardened_bool_t prehashed) {
+  uint32_t expanded[kEd25519HashWords];
+  uint32_t hash[kEd25519HashWords];
+  status_t result = sign_start(private_key, message, message_len, prehashed,
+                               expanded, hash);
+
+  // The buffers are already shredded if the secrets reached DMEM, but not if
+  // an earlier step failed.
+  hardened_memshred(expanded, ARRAYSIZE(expanded));
+  hardened_memshred(hash, ARRAYSIZE(hash));
+  if (launder32(OT_UNSIGNED(result.value)) != kHardenedBoolTrue) {
+    // DMEM still holds the secret scalar and nonce once they were written.
+    (void)otbn_dmem_sec_wipe();
+    return result;
+  }
+  HARDENED_CHECK_EQ(result.value, kHardenedBoolTrue);
+  return OTCRYPTO_OK;
+}
+
+status_t ed25519_sign_finalize(ed25519_signature_t *result) {
+  // Spin here waiting for OTBN to complete.
+  HARDENED_TRY(otbn_busy_wait_for_done());
+
+  // Read the signature out of OTBN dmem.
+  HARDENED_TRY(otbn_dmem_read(kEd25519Words, kOtbnVarEd25519EncR, result->r));
+  HARDENED_TRY(otbn_dmem_read(kEd25519Words, kOtbnVarEd25519SigS, result->s));
+
+  // Wipe DMEM.
+  HARDENED_TRY(otbn_dmem_sec_wipe());
+
+  return OTCRYPTO_OK;
+}
+
+status_t ed25519_verify_start(const ed25519_signature_t *signature,
+                              const ed25519_point_t *public_key,
+                              const uint8_t *message, size_t message_len,
+                              hardened_bool_t prehashed) {
+  // Compute the challenge hash SHA-512(dom2 || R || A || M).
+  uint32_t hash[kEd25519HashWords];
+  HARDENED_TRY(challenge_hash(signature->r, public_key->enc, message,
+                              message_len, prehashed, hash));
+
+  HARDENED_TRY(ed25519_load_mode(kOtbnEd25519ModeVerify));
+
+  // Set the challenge hash, signature S and public key.
+  HARDENED_TRY(otbn_dmem_write(kEd25519HashWords, hash, kOtbnVarEd25519HashK));
+  HARDENED_TRY(
+      otbn_dmem_write(kEd25519Words, signature->s, kOtbnVarEd25519SigS));
+  HARDENED_TRY(
+      otbn_dmem_write(kEd25519Words, public_key->enc, kOtbnVarEd25519EncA));
+
+  // Keep the signature R in DMEM for the final comparison; the verify routine
+  // does not use it.
+  HARDENED_TRY(
+      otbn_dmem_write(kEd25519Words, signature->r, kOtbnVarEd25519EncR));
+
+  // Start the OTBN routine.
+  return otbn_execute();
+}
+
+status_t ed25519_verify_finalize(hardened_bool_t *result) {
+  // Spin here waiting for OTBN to complete.
+  HARDENED_TRY(otbn_busy_wait_for_done());
+
+  // Read the status code out of DMEM (false if basic checks on the validity of
+  // the signature and public key failed).
+  uint32_t ok;
+  HARDENED_TRY(otbn_dmem_read(1, kOtbnVarEd25519Ok, &ok));
+  if (launder32(ok) != kHardenedBoolTrue) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(ok, kHardenedBoolTrue);
+
+  // Compare the recovered R with the one from the signature.
+  uint32_t enc_r[kEd25519Words];
+  uint32_t enc_r_check[kEd25519Words];
+  HARDENED_TRY(otbn_dmem_read(kEd25519Words, kOtbnVarEd25519EncR, enc_r));
+  HARDENED_TRY(
+      otbn_dmem_read(kEd25519Words, kOtbnVarEd25519EncRCheck, enc_r_check));
+
+  *result = hardened_memeq(enc_r, enc_r_check, kEd25519Words);
+
+  // Wipe DMEM.
+  HARDENED_TRY(otbn_dmem_sec_wipe());
+
+  return OTCRYPTO_OK;
+}
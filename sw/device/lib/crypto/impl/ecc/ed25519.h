@@ -0,0 +1,193 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_ECC_ED25519_H_
+#define OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_ECC_ED25519_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/crypto/drivers/otbn.h"
+#include "sw/device/lib/crypto/impl/status.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+enum {
+  /**
+   * Length of an Ed25519 private key seed or encoded point in bits.
+   */
+  kEd25519Bits = 256,
+  /**
+   * Length of an Ed25519 private key seed or encoded point in bytes.
+   */
+  kEd25519Bytes = kEd25519Bits / 8,
+  /**
+   * Length of an Ed25519 private key seed or encoded point in words.
+   */
+  kEd25519Words = kEd25519Bytes / sizeof(uint32_t),
+  /**
+   * Length of a masked private key seed share.
+   *
+   * Matches the share size the keyblob library uses for all ECC keys. Only the
+   * lower 256 bits are used; the extra bits are zero in both shares.
+   */
+  kEd25519MaskedSeedShareBits = kEd25519Bits + 64,
+  /**
+   * Length of a masked private key seed share in bytes.
+   */
+  kEd25519MaskedSeedShareBytes = kEd25519MaskedSeedShareBits / 8,
+  /**
+   * Length of a masked private key seed share in words.
+   */
+  kEd25519MaskedSeedShareWords =
+      kEd25519MaskedSeedShareBytes / sizeof(uint32_t),
+  /**
+   * Length of a SHA-512 digest (the Ed25519ph prehash) in bytes.
+   */
+  kEd25519PrehashBytes = 64,
+};
+
+/**
+ * A type that holds a masked Ed25519 private key.
+ *
+ * The private key is the 32-byte seed from RFC 8032, represented in two
+ * boolean shares such that seed = (share0 ^ share1) mod 2^256.
+ */
+typedef struct ed25519_masked_seed {
+  /**
+   * First share of the seed.
+   */
+  uint32_t share0[kEd25519MaskedSeedShareWords];
+  /**
+   * Second share of the seed.
+   */
+  uint32_t share1[kEd25519MaskedSeedShareWords];
+} ed25519_masked_seed_t;
+
+/**
+ * A type that holds an encoded Ed25519 point (a public key).
+ */
+typedef struct ed25519_point {
+  uint32_t enc[kEd25519Words];
+} ed25519_point_t;
+
+/**
+ * A type that holds an Ed25519 signature.
+ *
+ * The words hold the 64-byte signature R || S in the byte order of RFC 8032.
+ */
+typedef struct ed25519_signature {
+  uint32_t r[kEd25519Words];
+  uint32_t s[kEd25519Words];
+} ed25519_signature_t;
+
+/**
+ * Start an async Ed25519 keypair generation operation on OTBN.
+ *
+ * Draws a fresh private key seed from the CSRNG and hashes it on Ibex before
+ * starting OTBN. Assumes the entropy complex is initialized.
+ *
+ * Returns an `OTCRYPTO_ASYNC_INCOMPLETE` error if OTBN is busy.
+ *
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t ed25519_keygen_start(void);
+
+/**
+ * Finish an async Ed25519 keypair generation operation on OTBN.
+ *
+ * Blocks until OTBN is idle.
+ *
+ * @param[out] private_key Generated private key.
+ * @param[out] public_key Generated public key.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t ed25519_keygen_finalize(ed25519_masked_seed_t *private_key,
+                                 ed25519_point_t *public_key);
+
+/**
+ * Start an async Ed25519 signature generation operation on OTBN.
+ *
+ * Signing needs the encoded commitment R before the challenge can be hashed,
+ * so this routine runs the first OTBN stage to completion, hashes on Ibex, and
+ * then starts the second (short) stage.
+ *
+ * If `prehashed` is true, the message is the 64-byte SHA-512 digest of the
+ * real message and the signature is Ed25519ph (RFC 8032, section 5.1) with an
+ * empty context.
+ *
+ * Returns an `OTCRYPTO_ASYNC_INCOMPLETE` error if OTBN is busy.
+ *
+ * @param private_key Private key to sign with.
+ * @param message Message (or digest) to sign.
+ * @param message_len Length of message in bytes.
+ * @param prehashed Whether to produce an Ed25519ph signature.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t ed25519_sign_start(const ed25519_masked_seed_t *private_key,
+                            const uint8_t *message, size_t message_len,
+                            hardened_bool_t prehashed);
+
+/**
+ * Finish an async Ed25519 signature generation operation on OTBN.
+ *
+ * Blocks until OTBN is idle.
+ *
+ * @param[out] result Buffer in which to store the generated signature.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t ed25519_sign_finalize(ed25519_signature_t *result);
+
+/**
+ * Start an async Ed25519 signature verification operation on OTBN.
+ *
+ * See `ed25519_sign_start` for the meaning of `prehashed`.
+ *
+ * Returns an `OTCRYPTO_ASYNC_INCOMPLETE` error if OTBN is busy.
+ *
+ * @param signature Signature to be verified.
+ * @param public_key Key to check the signature against.
+ * @param message Message (or digest) to check the signature against.
+ * @param message_len Length of message in bytes.
+ * @param prehashed Whether the signature is an Ed25519ph signature.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t ed25519_verify_start(const ed25519_signature_t *signature,
+                              const ed25519_point_t *public_key,
+                              const uint8_t *message, size_t message_len,
+                              hardened_bool_t prehashed);
+
+/**
+ * Finish an async Ed25519 signature verification operation on OTBN.
+ *
+ * Blocks until OTBN is idle.
+ *
+ * If the signature is valid, writes `kHardenedBoolTrue` to `result`;
+ * otherwise, writes `kHardenedBoolFalse`.
+ *
+ * Note: the caller must check the `result` buffer in order to determine if a
+ * signature passed verification. If a function fails for any other reason, it
+ * will return a non-OK status, but verification failure does not mean the
+ * function failed. As an exception, a public key that does not decode to a
+ * curve point or a signature with S >= L results in `OTCRYPTO_BAD_ARGS`.
+ *
+ * @param[out] result Output buffer (true if signature is valid, else false)
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t ed25519_verify_finalize(hardened_bool_t *result);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_ECC_ED25519_H_
@@ -0,0 +1,164 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/crypto/impl/ecc/x25519.h"
+
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/hardened_memory.h"
+#include "sw/device/lib/crypto/drivers/otbn.h"
+
+// Module ID for status codes.
+#define MODULE_ID MAKE_MODULE_ID('x', '2', 'x')
+
+OTBN_DECLARE_APP_SYMBOLS(x25519_sideload);        // The OTBN X25519 app.
+OTBN_DECLARE_SYMBOL_ADDR(x25519_sideload, mode);  // X25519 application mode.
+OTBN_DECLARE_SYMBOL_ADDR(x25519_sideload, u);     // Public key u-coordinate.
+OTBN_DECLARE_SYMBOL_ADDR(x25519_sideload, k0);    // The private key (share 0).
+OTBN_DECLARE_SYMBOL_ADDR(x25519_sideload, k1);    // The private key (share 1).
+OTBN_DECLARE_SYMBOL_ADDR(x25519_sideload, z0);    // The shared key (share 0).
+OTBN_DECLARE_SYMBOL_ADDR(x25519_sideload, z1);    // The shared key (share 1).
+
+static const otbn_app_t kOtbnAppX25519 = OTBN_APP_T_INIT(x25519_sideload);
+static const otbn_addr_t kOtbnVarX25519Mode =
+    OTBN_ADDR_T_INIT(x25519_sideload, mode);
+static const otbn_addr_t kOtbnVarX25519U = OTBN_ADDR_T_INIT(x25519_sideload, u);
+static const otbn_addr_t kOtbnVarX25519K0 =
+    OTBN_ADDR_T_INIT(x25519_sideload, k0);
+static const otbn_addr_t kOtbnVarX25519K1 =
+    OTBN_ADDR_T_INIT(x25519_sideload, k1);
+static const otbn_addr_t kOtbnVarX25519Z0 =
+    OTBN_ADDR_T_INIT(x25519_sideload, z0);
+static const otbn_addr_t kOtbnVarX25519Z1 =
+    OTBN_ADDR_T_INIT(x25519_sideload, z1);
+
+enum {
+  /*
+   * Mode is represented by a single word.
+   */
+  kOtbnX25519ModeWords = 1,
+  /*
+   * Mode to generate a new random keypair.
+   */
+  kOtbnX25519ModeKeypairRandom = 0x3f1,
+  /*
+   * Mode to generate a new shared key.
+   */
+  kOtbnX25519ModeSharedKey = 0x5ec,
+  /*
+   * Mode to generate a new sideloaded keypair.
+   */
+  kOtbnX25519ModeKeypairFromSeed = 0x29f,
+  /*
+   * Mode to generate a new sideloaded shared key.
+   */
+  kOtbnX25519ModeSharedKeyFromSeed = 0x74b,
+};
+
+/**
+ * Load the X25519 app and set the mode.
+ *
+ * @param mode Mode to set.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+static status_t x25519_load_mode(uint32_t mode) {
+  // Load the X25519 app. Fails if OTBN is non-idle.
+  HARDENED_TRY(otbn_load_app(kOtbnAppX25519));
+  return otbn_dmem_write(kOtbnX25519ModeWords, &mode, kOtbnVarX25519Mode);
+}
+
+status_t x25519_keypair_start(void) {
+  HARDENED_TRY(x25519_load_mode(kOtbnX25519ModeKeypairRandom));
+
+  // Start the OTBN routine.
+  return otbn_execute();
+}
+
+status_t x25519_keypair_finalize(x25519_masked_scalar_t *private_key,
+                                 x25519_point_t *public_key) {
+  // Spin here waiting for OTBN to complete.
+  HARDENED_TRY(otbn_busy_wait_for_done());
+
+  // Read the masked private key from OTBN dmem. OTBN only produces the lower
+  // 256 bits of each share; the padding is zero in both shares.
+  HARDENED_TRY(
+      otbn_dmem_read(kX25519Words, kOtbnVarX25519K0, private_key->share0));
+  HARDENED_TRY(
+      otbn_dmem_read(kX25519Words, kOtbnVarX25519K1, private_key->share1));
+  for (size_t i = kX25519Words; i < kX25519MaskedScalarShareWords; i++) {
+    private_key->share0[i] = 0;
+    private_key->share1[i] = 0;
+  }
+
+  // Read the public key from OTBN dmem.
+  HARDENED_TRY(otbn_dmem_read(kX25519Words, kOtbnVarX25519U, public_key->u));
+
+  // Wipe DMEM.
+  HARDENED_TRY(otbn_dmem_sec_wipe());
+
+  return OTCRYPTO_OK;
+}
+
+status_t x25519_shared_key_start(const x25519_masked_scalar_t *private_key,
+                                 const x25519_point_t *public_key) {
+  HARDENED_TRY(x25519_load_mode(kOtbnX25519ModeSharedKey));
+
+  // Set the private key shares. Only the lower 256 bits are used.
+  HARDENED_TRY(
+      otbn_dmem_write(kX25519Words, private_key->share0, kOtbnVarX25519K0));
+  HARDENED_TRY(
+      otbn_dmem_write(kX25519Words, private_key->share1, kOtbnVarX25519K1));
+
+  // Set the public key.
+  HARDENED_TRY(otbn_dmem_write(kX25519Words, public_key->u, kOtbnVarX25519U));
+
+  // Start the OTBN routine.
+  return otbn_execute();
+}
+
+status_t x25519_shared_key_finalize(x25519_shared_key_t *shared_key) {
+  // Spin here waiting for OTBN to complete.
+  HARDENED_TRY(otbn_busy_wait_for_done());
+
+  // Read the shares of the key from OTBN dmem.
+  HARDENED_TRY(
+      otbn_dmem_read(kX25519Words, kOtbnVarX25519Z0, shared_key->share0));
+  HARDENED_TRY(
+      otbn_dmem_read(kX25519Words, kOtbnVarX25519Z1, shared_key->share1));
+
+  // Wipe DMEM.
+  HARDENED_TRY(otbn_dmem_sec_wipe());
+
+  return OTCRYPTO_OK;
+}
+
+status_t x25519_sideload_keypair_start(void) {
+  HARDENED_TRY(x25519_load_mode(kOtbnX25519ModeKeypairFromSeed));
+
+  // Start the OTBN routine.
+  return otbn_execute();
+}
+
+status_t x25519_sideload_keypair_finalize(x25519_point_t *public_key) {
+  // Spin here waiting for OTBN to complete.
+  HARDENED_TRY(otbn_busy_wait_for_done());
+
+  // Read the public key from OTBN dmem.
+  HARDENED_TRY(otbn_dmem_read(kX25519Words, kOtbnVarX25519U, public_key->u));
+
+  // Wipe DMEM.
+  HARDENED_TRY(otbn_dmem_sec_wipe());
+
+  return OTCRYPTO_OK;
+}
+
+status_t x25519_sideload_shared_key_start(const x25519_point_t *public_key) {
+  HARDENED_TRY(x25519_load_mode(kOtbnX25519ModeSharedKeyFromSeed));
+
+  // Set the public key.
+  HARDENED_TRY(otbn_dmem_write(kX25519Words, public_key->u, kOtbnVarX25519U));
+
+  // Start the OTBN routine.
+  return otbn_execute();
+}
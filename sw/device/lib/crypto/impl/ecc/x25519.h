@@ -0,0 +1,175 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_ECC_X25519_H_
+#define OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_ECC_X25519_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/crypto/drivers/otbn.h"
+#include "sw/device/lib/crypto/impl/status.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+enum {
+  /**
+   * Length of an encoded X25519 scalar or u-coordinate in bits.
+   */
+  kX25519Bits = 256,
+  /**
+   * Length of an encoded X25519 scalar or u-coordinate in bytes.
+   */
+  kX25519Bytes = kX25519Bits / 8,
+  /**
+   * Length of an encoded X25519 scalar or u-coordinate in words.
+   */
+  kX25519Words = kX25519Bytes / sizeof(uint32_t),
+  /**
+   * Length of a masked secret scalar share.
+   *
+   * Matches the share size the keyblob library uses for all ECC keys. Only the
+   * lower 256 bits are used; the extra bits are zero in both shares.
+   */
+  kX25519MaskedScalarShareBits = kX25519Bits + 64,
+  /**
+   * Length of a masked secret scalar share in bytes.
+   */
+  kX25519MaskedScalarShareBytes = kX25519MaskedScalarShareBits / 8,
+  /**
+   * Length of masked secret scalar share in words.
+   */
+  kX25519MaskedScalarShareWords =
+      kX25519MaskedScalarShareBytes / sizeof(uint32_t),
+};
+
+/**
+ * A type that holds a masked X25519 secret scalar.
+ *
+ * The encoded scalar enc(k) is represented in two boolean shares such that
+ * enc(k) = (share0 ^ share1) mod 2^256.
+ */
+typedef struct x25519_masked_scalar {
+  /**
+   * First share of the secret scalar.
+   */
+  uint32_t share0[kX25519MaskedScalarShareWords];
+  /**
+   * Second share of the secret scalar.
+   */
+  uint32_t share1[kX25519MaskedScalarShareWords];
+} x25519_masked_scalar_t;
+
+/**
+ * A type that holds an encoded Montgomery u-coordinate (a public key).
+ */
+typedef struct x25519_point {
+  uint32_t u[kX25519Words];
+} x25519_point_t;
+
+/**
+ * A type that holds a blinded X25519 shared secret key.
+ *
+ * The key is boolean-masked (XOR of the two shares).
+ */
+typedef struct x25519_shared_key {
+  uint32_t share0[kX25519Words];
+  uint32_t share1[kX25519Words];
+} x25519_shared_key_t;
+
+/**
+ * Start an async X25519 keypair generation operation on OTBN.
+ *
+ * Returns an `OTCRYPTO_ASYNC_INCOMPLETE` error if OTBN is busy.
+ *
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t x25519_keypair_start(void);
+
+/**
+ * Finish an async X25519 keypair generation operation on OTBN.
+ *
+ * Blocks until OTBN is idle.
+ *
+ * @param[out] private_key Generated private key.
+ * @param[out] public_key Generated public key.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t x25519_keypair_finalize(x25519_masked_scalar_t *private_key,
+                                 x25519_point_t *public_key);
+
+/**
+ * Start an async X25519 shared key generation operation on OTBN.
+ *
+ * Returns an `OTCRYPTO_ASYNC_INCOMPLETE` error if OTBN is busy.
+ *
+ * @param private_key Private key (k).
+ * @param public_key Public key (u).
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t x25519_shared_key_start(const x25519_masked_scalar_t *private_key,
+                                 const x25519_point_t *public_key);
+
+/**
+ * Finish an async X25519 shared key generation operation on OTBN.
+ *
+ * Blocks until OTBN is idle. May be used after either
+ * `x25519_shared_key_start` or `x25519_sideload_shared_key_start`; the
+ * operation is the same.
+ *
+ * @param[out] shared_key Shared secret key, X25519(k, u).
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t x25519_shared_key_finalize(x25519_shared_key_t *shared_key);
+
+/**
+ * Start an async X25519 sideloaded keypair generation operation on OTBN.
+ *
+ * Generates the keypair from a key manager seed. The key manager should
+ * already have sideloaded the key into OTBN before this operation is called.
+ *
+ * Returns an `OTCRYPTO_ASYNC_INCOMPLETE` error if OTBN is busy.
+ *
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t x25519_sideload_keypair_start(void);
+
+/**
+ * Finish an async X25519 sideloaded keypair generation operation on OTBN.
+ *
+ * Blocks until OTBN is idle. Returns only the public key.
+ *
+ * @param[out] public_key Generated public key.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t x25519_sideload_keypair_finalize(x25519_point_t *public_key);
+
+/**
+ * Start an async X25519 shared key generation operation on OTBN.
+ *
+ * Uses a private key generated from a key manager seed. The key manager should
+ * already have sideloaded the key into OTBN before this operation is called.
+ *
+ * Returns an `OTCRYPTO_ASYNC_INCOMPLETE` error if OTBN is busy.
+ *
+ * @param public_key Public key (u).
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t x25519_sideload_shared_key_start(const x25519_point_t *public_key);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_ECC_X25519_H_
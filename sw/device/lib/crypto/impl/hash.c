@@ -7,127 +7,128 @@
 #include <stdbool.h>
 
 #include "sw/device/lib/base/hardened_memory.h"
+#include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/crypto/drivers/hmac.h"
 #include "sw/device/lib/crypto/drivers/kmac.h"
-#include "sw/device/lib/crypto/impl/sha2/sha256.h"
-#include "sw/device/lib/crypto/impl/sha2/sha512.h"
+#include "sw/device/lib/crypto/impl/hash_midstate.h"
 #include "sw/device/lib/crypto/impl/status.h"
 
 // Module ID for status codes.
 #define MODULE_ID MAKE_MODULE_ID('h', 'a', 's')
 
 /**
- * Ensure that the hash context is large enough for all SHA2 state structs.
- */
-static_assert(
-    sizeof(otcrypto_hash_context_t) >= sizeof(sha256_state_t),
-    "otcrypto_hash_context_t must be big enough to hold sha256_state_t");
-static_assert(
-    sizeof(otcrypto_hash_context_t) >= sizeof(sha384_state_t),
-    "otcrypto_hash_context_t must be big enough to hold sha384_state_t");
-static_assert(
-    sizeof(otcrypto_hash_context_t) >= sizeof(sha512_state_t),
-    "otcrypto_hash_context_t must be big enough to hold sha512_state_t");
-/**
- * Ensure that all SHA2 state structs are suitable for `hardened_memcpy()`.
- */
-static_assert(sizeof(sha256_state_t) % sizeof(uint32_t) == 0,
-              "Size of sha256_state_t must be a multiple of the word size for "
-              "`hardened_memcpy()`");
-static_assert(sizeof(sha384_state_t) % sizeof(uint32_t) == 0,
-              "Size of sha384_state_t must be a multiple of the word size for "
-              "`hardened_memcpy()`");
-static_assert(sizeof(sha512_state_t) % sizeof(uint32_t) == 0,
-              "Size of sha512_state_t must be a multiple of the word size for "
-              "`hardened_memcpy()`");
-/**
- * Save a SHA-256 state to a generic hash context.
+ * Progress of a SHA-2 stream on the HMAC block.
  *
- * @param[out] ctx Generic hash context to copy to.
- * @param state SHA-256 context object.
+ * These are the fields of `hmac_ctx_t` that change while hashing. The other
+ * fields only depend on the hash mode and are recomputed by `hmac_init()`,
+ * which keeps the saved state small enough for `otcrypto_hash_context_t`; the
+ * key buffer of `hmac_ctx_t` alone would not fit.
  */
-static void sha256_state_save(otcrypto_hash_context_t *restrict ctx,
-                              const sha256_state_t *restrict state) {
-  // As per the `hardened_memcpy()` documentation, it is OK to cast to
-  // `uint32_t *` here as long as `state` is word-aligned, which it must be
-  // because all its fields are.
-  hardened_memcpy(ctx->data, (uint32_t *)state,
-                  sizeof(sha256_state_t) / sizeof(uint32_t));
-}
+typedef struct hmac_sha2_state {
+  // Intermediate digest and message length, as saved from the HMAC block.
+  uint32_t H[kHmacMaxDigestWords];
+  uint32_t lower;
+  uint32_t upper;
+  // Whether the HMAC block has processed any message block of this stream.
+  uint32_t hw_started;
+  // Message bytes that do not fill a complete block yet.
+  uint32_t partial_block_len;
+  uint32_t partial_block[kHmacMaxBlockWords];
+} hmac_sha2_state_t;
 
 /**
- * Restore a SHA-256 state from a generic hash context.
- *
- * @param ctx Generic hash context to restore from.
- * @param[out] state Destination SHA-256 context object.
+ * Ensure that the hash context is large enough for the SHA-2 state.
  */
-static void sha256_state_restore(const otcrypto_hash_context_t *restrict ctx,
-                                 sha256_state_t *restrict state) {
-  // As per the `hardened_memcpy()` documentation, it is OK to cast to
-  // `uint32_t *` here as long as `state` is word-aligned, which it must be
-  // because all its fields are.
-  hardened_memcpy((uint32_t *)state, ctx->data,
-                  sizeof(sha256_state_t) / sizeof(uint32_t));
-}
+static_assert(sizeof(((otcrypto_hash_context_t *)NULL)->data) >=
+                  sizeof(hmac_sha2_state_t),
+              "otcrypto_hash_context_t must be big enough to hold "
+              "hmac_sha2_state_t");
+static_assert(sizeof(((hmac_ctx_t *)NULL)->partial_block) ==
+                  sizeof(((hmac_sha2_state_t *)NULL)->partial_block),
+              "The partial block of hmac_sha2_state_t must match hmac_ctx_t");
 
 /**
- * Save a SHA-384 state to a generic hash context.
- *
- * @param[out] ctx Generic hash context to copy to.
- * @param state SHA-384 context object.
+ * Ensure that the hash context is large enough for the KMAC stream state.
  */
-static void sha384_state_save(otcrypto_hash_context_t *restrict ctx,
-                              const sha384_state_t *restrict state) {
-  // As per the `hardened_memcpy()` documentation, it is OK to cast to
-  // `uint32_t *` here as long as `state` is word-aligned, which it must be
-  // because all its fields are.
-  hardened_memcpy(ctx->data, (uint32_t *)state,
-                  sizeof(sha384_state_t) / sizeof(uint32_t));
-}
+static_assert(sizeof(((otcrypto_hash_context_t *)NULL)->data) >=
+                  sizeof(kmac_stream_t),
+              "otcrypto_hash_context_t must be big enough to hold "
+              "kmac_stream_t");
 
 /**
- * Restore a SHA-384 state from a generic hash context.
+ * Get the HMAC block mode for a SHA-2 hash mode.
  *
- * @param ctx Generic hash context to restore from.
- * @param[out] state Destination SHA-384 context object.
+ * @param hash_mode Hash mode.
+ * @param[out] hmac_mode Corresponding HMAC block mode.
+ * @return Error status; `OTCRYPTO_BAD_ARGS` if `hash_mode` is not SHA-2.
  */
-static void sha384_state_restore(const otcrypto_hash_context_t *restrict ctx,
-                                 sha384_state_t *restrict state) {
-  // As per the `hardened_memcpy()` documentation, it is OK to cast to
-  // `uint32_t *` here as long as `state` is word-aligned, which it must be
-  // because all its fields are.
-  hardened_memcpy((uint32_t *)state, ctx->data,
-                  sizeof(sha384_state_t) / sizeof(uint32_t));
+OT_WARN_UNUSED_RESULT
+static status_t sha2_hmac_mode_get(otcrypto_hash_mode_t hash_mode,
+                                   hmac_mode_t *hmac_mode) {
+  switch (launder32(hash_mode)) {
+    case kOtcryptoHashModeSha256:
+      HARDENED_CHECK_EQ(hash_mode, kOtcryptoHashModeSha256);
+      *hmac_mode = kHmacModeSha256;
+      return OTCRYPTO_OK;
+    case kOtcryptoHashModeSha384:
+      HARDENED_CHECK_EQ(hash_mode, kOtcryptoHashModeSha384);
+      *hmac_mode = kHmacModeSha384;
+      return OTCRYPTO_OK;
+    case kOtcryptoHashModeSha512:
+      HARDENED_CHECK_EQ(hash_mode, kOtcryptoHashModeSha512);
+      *hmac_mode = kHmacModeSha512;
+      return OTCRYPTO_OK;
+    default:
+      return OTCRYPTO_BAD_ARGS;
+  }
 }
 
 /**
- * Save a SHA-512 state to a generic hash context.
+ * Save the state of a SHA-2 stream on the HMAC block to a generic hash
+ * context.
  *
  * @param[out] ctx Generic hash context to copy to.
- * @param state SHA-512 context object.
+ * @param hwip_ctx HMAC driver context.
  */
-static void sha512_state_save(otcrypto_hash_context_t *restrict ctx,
-                              const sha512_state_t *restrict state) {
-  // As per the `hardened_memcpy()` documentation, it is OK to cast to
-  // `uint32_t *` here as long as `state` is word-aligned, which it must be
-  // because all its fields are.
-  hardened_memcpy(ctx->data, (uint32_t *)state,
-                  sizeof(sha512_state_t) / sizeof(uint32_t));
+static void sha2_state_save(otcrypto_hash_context_t *restrict ctx,
+                            const hmac_ctx_t *restrict hwip_ctx) {
+  hmac_sha2_state_t *state = (hmac_sha2_state_t *)ctx->data;
+  hardened_memcpy(state->H, hwip_ctx->H, kHmacMaxDigestWords);
+  state->lower = hwip_ctx->lower;
+  state->upper = hwip_ctx->upper;
+  state->hw_started = hwip_ctx->hw_started;
+  state->partial_block_len = hwip_ctx->partial_block_len;
+  memcpy(state->partial_block, hwip_ctx->partial_block,
+         hwip_ctx->partial_block_len);
 }
 
 /**
- * Restore a SHA-512 state from a generic hash context.
+ * Restore the state of a SHA-2 stream on the HMAC block from a generic hash
+ * context.
  *
  * @param ctx Generic hash context to restore from.
- * @param[out] state Destination SHA-512 context object.
+ * @param[out] hwip_ctx Destination HMAC driver context.
+ * @return Error status.
  */
-static void sha512_state_restore(const otcrypto_hash_context_t *restrict ctx,
-                                 sha512_state_t *restrict state) {
-  // As per the `hardened_memcpy()` documentation, it is OK to cast to
-  // `uint32_t *` here as long as `state` is word-aligned, which it must be
-  // because all its fields are.
-  hardened_memcpy((uint32_t *)state, ctx->data,
-                  sizeof(sha512_state_t) / sizeof(uint32_t));
+OT_WARN_UNUSED_RESULT
+static status_t sha2_state_restore(const otcrypto_hash_context_t *restrict ctx,
+                                   hmac_ctx_t *restrict hwip_ctx) {
+  hmac_mode_t hmac_mode;
+  HARDENED_TRY(sha2_hmac_mode_get(ctx->mode, &hmac_mode));
+  HARDENED_TRY(hmac_init(hwip_ctx, hmac_mode, /*key=*/NULL));
+
+  const hmac_sha2_state_t *state = (const hmac_sha2_state_t *)ctx->data;
+  if (state->partial_block_len >= hwip_ctx->msg_block_len) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  hardened_memcpy(hwip_ctx->H, state->H, kHmacMaxDigestWords);
+  hwip_ctx->lower = state->lower;
+  hwip_ctx->upper = state->upper;
+  hwip_ctx->hw_started = state->hw_started;
+  hwip_ctx->partial_block_len = state->partial_block_len;
+  memcpy(hwip_ctx->partial_block, state->partial_block,
+         state->partial_block_len);
+  return OTCRYPTO_OK;
 }
 
 /**
@@ -180,26 +181,26 @@ static status_t check_digest_len(otcrypto_hash_digest_t digest) {
 }
 
 /**
- * Compute SHA256 using the HMAC hardware block.
+ * Compute SHA-256, SHA-384 or SHA-512 using the HMAC hardware block.
  *
  * @param message Message to hash.
  * @param[out] digest Output digest.
  */
 OT_WARN_UNUSED_RESULT
-static status_t hmac_sha256(otcrypto_const_byte_buf_t message,
-                            otcrypto_hash_digest_t digest) {
-  HARDENED_CHECK_EQ(digest.len, kHmacSha256DigestWords);
-  HARDENED_CHECK_EQ(digest.mode, kOtcryptoHashModeSha256);
+static status_t hmac_sha2(otcrypto_const_byte_buf_t message,
+                          otcrypto_hash_digest_t digest) {
+  hmac_mode_t hmac_mode;
+  HARDENED_TRY(sha2_hmac_mode_get(digest.mode, &hmac_mode));
 
   hmac_ctx_t hwip_ctx;
   hmac_digest_t hmac_digest = {
-      .len = kHmacSha256DigestBytes,
+      .len = digest.len * sizeof(uint32_t),
   };
-  HARDENED_TRY(hmac_init(&hwip_ctx, kHmacModeSha256, /*key=*/NULL));
+  HARDENED_TRY(hmac_init(&hwip_ctx, hmac_mode, /*key=*/NULL));
   HARDENED_TRY(hmac_update(&hwip_ctx, message.data, message.len));
   HARDENED_TRY(hmac_final(&hwip_ctx, &hmac_digest));
 
-  hardened_memcpy(digest.data, hmac_digest.digest, kHmacSha256DigestWords);
+  hardened_memcpy(digest.data, hmac_digest.digest, digest.len);
 
   return OTCRYPTO_OK;
 }
@@ -227,12 +228,12 @@ otcrypto_status_t otcrypto_hash(otcrypto_const_byte_buf_t input_message,
     case kOtcryptoHashModeSha3_512:
       return kmac_sha3_512(input_message.data, input_message.len, digest.data);
     case kOtcryptoHashModeSha256:
-      // Call the HMAC block driver in SHA-256 mode.
-      return hmac_sha256(input_message, digest);
+      OT_FALLTHROUGH_INTENDED;
     case kOtcryptoHashModeSha384:
-      return sha384(input_message.data, input_message.len, digest.data);
+      OT_FALLTHROUGH_INTENDED;
     case kOtcryptoHashModeSha512:
-      return sha512(input_message.data, input_message.len, digest.data);
+      // Call the HMAC block driver in SHA-2 mode.
+      return hmac_sha2(input_message, digest);
     default:
       // Invalid hash mode.
       return OTCRYPTO_BAD_ARGS;
@@ -308,24 +309,38 @@ otcrypto_status_t otcrypto_hash_init(otcrypto_hash_context_t *const ctx,
     return OTCRYPTO_BAD_ARGS;
   }
 
-  ctx->mode = hash_mode;
+  // SHA-3 and SHAKE hold the KMAC block until the end of the operation.
+  kmac_stream_t *stream = (kmac_stream_t *)ctx->data;
   switch (hash_mode) {
-    case kOtcryptoHashModeSha256: {
-      sha256_state_t state;
-      sha256_init(&state);
-      sha256_state_save(ctx, &state);
+    case kOtcryptoHashModeSha3_224:
+      HARDENED_TRY(kmac_sha3_224_start(stream));
       break;
-    }
-    case kOtcryptoHashModeSha384: {
-      sha384_state_t state;
-      sha384_init(&state);
-      sha384_state_save(ctx, &state);
+    case kOtcryptoHashModeSha3_256:
+      HARDENED_TRY(kmac_sha3_256_start(stream));
       break;
-    }
+    case kOtcryptoHashModeSha3_384:
+      HARDENED_TRY(kmac_sha3_384_start(stream));
+      break;
+    case kOtcryptoHashModeSha3_512:
+      HARDENED_TRY(kmac_sha3_512_start(stream));
+      break;
+    case kOtcryptoHashXofModeShake128:
+      HARDENED_TRY(kmac_shake_128_start(stream));
+      break;
+    case kOtcryptoHashXofModeShake256:
+      HARDENED_TRY(kmac_shake_256_start(stream));
+      break;
+    case kOtcryptoHashModeSha256:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashModeSha384:
+      OT_FALLTHROUGH_INTENDED;
     case kOtcryptoHashModeSha512: {
-      sha512_state_t state;
-      sha512_init(&state);
-      sha512_state_save(ctx, &state);
+      // SHA-2 runs on the HMAC block.
+      hmac_mode_t hmac_mode;
+      HARDENED_TRY(sha2_hmac_mode_get(hash_mode, &hmac_mode));
+      hmac_ctx_t hwip_ctx;
+      HARDENED_TRY(hmac_init(&hwip_ctx, hmac_mode, /*key=*/NULL));
+      sha2_state_save(ctx, &hwip_ctx);
       break;
     }
     default:
@@ -333,6 +348,84 @@ otcrypto_status_t otcrypto_hash_init(otcrypto_hash_context_t *const ctx,
       return OTCRYPTO_BAD_ARGS;
   }
 
+  ctx->mode = hash_mode;
+  return OTCRYPTO_OK;
+}
+
+status_t hash_sha2_midstate_resume(otcrypto_hash_context_t *ctx,
+                                   otcrypto_hash_mode_t hash_mode,
+                                   const uint32_t *midstate,
+                                   size_t prefix_len) {
+  if (ctx == NULL || midstate == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  hmac_mode_t hmac_mode;
+  HARDENED_TRY(sha2_hmac_mode_get(hash_mode, &hmac_mode));
+  hmac_ctx_t hwip_ctx;
+  HARDENED_TRY(hmac_init(&hwip_ctx, hmac_mode, /*key=*/NULL));
+  if (prefix_len == 0 || prefix_len % hwip_ctx.msg_block_len != 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // SHA-384 continues from the full SHA-512 state, which is larger than its
+  // digest.
+  size_t state_words = kHmacMaxDigestWords;
+  if (hmac_mode == kHmacModeSha256) {
+    state_words = kHmacSha256DigestWords;
+  }
+  memset(hwip_ctx.H, 0, sizeof(hwip_ctx.H));
+  hardened_memcpy(hwip_ctx.H, midstate, state_words);
+
+  // The HMAC block counts the message length in bits.
+  uint64_t prefix_bits = (uint64_t)prefix_len << 3;
+  hwip_ctx.lower = (uint32_t)prefix_bits;
+  hwip_ctx.upper = (uint32_t)(prefix_bits >> 32);
+  hwip_ctx.hw_started = 1;
+  hwip_ctx.partial_block_len = 0;
+  sha2_state_save(ctx, &hwip_ctx);
+  ctx->mode = hash_mode;
+  return OTCRYPTO_OK;
+}
+
+otcrypto_status_t otcrypto_xof_cshake_init(
+    otcrypto_hash_context_t *const ctx, otcrypto_hash_mode_t mode,
+    otcrypto_const_byte_buf_t function_name_string,
+    otcrypto_const_byte_buf_t customization_string) {
+  if (ctx == NULL ||
+      (function_name_string.data == NULL && function_name_string.len != 0) ||
+      (customization_string.data == NULL && customization_string.len != 0)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // As in `otcrypto_xof_cshake`, cSHAKE with empty strings is SHAKE.
+  bool is_shake =
+      customization_string.len == 0 && function_name_string.len == 0;
+  kmac_stream_t *stream = (kmac_stream_t *)ctx->data;
+  switch (mode) {
+    case kOtcryptoHashXofModeCshake128:
+      if (is_shake) {
+        HARDENED_TRY(kmac_shake_128_start(stream));
+      } else {
+        HARDENED_TRY(kmac_cshake_128_start(
+            stream, function_name_string.data, function_name_string.len,
+            customization_string.data, customization_string.len));
+      }
+      break;
+    case kOtcryptoHashXofModeCshake256:
+      if (is_shake) {
+        HARDENED_TRY(kmac_shake_256_start(stream));
+      } else {
+        HARDENED_TRY(kmac_cshake_256_start(
+            stream, function_name_string.data, function_name_string.len,
+            customization_string.data, customization_string.len));
+      }
+      break;
+    default:
+      return OTCRYPTO_BAD_ARGS;
+  }
+
+  ctx->mode = mode;
   return OTCRYPTO_OK;
 }
 
@@ -344,36 +437,46 @@ otcrypto_status_t otcrypto_hash_update(
   }
 
   switch (ctx->mode) {
-    case kOtcryptoHashModeSha256: {
-      sha256_state_t state;
-      sha256_state_restore(ctx, &state);
-      HARDENED_TRY(
-          sha256_update(&state, input_message.data, input_message.len));
-      sha256_state_save(ctx, &state);
-      break;
-    }
-    case kOtcryptoHashModeSha384: {
-      sha384_state_t state;
-      sha384_state_restore(ctx, &state);
-      HARDENED_TRY(
-          sha384_update(&state, input_message.data, input_message.len));
-      sha384_state_save(ctx, &state);
-      break;
-    }
+    case kOtcryptoHashModeSha3_224:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashModeSha3_256:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashModeSha3_384:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashModeSha3_512:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashXofModeShake128:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashXofModeShake256:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashXofModeCshake128:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashXofModeCshake256:
+      return kmac_stream_absorb((kmac_stream_t *)ctx->data, input_message.data,
+                                input_message.len);
+    case kOtcryptoHashModeSha256:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashModeSha384:
+      OT_FALLTHROUGH_INTENDED;
     case kOtcryptoHashModeSha512: {
-      sha512_state_t state;
-      sha512_state_restore(ctx, &state);
+      // The HMAC block only holds the stream's state while processing this
+      // message, so streams can be interleaved with each other and with any
+      // other HMAC block operation.
+      hmac_ctx_t hwip_ctx;
+      HARDENED_TRY(sha2_state_restore(ctx, &hwip_ctx));
       HARDENED_TRY(
-          sha512_update(&state, input_message.data, input_message.len));
-      sha512_state_save(ctx, &state);
-      break;
+          hmac_update(&hwip_ctx, input_message.data, input_message.len));
+      sha2_state_save(ctx, &hwip_ctx);
+      return OTCRYPTO_OK;
     }
     default:
       // Unrecognized or unsupported hash mode.
       return OTCRYPTO_BAD_ARGS;
   }
 
-  return OTCRYPTO_OK;
+  // Should be unreachable.
+  HARDENED_TRAP();
+  return OTCRYPTO_FATAL_ERR;
 }
 
 otcrypto_status_t otcrypto_hash_final(otcrypto_hash_context_t *const ctx,
@@ -389,28 +492,130 @@ otcrypto_status_t otcrypto_hash_final(otcrypto_hash_context_t *const ctx,
   }
 
   switch (ctx->mode) {
-    case kOtcryptoHashModeSha256: {
-      sha256_state_t state;
-      sha256_state_restore(ctx, &state);
-      HARDENED_TRY(sha256_final(&state, digest.data));
-      break;
-    }
-    case kOtcryptoHashModeSha384: {
-      sha384_state_t state;
-      sha384_state_restore(ctx, &state);
-      HARDENED_TRY(sha384_final(&state, digest.data));
-      break;
+    case kOtcryptoHashModeSha3_224:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashModeSha3_256:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashModeSha3_384:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashModeSha3_512: {
+      kmac_stream_t *stream = (kmac_stream_t *)ctx->data;
+      status_t result = kmac_stream_squeeze(stream, digest.data, digest.len);
+      if (launder32(OT_UNSIGNED(result.value)) != kHardenedBoolTrue) {
+        // Release the KMAC block anyway; the squeeze error is the one to
+        // report.
+        (void)kmac_stream_end(stream);
+        return result;
+      }
+      HARDENED_CHECK_EQ(result.value, kHardenedBoolTrue);
+      return kmac_stream_end(stream);
     }
+    case kOtcryptoHashModeSha256:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashModeSha384:
+      OT_FALLTHROUGH_INTENDED;
     case kOtcryptoHashModeSha512: {
-      sha512_state_t state;
-      sha512_state_restore(ctx, &state);
-      HARDENED_TRY(sha512_final(&state, digest.data));
-      break;
+      hmac_ctx_t hwip_ctx;
+      HARDENED_TRY(sha2_state_restore(ctx, &hwip_ctx));
+      hmac_digest_t hmac_digest = {
+          .len = digest.len * sizeof(uint32_t),
+      };
+      HARDENED_TRY(hmac_final(&hwip_ctx, &hmac_digest));
+      hardened_memcpy(digest.data, hmac_digest.digest, digest.len);
+      return OTCRYPTO_OK;
     }
     default:
       // Unrecognized or unsupported hash mode.
       return OTCRYPTO_BAD_ARGS;
   }
 
-  return OTCRYPTO_OK;
+  // Should be unreachable.
+  HARDENED_TRAP();
+  return OTCRYPTO_FATAL_ERR;
+}
+
+/**
+ * Checks that a hash mode is an extendable-output function.
+ *
+ * @param mode Hash mode.
+ * @return Error status; `OTCRYPTO_BAD_ARGS` for other modes.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t check_xof_mode(otcrypto_hash_mode_t mode) {
+  switch (mode) {
+    case kOtcryptoHashXofModeShake128:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashXofModeShake256:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashXofModeCshake128:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashXofModeCshake256:
+      return OTCRYPTO_OK;
+    default:
+      return OTCRYPTO_BAD_ARGS;
+  }
+}
+
+otcrypto_status_t otcrypto_xof_squeeze(otcrypto_hash_context_t *const ctx,
+                                       otcrypto_hash_digest_t digest) {
+  if (ctx == NULL || (digest.data == NULL && digest.len != 0)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_TRY(check_xof_mode(ctx->mode));
+  if (ctx->mode != digest.mode) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  return kmac_stream_squeeze((kmac_stream_t *)ctx->data, digest.data,
+                             digest.len);
+}
+
+otcrypto_status_t otcrypto_xof_final(otcrypto_hash_context_t *const ctx) {
+  if (ctx == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_TRY(check_xof_mode(ctx->mode));
+
+  return kmac_stream_end((kmac_stream_t *)ctx->data);
+}
+
+otcrypto_status_t otcrypto_hash_abort(otcrypto_hash_context_t *const ctx) {
+  if (ctx == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  switch (ctx->mode) {
+    case kOtcryptoHashModeSha3_224:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashModeSha3_256:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashModeSha3_384:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashModeSha3_512:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashXofModeShake128:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashXofModeShake256:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashXofModeCshake128:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashXofModeCshake256:
+      return kmac_stream_end((kmac_stream_t *)ctx->data);
+    case kOtcryptoHashModeSha256:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashModeSha384:
+      OT_FALLTHROUGH_INTENDED;
+    case kOtcryptoHashModeSha512:
+      // SHA-2 contexts don't hold any hardware, so only the saved state needs
+      // to be cleared.
+      hardened_memshred(ctx->data, ARRAYSIZE(ctx->data));
+      return OTCRYPTO_OK;
+    default:
+      // Unrecognized or unsupported hash mode.
+      return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Should be unreachable.
+  HARDENED_TRAP();
+  return OTCRYPTO_FATAL_ERR;
 }
@@ -0,0 +1,49 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_HASH_MIDSTATE_H_
+#define OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_HASH_MIDSTATE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/crypto/impl/status.h"
+#include "sw/device/lib/crypto/include/datatypes.h"
+#include "sw/device/lib/crypto/include/hash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+/**
+ * Start a SHA-2 stream from an intermediate hash state.
+ *
+ * Initializes `ctx` as if `otcrypto_hash_init` and `otcrypto_hash_update` had
+ * been called with a `prefix_len`-byte message that produced `midstate`. The
+ * stream can then be continued with `otcrypto_hash_update` and
+ * `otcrypto_hash_final` as usual.
+ *
+ * The midstate is in digest form (see `hmac_sideload_midstates_t`): 8 words
+ * for SHA-256, and the full 16-word SHA-512 state for SHA-384 and SHA-512.
+ * The prefix length must be a non-zero multiple of the message block size.
+ *
+ * @param[out] ctx Hash context to initialize.
+ * @param hash_mode Hash mode (SHA-256, SHA-384 or SHA-512).
+ * @param midstate Intermediate hash state.
+ * @param prefix_len Length of the message that produced `midstate` in bytes.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t hash_sha2_midstate_resume(otcrypto_hash_context_t *ctx,
+                                   otcrypto_hash_mode_t hash_mode,
+                                   const uint32_t *midstate,
+                                   size_t prefix_len);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_HASH_MIDSTATE_H_
@@ -6,9 +6,12 @@
 
 #include "sw/device/lib/base/hardened_memory.h"
 #include "sw/device/lib/crypto/drivers/hmac.h"
+#include "sw/device/lib/crypto/drivers/keymgr.h"
 #include "sw/device/lib/crypto/drivers/kmac.h"
+#include "sw/device/lib/crypto/impl/hash_midstate.h"
 #include "sw/device/lib/crypto/impl/integrity.h"
 #include "sw/device/lib/crypto/impl/keyblob.h"
+#include "sw/device/lib/crypto/impl/sha2/hmac_sideload.h"
 #include "sw/device/lib/crypto/impl/sha2/sha256.h"
 #include "sw/device/lib/crypto/impl/sha2/sha512.h"
 #include "sw/device/lib/crypto/impl/status.h"
@@ -28,6 +31,92 @@ otcrypto_status_t otcrypto_hmac(const otcrypto_blinded_key_t *key,
   return otcrypto_hmac_final(&ctx, tag);
 }
 
+/**
+ * Prepare a blinded key for the KMAC driver.
+ *
+ * Checks the key against the KMAC mode and, for sideloaded keys, has the key
+ * manager generate the key on the sideload port.
+ *
+ * @param key Blinded key from the caller.
+ * @param kmac_mode KMAC mode the key is used for.
+ * @param[out] kmac_key Key for the KMAC driver.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_key_prepare(const otcrypto_blinded_key_t *key,
+                                 otcrypto_kmac_mode_t kmac_mode,
+                                 kmac_blinded_key_t *kmac_key) {
+  // Check `key_mode` matches `mac_mode`
+  switch (kmac_mode) {
+    case kOtcryptoKmacModeKmac128:
+      if (key->config.key_mode != kOtcryptoKeyModeKmac128) {
+        return OTCRYPTO_BAD_ARGS;
+      }
+      break;
+    case kOtcryptoKmacModeKmac256:
+      if (key->config.key_mode != kOtcryptoKeyModeKmac256) {
+        return OTCRYPTO_BAD_ARGS;
+      }
+      break;
+    default:
+      return OTCRYPTO_BAD_ARGS;
+  }
+
+  size_t key_len = keyblob_share_num_words(key->config) * sizeof(uint32_t);
+
+  // Check `key_len` is valid/supported by KMAC HWIP.
+  HARDENED_TRY(kmac_key_length_check(key_len));
+
+  // Check the integrity of the blinded key.
+  if (integrity_blinded_key_check(key) != kHardenedBoolTrue) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  kmac_key->share0 = NULL;
+  kmac_key->share1 = NULL;
+  kmac_key->hw_backed = key->config.hw_backed;
+  kmac_key->len = key_len;
+
+  if (key->config.hw_backed == kHardenedBoolTrue) {
+    if (key_len != kKmacSideloadKeyLength / 8) {
+      return OTCRYPTO_BAD_ARGS;
+    }
+    // Configure keymgr with diversification input and then generate the
+    // sideload key.
+    keymgr_diversification_t diversification;
+    // Diversification call also checks that `key->keyblob_length` is 8 words
+    // long.
+    HARDENED_TRY(keyblob_to_keymgr_diversification(key, &diversification));
+    HARDENED_TRY(keymgr_generate_key_kmac(diversification));
+  } else if (key->config.hw_backed == kHardenedBoolFalse) {
+    // Check `key_len` matches `keyblob_length`.
+    if (key->keyblob_length != 2 * key->config.key_length) {
+      return OTCRYPTO_BAD_ARGS;
+    }
+    HARDENED_TRY(keyblob_to_shares(key, &kmac_key->share0, &kmac_key->share1));
+  } else {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Clear the sideloaded KMAC key after use.
+ *
+ * @param hw_backed Whether the key was sideloaded.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_key_release(hardened_bool_t hw_backed) {
+  if (hw_backed == kHardenedBoolTrue) {
+    HARDENED_TRY(keymgr_sideload_clear_kmac());
+  } else if (hw_backed != kHardenedBoolFalse) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  return OTCRYPTO_OK;
+}
+
 OT_WARN_UNUSED_RESULT
 otcrypto_status_t otcrypto_kmac(const otcrypto_blinded_key_t *key,
                                 otcrypto_const_byte_buf_t input_message,
@@ -58,74 +147,208 @@ otcrypto_status_t otcrypto_kmac(const otcrypto_blinded_key_t *key,
     return OTCRYPTO_BAD_ARGS;
   }
 
-  size_t key_len = keyblob_share_num_words(key->config) * sizeof(uint32_t);
-
-  // Check `key_len` is valid/supported by KMAC HWIP.
-  HARDENED_TRY(kmac_key_length_check(key_len));
+  kmac_blinded_key_t kmac_key;
+  HARDENED_TRY(kmac_key_prepare(key, kmac_mode, &kmac_key));
 
-  // Check the integrity of the blinded key.
-  if (integrity_blinded_key_check(key) != kHardenedBoolTrue) {
-    return OTCRYPTO_BAD_ARGS;
+  status_t result;
+  switch (kmac_mode) {
+    case kOtcryptoKmacModeKmac128:
+      result = kmac_kmac_128(&kmac_key, input_message.data, input_message.len,
+                             customization_string.data,
+                             customization_string.len, tag.data, tag.len);
+      break;
+    case kOtcryptoKmacModeKmac256:
+      result = kmac_kmac_256(&kmac_key, input_message.data, input_message.len,
+                             customization_string.data,
+                             customization_string.len, tag.data, tag.len);
+      break;
+    default:
+      result = OTCRYPTO_BAD_ARGS;
+  }
+  if (launder32(OT_UNSIGNED(result.value)) != kHardenedBoolTrue) {
+    // Clear a sideloaded key anyway; the KMAC error is the one to report.
+    (void)kmac_key_release(key->config.hw_backed);
+    return result;
   }
+  HARDENED_CHECK_EQ(result.value, kHardenedBoolTrue);
 
-  kmac_blinded_key_t kmac_key = {
-      .share0 = NULL,
-      .share1 = NULL,
-      .hw_backed = key->config.hw_backed,
-      .len = key_len,
-  };
+  return kmac_key_release(key->config.hw_backed);
+}
 
-  if (key->config.hw_backed == kHardenedBoolTrue) {
-    if (key_len != kKmacSideloadKeyLength / 8) {
-      return OTCRYPTO_BAD_ARGS;
-    }
-    // Configure keymgr with diversification input and then generate the
-    // sideload key.
-    keymgr_diversification_t diversification;
-    // Diversification call also checks that `key->keyblob_length` is 8 words
-    // long.
-    HARDENED_TRY(keyblob_to_keymgr_diversification(key, &diversification));
-    HARDENED_TRY(keymgr_generate_key_kmac(diversification));
-  } else if (key->config.hw_backed == kHardenedBoolFalse) {
-    // Check `key_len` matches `keyblob_length`.
-    if (key->keyblob_length != 2 * key->config.key_length) {
-      return OTCRYPTO_BAD_ARGS;
-    }
-    HARDENED_TRY(keyblob_to_shares(key, &kmac_key.share0, &kmac_key.share1));
-  } else {
+/**
+ * Ensure that the KMAC context is large enough for the KMAC stream state.
+ */
+static_assert(sizeof(((otcrypto_kmac_context_t *)NULL)->data) >=
+                  sizeof(kmac_stream_t),
+              "otcrypto_kmac_context_t must be big enough to hold "
+              "kmac_stream_t");
+
+otcrypto_status_t otcrypto_kmac_init(
+    otcrypto_kmac_context_t *ctx, const otcrypto_blinded_key_t *key,
+    otcrypto_kmac_mode_t kmac_mode,
+    otcrypto_const_byte_buf_t customization_string) {
+  if (ctx == NULL || key == NULL || key->keyblob == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  if (customization_string.data == NULL && customization_string.len != 0) {
     return OTCRYPTO_BAD_ARGS;
   }
 
+  kmac_blinded_key_t kmac_key;
+  HARDENED_TRY(kmac_key_prepare(key, kmac_mode, &kmac_key));
+
+  kmac_stream_t *stream = (kmac_stream_t *)ctx->data;
+  status_t result;
   switch (kmac_mode) {
     case kOtcryptoKmacModeKmac128:
-      // Check `key_mode` matches `mac_mode`
-      if (key->config.key_mode != kOtcryptoKeyModeKmac128) {
-        return OTCRYPTO_BAD_ARGS;
-      }
-      HARDENED_TRY(kmac_kmac_128(&kmac_key, input_message.data,
-                                 input_message.len, customization_string.data,
-                                 customization_string.len, tag.data, tag.len));
+      result = kmac_kmac_128_start(stream, &kmac_key, customization_string.data,
+                                   customization_string.len);
       break;
     case kOtcryptoKmacModeKmac256:
-      // Check `key_mode` matches `mac_mode`
-      if (key->config.key_mode != kOtcryptoKeyModeKmac256) {
-        return OTCRYPTO_BAD_ARGS;
-      }
-
-      HARDENED_TRY(kmac_kmac_256(&kmac_key, input_message.data,
-                                 input_message.len, customization_string.data,
-                                 customization_string.len, tag.data, tag.len));
+      result = kmac_kmac_256_start(stream, &kmac_key, customization_string.data,
+                                   customization_string.len);
       break;
     default:
-      return OTCRYPTO_BAD_ARGS;
+      result = OTCRYPTO_BAD_ARGS;
+  }
+  if (launder32(OT_UNSIGNED(result.value)) != kHardenedBoolTrue) {
+    // No stream was started, but a sideloaded key must still be cleared.
+    (void)kmac_key_release(key->config.hw_backed);
+    return result;
   }
+  HARDENED_CHECK_EQ(result.value, kHardenedBoolTrue);
 
-  if (key->config.hw_backed == kHardenedBoolTrue) {
-    HARDENED_TRY(keymgr_sideload_clear_kmac());
-  } else if (key->config.hw_backed != kHardenedBoolFalse) {
+  ctx->mode = kmac_mode;
+  ctx->hw_backed = key->config.hw_backed;
+  return OTCRYPTO_OK;
+}
+
+otcrypto_status_t otcrypto_kmac_update(
+    otcrypto_kmac_context_t *const ctx,
+    otcrypto_const_byte_buf_t input_message) {
+  if (ctx == NULL || (input_message.data == NULL && input_message.len != 0)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  kmac_stream_t *stream = (kmac_stream_t *)ctx->data;
+  return kmac_stream_absorb(stream, input_message.data, input_message.len);
+}
+
+otcrypto_status_t otcrypto_kmac_final(otcrypto_kmac_context_t *const ctx,
+                                      size_t required_output_len,
+                                      otcrypto_word32_buf_t tag) {
+  if (ctx == NULL || tag.data == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Ensure that tag buffer length and `required_output_len` match each other.
+  if (required_output_len != tag.len * sizeof(uint32_t) ||
+      required_output_len == 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // End the stream and clear the key even if squeezing fails, so that the
+  // block is not left reserved; the first error is the one to report.
+  kmac_stream_t *stream = (kmac_stream_t *)ctx->data;
+  status_t squeeze_result = kmac_stream_squeeze(stream, tag.data, tag.len);
+  status_t end_result = otcrypto_kmac_abort(ctx);
+  if (launder32(OT_UNSIGNED(squeeze_result.value)) != kHardenedBoolTrue) {
+    return squeeze_result;
+  }
+  HARDENED_CHECK_EQ(squeeze_result.value, kHardenedBoolTrue);
+  return end_result;
+}
+
+otcrypto_status_t otcrypto_kmac_abort(otcrypto_kmac_context_t *const ctx) {
+  if (ctx == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  kmac_stream_t *stream = (kmac_stream_t *)ctx->data;
+  status_t end_result = kmac_stream_end(stream);
+  status_t release_result = kmac_key_release(ctx->hw_backed);
+  if (launder32(OT_UNSIGNED(end_result.value)) != kHardenedBoolTrue) {
+    return end_result;
+  }
+  HARDENED_CHECK_EQ(end_result.value, kHardenedBoolTrue);
+  return release_result;
+}
+
+/**
+ * Continue the inner and outer hashes of HMAC after their first block.
+ *
+ * @param ctx HMAC context to initialize.
+ * @param hash_mode Hash function for HMAC.
+ * @param midstates Hash states after the first block.
+ * @param message_block_words Message block size of the hash function.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t hmac_midstates_resume(
+    otcrypto_hmac_context_t *ctx, otcrypto_hash_mode_t hash_mode,
+    const hmac_sideload_midstates_t *midstates, size_t message_block_words) {
+  size_t prefix_len = message_block_words * sizeof(uint32_t);
+  HARDENED_TRY(hash_sha2_midstate_resume(&ctx->inner, hash_mode,
+                                         midstates->inner, prefix_len));
+  return hash_sha2_midstate_resume(&ctx->outer, hash_mode, midstates->outer,
+                                   prefix_len);
+}
+
+/**
+ * Start an HMAC operation with a sideloaded key.
+ *
+ * Generates the key in the OTBN sideload slot and lets OTBN hash the two
+ * message blocks that depend on the key. The inner and outer hashes then
+ * continue from the resulting intermediate states on the HMAC block like for
+ * any other key, so the key itself never reaches Ibex.
+ *
+ * @param ctx HMAC context to initialize.
+ * @param key Hardware-backed HMAC key.
+ * @param hash_mode Hash function for HMAC.
+ * @param sideload_hash Same hash function, for the OTBN app.
+ * @param message_block_words Message block size of the hash function.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t hmac_sideload_init(otcrypto_hmac_context_t *ctx,
+                                   const otcrypto_blinded_key_t *key,
+                                   otcrypto_hash_mode_t hash_mode,
+                                   hmac_sideload_hash_t sideload_hash,
+                                   size_t message_block_words) {
+  if (key->config.key_length != kHmacSideloadKeyBytes) {
     return OTCRYPTO_BAD_ARGS;
   }
 
+  // Configure keymgr with diversification input and then generate the
+  // sideload key.
+  keymgr_diversification_t diversification;
+  HARDENED_TRY(keyblob_to_keymgr_diversification(key, &diversification));
+  HARDENED_TRY(keymgr_generate_key_otbn(diversification));
+
+  // Hash (K0 ^ ipad) and (K0 ^ opad) on OTBN, then clear the key in any case.
+  // An OTBN error is the one to report.
+  hmac_sideload_midstates_t midstates;
+  status_t result = hmac_sideload_midstates(sideload_hash, &midstates);
+  status_t clear_result = keymgr_sideload_clear_otbn();
+  if (launder32(OT_UNSIGNED(result.value)) == kHardenedBoolTrue) {
+    result = clear_result;
+  }
+
+  // Continue the inner and outer hashes after their first block.
+  if (launder32(OT_UNSIGNED(result.value)) == kHardenedBoolTrue) {
+    result = hmac_midstates_resume(ctx, hash_mode, &midstates,
+                                   message_block_words);
+  }
+
+  // The midstates are key-equivalent, so shred them on every path.
+  hardened_memshred(midstates.inner, ARRAYSIZE(midstates.inner));
+  hardened_memshred(midstates.outer, ARRAYSIZE(midstates.outer));
+  if (launder32(OT_UNSIGNED(result.value)) != kHardenedBoolTrue) {
+    // The inner hash may already hold its midstate.
+    hardened_memshred(ctx->inner.data, ARRAYSIZE(ctx->inner.data));
+    return result;
+  }
+  HARDENED_CHECK_EQ(result.value, kHardenedBoolTrue);
   return OTCRYPTO_OK;
 }
 
@@ -134,10 +357,6 @@ otcrypto_status_t otcrypto_hmac_init(otcrypto_hmac_context_t *ctx,
   if (ctx == NULL || key == NULL || key->keyblob == NULL) {
     return OTCRYPTO_BAD_ARGS;
   }
-  if (key->config.hw_backed != kHardenedBoolFalse) {
-    // TODO(#15590): Add support for sideloaded keys via a custom OTBN program.
-    return OTCRYPTO_NOT_IMPLEMENTED;
-  }
   if (key->config.security_level != kOtcryptoKeySecurityLevelLow) {
     // TODO: Harden SHA2 implementations.
     return OTCRYPTO_NOT_IMPLEMENTED;
@@ -148,14 +367,17 @@ otcrypto_status_t otcrypto_hmac_init(otcrypto_hmac_context_t *ctx,
   size_t digest_words = 0;
   size_t message_block_words = 0;
   otcrypto_hash_mode_t hash_mode;
+  hmac_sideload_hash_t sideload_hash;
   switch (key->config.key_mode) {
     case kOtcryptoKeyModeHmacSha256:
       hash_mode = kOtcryptoHashModeSha256;
+      sideload_hash = kHmacSideloadHashSha256;
       digest_words = kSha256DigestWords;
       message_block_words = kSha256MessageBlockWords;
       break;
     case kOtcryptoKeyModeHmacSha384:
       hash_mode = kOtcryptoHashModeSha384;
+      sideload_hash = kHmacSideloadHashSha384;
       digest_words = kSha384DigestWords;
       // Since SHA-512 and SHA-384 have the same core, they use the same
       // message block size.
@@ -163,6 +385,7 @@ otcrypto_status_t otcrypto_hmac_init(otcrypto_hmac_context_t *ctx,
       break;
     case kOtcryptoKeyModeHmacSha512:
       hash_mode = kOtcryptoHashModeSha512;
+      sideload_hash = kHmacSideloadHashSha512;
       digest_words = kSha512DigestWords;
       message_block_words = kSha512MessageBlockWords;
       break;
@@ -178,6 +401,13 @@ otcrypto_status_t otcrypto_hmac_init(otcrypto_hmac_context_t *ctx,
     return OTCRYPTO_BAD_ARGS;
   }
 
+  if (key->config.hw_backed == kHardenedBoolTrue) {
+    return hmac_sideload_init(ctx, key, hash_mode, sideload_hash,
+                              message_block_words);
+  } else if (key->config.hw_backed != kHardenedBoolFalse) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
   // Get pointers to key shares.
   uint32_t *share0;
   uint32_t *share1;
@@ -0,0 +1,139 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/crypto/impl/sha2/hmac_sideload.h"
+
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/hardened_memory.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/crypto/drivers/otbn.h"
+#include "sw/device/lib/crypto/impl/sha2/sha256.h"
+#include "sw/device/lib/crypto/impl/sha2/sha512.h"
+#include "sw/device/lib/crypto/impl/status.h"
+
+// Module ID for status codes.
+#define MODULE_ID MAKE_MODULE_ID('s', '2', 'h')
+
+OTBN_DECLARE_APP_SYMBOLS(hmac_sideload);  // The OTBN sideloaded HMAC app.
+OTBN_DECLARE_SYMBOL_ADDR(hmac_sideload, mode);         // Hash function.
+OTBN_DECLARE_SYMBOL_ADDR(hmac_sideload, inner_state);  // Inner midstate.
+OTBN_DECLARE_SYMBOL_ADDR(hmac_sideload, outer_state);  // Outer midstate.
+
+static const otbn_app_t kOtbnAppHmacSideload = OTBN_APP_T_INIT(hmac_sideload);
+static const otbn_addr_t kOtbnVarHmacSideloadMode =
+    OTBN_ADDR_T_INIT(hmac_sideload, mode);
+static const otbn_addr_t kOtbnVarHmacSideloadInnerState =
+    OTBN_ADDR_T_INIT(hmac_sideload, inner_state);
+static const otbn_addr_t kOtbnVarHmacSideloadOuterState =
+    OTBN_ADDR_T_INIT(hmac_sideload, outer_state);
+
+// Mode is represented by a single word. See `hmac_sideload.s` for values.
+static const uint32_t kOtbnHmacSideloadModeSha256 = 0x39b;
+static const uint32_t kOtbnHmacSideloadModeSha384 = 0x74d;
+static const uint32_t kOtbnHmacSideloadModeSha512 = 0x4ae;
+
+/**
+ * Convert a SHA-256 state from the OTBN representation to digest form.
+ *
+ * The OTBN app holds the state as little-endian words in reverse word-order.
+ *
+ * @param otbn_state State as read from OTBN.
+ * @param[out] state State in digest form.
+ */
+static void sha256_state_from_otbn(const uint32_t *otbn_state,
+                                   uint32_t *state) {
+  for (size_t i = 0; i < kSha256StateWords; i++) {
+    state[i] = __builtin_bswap32(otbn_state[kSha256StateWords - 1 - i]);
+  }
+}
+
+/**
+ * Convert a SHA-512 state from the OTBN representation to digest form.
+ *
+ * The OTBN app packs the state as little-endian 64-bit words, H[0] first.
+ *
+ * @param otbn_state State as read from OTBN.
+ * @param[out] state State in digest form.
+ */
+static void sha512_state_from_otbn(const uint32_t *otbn_state,
+                                   uint32_t *state) {
+  for (size_t i = 0; i + 1 < kSha512StateWords; i += 2) {
+    state[i] = __builtin_bswap32(otbn_state[i + 1]);
+    state[i + 1] = __builtin_bswap32(otbn_state[i]);
+  }
+}
+
+/**
+ * Run the OTBN app and read back both states in the OTBN representation.
+ *
+ * The caller must shred `inner` and `outer` and wipe DMEM, also on failure.
+ *
+ * @param mode OTBN app mode.
+ * @param[out] inner Buffer for the inner state.
+ * @param[out] outer Buffer for the outer state.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+static status_t midstates_run(uint32_t mode,
+                              uint32_t inner[kHmacSideloadMaxStateWords],
+                              uint32_t outer[kHmacSideloadMaxStateWords]) {
+  // Load the app and run it. Fails if OTBN is non-idle.
+  HARDENED_TRY(otbn_load_app(kOtbnAppHmacSideload));
+  HARDENED_TRY(otbn_dmem_write(1, &mode, kOtbnVarHmacSideloadMode));
+  HARDENED_TRY(otbn_execute());
+  HARDENED_TRY(otbn_busy_wait_for_done());
+  HARDENED_TRY(otbn_dmem_read(kHmacSideloadMaxStateWords,
+                              kOtbnVarHmacSideloadInnerState, inner));
+  return otbn_dmem_read(kHmacSideloadMaxStateWords,
+                        kOtbnVarHmacSideloadOuterState, outer);
+}
+
+status_t hmac_sideload_midstates(hmac_sideload_hash_t hash,
+                                 hmac_sideload_midstates_t *midstates) {
+  uint32_t mode;
+  switch (launder32(hash)) {
+    case kHmacSideloadHashSha256:
+      HARDENED_CHECK_EQ(hash, kHmacSideloadHashSha256);
+      mode = kOtbnHmacSideloadModeSha256;
+      break;
+    case kHmacSideloadHashSha384:
+      HARDENED_CHECK_EQ(hash, kHmacSideloadHashSha384);
+      mode = kOtbnHmacSideloadModeSha384;
+      break;
+    case kHmacSideloadHashSha512:
+      HARDENED_CHECK_EQ(hash, kHmacSideloadHashSha512);
+      mode = kOtbnHmacSideloadModeSha512;
+      break;
+    default:
+      return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Read back both states and convert them to digest form. The key blocks
+  // and states in DMEM are key-equivalent, so the stack copies are shredded
+  // and DMEM is wiped even if running the app fails.
+  uint32_t inner[kHmacSideloadMaxStateWords];
+  uint32_t outer[kHmacSideloadMaxStateWords];
+  status_t result = midstates_run(mode, inner, outer);
+  if (launder32(OT_UNSIGNED(result.value)) != kHardenedBoolTrue) {
+    hardened_memshred(inner, ARRAYSIZE(inner));
+    hardened_memshred(outer, ARRAYSIZE(outer));
+    (void)otbn_dmem_sec_wipe();
+    return result;
+  }
+  HARDENED_CHECK_EQ(result.value, kHardenedBoolTrue);
+
+  memset(midstates, 0, sizeof(hmac_sideload_midstates_t));
+  if (launder32(hash) == kHmacSideloadHashSha256) {
+    HARDENED_CHECK_EQ(hash, kHmacSideloadHashSha256);
+    sha256_state_from_otbn(inner, midstates->inner);
+    sha256_state_from_otbn(outer, midstates->outer);
+  } else {
+    HARDENED_CHECK_NE(hash, kHmacSideloadHashSha256);
+    sha512_state_from_otbn(inner, midstates->inner);
+    sha512_state_from_otbn(outer, midstates->outer);
+  }
+  hardened_memshred(inner, ARRAYSIZE(inner));
+  hardened_memshred(outer, ARRAYSIZE(outer));
+  return otbn_dmem_sec_wipe();
+}
@@ -0,0 +1,88 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_SHA2_HMAC_SIDELOAD_H_
+#define OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_SHA2_HMAC_SIDELOAD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/crypto/impl/sha2/sha512.h"
+#include "sw/device/lib/crypto/impl/status.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+enum {
+  /**
+   * Length of a sideloaded HMAC key in bits.
+   *
+   * This is the full size of the key manager's OTBN sideload key.
+   */
+  kHmacSideloadKeyBits = 384,
+  /**
+   * Length of a sideloaded HMAC key in bytes.
+   */
+  kHmacSideloadKeyBytes = kHmacSideloadKeyBits / 8,
+  /**
+   * Maximum length of an intermediate hash state in words.
+   *
+   * SHA-384 keeps the full SHA-512 state, so this is the size of the SHA-512
+   * state for all SHA-2 variants with 1024-bit message blocks.
+   */
+  kHmacSideloadMaxStateWords = kSha512StateWords,
+};
+
+/**
+ * Hash functions supported for sideloaded HMAC.
+ */
+typedef enum hmac_sideload_hash {
+  kHmacSideloadHashSha256 = 1,
+  kHmacSideloadHashSha384 = 2,
+  kHmacSideloadHashSha512 = 3,
+} hmac_sideload_hash_t;
+
+/**
+ * Intermediate hash states for HMAC.
+ *
+ * The inner state is the hash state after absorbing (K0 ^ ipad), and the outer
+ * state the hash state after absorbing (K0 ^ opad); see FIPS 198-1. Together,
+ * they are enough to compute HMAC tags for any message, so they are as
+ * sensitive as the key itself.
+ *
+ * Each state is serialized like a digest, i.e. as the FIPS 180-4 big-endian
+ * byte string of the hash state words, so that H[0] comes first. SHA-256
+ * states only use the first `kSha256StateWords` words.
+ */
+typedef struct hmac_sideload_midstates {
+  uint32_t inner[kHmacSideloadMaxStateWords];
+  uint32_t outer[kHmacSideloadMaxStateWords];
+} hmac_sideload_midstates_t;
+
+/**
+ * Compute the HMAC intermediate hash states for the sideloaded OTBN key.
+ *
+ * The HMAC key is the 384-bit value derived into the key manager's OTBN
+ * sideload slot; see `hmac_sideload.s` for details. Both message blocks that
+ * depend on the key are hashed on OTBN, so the key never reaches Ibex.
+ *
+ * The caller must have generated the sideloaded key (e.g. with
+ * `keymgr_generate_key_otbn`) and is responsible for clearing it afterwards.
+ * Blocks until OTBN is done, and wipes OTBN data memory before returning.
+ *
+ * @param hash Hash function to use.
+ * @param[out] midstates Intermediate hash states.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t hmac_sideload_midstates(hmac_sideload_hash_t hash,
+                                 hmac_sideload_midstates_t *midstates);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_SHA2_HMAC_SIDELOAD_H_
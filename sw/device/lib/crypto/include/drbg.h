@@ -16,6 +16,20 @@
 extern "C" {
 #endif  // __cplusplus
 
+/**
+ * Buffered DRBG output pool.
+ *
+ * A pool fetches DRBG output in larger blocks and serves small requests from
+ * the buffer, so that callers that need many small random values do not pay
+ * for a full CSRNG command each time.
+ *
+ * Representation is internal to the DRBG implementation; initialize with
+ * #otcrypto_drbg_pool_init and clear with #otcrypto_drbg_pool_clear.
+ */
+typedef struct otcrypto_drbg_pool {
+  uint32_t data[40];
+} otcrypto_drbg_pool_t;
+
 /**
  * Instantiates the DRBG system.
  *
@@ -120,6 +134,64 @@ otcrypto_status_t otcrypto_drbg_manual_generate(
     otcrypto_const_byte_buf_t additional_input,
     otcrypto_word32_buf_t drbg_output);
 
+/**
+ * Initializes a DRBG output pool.
+ *
+ * The pool starts out empty and is filled on first use. The DRBG must be
+ * instantiated with `otcrypto_drbg_instantiate` before the pool is used.
+ *
+ * If `reseed_interval` is nonzero, the pool reseeds the DRBG with fresh
+ * entropy after every `reseed_interval` refills, before the next refill. The
+ * reseed happens on a refill, so requests served from the buffer do not wait
+ * for it. If `reseed_interval` is zero, the pool relies on the caller (or the
+ * hardware reseed counter) to reseed.
+ *
+ * If `prediction_resistance` is `kHardenedBoolTrue`, every request reseeds
+ * the DRBG and is generated directly, so the pool never buffers any output.
+ *
+ * @param[out] pool Pool to initialize.
+ * @param reseed_interval Number of refills between automatic reseeds.
+ * @param prediction_resistance Whether to reseed before every request.
+ * @return Result of the pool initialization.
+ */
+otcrypto_status_t otcrypto_drbg_pool_init(
+    otcrypto_drbg_pool_t *pool, size_t reseed_interval,
+    hardened_bool_t prediction_resistance);
+
+/**
+ * DRBG function for generating random bits through an output pool.
+ *
+ * Equivalent to `otcrypto_drbg_generate`, except that short requests without
+ * additional input are served from the pool. Requests with additional input,
+ * and requests at least as large as the pool, bypass the buffer and go to the
+ * DRBG directly. Like `otcrypto_drbg_generate`, this function checks the
+ * hardware flags for FIPS compatibility.
+ *
+ * Output that was buffered before the DRBG was last instantiated, reseeded or
+ * uninstantiated is discarded rather than served. This includes reseeds done
+ * inside other operations, such as RSA and Ed25519 key generation. Words are
+ * shredded from the pool as soon as they are handed out.
+ *
+ * @param pool Initialized output pool.
+ * @param additional_input Pointer to the additional data.
+ * @param[out] drbg_output Pointer to the generated pseudo random bits.
+ * @return Result of the DRBG generate operation.
+ */
+otcrypto_status_t otcrypto_drbg_pool_generate(
+    otcrypto_drbg_pool_t *pool, otcrypto_const_byte_buf_t additional_input,
+    otcrypto_word32_buf_t drbg_output);
+
+/**
+ * Clears a DRBG output pool.
+ *
+ * Shreds any buffered output. The pool must be initialized again before it
+ * can be reused.
+ *
+ * @param pool Pool to clear.
+ * @return Result of the clear operation.
+ */
+otcrypto_status_t otcrypto_drbg_pool_clear(otcrypto_drbg_pool_t *pool);
+
 /**
  * Uninstantiates DRBG and clears the context.
  *
@@ -231,6 +231,8 @@ otcrypto_status_t otcrypto_ecdh(const otcrypto_blinded_key_t *private_key,
  * The value in the `checksum` field of the blinded key struct will be
  * populated by the key generation function.
  *
+ * See `otcrypto_ed25519_sign` for a limitation on masking the private key.
+ *
  * @param[out] private_key Pointer to the blinded private key struct.
  * @param[out] public_key Pointer to the unblinded public key struct.
  * @return Result of the Ed25519 key generation.
@@ -242,6 +244,15 @@ otcrypto_status_t otcrypto_ed25519_keygen(otcrypto_blinded_key_t *private_key,
 /**
  * Generates an Ed25519 digital signature.
  *
+ * In `kOtcryptoEddsaSignModeHashEddsa` mode, this computes an Ed25519ph
+ * signature with an empty context (RFC 8032, section 5.1) and `input_message`
+ * must be the 64-byte SHA-512 digest of the message.
+ *
+ * The private key is stored masked, but the seed and the expanded secret
+ * scalar are briefly unmasked on Ibex while they are hashed with SHA-512,
+ * because the HMAC block has no masked mode. Ed25519 key generation and
+ * signing are therefore not hardened against side-channel attacks on Ibex.
+ *
  * @param private_key Pointer to the blinded private key struct.
  * @param input_message Input message to be signed.
  * @param sign_mode Parameter for EdDSA or Hash EdDSA sign mode.
@@ -257,6 +268,10 @@ otcrypto_status_t otcrypto_ed25519_sign(
 /**
  * Verifies an Ed25519 signature.
  *
+ * See `otcrypto_ed25519_sign` for the meaning of `sign_mode`. A public key
+ * that does not decode to a curve point, or a signature with S >= L, results
+ * in `OTCRYPTO_BAD_ARGS`.
+ *
  * @param public_key Pointer to the unblinded public key struct.
  * @param input_message Input message to be signed for verification.
  * @param sign_mode Parameter for EdDSA or Hash EdDSA sign mode.
@@ -577,10 +592,14 @@ otcrypto_status_t otcrypto_ed25519_keygen_async_finalize(
  * signature on the input message. The `domain_parameter` field for
  * Ed25519 is automatically set.
  *
+ * The signature depends on a hash of the commitment R, so this function blocks
+ * until OTBN has computed R and only leaves the final scalar arithmetic
+ * running. See `otcrypto_ed25519_sign` for the meaning of `sign_mode`.
+ *
  * @param private_key Pointer to the blinded private key struct.
  * @param input_message Input message to be signed.
  * @param sign_mode Parameter for EdDSA or Hash EdDSA sign mode.
- * @param[out] signature Pointer to the EdDSA signature to get (r) value.
+ * @param[out] signature Pointer to the EdDSA signature (written on finalize).
  * @return Result of async Ed25519 start operation.
  */
 OT_WARN_UNUSED_RESULT
@@ -596,7 +615,7 @@ otcrypto_status_t otcrypto_ed25519_sign_async_start(
  * status is done, or `kOtcryptoStatusValueAsyncIncomplete` if the OTBN is
  * busy or `kOtcryptoStatusValueInternalError` if there is an error.
  *
- * @param[out] signature Pointer to the EdDSA signature to get (s) value.
+ * @param[out] signature Pointer to the EdDSA signature with (r,s) values.
  * @return Result of async Ed25519 finalize operation.
  */
 OT_WARN_UNUSED_RESULT
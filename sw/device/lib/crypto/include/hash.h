@@ -94,9 +94,16 @@ otcrypto_status_t otcrypto_xof_cshake(
  * Performs the INIT operation for a cryptographic hash function.
  *
  * Initializes the generic hash context. The required hash mode is selected
- * through the `hash_mode` parameter. Only `kOtcryptoHashModeSha256`,
- * `kOtcryptoHashModeSha384` and `kOtcryptoHashModeSha512` are supported. Other
- * modes are not supported and an error would be returned.
+ * through the `hash_mode` parameter. SHA-2, SHA-3 and SHAKE modes are
+ * supported; use #otcrypto_xof_cshake_init for cSHAKE. Other modes are not
+ * supported and an error would be returned.
+ *
+ * SHA-2 contexts hold the complete hash state, so any number of them can be
+ * used at the same time. SHA-3 and SHAKE run on the KMAC hardware block, which
+ * cannot save its state; the block is reserved for the operation until
+ * #otcrypto_hash_final (SHA-3) or #otcrypto_xof_final (SHAKE), and other
+ * operations that use the KMAC block return errors in between. Use
+ * #otcrypto_hash_abort to release it early, e.g. after an error.
  *
  * Populates the hash context with the selected hash mode and its digest and
  * block sizes. The structure of hash context and how it populates the required
@@ -130,7 +137,9 @@ otcrypto_status_t otcrypto_hash_update(otcrypto_hash_context_t *const ctx,
  * Performs the FINAL operation for a cryptographic hash function.
  *
  * The final operation processes the remaining partial blocks, computes the
- * final hash and copies it to the `digest` parameter.
+ * final hash and copies it to the `digest` parameter. Only for fixed-length
+ * hash functions; use #otcrypto_xof_squeeze and #otcrypto_xof_final for
+ * extendable-output functions.
  *
  * #otcrypto_hash_update should be called before this function.
  *
@@ -145,6 +154,69 @@ otcrypto_status_t otcrypto_hash_update(otcrypto_hash_context_t *const ctx,
 otcrypto_status_t otcrypto_hash_final(otcrypto_hash_context_t *const ctx,
                                       otcrypto_hash_digest_t digest);
 
+/**
+ * Performs the INIT operation for cSHAKE.
+ *
+ * Initializes the generic hash context for streaming cSHAKE with the given
+ * function name and customization strings, see #otcrypto_xof_cshake. The
+ * `mode` must be `kOtcryptoHashXofModeCshake128` or
+ * `kOtcryptoHashXofModeCshake256`.
+ *
+ * As for SHAKE, the KMAC hardware block is reserved for the operation until
+ * #otcrypto_xof_final.
+ *
+ * @param ctx Pointer to the generic hash context struct.
+ * @param mode Required cSHAKE mode.
+ * @param function_name_string NIST Function name string.
+ * @param customization_string Customization string for cSHAKE.
+ * @return Result of the cSHAKE init operation.
+ */
+otcrypto_status_t otcrypto_xof_cshake_init(
+    otcrypto_hash_context_t *const ctx, otcrypto_hash_mode_t mode,
+    otcrypto_const_byte_buf_t function_name_string,
+    otcrypto_const_byte_buf_t customization_string);
+
+/**
+ * Squeezes output from an extendable-output function.
+ *
+ * The first call completes the message, so #otcrypto_hash_update cannot be
+ * called afterwards. Each call continues the output where the previous one
+ * stopped, so output can be read in pieces of any number of words.
+ *
+ * The caller should allocate space for the `digest` buffer and set the `mode`
+ * and `len` fields. The `mode` must match the mode of the hash context.
+ *
+ * @param ctx Pointer to the generic hash context struct.
+ * @param[out] digest Next output words of the extendable-output function.
+ * @return Result of the squeeze operation.
+ */
+otcrypto_status_t otcrypto_xof_squeeze(otcrypto_hash_context_t *const ctx,
+                                       otcrypto_hash_digest_t digest);
+
+/**
+ * Ends an extendable-output function and releases the KMAC block.
+ *
+ * @param ctx Pointer to the generic hash context struct.
+ * @return Result of the operation.
+ */
+otcrypto_status_t otcrypto_xof_final(otcrypto_hash_context_t *const ctx);
+
+/**
+ * Abandons a streaming hash operation.
+ *
+ * Accepts a context of any hash mode after its INIT operation succeeded, e.g.
+ * to clean up after an UPDATE operation returned an error. For SHA-3, SHAKE
+ * and cSHAKE this releases the KMAC block; the block is released even if this
+ * function returns an error. For SHA-2 it clears the saved state.
+ *
+ * It is not needed after #otcrypto_hash_final or #otcrypto_xof_final, which
+ * end the operation themselves.
+ *
+ * @param ctx Pointer to the generic hash context struct.
+ * @return Result of the operation.
+ */
+otcrypto_status_t otcrypto_hash_abort(otcrypto_hash_context_t *const ctx);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
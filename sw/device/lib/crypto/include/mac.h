@@ -42,6 +42,21 @@ typedef struct otcrypto_hmac_context {
   otcrypto_hash_context_t outer;
 } otcrypto_hmac_context_t;
 
+/**
+ * Generic KMAC context.
+ *
+ * Representation is internal to the KMAC implementation; initialize
+ * with #otcrypto_kmac_init.
+ */
+typedef struct otcrypto_kmac_context {
+  // Required KMAC mode.
+  otcrypto_kmac_mode_t mode;
+  // Whether the key is sideloaded.
+  hardened_bool_t hw_backed;
+  // Context for the KMAC operation.
+  uint32_t data[8];
+} otcrypto_kmac_context_t;
+
 /**
  * Performs the HMAC function on the input data.
  *
@@ -112,6 +127,9 @@ otcrypto_status_t otcrypto_kmac(const otcrypto_blinded_key_t *key,
  * key mode. Only SHA-2 hash functions are are supported. Other modes (e.g.
  * SHA-3) are not supported and will result in errors.
  *
+ * Hardware-backed keys are derived into the OTBN sideload slot and must be
+ * exactly 384 bits (48 bytes) long.
+ *
  * @param[out] ctx Pointer to the generic HMAC context struct.
  * @param key Pointer to the blinded HMAC key struct.
  * @param hash_mode Hash function to use.
@@ -157,6 +175,72 @@ otcrypto_status_t otcrypto_hmac_update(otcrypto_hmac_context_t *const ctx,
 otcrypto_status_t otcrypto_hmac_final(otcrypto_hmac_context_t *const ctx,
                                       otcrypto_word32_buf_t tag);
 
+/**
+ * Performs the INIT operation for KMAC.
+ *
+ * Checks the key as for #otcrypto_kmac and starts the KMAC computation with the
+ * customization string.
+ *
+ * The KMAC hardware block cannot save its state, so it is reserved for this
+ * operation until #otcrypto_kmac_final is called. Other operations that use
+ * the KMAC block, including SHA-3 hashing, return errors in between. Use
+ * #otcrypto_kmac_abort to release it early, e.g. after an error.
+ *
+ * @param[out] ctx Pointer to the KMAC context struct.
+ * @param key Pointer to the blinded key struct with key shares.
+ * @param kmac_mode Required KMAC mode.
+ * @param customization_string Customization string.
+ * @return Result of the KMAC init operation.
+ */
+otcrypto_status_t otcrypto_kmac_init(
+    otcrypto_kmac_context_t *ctx, const otcrypto_blinded_key_t *key,
+    otcrypto_kmac_mode_t kmac_mode,
+    otcrypto_const_byte_buf_t customization_string);
+
+/**
+ * Performs the UPDATE operation for KMAC.
+ *
+ * #otcrypto_kmac_init should be called before calling this function.
+ *
+ * @param ctx Pointer to the KMAC context struct.
+ * @param input_message Input message to be hashed.
+ * @return Result of the KMAC update operation.
+ */
+otcrypto_status_t otcrypto_kmac_update(otcrypto_kmac_context_t *const ctx,
+                                       otcrypto_const_byte_buf_t input_message);
+
+/**
+ * Performs the FINAL operation for KMAC.
+ *
+ * Computes the tag of `required_output_len` bytes and releases the KMAC
+ * block. The block and a sideloaded key are released even if computing the
+ * tag fails, but not if the arguments are invalid. The `tag` buffer is set up
+ * as for #otcrypto_kmac.
+ *
+ * @param ctx Pointer to the KMAC context struct.
+ * @param required_output_len Required output length, in bytes.
+ * @param[out] tag Output authentication tag.
+ * @return Result of the KMAC final operation.
+ */
+otcrypto_status_t otcrypto_kmac_final(otcrypto_kmac_context_t *const ctx,
+                                      size_t required_output_len,
+                                      otcrypto_word32_buf_t tag);
+
+/**
+ * Abandons a streaming KMAC operation.
+ *
+ * Accepts a context after its INIT operation succeeded, e.g. to clean up after
+ * an UPDATE operation returned an error. Releases the KMAC block and clears a
+ * sideloaded key; both are released even if this function returns an error.
+ *
+ * It is not needed after #otcrypto_kmac_final, which ends the operation
+ * itself.
+ *
+ * @param ctx Pointer to the KMAC context struct.
+ * @return Result of the operation.
+ */
+otcrypto_status_t otcrypto_kmac_abort(otcrypto_kmac_context_t *const ctx);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
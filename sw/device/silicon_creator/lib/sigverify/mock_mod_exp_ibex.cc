@@ -11,5 +11,17 @@ rom_error_t sigverify_mod_exp_ibex(const sigverify_rsa_key_t *key,
                                    sigverify_rsa_buffer_t *result) {
   return MockSigverifyModExpIbex::Instance().mod_exp(key, sig, result);
 }
+
+void sigverify_mod_exp_ibex_rr_compute(const sigverify_rsa_key_t *key,
+                                       sigverify_rsa_buffer_t *rr) {
+  MockSigverifyModExpIbex::Instance().rr_compute(key, rr);
+}
+
+rom_error_t sigverify_mod_exp_ibex_rr(const sigverify_rsa_key_t *key,
+                                      const sigverify_rsa_buffer_t *rr,
+                                      const sigverify_rsa_buffer_t *sig,
+                                      sigverify_rsa_buffer_t *result) {
+  return MockSigverifyModExpIbex::Instance().mod_exp_rr(key, rr, sig, result);
+}
 }  // extern "C"
 }  // namespace rom_test
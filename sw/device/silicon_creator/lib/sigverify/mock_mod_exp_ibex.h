@@ -21,6 +21,11 @@ class MockSigverifyModExpIbex
   MOCK_METHOD(rom_error_t, mod_exp,
               (const sigverify_rsa_key_t *, const sigverify_rsa_buffer_t *,
                sigverify_rsa_buffer_t *));
+  MOCK_METHOD(void, rr_compute,
+              (const sigverify_rsa_key_t *, sigverify_rsa_buffer_t *));
+  MOCK_METHOD(rom_error_t, mod_exp_rr,
+              (const sigverify_rsa_key_t *, const sigverify_rsa_buffer_t *,
+               const sigverify_rsa_buffer_t *, sigverify_rsa_buffer_t *));
 };
 
 }  // namespace internal
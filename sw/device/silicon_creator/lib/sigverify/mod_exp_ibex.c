@@ -4,6 +4,7 @@
 
 #include "sw/device/silicon_creator/lib/sigverify/mod_exp_ibex.h"
 
+#include <assert.h>
 #include <stddef.h>
 
 #include "sw/device/lib/base/macros.h"
@@ -71,6 +72,42 @@ static uint32_t shift_left(sigverify_rsa_buffer_t *a) {
   return msb;
 }
 
+enum {
+  /**
+   * Number of inner-loop iterations of `mont_mul` per loop body.
+   *
+   * The inner loop covers the `kSigVerifyRsaNumWords - 1` digits after the
+   * first one, which is 95 = 5 * 19 for RSA-3072.
+   */
+  kMontMulUnroll = 5,
+};
+static_assert((kSigVerifyRsaNumWords - 1) % kMontMulUnroll == 0,
+              "Inner loop of `mont_mul` must unroll evenly.");
+
+/**
+ * Processes digit `j` of `y` and `n` for one outer iteration of `mont_mul`.
+ *
+ * Adds x_i * y_j and u_i * n_j to the j^th digit of the intermediate result
+ * and writes the sum, shifted right by one digit, to digit j - 1. See
+ * `mont_mul` for the roles of `acc0` and `acc1`.
+ *
+ * @param x_i The i^th digit of `x`.
+ * @param u_i The i^th quotient digit.
+ * @param y_j The j^th digit of `y`.
+ * @param n_j The j^th digit of the modulus.
+ * @param[in,out] acc0 Sum of the first two addends and its carry.
+ * @param[in,out] acc1 Sum of all three addends and its carry.
+ * @param[in,out] r Pointer to the j^th digit of the intermediate result.
+ */
+OT_ALWAYS_INLINE
+static void mont_mul_step(uint32_t x_i, uint32_t u_i, uint32_t y_j,
+                          uint32_t n_j, uint64_t *acc0, uint64_t *acc1,
+                          uint32_t *r) {
+  *acc0 = (uint64_t)x_i * y_j + r[0] + (*acc0 >> 32);
+  *acc1 = (uint64_t)u_i * n_j + (uint32_t)*acc0 + (*acc1 >> 32);
+  r[-1] = (uint32_t)*acc1;
+}
+
 /**
  * Computes the Montgomery reduction of the product of two integers.
  *
@@ -80,7 +117,9 @@ static uint32_t shift_left(sigverify_rsa_buffer_t *a) {
  * - n is the modulus of the key, and
  * - R is 2^`kSigVerifyRsaNumBits`, e.g. 2^3072 for RSA-3072.
  *
- * See Handbook of Applied Cryptography, Ch. 14, Alg. 14.36.
+ * See Handbook of Applied Cryptography, Ch. 14, Alg. 14.36. The multiplication
+ * and reduction for each digit of `x` are fused into a single pass over `y` and
+ * `n`, i.e. the finely integrated operand scanning (FIOS) variant.
  *
  * @param key An RSA public key.
  * @param x Buffer that holds `x`, little-endian.
@@ -93,6 +132,9 @@ static void mont_mul(const sigverify_rsa_key_t *key,
                      sigverify_rsa_buffer_t *result) {
   memset(result->data, 0, sizeof(result->data));
 
+  const uint32_t *n = key->n.data;
+  const uint32_t n0_inv = key->n0_inv[0];
+  uint32_t *r = result->data;
   for (size_t i = 0; i < ARRAYSIZE(x->data); ++i) {
     // The loop below reads one word ahead of writes to avoid a separate loop
     // for the division by `b` in step 2.2 of the algorithm. Thus, `acc0` and
@@ -102,21 +144,30 @@ static void mont_mul(const sigverify_rsa_key_t *key,
     // and `acc1`. `acc0` and `acc1` can safely store these intermediate values,
     // i.e. without wrapping, because UINT32_MAX^2 + 2*UINT32_MAX is
     // 0xffff_ffff_ffff_ffff.
+    const uint32_t x_i = x->data[i];
 
     // Holds the sum of the first two addends in step 2.2.
-    uint64_t acc0 = (uint64_t)x->data[i] * y->data[0] + result->data[0];
-    const uint32_t u_i = (uint32_t)acc0 * key->n0_inv[0];
+    uint64_t acc0 = (uint64_t)x_i * y->data[0] + r[0];
+    const uint32_t u_i = (uint32_t)acc0 * n0_inv;
     // Holds the sum of the all three addends in step 2.2.
-    uint64_t acc1 = (uint64_t)u_i * key->n.data[0] + (uint32_t)acc0;
+    uint64_t acc1 = (uint64_t)u_i * n[0] + (uint32_t)acc0;
 
-    // Process the i^th digit of `x`, i.e. `x[i]`.
-    for (size_t j = 1; j < ARRAYSIZE(result->data); ++j) {
-      acc0 = (uint64_t)x->data[i] * y->data[j] + result->data[j] + (acc0 >> 32);
-      acc1 = (uint64_t)u_i * key->n.data[j] + (uint32_t)acc0 + (acc1 >> 32);
-      result->data[j - 1] = (uint32_t)acc1;
+    // Process the i^th digit of `x`, i.e. `x[i]`. The loop is unrolled to
+    // amortize the loop overhead, which is significant on Ibex relative to
+    // the four multiplications per digit.
+    for (size_t j = 1; j < ARRAYSIZE(result->data); j += kMontMulUnroll) {
+      mont_mul_step(x_i, u_i, y->data[j], n[j], &acc0, &acc1, &r[j]);
+      mont_mul_step(x_i, u_i, y->data[j + 1], n[j + 1], &acc0, &acc1,
+                    &r[j + 1]);
+      mont_mul_step(x_i, u_i, y->data[j + 2], n[j + 2], &acc0, &acc1,
+                    &r[j + 2]);
+      mont_mul_step(x_i, u_i, y->data[j + 3], n[j + 3], &acc0, &acc1,
+                    &r[j + 3]);
+      mont_mul_step(x_i, u_i, y->data[j + 4], n[j + 4], &acc0, &acc1,
+                    &r[j + 4]);
     }
     acc0 = (acc0 >> 32) + (acc1 >> 32);
-    result->data[ARRAYSIZE(result->data) - 1] = (uint32_t)acc0;
+    r[ARRAYSIZE(result->data) - 1] = (uint32_t)acc0;
 
     // The intermediate result of this algorithm before the check below is
     // bounded by R + n (Eq. (4) in Montgomery Arithmetic from a Software
@@ -133,16 +184,10 @@ static void mont_mul(const sigverify_rsa_key_t *key,
   }
 }
 
-/**
- * Calculates R^2 mod n, where R = 2^kSigVerifyRsaNumBits.
- *
- * @param key An RSA public key.
- * @param[out] result Buffer to write the result to, little-endian.
- */
-static void calc_r_square(const sigverify_rsa_key_t *key,
-                          sigverify_rsa_buffer_t *result) {
+void sigverify_mod_exp_ibex_rr_compute(const sigverify_rsa_key_t *key,
+                                       sigverify_rsa_buffer_t *rr) {
   sigverify_rsa_buffer_t buf;
-  memset(buf.data, 0, sizeof(result->data));
+  memset(buf.data, 0, sizeof(rr->data));
   // This subtraction sets buf = -n mod R = R - n, which is equivalent to R
   // modulo n and ensures that `buf` fits in `kSigVerifyRsaNumWords` going
   // into the loop.
@@ -160,28 +205,68 @@ static void calc_r_square(const sigverify_rsa_key_t *key,
   }
 
   // Perform 5 montgomery squares to get RR = ((2^96)^32 * R) mod n
-  mont_mul(key, &buf, &buf, result);
+  mont_mul(key, &buf, &buf, rr);
   for (size_t i = 0; i < 2; ++i) {
-    mont_mul(key, result, result, &buf);
-    mont_mul(key, &buf, &buf, result);
+    mont_mul(key, rr, rr, &buf);
+    mont_mul(key, &buf, &buf, rr);
+  }
+
+  // Callers may store `rr`, so return the least non-negative residue.
+  if (greater_equal_modulus(key, rr)) {
+    OT_DISCARD(subtract_modulus(key, rr));
   }
 }
 
-rom_error_t sigverify_mod_exp_ibex(const sigverify_rsa_key_t *key,
-                                   const sigverify_rsa_buffer_t *sig,
-                                   sigverify_rsa_buffer_t *result) {
-  // Reject the signature if it is too large (n <= sig): RFC 8017, section
-  // 5.2.2, step 1.
-  if (greater_equal_modulus(key, sig)) {
-    return kErrorSigverifyLargeRsaSignature;
+/**
+ * Checks that `rr` is R^2 mod n, where R = 2^kSigVerifyRsaNumBits.
+ *
+ * Since R and n are coprime, rr = R^2 mod n if and only if rr < n and
+ * rr*R^-1 mod n = R mod n = R - n, which costs a single Montgomery
+ * multiplication.
+ *
+ * @param key An RSA public key.
+ * @param rr Buffer that holds the value to check, little-endian.
+ * @return Whether `rr` is R^2 mod n.
+ */
+OT_WARN_UNUSED_RESULT
+static bool rr_check(const sigverify_rsa_key_t *key,
+                     const sigverify_rsa_buffer_t *rr) {
+  if (greater_equal_modulus(key, rr)) {
+    return false;
   }
 
+  sigverify_rsa_buffer_t one;
+  memset(one.data, 0, sizeof(one.data));
+  one.data[0] = 1;
+  sigverify_rsa_buffer_t r;
+  mont_mul(key, rr, &one, &r);
+  if (greater_equal_modulus(key, &r)) {
+    OT_DISCARD(subtract_modulus(key, &r));
+  }
+
+  // R - n, computed as in `sigverify_mod_exp_ibex_rr_compute()`.
+  sigverify_rsa_buffer_t r_mod_n;
+  memset(r_mod_n.data, 0, sizeof(r_mod_n.data));
+  OT_DISCARD(subtract_modulus(key, &r_mod_n));
+  return memcmp(r.data, r_mod_n.data, sizeof(r.data)) == 0;
+}
+
+/**
+ * Computes sig^65537 mod n given R^2 mod n.
+ *
+ * @param key An RSA public key.
+ * @param rr Buffer that holds R^2 mod n, little-endian.
+ * @param sig Buffer that holds the signature, little-endian.
+ * @param[out] result Buffer to write the result to, little-endian.
+ */
+static void mod_exp(const sigverify_rsa_key_t *key,
+                    const sigverify_rsa_buffer_t *rr,
+                    const sigverify_rsa_buffer_t *sig,
+                    sigverify_rsa_buffer_t *result) {
   sigverify_rsa_buffer_t buf;
 
-  // result = R^2 mod n
-  calc_r_square(key, result);
   // buf = sig * R mod n
-  mont_mul(key, sig, result, &buf);
+  mont_mul(key, sig, rr, &buf);
   for (size_t i = 0; i < 8; ++i) {
     // result = sig^{2*4^i} * R mod n (sig's exponent: 2, 8, 32, ..., 32768)
     mont_mul(key, &buf, &buf, result);
@@ -197,6 +282,37 @@ rom_error_t sigverify_mod_exp_ibex(const sigverify_rsa_key_t *key,
   if (greater_equal_modulus(key, result)) {
     OT_DISCARD(subtract_modulus(key, result));
   }
+}
+
+rom_error_t sigverify_mod_exp_ibex(const sigverify_rsa_key_t *key,
+                                   const sigverify_rsa_buffer_t *sig,
+                                   sigverify_rsa_buffer_t *result) {
+  // Reject the signature if it is too large (n <= sig): RFC 8017, section
+  // 5.2.2, step 1.
+  if (greater_equal_modulus(key, sig)) {
+    return kErrorSigverifyLargeRsaSignature;
+  }
+
+  sigverify_rsa_buffer_t rr;
+  sigverify_mod_exp_ibex_rr_compute(key, &rr);
+  mod_exp(key, &rr, sig, result);
+  return kErrorOk;
+}
+
+rom_error_t sigverify_mod_exp_ibex_rr(const sigverify_rsa_key_t *key,
+                                      const sigverify_rsa_buffer_t *rr,
+                                      const sigverify_rsa_buffer_t *sig,
+                                      sigverify_rsa_buffer_t *result) {
+  // Reject the signature if it is too large (n <= sig): RFC 8017, section
+  // 5.2.2, step 1.
+  if (greater_equal_modulus(key, sig)) {
+    return kErrorSigverifyLargeRsaSignature;
+  }
+  // A wrong R^2 would scale the result by a value of the caller's choice.
+  if (!rr_check(key, rr)) {
+    return kErrorSigverifyBadRsaKey;
+  }
 
+  mod_exp(key, rr, sig, result);
   return kErrorOk;
 }
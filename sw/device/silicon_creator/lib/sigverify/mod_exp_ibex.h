@@ -35,6 +35,41 @@ rom_error_t sigverify_mod_exp_ibex(const sigverify_rsa_key_t *key,
                                    const sigverify_rsa_buffer_t *sig,
                                    sigverify_rsa_buffer_t *result);
 
+/**
+ * Computes R^2 mod n for an RSA public key, where R = 2^kSigVerifyRsaNumBits.
+ *
+ * R^2 mod n depends only on the key, and computing it is a significant part of
+ * `sigverify_mod_exp_ibex()`. Callers that verify several signatures with the
+ * same key can compute it once, store it with the key, and use
+ * `sigverify_mod_exp_ibex_rr()` instead.
+ *
+ * @param key An RSA public key.
+ * @param[out] rr Buffer to write R^2 mod n to, little-endian.
+ */
+void sigverify_mod_exp_ibex_rr_compute(const sigverify_rsa_key_t *key,
+                                       sigverify_rsa_buffer_t *rr);
+
+/**
+ * Computes the modular exponentiation of an RSA signature on Ibex using a
+ * precomputed R^2 mod n.
+ *
+ * Same as `sigverify_mod_exp_ibex()`, but takes R^2 mod n as computed by
+ * `sigverify_mod_exp_ibex_rr_compute()`. The value is checked against the
+ * modulus with a single Montgomery multiplication before it is used.
+ *
+ * @param key An RSA public key.
+ * @param rr Buffer that holds R^2 mod n, little-endian.
+ * @param sig Buffer that holds the signature, little-endian.
+ * @param result Buffer to write the result to, little-endian.
+ * @return The result of the operation; `kErrorSigverifyBadRsaKey` if `rr` is
+ * not R^2 mod n.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t sigverify_mod_exp_ibex_rr(const sigverify_rsa_key_t *key,
+                                      const sigverify_rsa_buffer_t *rr,
+                                      const sigverify_rsa_buffer_t *sig,
+                                      sigverify_rsa_buffer_t *result);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
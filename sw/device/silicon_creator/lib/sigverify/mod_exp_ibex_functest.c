@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/runtime/ibex.h"
 #include "sw/device/lib/testing/test_framework/ottf_main.h"
 #include "sw/device/silicon_creator/lib/base/sec_mmio.h"
 #include "sw/device/silicon_creator/lib/sigverify/mod_exp_ibex.h"
@@ -50,6 +51,47 @@ rom_error_t sigverify_mod_exp_ibex_test(void) {
   return kErrorOk;
 }
 
+rom_error_t sigverify_mod_exp_ibex_rr_test(void) {
+  sigverify_test_vector_t testvec = sigverify_tests[test_index];
+
+  uint64_t t_start = ibex_mcycle_read();
+  sigverify_rsa_buffer_t expected;
+  rom_error_t err =
+      sigverify_mod_exp_ibex(&testvec.key, &testvec.sig, &expected);
+  uint64_t cycles = ibex_mcycle_read() - t_start;
+
+  sigverify_rsa_buffer_t rr;
+  sigverify_mod_exp_ibex_rr_compute(&testvec.key, &rr);
+  t_start = ibex_mcycle_read();
+  sigverify_rsa_buffer_t recovered_message;
+  rom_error_t err_rr = sigverify_mod_exp_ibex_rr(
+      &testvec.key, &rr, &testvec.sig, &recovered_message);
+  uint64_t cycles_rr = ibex_mcycle_read() - t_start;
+
+  // Both variants must agree, including on rejected signatures.
+  if (err_rr != err) {
+    LOG_ERROR("Precomputed R^2 changed the result: %x vs %x", err_rr, err);
+    return kErrorUnknown;
+  }
+  if (err != kErrorOk) {
+    return kErrorOk;
+  }
+  if (memcmp(expected.data, recovered_message.data, sizeof(expected.data)) !=
+      0) {
+    LOG_ERROR("Precomputed R^2 gave a different result.");
+    LOG_INFO("Test notes: %s", testvec.comment);
+    return kErrorUnknown;
+  }
+
+  LOG_INFO("mod_exp cycles: %d, with precomputed R^2: %d", (uint32_t)cycles,
+           (uint32_t)cycles_rr);
+  if (cycles_rr >= cycles) {
+    LOG_ERROR("Precomputed R^2 is not faster.");
+    return kErrorUnknown;
+  }
+  return kErrorOk;
+}
+
 OTTF_DEFINE_TEST_CONFIG();
 
 bool test_main(void) {
@@ -61,6 +103,7 @@ bool test_main(void) {
     LOG_INFO("Starting test vector %d of %d...", i + 1, SIGVERIFY_NUM_TESTS);
     test_index = i;
     EXECUTE_TEST(result, sigverify_mod_exp_ibex_test);
+    EXECUTE_TEST(result, sigverify_mod_exp_ibex_rr_test);
   }
   LOG_INFO("Finished mod_exp_ibex_functest:%s", RULE_NAME);
   return status_ok(result);
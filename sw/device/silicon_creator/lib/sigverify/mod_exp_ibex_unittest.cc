@@ -145,6 +145,35 @@ TEST_P(ModExp, EncMsg) {
   EXPECT_THAT(res.data, ::testing::ElementsAreArray(GetParam().enc_msg->data));
 }
 
+TEST_P(ModExp, EncMsgRr) {
+  sigverify_rsa_buffer_t rr;
+  sigverify_mod_exp_ibex_rr_compute(&GetParam().key, &rr);
+  sigverify_rsa_buffer_t res;
+  EXPECT_EQ(sigverify_mod_exp_ibex_rr(&GetParam().key, &rr, &GetParam().sig,
+                                      &res),
+            kErrorOk);
+  EXPECT_THAT(res.data, ::testing::ElementsAreArray(GetParam().enc_msg->data));
+}
+
+TEST_P(ModExp, BadRr) {
+  sigverify_rsa_buffer_t rr;
+  sigverify_mod_exp_ibex_rr_compute(&GetParam().key, &rr);
+  sigverify_rsa_buffer_t res;
+
+  // Off by one.
+  sigverify_rsa_buffer_t bad_rr = rr;
+  bad_rr.data[0] ^= 1;
+  EXPECT_EQ(sigverify_mod_exp_ibex_rr(&GetParam().key, &bad_rr,
+                                      &GetParam().sig, &res),
+            kErrorSigverifyBadRsaKey);
+
+  // Not less than the modulus.
+  bad_rr = GetParam().key.n;
+  EXPECT_EQ(sigverify_mod_exp_ibex_rr(&GetParam().key, &bad_rr,
+                                      &GetParam().sig, &res),
+            kErrorSigverifyBadRsaKey);
+}
+
 INSTANTIATE_TEST_SUITE_P(AllCases, ModExp, testing::ValuesIn(kSigTestCases));
 
 }  // namespace
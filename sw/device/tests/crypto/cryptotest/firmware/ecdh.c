@@ -5,6 +5,7 @@
 #include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/base/status.h"
 #include "sw/device/lib/crypto/impl/ecc/p256_common.h"
+#include "sw/device/lib/crypto/impl/ecc/x25519.h"
 #include "sw/device/lib/crypto/impl/integrity.h"
 #include "sw/device/lib/crypto/impl/keyblob.h"
 #include "sw/device/lib/crypto/include/datatypes.h"
@@ -32,6 +33,8 @@ status_t handle_ecdh(ujson_t *uj) {
   otcrypto_ecc_curve_type_t curve_type;
   otcrypto_unblinded_key_t public_key;
   p256_point_t pub_p256;
+  x25519_point_t pub_x25519;
+  x25519_masked_scalar_t x25519_key_masked;
 
   otcrypto_key_config_t key_config = {
       .version = kOtcryptoLibVersion1,
@@ -62,6 +65,25 @@ status_t handle_ecdh(ujson_t *uj) {
       private_key_masked_raw = (uint32_t *)&private_key_masked;
       private_keyblob_length = sizeof(private_key_masked);
       break;
+    case kCryptotestEcdhCurveX25519:
+      // X25519 public keys are a single u-coordinate; `uj_qy` is unused and
+      // so is the curve type, since X25519 has its own entry point.
+      curve_type = kOtcryptoEccCurveTypeCustom;
+      memset(pub_x25519.u, 0, kX25519Bytes);
+      memcpy(pub_x25519.u, uj_qx.coordinate, uj_qx.coordinate_len);
+      public_key.key_mode = kOtcryptoKeyModeX25519;
+      public_key.key_length = sizeof(x25519_point_t);
+      public_key.key = (uint32_t *)&pub_x25519;
+      key_config.key_mode = kOtcryptoKeyModeX25519;
+      key_config.key_length = kX25519Bytes;
+      shared_key_words = kX25519Words;
+      memset(x25519_key_masked.share0, 0, kX25519MaskedScalarShareBytes);
+      memcpy(x25519_key_masked.share0, uj_private_key.d0, kX25519Bytes);
+      memset(x25519_key_masked.share1, 0, kX25519MaskedScalarShareBytes);
+      memcpy(x25519_key_masked.share1, uj_private_key.d1, kX25519Bytes);
+      private_key_masked_raw = (uint32_t *)&x25519_key_masked;
+      private_keyblob_length = sizeof(x25519_key_masked);
+      break;
     default:
       LOG_ERROR("Unsupported ECC curve: %d", uj_curve);
       return INVALID_ARGUMENT();
@@ -88,8 +110,13 @@ status_t handle_ecdh(ujson_t *uj) {
       .keyblob = shared_keyblob,
   };
 
-  otcrypto_status_t status =
-      otcrypto_ecdh(&private_key, &public_key, &elliptic_curve, &shared_key);
+  otcrypto_status_t status;
+  if (uj_curve == kCryptotestEcdhCurveX25519) {
+    status = otcrypto_x25519(&private_key, &public_key, &shared_key);
+  } else {
+    status =
+        otcrypto_ecdh(&private_key, &public_key, &elliptic_curve, &shared_key);
+  }
   cryptotest_ecdh_derive_output_t uj_output;
   switch (status.value) {
     case kOtcryptoStatusValueOk: {
@@ -118,7 +145,7 @@ status_t handle_ecdh(ujson_t *uj) {
     }
     default: {
       LOG_ERROR(
-          "Unexpected status value returned from otcrypto_ecdh: "
+          "Unexpected status value returned from ECDH: "
           "0x%x",
           status.value);
       return INTERNAL();
@@ -0,0 +1,124 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/base/status.h"
+#include "sw/device/lib/crypto/impl/ecc/ed25519.h"
+#include "sw/device/lib/crypto/impl/integrity.h"
+#include "sw/device/lib/crypto/include/datatypes.h"
+#include "sw/device/lib/crypto/include/ecc.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/ujson_ottf.h"
+#include "sw/device/lib/ujson/ujson.h"
+#include "sw/device/tests/crypto/cryptotest/json/ed25519_commands.h"
+
+static status_t respond_verify_output(ujson_t *uj, bool success) {
+  cryptotest_ed25519_verify_output_t uj_output =
+      success ? kCryptotestEd25519VerifyOutputSuccess
+              : kCryptotestEd25519VerifyOutputFailure;
+  RESP_OK(ujson_serialize_cryptotest_ed25519_verify_output_t, uj, &uj_output);
+  return OK_STATUS(0);
+}
+
+static status_t ed25519_verify(ujson_t *uj) {
+  cryptotest_ed25519_sign_mode_t uj_sign_mode;
+  cryptotest_ed25519_message_t uj_message;
+  cryptotest_ed25519_signature_t uj_signature;
+  cryptotest_ed25519_public_key_t uj_public_key;
+  TRY(ujson_deserialize_cryptotest_ed25519_sign_mode_t(uj, &uj_sign_mode));
+  TRY(ujson_deserialize_cryptotest_ed25519_message_t(uj, &uj_message));
+  TRY(ujson_deserialize_cryptotest_ed25519_signature_t(uj, &uj_signature));
+  TRY(ujson_deserialize_cryptotest_ed25519_public_key_t(uj, &uj_public_key));
+
+  otcrypto_eddsa_sign_mode_t sign_mode;
+  switch (uj_sign_mode) {
+    case kCryptotestEd25519SignModeEddsa:
+      sign_mode = kOtcryptoEddsaSignModeEddsa;
+      break;
+    case kCryptotestEd25519SignModeHashEddsa:
+      sign_mode = kOtcryptoEddsaSignModeHashEddsa;
+      break;
+    default:
+      LOG_ERROR("Unrecognized Ed25519 sign mode: %d", uj_sign_mode);
+      return INVALID_ARGUMENT();
+  }
+
+  if (uj_message.input_len > ED25519_CMD_MAX_MESSAGE_BYTES ||
+      uj_signature.signature_len > ED25519_CMD_MAX_SIGNATURE_BYTES ||
+      uj_public_key.public_key_len > ED25519_CMD_MAX_PUBLIC_KEY_BYTES) {
+    LOG_ERROR("Ed25519 input too large for the command buffers.");
+    return INVALID_ARGUMENT();
+  }
+
+  // Some Wycheproof vectors test truncated or padded signatures and keys;
+  // those are rejected before they reach the cryptolib.
+  if (uj_signature.signature_len != sizeof(ed25519_signature_t) ||
+      uj_public_key.public_key_len != sizeof(ed25519_point_t)) {
+    return respond_verify_output(uj, false);
+  }
+
+  ed25519_point_t pk;
+  memcpy(pk.enc, uj_public_key.public_key, sizeof(pk));
+  otcrypto_unblinded_key_t public_key = {
+      .key_mode = kOtcryptoKeyModeEd25519,
+      .key_length = sizeof(pk),
+      .key = pk.enc,
+  };
+  public_key.checksum = integrity_unblinded_checksum(&public_key);
+
+  ed25519_signature_t sig;
+  memcpy(&sig, uj_signature.signature, sizeof(sig));
+  otcrypto_const_word32_buf_t signature = {
+      .len = sizeof(sig) / sizeof(uint32_t),
+      .data = (const uint32_t *)&sig,
+  };
+
+  otcrypto_const_byte_buf_t message = {
+      .len = uj_message.input_len,
+      .data = uj_message.input,
+  };
+
+  hardened_bool_t verification_result = kHardenedBoolFalse;
+  otcrypto_status_t status = otcrypto_ed25519_verify(
+      &public_key, message, sign_mode, signature, &verification_result);
+  switch (status.value) {
+    case kOtcryptoStatusValueOk:
+      break;
+    case kOtcryptoStatusValueBadArgs:
+      // Public keys that do not decode to a curve point and signatures with
+      // S >= L are reported as invalid arguments; respond with "validation
+      // failed". Otherwise, we error out.
+      return respond_verify_output(uj, false);
+    default:
+      LOG_ERROR(
+          "Unexpected status value returned from otcrypto_ed25519_verify: "
+          "0x%x",
+          status.value);
+      return INTERNAL();
+  }
+
+  switch (verification_result) {
+    case kHardenedBoolFalse:
+      return respond_verify_output(uj, false);
+    case kHardenedBoolTrue:
+      return respond_verify_output(uj, true);
+    default:
+      LOG_ERROR("Unexpected result value from otcrypto_ed25519_verify: %d",
+                verification_result);
+      return INTERNAL();
+  }
+}
+
+status_t handle_ed25519(ujson_t *uj) {
+  cryptotest_ed25519_operation_t uj_op;
+  TRY(ujson_deserialize_cryptotest_ed25519_operation_t(uj, &uj_op));
+
+  switch (uj_op) {
+    case kCryptotestEd25519OperationVerify:
+      return ed25519_verify(uj);
+    default:
+      LOG_ERROR("Unrecognized Ed25519 operation: %d", uj_op);
+      return INVALID_ARGUMENT();
+  }
+}
@@ -17,6 +17,7 @@
 #include "sw/device/tests/crypto/cryptotest/json/drbg_commands.h"
 #include "sw/device/tests/crypto/cryptotest/json/ecdh_commands.h"
 #include "sw/device/tests/crypto/cryptotest/json/ecdsa_commands.h"
+#include "sw/device/tests/crypto/cryptotest/json/ed25519_commands.h"
 #include "sw/device/tests/crypto/cryptotest/json/extclk_sca_fi_commands.h"
 #include "sw/device/tests/crypto/cryptotest/json/hash_commands.h"
 #include "sw/device/tests/crypto/cryptotest/json/hmac_commands.h"
@@ -34,6 +35,7 @@
 #include "drbg.h"
 #include "ecdh.h"
 #include "ecdsa.h"
+#include "ed25519.h"
 #include "extclk_sca_fi.h"
 #include "hash.h"
 #include "hmac.h"
@@ -64,6 +66,9 @@ status_t process_cmd(ujson_t *uj) {
       case kCryptotestCommandEcdh:
         RESP_ERR(uj, handle_ecdh(uj));
         break;
+      case kCryptotestCommandEd25519:
+        RESP_ERR(uj, handle_ed25519(uj));
+        break;
       case kCryptotestCommandHash:
         RESP_ERR(uj, handle_hash(uj));
         break;
@@ -16,6 +16,7 @@ extern "C" {
     value(_, Drbg) \
     value(_, Ecdsa) \
     value(_, Ecdh) \
+    value(_, Ed25519) \
     value(_, Hash) \
     value(_, Hmac) \
     value(_, Kmac) \
@@ -0,0 +1,59 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_TESTS_CRYPTO_CRYPTOTEST_JSON_ED25519_COMMANDS_H_
+#define OPENTITAN_SW_DEVICE_TESTS_CRYPTO_CRYPTOTEST_JSON_ED25519_COMMANDS_H_
+#include "sw/device/lib/ujson/ujson_derive.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ED25519_CMD_MAX_MESSAGE_BYTES 1024
+#define ED25519_CMD_MAX_SIGNATURE_BYTES 128
+#define ED25519_CMD_MAX_PUBLIC_KEY_BYTES 64
+
+// clang-format off
+
+// Following a `Verify` Operation, the host is expected to send the following parameters, in order:
+// - sign_mode (ED25519_SIGN_MODE)
+// - message (ED25519_MESSAGE)
+// - signature (ED25519_SIGNATURE)
+// - public_key (ED25519_PUBLIC_KEY)
+// The device will then respond with:
+// - result (ED25519_VERIFY_OUTPUT)
+#define ED25519_OPERATION(_, value) \
+    value(_, Verify)
+UJSON_SERDE_ENUM(CryptotestEd25519Operation, cryptotest_ed25519_operation_t, ED25519_OPERATION);
+
+#define ED25519_SIGN_MODE(_, value) \
+    value(_, Eddsa) \
+    value(_, HashEddsa)
+UJSON_SERDE_ENUM(CryptotestEd25519SignMode, cryptotest_ed25519_sign_mode_t, ED25519_SIGN_MODE);
+
+#define ED25519_MESSAGE(field, string) \
+    field(input, uint8_t, ED25519_CMD_MAX_MESSAGE_BYTES) \
+    field(input_len, size_t)
+UJSON_SERDE_STRUCT(CryptotestEd25519Message, cryptotest_ed25519_message_t, ED25519_MESSAGE);
+
+#define ED25519_SIGNATURE(field, string) \
+    field(signature, uint8_t, ED25519_CMD_MAX_SIGNATURE_BYTES) \
+    field(signature_len, size_t)
+UJSON_SERDE_STRUCT(CryptotestEd25519Signature, cryptotest_ed25519_signature_t, ED25519_SIGNATURE);
+
+#define ED25519_PUBLIC_KEY(field, string) \
+    field(public_key, uint8_t, ED25519_CMD_MAX_PUBLIC_KEY_BYTES) \
+    field(public_key_len, size_t)
+UJSON_SERDE_STRUCT(CryptotestEd25519PublicKey, cryptotest_ed25519_public_key_t, ED25519_PUBLIC_KEY);
+
+#define ED25519_VERIFY_OUTPUT(_, value) \
+    value(_, Success) \
+    value(_, Failure)
+UJSON_SERDE_ENUM(CryptotestEd25519VerifyOutput, cryptotest_ed25519_verify_output_t, ED25519_VERIFY_OUTPUT);
+
+// clang-format on
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // OPENTITAN_SW_DEVICE_TESTS_CRYPTO_CRYPTOTEST_JSON_ED25519_COMMANDS_H_
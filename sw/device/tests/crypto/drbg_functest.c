@@ -5,6 +5,7 @@
 #include "sw/device/lib/base/status.h"
 #include "sw/device/lib/crypto/drivers/entropy.h"
 #include "sw/device/lib/crypto/include/drbg.h"
+#include "sw/device/lib/runtime/ibex.h"
 #include "sw/device/lib/runtime/log.h"
 #include "sw/device/lib/testing/randomness_quality.h"
 #include "sw/device/lib/testing/test_framework/check.h"
@@ -31,6 +32,13 @@ static const otcrypto_const_byte_buf_t kEmptyBuffer = {
     .len = 0,
 };
 
+enum {
+  /* Number of single-word requests for the pool benchmark. */
+  kPoolBenchmarkRequests = 256,
+  /* Number of refills between automatic reseeds for the pool tests. */
+  kPoolReseedInterval = 4,
+};
+
 static status_t kat_test(void) {
   otcrypto_const_byte_buf_t entropy = {
       .data = (const unsigned char *)kTestSeed,
@@ -79,6 +87,78 @@ static status_t random_test(void) {
       kRandomnessQualitySignificanceOnePercent);
 }
 
+static status_t pool_test(void) {
+  // Instantiate DRBG.
+  TRY(otcrypto_drbg_instantiate(/*perso_string=*/kEmptyBuffer));
+
+  otcrypto_drbg_pool_t pool;
+  TRY(otcrypto_drbg_pool_init(&pool, kPoolReseedInterval,
+                              /*prediction_resistance=*/kHardenedBoolFalse));
+
+  // Fill a large buffer with small, unevenly sized requests so that the pool
+  // refills and reseeds several times.
+  uint32_t output_data[1024];
+  size_t offset = 0;
+  size_t len = 1;
+  while (offset < ARRAYSIZE(output_data)) {
+    if (len > ARRAYSIZE(output_data) - offset) {
+      len = ARRAYSIZE(output_data) - offset;
+    }
+    TRY(otcrypto_drbg_pool_generate(&pool, /*additional_input=*/kEmptyBuffer,
+                                    (otcrypto_word32_buf_t){
+                                        .data = &output_data[offset],
+                                        .len = len,
+                                    }));
+    offset += len;
+    len = len % 7 + 1;
+  }
+  TRY(otcrypto_drbg_pool_clear(&pool));
+
+  // A cleared pool must not serve output.
+  uint32_t word;
+  TRY_CHECK(!status_ok(otcrypto_drbg_pool_generate(
+      &pool, /*additional_input=*/kEmptyBuffer,
+      (otcrypto_word32_buf_t){.data = &word, .len = 1})));
+
+  // Run a basic randomness-quality check on the output.
+  return randomness_quality_monobit_test(
+      (unsigned char *)output_data, sizeof(output_data),
+      kRandomnessQualitySignificanceOnePercent);
+}
+
+static status_t pool_benchmark(void) {
+  // Instantiate DRBG.
+  TRY(otcrypto_drbg_instantiate(/*perso_string=*/kEmptyBuffer));
+
+  uint32_t word;
+  otcrypto_word32_buf_t output = {
+      .data = &word,
+      .len = 1,
+  };
+
+  uint64_t t_start = ibex_mcycle_read();
+  for (size_t i = 0; i < kPoolBenchmarkRequests; i++) {
+    TRY(otcrypto_drbg_generate(/*additional_input=*/kEmptyBuffer, output));
+  }
+  uint64_t direct_cycles = ibex_mcycle_read() - t_start;
+
+  otcrypto_drbg_pool_t pool;
+  TRY(otcrypto_drbg_pool_init(&pool, kPoolReseedInterval,
+                              /*prediction_resistance=*/kHardenedBoolFalse));
+  t_start = ibex_mcycle_read();
+  for (size_t i = 0; i < kPoolBenchmarkRequests; i++) {
+    TRY(otcrypto_drbg_pool_generate(&pool, /*additional_input=*/kEmptyBuffer,
+                                    output));
+  }
+  uint64_t pool_cycles = ibex_mcycle_read() - t_start;
+  TRY(otcrypto_drbg_pool_clear(&pool));
+
+  LOG_INFO("%d one-word requests: direct %d cycles, pooled %d cycles",
+           kPoolBenchmarkRequests, (uint32_t)direct_cycles,
+           (uint32_t)pool_cycles);
+  return OK_STATUS();
+}
+
 bool test_main(void) {
   status_t result = OK_STATUS();
 
@@ -88,5 +168,7 @@ bool test_main(void) {
 
   EXECUTE_TEST(result, kat_test);
   EXECUTE_TEST(result, random_test);
+  EXECUTE_TEST(result, pool_test);
+  EXECUTE_TEST(result, pool_benchmark);
   return status_ok(result);
 }
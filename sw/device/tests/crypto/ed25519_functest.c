@@ -0,0 +1,272 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/crypto/drivers/otbn.h"
+#include "sw/device/lib/crypto/impl/integrity.h"
+#include "sw/device/lib/crypto/impl/keyblob.h"
+#include "sw/device/lib/crypto/include/datatypes.h"
+#include "sw/device/lib/crypto/include/ecc.h"
+#include "sw/device/lib/runtime/ibex.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/entropy_testutils.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+enum {
+  /* Number of bytes in an Ed25519 private key. */
+  kEd25519PrivateKeyBytes = 256 / 8,
+  /* Number of 32-bit words in an Ed25519 private key. */
+  kEd25519PrivateKeyWords = kEd25519PrivateKeyBytes / sizeof(uint32_t),
+  /* Number of 32-bit words in an Ed25519 public key. */
+  kEd25519PublicKeyWords = 256 / 32,
+  /* Number of 32-bit words in an Ed25519 signature. */
+  kEd25519SignatureWords = 512 / 32,
+  /* Number of 32-bit words in a SHA-512 digest. */
+  kSha512DigestWords = 512 / 32,
+};
+
+static const otcrypto_key_config_t kPrivateKeyConfig = {
+    .version = kOtcryptoLibVersion1,
+    .key_mode = kOtcryptoKeyModeEd25519,
+    .key_length = kEd25519PrivateKeyBytes,
+    .hw_backed = kHardenedBoolFalse,
+    .security_level = kOtcryptoKeySecurityLevelLow,
+};
+
+// Random mask for the private key seeds.
+static const uint32_t kSeedMask[kEd25519PrivateKeyWords] = {
+    0x7bc2a1f0, 0x2d1c8e94, 0xe5a06b37, 0x91f4d2c8,
+    0x0b3e7a65, 0xc8d91f02, 0x5f6e24ab, 0x3a07c9d1,
+};
+
+/**
+ * An Ed25519 known-answer test.
+ *
+ * All values are in the byte order of RFC 8032, read as little-endian words.
+ */
+typedef struct ed25519_test_vector {
+  const char *name;
+  otcrypto_eddsa_sign_mode_t sign_mode;
+  uint32_t seed[kEd25519PrivateKeyWords];
+  uint32_t public_key[kEd25519PublicKeyWords];
+  // Message (or, for Ed25519ph, the SHA-512 digest of the message).
+  const uint8_t *message;
+  size_t message_len;
+  uint32_t signature[kEd25519SignatureWords];
+} ed25519_test_vector_t;
+
+// RFC 8032, section 7.2, TEST 2: the one-byte message.
+static const uint8_t kRfc8032Test2Message[] = {0x72};
+
+// SHA-512("abc"), the prehashed message for RFC 8032, section 7.3.
+static const uint32_t kRfc8032AbcDigest[kSha512DigestWords] = {
+    0xa135afdd, 0xba7a6193, 0x497341cc, 0x314120ae, 0x4efae612, 0xa27ea989,
+    0xe6ee9e0a, 0x9ad3554b, 0x2a999221, 0xa8c14f27, 0x233cba36, 0xbdebfea3,
+    0x23444d45, 0x0ee83c64, 0x4fc99a2a, 0x9fa44ca5,
+};
+
+static const ed25519_test_vector_t kTestVectors[] = {
+    {
+        .name = "RFC 8032 TEST 1",
+        .sign_mode = kOtcryptoEddsaSignModeEddsa,
+        .seed = {0x9db1619d, 0x605afdef, 0xf44a84ba, 0xc42cec92, 0x69c54944,
+                 0x1969327b, 0x03ac3b70, 0x607fae1c},
+        .public_key = {0x01985ad7, 0xb70ab182, 0xd3fe4bd5, 0x3a0764c9,
+                       0xf372e10e, 0x2523a6da, 0x681a02af, 0x1a5107f7},
+        .message = NULL,
+        .message_len = 0,
+        .signature = {0x004356e5, 0x72ac60c3, 0xcce28690, 0x8a826e80,
+                      0x1e7f8784, 0x74d9e5b8, 0x65e073d8, 0x55014922,
+                      0x1582b85f, 0xac3ba390, 0x70391ec6, 0x6bb4f91c,
+                      0xf0f55bd2, 0x24be5b59, 0x43415165, 0x0b107a8e},
+    },
+    {
+        .name = "RFC 8032 TEST 2",
+        .sign_mode = kOtcryptoEddsaSignModeEddsa,
+        .seed = {0x9b08cd4c, 0xda96ff28, 0x46c3b69d, 0x0f4e11ec, 0x9f318a5b,
+                 0x24a6ab35, 0xedf68cda, 0xfba6b84f},
+        .public_key = {0xc317403d, 0x5a8943e8, 0xa70ab792, 0xbc7e1b4d,
+                       0xcf2c989c, 0x8c96c42e, 0xf155cdc0, 0x0c66f42a},
+        .message = kRfc8032Test2Message,
+        .message_len = sizeof(kRfc8032Test2Message),
+        .signature = {0xa909a092, 0xb8cad4f0, 0x0b820e72, 0x4025645f,
+                      0x547bb2a2, 0x8f3f5016, 0x232276b3, 0xda69dbeb,
+                      0xe4c15a08, 0x6e99153e, 0x13368f45, 0x8c1df1d0,
+                      0xae2e7b38, 0xee2a30b4, 0x16290db0, 0x000cbb12},
+    },
+    {
+        .name = "RFC 8032 TEST abc (Ed25519ph)",
+        .sign_mode = kOtcryptoEddsaSignModeHashEddsa,
+        .seed = {0x24e63f83, 0x9d7b2309, 0x5877ec62, 0x1e912075, 0xec9c759a,
+                 0x5b75191d, 0xb901a97d, 0x423dca6d},
+        .public_key = {0x932b17ec, 0x3b565ead, 0x702c93f4, 0x345024e1,
+                       0xef6754c3, 0x644dfd2e, 0x6819f8eb, 0xbfe26734},
+        .message = (const uint8_t *)kRfc8032AbcDigest,
+        .message_len = sizeof(kRfc8032AbcDigest),
+        .signature = {0x2202a798, 0x1a12b8f0, 0x810fd3a9, 0x803f683d,
+                      0x462b469e, 0x76f87f9c, 0xb99b4939, 0x41ae6d4e,
+                      0x4250f831, 0x352a3c46, 0xd003205a, 0xaaf5ad62,
+                      0x618c0ba1, 0x2a0636e6, 0x2a1cd1aa, 0x06340826},
+    },
+};
+
+/**
+ * Build a masked private key from an unmasked seed.
+ *
+ * @param seed Unmasked seed.
+ * @param keyblob Destination keyblob, `keyblob_num_words(kPrivateKeyConfig)`
+ * words long.
+ * @return Blinded key struct pointing at `keyblob`.
+ */
+static otcrypto_blinded_key_t make_private_key(const uint32_t *seed,
+                                               uint32_t *keyblob) {
+  // share0 = seed ^ mask, share1 = mask; the extra share words stay zero.
+  size_t share_words = keyblob_num_words(kPrivateKeyConfig) / 2;
+  memset(keyblob, 0, keyblob_num_words(kPrivateKeyConfig) * sizeof(uint32_t));
+  for (size_t i = 0; i < kEd25519PrivateKeyWords; i++) {
+    keyblob[i] = seed[i] ^ kSeedMask[i];
+    keyblob[share_words + i] = kSeedMask[i];
+  }
+  otcrypto_blinded_key_t private_key = {
+      .config = kPrivateKeyConfig,
+      .keyblob_length = keyblob_num_words(kPrivateKeyConfig) * sizeof(uint32_t),
+      .keyblob = keyblob,
+  };
+  private_key.checksum = integrity_blinded_checksum(&private_key);
+  return private_key;
+}
+
+/**
+ * Check a known-answer test: signature generation and verification.
+ *
+ * Also checks that verification rejects a modified signature.
+ */
+static status_t kat_test(const ed25519_test_vector_t *vec) {
+  LOG_INFO("Running %s...", vec->name);
+
+  uint32_t keyblob[keyblob_num_words(kPrivateKeyConfig)];
+  otcrypto_blinded_key_t private_key = make_private_key(vec->seed, keyblob);
+
+  uint32_t pk[kEd25519PublicKeyWords];
+  memcpy(pk, vec->public_key, sizeof(pk));
+  otcrypto_unblinded_key_t public_key = {
+      .key_mode = kOtcryptoKeyModeEd25519,
+      .key_length = sizeof(pk),
+      .key = pk,
+  };
+  public_key.checksum = integrity_unblinded_checksum(&public_key);
+
+  otcrypto_const_byte_buf_t msg = {
+      .data = vec->message,
+      .len = vec->message_len,
+  };
+
+  // Sign and compare against the expected (deterministic) signature.
+  uint32_t sig[kEd25519SignatureWords] = {0};
+  uint64_t t_start = ibex_mcycle_read();
+  TRY(otcrypto_ed25519_sign(
+      &private_key, msg, vec->sign_mode,
+      (otcrypto_word32_buf_t){.data = sig, .len = ARRAYSIZE(sig)}));
+  uint64_t sign_cycles = ibex_mcycle_read() - t_start;
+  CHECK_ARRAYS_EQ(sig, vec->signature, ARRAYSIZE(sig));
+
+  // Verify the expected signature.
+  hardened_bool_t verification_result = kHardenedBoolFalse;
+  t_start = ibex_mcycle_read();
+  TRY(otcrypto_ed25519_verify(
+      &public_key, msg, vec->sign_mode,
+      (otcrypto_const_word32_buf_t){.data = vec->signature,
+                                    .len = ARRAYSIZE(vec->signature)},
+      &verification_result));
+  uint64_t verify_cycles = ibex_mcycle_read() - t_start;
+  CHECK(verification_result == kHardenedBoolTrue,
+        "Valid signature failed verification.");
+
+  LOG_INFO("Sign cycles: %d, verify cycles: %d", (uint32_t)sign_cycles,
+           (uint32_t)verify_cycles);
+
+  // Flip a bit in S; verification must fail.
+  sig[kEd25519SignatureWords - 1] ^= 1;
+  TRY(otcrypto_ed25519_verify(
+      &public_key, msg, vec->sign_mode,
+      (otcrypto_const_word32_buf_t){.data = sig, .len = ARRAYSIZE(sig)},
+      &verification_result));
+  CHECK(verification_result == kHardenedBoolFalse,
+        "Modified signature passed verification.");
+
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Generate a fresh keypair, then sign and verify a message with it.
+ */
+static status_t keygen_sign_verify_test(void) {
+  static const char kMessage[] = "test message";
+
+  uint32_t keyblob[keyblob_num_words(kPrivateKeyConfig)];
+  otcrypto_blinded_key_t private_key = {
+      .config = kPrivateKeyConfig,
+      .keyblob_length = sizeof(keyblob),
+      .keyblob = keyblob,
+  };
+  uint32_t pk[kEd25519PublicKeyWords] = {0};
+  otcrypto_unblinded_key_t public_key = {
+      .key_mode = kOtcryptoKeyModeEd25519,
+      .key_length = sizeof(pk),
+      .key = pk,
+  };
+
+  LOG_INFO("Generating keypair...");
+  uint64_t t_start = ibex_mcycle_read();
+  TRY(otcrypto_ed25519_keygen(&private_key, &public_key));
+  uint64_t keygen_cycles = ibex_mcycle_read() - t_start;
+  LOG_INFO("Keygen cycles: %d", (uint32_t)keygen_cycles);
+
+  otcrypto_const_byte_buf_t msg = {
+      .data = (const uint8_t *)kMessage,
+      .len = sizeof(kMessage) - 1,
+  };
+  uint32_t sig[kEd25519SignatureWords] = {0};
+  LOG_INFO("Signing...");
+  TRY(otcrypto_ed25519_sign(
+      &private_key, msg, kOtcryptoEddsaSignModeEddsa,
+      (otcrypto_word32_buf_t){.data = sig, .len = ARRAYSIZE(sig)}));
+
+  LOG_INFO("Verifying...");
+  hardened_bool_t verification_result = kHardenedBoolFalse;
+  TRY(otcrypto_ed25519_verify(
+      &public_key, msg, kOtcryptoEddsaSignModeEddsa,
+      (otcrypto_const_word32_buf_t){.data = sig, .len = ARRAYSIZE(sig)},
+      &verification_result));
+  CHECK(verification_result == kHardenedBoolTrue,
+        "Signature with generated key failed verification.");
+
+  return OTCRYPTO_OK;
+}
+
+static status_t run_tests(void) {
+  for (size_t i = 0; i < ARRAYSIZE(kTestVectors); i++) {
+    TRY(kat_test(&kTestVectors[i]));
+  }
+  return keygen_sign_verify_test();
+}
+
+OTTF_DEFINE_TEST_CONFIG();
+
+bool test_main(void) {
+  CHECK_STATUS_OK(entropy_testutils_auto_mode_init());
+
+  status_t err = run_tests();
+  if (!status_ok(err)) {
+    // If there was an error, print the OTBN error bits and instruction count.
+    LOG_INFO("OTBN error bits: 0x%08x", otbn_err_bits_get());
+    LOG_INFO("OTBN instruction count: 0x%08x", otbn_instruction_count_get());
+    // Print the error.
+    CHECK_STATUS_OK(err);
+    return false;
+  }
+
+  return true;
+}
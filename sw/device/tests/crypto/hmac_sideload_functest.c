@@ -0,0 +1,267 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/crypto/drivers/entropy.h"
+#include "sw/device/lib/crypto/impl/integrity.h"
+#include "sw/device/lib/crypto/impl/keyblob.h"
+#include "sw/device/lib/crypto/include/datatypes.h"
+#include "sw/device/lib/crypto/include/key_transport.h"
+#include "sw/device/lib/crypto/include/mac.h"
+#include "sw/device/lib/runtime/ibex.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/keymgr_testutils.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+// Module ID for status codes.
+#define MODULE_ID MAKE_MODULE_ID('t', 's', 't')
+
+enum {
+  /* Length of a sideloaded HMAC key in bytes. */
+  kKeyBytes = 384 / 8,
+  /* Length of a sideloaded HMAC key in 32-bit words. */
+  kKeyWords = kKeyBytes / sizeof(uint32_t),
+  /* Maximum tag length in 32-bit words (HMAC-SHA512). */
+  kMaxTagWords = 512 / 32,
+  /* Length of the message for the throughput comparison. */
+  kLongMessageBytes = 1024,
+};
+
+/**
+ * An HMAC variant to test.
+ */
+typedef struct hmac_test_case {
+  const char *name;
+  otcrypto_key_mode_t key_mode;
+  size_t tag_words;
+} hmac_test_case_t;
+
+static const hmac_test_case_t kTestCases[] = {
+    {
+        .name = "HMAC-SHA256",
+        .key_mode = kOtcryptoKeyModeHmacSha256,
+        .tag_words = 256 / 32,
+    },
+    {
+        .name = "HMAC-SHA384",
+        .key_mode = kOtcryptoKeyModeHmacSha384,
+        .tag_words = 384 / 32,
+    },
+    {
+        .name = "HMAC-SHA512",
+        .key_mode = kOtcryptoKeyModeHmacSha512,
+        .tag_words = 512 / 32,
+    },
+};
+
+static const uint32_t kKeySalt[7] = {0xdeadbeef, 0xdeadbeef, 0xdeadbeef,
+                                     0xdeadbeef, 0xdeadbeef, 0xdeadbeef,
+                                     0xdeadbeef};
+static const uint32_t kOtherKeySalt[7] = {0xdeadbeef, 0xdeadbeef, 0xdeadbeef,
+                                          0xdeadbeef, 0xdeadbeef, 0xdeadbeef,
+                                          0xfeedf00d};
+static const uint32_t kKeyVersion = 0x0;
+
+// Key and mask for the software-keyed comparison. The values do not matter.
+static const uint32_t kSoftwareKey[kKeyWords] = {
+    0x6f1c2b7e, 0x0f8d4a63, 0x9e52c1d8, 0x34a7f0b9, 0xc81e6d25, 0x5b93e04a,
+    0xa2f7163c, 0x7d4b89e1, 0x1e06c5f3, 0xe9a23d57, 0x48bf7c02, 0xb35e91a6,
+};
+static const uint32_t kSoftwareKeyMask[kKeyWords] = {
+    0x8cb847c3, 0xc6d34f36, 0x72edbf7b, 0x9bc0317f, 0x8f003c7f, 0x1d7ba049,
+    0xfd463b63, 0xbb720c44, 0x784c215e, 0xeb101d65, 0x35beb911, 0xab481345,
+};
+
+static const char kMessage[] = "Sideloaded HMAC test message.";
+
+// Message for the throughput comparison.
+static uint8_t long_message[kLongMessageBytes];
+
+/**
+ * Key configuration for a hardware-backed HMAC key.
+ *
+ * @param key_mode HMAC key mode.
+ * @return Key configuration.
+ */
+static otcrypto_key_config_t hw_key_config(otcrypto_key_mode_t key_mode) {
+  return (otcrypto_key_config_t){
+      .version = kOtcryptoLibVersion1,
+      .key_mode = key_mode,
+      .key_length = kKeyBytes,
+      .hw_backed = kHardenedBoolTrue,
+      .exportable = kHardenedBoolFalse,
+      .security_level = kOtcryptoKeySecurityLevelLow,
+  };
+}
+
+/**
+ * Check that one-shot and streaming HMAC agree for a sideloaded key.
+ *
+ * Also checks that the tag depends on the key salt.
+ */
+static status_t stream_test(const hmac_test_case_t *test) {
+  LOG_INFO("Testing %s with a sideloaded key...", test->name);
+  uint32_t keyblob[8] = {0};
+  otcrypto_blinded_key_t key = {
+      .config = hw_key_config(test->key_mode),
+      .keyblob_length = sizeof(keyblob),
+      .keyblob = keyblob,
+  };
+  TRY(otcrypto_hw_backed_key(kKeyVersion, kKeySalt, &key));
+
+  otcrypto_const_byte_buf_t msg = {
+      .data = (const uint8_t *)kMessage,
+      .len = sizeof(kMessage) - 1,
+  };
+
+  // One-shot tag.
+  uint32_t tag[kMaxTagWords];
+  otcrypto_word32_buf_t tag_buf = {.data = tag, .len = test->tag_words};
+  TRY(otcrypto_hmac(&key, msg, tag_buf));
+
+  // Same message in three uneven pieces.
+  uint32_t stream_tag[kMaxTagWords];
+  otcrypto_hmac_context_t ctx;
+  TRY(otcrypto_hmac_init(&ctx, &key));
+  TRY(otcrypto_hmac_update(
+      &ctx, (otcrypto_const_byte_buf_t){.data = msg.data, .len = 1}));
+  TRY(otcrypto_hmac_update(
+      &ctx, (otcrypto_const_byte_buf_t){.data = msg.data + 1, .len = 10}));
+  TRY(otcrypto_hmac_update(
+      &ctx,
+      (otcrypto_const_byte_buf_t){.data = msg.data + 11, .len = msg.len - 11}));
+  TRY(otcrypto_hmac_final(&ctx, (otcrypto_word32_buf_t){
+                                    .data = stream_tag,
+                                    .len = test->tag_words,
+                                }));
+  TRY_CHECK_ARRAYS_EQ(stream_tag, tag, test->tag_words);
+
+  // A key with another salt must give another tag.
+  uint32_t other_keyblob[8] = {0};
+  otcrypto_blinded_key_t other_key = {
+      .config = hw_key_config(test->key_mode),
+      .keyblob_length = sizeof(other_keyblob),
+      .keyblob = other_keyblob,
+  };
+  TRY(otcrypto_hw_backed_key(kKeyVersion, kOtherKeySalt, &other_key));
+  uint32_t other_tag[kMaxTagWords];
+  TRY(otcrypto_hmac(&other_key, msg,
+                    (otcrypto_word32_buf_t){.data = other_tag,
+                                            .len = test->tag_words}));
+  TRY_CHECK_ARRAYS_NE(other_tag, tag, test->tag_words);
+  return OK_STATUS();
+}
+
+/**
+ * Compare the latency and throughput of sideloaded and software keys.
+ */
+static status_t performance_test(const hmac_test_case_t *test) {
+  uint32_t keyblob[8] = {0};
+  otcrypto_blinded_key_t hw_key = {
+      .config = hw_key_config(test->key_mode),
+      .keyblob_length = sizeof(keyblob),
+      .keyblob = keyblob,
+  };
+  TRY(otcrypto_hw_backed_key(kKeyVersion, kKeySalt, &hw_key));
+
+  otcrypto_key_config_t sw_config = {
+      .version = kOtcryptoLibVersion1,
+      .key_mode = test->key_mode,
+      .key_length = kKeyBytes,
+      .hw_backed = kHardenedBoolFalse,
+      .exportable = kHardenedBoolFalse,
+      .security_level = kOtcryptoKeySecurityLevelLow,
+  };
+  uint32_t sw_keyblob[keyblob_num_words(sw_config)];
+  TRY(keyblob_from_key_and_mask(kSoftwareKey, kSoftwareKeyMask, sw_config,
+                                sw_keyblob));
+  otcrypto_blinded_key_t sw_key = {
+      .config = sw_config,
+      .keyblob = sw_keyblob,
+      .keyblob_length = sizeof(sw_keyblob),
+  };
+  sw_key.checksum = integrity_blinded_checksum(&sw_key);
+
+  otcrypto_const_byte_buf_t msg = {
+      .data = long_message,
+      .len = sizeof(long_message),
+  };
+  uint32_t tag[kMaxTagWords];
+  otcrypto_word32_buf_t tag_buf = {.data = tag, .len = test->tag_words};
+  otcrypto_hmac_context_t ctx;
+
+  // Key setup latency.
+  uint64_t t_start = ibex_mcycle_read();
+  TRY(otcrypto_hmac_init(&ctx, &hw_key));
+  uint64_t hw_init_cycles = ibex_mcycle_read() - t_start;
+  TRY(otcrypto_hmac_final(&ctx, tag_buf));
+
+  t_start = ibex_mcycle_read();
+  TRY(otcrypto_hmac_init(&ctx, &sw_key));
+  uint64_t sw_init_cycles = ibex_mcycle_read() - t_start;
+  TRY(otcrypto_hmac_final(&ctx, tag_buf));
+
+  // End-to-end time for a long message.
+  t_start = ibex_mcycle_read();
+  TRY(otcrypto_hmac(&hw_key, msg, tag_buf));
+  uint64_t hw_cycles = ibex_mcycle_read() - t_start;
+
+  t_start = ibex_mcycle_read();
+  TRY(otcrypto_hmac(&sw_key, msg, tag_buf));
+  uint64_t sw_cycles = ibex_mcycle_read() - t_start;
+
+  LOG_INFO("%s init cycles: sideloaded %d, software %d", test->name,
+           (uint32_t)hw_init_cycles, (uint32_t)sw_init_cycles);
+  LOG_INFO("%s %d-byte message cycles: sideloaded %d, software %d",
+           test->name, kLongMessageBytes, (uint32_t)hw_cycles,
+           (uint32_t)sw_cycles);
+  return OK_STATUS();
+}
+
+static status_t test_setup(void) {
+  // Initialize the key manager and advance to OwnerRootKey state.  Note: the
+  // keymgr testutils set this up using software entropy, so there is no need
+  // to initialize the entropy complex first. However, this is of course not
+  // the expected setup in production.
+  dif_keymgr_t keymgr;
+  dif_kmac_t kmac;
+  dif_keymgr_state_t keymgr_state;
+  TRY(keymgr_testutils_try_startup(&keymgr, &kmac, &keymgr_state));
+
+  if (keymgr_state == kDifKeymgrStateCreatorRootKey) {
+    TRY(keymgr_testutils_advance_state(&keymgr, &kOwnerIntParams));
+    TRY(keymgr_testutils_advance_state(&keymgr, &kOwnerRootKeyParams));
+  } else if (keymgr_state == kDifKeymgrStateOwnerIntermediateKey) {
+    TRY(keymgr_testutils_advance_state(&keymgr, &kOwnerRootKeyParams));
+  }
+
+  TRY(keymgr_testutils_check_state(&keymgr, kDifKeymgrStateOwnerRootKey));
+
+  // Initialize entropy complex for cryptolib, which the key manager uses to
+  // clear sideloaded keys. The `keymgr_testutils_startup` function restarts
+  // the device, so this should happen afterwards.
+  return entropy_complex_init();
+}
+
+static status_t run_tests(void) {
+  for (size_t i = 0; i < sizeof(long_message); i++) {
+    long_message[i] = (uint8_t)i;
+  }
+  for (size_t i = 0; i < ARRAYSIZE(kTestCases); i++) {
+    TRY(stream_test(&kTestCases[i]));
+    TRY(performance_test(&kTestCases[i]));
+  }
+  return OK_STATUS();
+}
+
+OTTF_DEFINE_TEST_CONFIG();
+
+bool test_main(void) {
+  status_t result = OK_STATUS();
+
+  CHECK_STATUS_OK(test_setup());
+  EXECUTE_TEST(result, run_tests);
+
+  return status_ok(result);
+}
@@ -366,6 +366,39 @@ static status_t run_test_vector(void) {
   return OTCRYPTO_OK;
 }
 
+/**
+ * Test that a sideloaded KMAC operation fails while a SHAKE stream holds the
+ * KMAC block, instead of waiting forever for keymgr, and works once the
+ * stream has ended.
+ */
+static status_t busy_stream_test(void) {
+  kmac_test_vector_t *vector = &kKmacTestVectors[0];
+  vector->key.checksum = integrity_blinded_checksum(&vector->key);
+  otcrypto_kmac_mode_t mode;
+  TRY(get_kmac_mode(vector->security_strength, &mode));
+
+  uint32_t tag[vector->digest.len / sizeof(uint32_t)];
+  otcrypto_word32_buf_t tag_buf = {
+      .data = tag,
+      .len = ARRAYSIZE(tag),
+  };
+
+  otcrypto_hash_context_t ctx;
+  TRY(otcrypto_hash_init(&ctx, kOtcryptoHashXofModeShake128));
+  TRY(otcrypto_hash_update(&ctx, vector->input_msg));
+  TRY_CHECK(!status_ok(otcrypto_kmac(&vector->key, vector->input_msg, mode,
+                                     vector->cust_str, vector->digest.len,
+                                     tag_buf)));
+  otcrypto_kmac_context_t kmac_ctx;
+  TRY_CHECK(!status_ok(
+      otcrypto_kmac_init(&kmac_ctx, &vector->key, mode, vector->cust_str)));
+
+  TRY(otcrypto_xof_final(&ctx));
+  TRY(otcrypto_kmac(&vector->key, vector->input_msg, mode, vector->cust_str,
+                    vector->digest.len, tag_buf));
+  return OK_STATUS();
+}
+
 OTTF_DEFINE_TEST_CONFIG();
 bool test_main(void) {
   // Initialize keymgr and advance to CreatorRootKey state.
@@ -393,5 +426,6 @@ bool test_main(void) {
              current_test_vector->vector_identifier);
     EXECUTE_TEST(test_result, run_test_vector);
   }
+  EXECUTE_TEST(test_result, busy_stream_test);
   return status_ok(test_result);
 }
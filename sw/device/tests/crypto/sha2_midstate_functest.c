@@ -0,0 +1,203 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/crypto/drivers/entropy.h"
+#include "sw/device/lib/crypto/impl/hash_midstate.h"
+#include "sw/device/lib/crypto/impl/status.h"
+#include "sw/device/lib/crypto/include/hash.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+/**
+ * Known-answer tests for resuming SHA-2 from an intermediate hash state.
+ *
+ * Each midstate is the hash state after the prefix 0x00, 0x01, 0x02, ... of
+ * the given number of message blocks, serialized like a digest. Each digest is
+ * the hash of that prefix followed by the suffix. The values were computed
+ * with a reference SHA-2 implementation.
+ */
+static const uint8_t kSha256OneBlockMidstate[] = {
+    0xfc, 0x99, 0xa2, 0xdf, 0x88, 0xf4, 0x2a, 0x7a, 0x7b, 0xb9, 0xd1, 0x80,
+    0x33, 0xcd, 0xc6, 0xa2, 0x02, 0x56, 0x75, 0x5f, 0x9d, 0x5b, 0x9a, 0x50,
+    0x44, 0xa9, 0xcc, 0x31, 0x5a, 0xbe, 0x84, 0xa7,
+};
+
+static const uint8_t kSha256OneBlockDigest[] = {
+    0xeb, 0x1c, 0x93, 0x45, 0xc3, 0x4c, 0x8a, 0x49, 0x11, 0xd0, 0x00, 0x6d,
+    0xf1, 0x8e, 0x6a, 0xb4, 0x31, 0xcb, 0x97, 0x51, 0xa4, 0x99, 0x21, 0x97,
+    0x7f, 0xdc, 0x00, 0xa2, 0x4e, 0xca, 0xff, 0xb7,
+};
+
+static const uint8_t kSha256TwoBlockMidstate[] = {
+    0x59, 0x32, 0x53, 0xad, 0xfb, 0x4c, 0xc0, 0x18, 0xbe, 0x61, 0x13, 0x95,
+    0x48, 0x5e, 0x47, 0xc1, 0x5a, 0x5b, 0x27, 0x1d, 0xfb, 0x8d, 0xa1, 0x4f,
+    0xe8, 0xf7, 0x7f, 0xb4, 0xd0, 0x5e, 0xac, 0xbc,
+};
+
+static const uint8_t kSha256TwoBlockDigest[] = {
+    0x47, 0x1f, 0xb9, 0x43, 0xaa, 0x23, 0xc5, 0x11, 0xf6, 0xf7, 0x2f, 0x8d,
+    0x16, 0x52, 0xd9, 0xc8, 0x80, 0xcf, 0xa3, 0x92, 0xad, 0x80, 0x50, 0x31,
+    0x20, 0x54, 0x77, 0x03, 0xe5, 0x6a, 0x2b, 0xe5,
+};
+
+static const uint8_t kSha384Midstate[] = {
+    0x6f, 0x16, 0x64, 0xd2, 0x13, 0xdd, 0x80, 0x2f, 0x7c, 0x47, 0xbc, 0x50,
+    0x63, 0x7c, 0xf9, 0x35, 0x92, 0x57, 0x0a, 0x2b, 0x86, 0x95, 0x83, 0x91,
+    0x48, 0xbf, 0x38, 0x34, 0x1c, 0x6e, 0xac, 0xd0, 0x53, 0x26, 0x45, 0x2e,
+    0xf1, 0xcb, 0xe6, 0x4d, 0x90, 0xf1, 0xef, 0x73, 0xbb, 0x5a, 0xc7, 0xd2,
+    0x80, 0x35, 0x65, 0x46, 0x7d, 0x0d, 0xdb, 0x10, 0xc5, 0xee, 0x3f, 0xc0,
+    0x50, 0xf9, 0xf0, 0xc1,
+};
+
+static const uint8_t kSha384Digest[] = {
+    0xe3, 0x54, 0x0b, 0x19, 0x77, 0xd6, 0x5f, 0x72, 0x02, 0x37, 0x62, 0xe2,
+    0x3c, 0xf7, 0xa7, 0xb0, 0x7c, 0x0d, 0x29, 0xb5, 0x8e, 0xd7, 0x3d, 0x85,
+    0x77, 0x14, 0xbf, 0x6d, 0x79, 0x8d, 0xa3, 0x2c, 0xdb, 0x17, 0xfc, 0x60,
+    0xf3, 0x76, 0x99, 0xc9, 0x25, 0xa9, 0xb0, 0x33, 0x27, 0x50, 0x54, 0xd9,
+};
+
+static const uint8_t kSha512Midstate[] = {
+    0x8e, 0x03, 0x95, 0x3c, 0xd5, 0x7c, 0xd6, 0x87, 0x93, 0x21, 0x27, 0x0a,
+    0xfa, 0x70, 0xc5, 0x82, 0x7b, 0xb5, 0xb6, 0x9b, 0xe5, 0x9a, 0x8f, 0x01,
+    0x30, 0x14, 0x7e, 0x94, 0xf2, 0xae, 0xdf, 0x7b, 0xdc, 0x01, 0xc5, 0x6c,
+    0x92, 0x34, 0x3c, 0xa8, 0xbd, 0x83, 0x7b, 0xb7, 0xf0, 0x20, 0x8f, 0x5a,
+    0x23, 0xe1, 0x55, 0x69, 0x45, 0x16, 0xb6, 0xf1, 0x47, 0x09, 0x9d, 0x49,
+    0x1a, 0x30, 0xb1, 0x51,
+};
+
+static const uint8_t kSha512Digest[] = {
+    0x5b, 0x15, 0x2c, 0x51, 0x2e, 0x4a, 0xf2, 0x7f, 0x0e, 0x5f, 0x69, 0x7b,
+    0x57, 0x5c, 0xe4, 0x84, 0xf4, 0x1a, 0xf1, 0x6e, 0x04, 0xb6, 0xe2, 0x9c,
+    0xcd, 0x1e, 0x49, 0x8f, 0xe7, 0xca, 0xa7, 0x4a, 0xba, 0xee, 0x1b, 0x93,
+    0xed, 0xa1, 0xe3, 0x2d, 0x6a, 0x5f, 0x19, 0x1d, 0x29, 0x87, 0xe5, 0xa4,
+    0xfa, 0xc3, 0x25, 0x11, 0xc3, 0xa2, 0xb6, 0xe1, 0xa0, 0xc3, 0x7f, 0x46,
+    0xa2, 0x93, 0x8f, 0x0d,
+};
+
+/**
+ * A SHA-2 midstate test vector.
+ */
+typedef struct midstate_test_case {
+  const char *name;
+  otcrypto_hash_mode_t mode;
+  const uint8_t *midstate;
+  size_t midstate_len;
+  size_t prefix_len;
+  const unsigned char *suffix;
+  size_t suffix_len;
+  const uint8_t *digest;
+  size_t digest_len;
+} midstate_test_case_t;
+
+static const midstate_test_case_t kTestCases[] = {
+    {
+        .name = "SHA-256, one-block prefix",
+        .mode = kOtcryptoHashModeSha256,
+        .midstate = kSha256OneBlockMidstate,
+        .midstate_len = sizeof(kSha256OneBlockMidstate),
+        .prefix_len = 64,
+        .suffix = (const unsigned char *)"abc",
+        .suffix_len = 3,
+        .digest = kSha256OneBlockDigest,
+        .digest_len = sizeof(kSha256OneBlockDigest),
+    },
+    {
+        .name = "SHA-256, two-block prefix, empty suffix",
+        .mode = kOtcryptoHashModeSha256,
+        .midstate = kSha256TwoBlockMidstate,
+        .midstate_len = sizeof(kSha256TwoBlockMidstate),
+        .prefix_len = 128,
+        .suffix = NULL,
+        .suffix_len = 0,
+        .digest = kSha256TwoBlockDigest,
+        .digest_len = sizeof(kSha256TwoBlockDigest),
+    },
+    {
+        .name = "SHA-384, one-block prefix",
+        .mode = kOtcryptoHashModeSha384,
+        .midstate = kSha384Midstate,
+        .midstate_len = sizeof(kSha384Midstate),
+        .prefix_len = 128,
+        .suffix = (const unsigned char *)"abc",
+        .suffix_len = 3,
+        .digest = kSha384Digest,
+        .digest_len = sizeof(kSha384Digest),
+    },
+    {
+        .name = "SHA-512, one-block prefix",
+        .mode = kOtcryptoHashModeSha512,
+        .midstate = kSha512Midstate,
+        .midstate_len = sizeof(kSha512Midstate),
+        .prefix_len = 128,
+        .suffix = (const unsigned char *)"abc",
+        .suffix_len = 3,
+        .digest = kSha512Digest,
+        .digest_len = sizeof(kSha512Digest),
+    },
+};
+
+/**
+ * Resume from the midstate, hash the suffix and check the digest.
+ */
+static status_t midstate_test(const midstate_test_case_t *test) {
+  LOG_INFO("Testing %s...", test->name);
+
+  // The midstate must be word-aligned.
+  uint32_t midstate[512 / 32];
+  memcpy(midstate, test->midstate, test->midstate_len);
+
+  otcrypto_hash_context_t ctx;
+  TRY(hash_sha2_midstate_resume(&ctx, test->mode, midstate,
+                                test->prefix_len));
+  TRY(otcrypto_hash_update(&ctx, (otcrypto_const_byte_buf_t){
+                                     .data = test->suffix,
+                                     .len = test->suffix_len,
+                                 }));
+
+  uint32_t actual_digest[512 / 32];
+  TRY(otcrypto_hash_final(&ctx, (otcrypto_hash_digest_t){
+                                    .data = actual_digest,
+                                    .len = test->digest_len / sizeof(uint32_t),
+                                    .mode = test->mode,
+                                }));
+  TRY_CHECK_ARRAYS_EQ((unsigned char *)actual_digest, test->digest,
+                      test->digest_len);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Check that a prefix that is not a whole number of blocks is rejected.
+ */
+static status_t bad_prefix_len_test(void) {
+  uint32_t midstate[256 / 32];
+  memcpy(midstate, kSha256OneBlockMidstate, sizeof(midstate));
+  otcrypto_hash_context_t ctx;
+  TRY_CHECK(!status_ok(
+      hash_sha2_midstate_resume(&ctx, kOtcryptoHashModeSha256, midstate, 0)));
+  TRY_CHECK(!status_ok(
+      hash_sha2_midstate_resume(&ctx, kOtcryptoHashModeSha256, midstate, 65)));
+  return OTCRYPTO_OK;
+}
+
+static status_t run_kats(void) {
+  for (size_t i = 0; i < ARRAYSIZE(kTestCases); i++) {
+    TRY(midstate_test(&kTestCases[i]));
+  }
+  return OTCRYPTO_OK;
+}
+
+OTTF_DEFINE_TEST_CONFIG();
+
+// Holds the test result.
+static volatile status_t test_result;
+
+bool test_main(void) {
+  test_result = OK_STATUS();
+  CHECK_STATUS_OK(entropy_complex_init());
+  EXECUTE_TEST(test_result, run_kats);
+  EXECUTE_TEST(test_result, bad_prefix_len_test);
+  return status_ok(test_result);
+}
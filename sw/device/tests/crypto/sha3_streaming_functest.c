@@ -0,0 +1,425 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/crypto/drivers/entropy.h"
+#include "sw/device/lib/crypto/impl/integrity.h"
+#include "sw/device/lib/crypto/impl/keyblob.h"
+#include "sw/device/lib/crypto/include/datatypes.h"
+#include "sw/device/lib/crypto/include/hash.h"
+#include "sw/device/lib/crypto/include/mac.h"
+#include "sw/device/lib/runtime/ibex.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+#define MODULE_ID MAKE_MODULE_ID('t', 's', 't')
+
+enum {
+  /**
+   * Size of the message used by the streaming and benchmark tests.
+   */
+  kLongMessageLen = 4096,
+  /**
+   * Number of 32-bit words squeezed from the XOFs; more than one Keccak
+   * block at any rate.
+   */
+  kXofOutputWords = 64,
+};
+
+/**
+ * SHA3-256('abc')
+ *   = 0x3a985da74fe225b2045c172d6bd390bd855f086e3e9d525b46bfe24511431532
+ */
+static const uint8_t kAbcSha3_256ExpDigest[] = {
+    0x3a, 0x98, 0x5d, 0xa7, 0x4f, 0xe2, 0x25, 0xb2, 0x04, 0x5c, 0x17,
+    0x2d, 0x6b, 0xd3, 0x90, 0xbd, 0x85, 0x5f, 0x08, 0x6e, 0x3e, 0x9d,
+    0x52, 0x5b, 0x46, 0xbf, 0xe2, 0x45, 0x11, 0x43, 0x15, 0x32,
+};
+
+/**
+ * Message of the NIST SP 800-185 cSHAKE and KMAC samples #1 and #2.
+ */
+static const uint8_t kNistSampleMessage[] = {0x00, 0x01, 0x02, 0x03};
+
+/**
+ * cSHAKE128(0x00010203, N = '', S = 'Email Signature'), 256 bits.
+ *
+ * Test from NIST SP 800-185 cSHAKE sample #1.
+ */
+static const char kCshakeCustomization[] = "Email Signature";
+static const uint8_t kCshakeExpDigest[] = {
+    0xc1, 0xc3, 0x69, 0x25, 0xb6, 0x40, 0x9a, 0x04, 0xf1, 0xb5, 0x04,
+    0xfc, 0xbc, 0xa9, 0xd8, 0x2b, 0x40, 0x17, 0x27, 0x7c, 0xb5, 0xed,
+    0x2b, 0x20, 0x65, 0xfc, 0x1d, 0x38, 0x14, 0xd5, 0xaa, 0xf5,
+};
+
+/**
+ * KMAC128(K = 0x404142...5f, 0x00010203, S = 'My Tagged Application'), 256
+ * bits.
+ *
+ * Test from NIST SP 800-185 KMAC sample #2.
+ */
+static const uint32_t kKmacKey[] = {
+    0x43424140, 0x47464544, 0x4b4a4948, 0x4f4e4d4c,
+    0x53525150, 0x57565554, 0x5b5a5958, 0x5f5e5d5c,
+};
+static const uint32_t kKmacKeyMask[ARRAYSIZE(kKmacKey)] = {
+    0x8cb847c3, 0xc6d34f36, 0x72edbf7b, 0x9bc0317f,
+    0x8f003c7f, 0x1d7ba049, 0xfd463b63, 0xbb720c44,
+};
+static const char kKmacCustomization[] = "My Tagged Application";
+static const uint8_t kKmacExpTag[] = {
+    0x3b, 0x1f, 0xba, 0x96, 0x3c, 0xd8, 0xb0, 0xb5, 0x9e, 0x8c, 0x1a,
+    0x6d, 0x71, 0x88, 0x8b, 0x71, 0x43, 0x65, 0x1a, 0xf8, 0xba, 0x0a,
+    0x70, 0x70, 0xc0, 0x97, 0x9e, 0x28, 0x11, 0x32, 0x4a, 0xa5,
+};
+
+/**
+ * Message for the streaming and benchmark tests.
+ */
+static uint8_t long_message[kLongMessageLen];
+
+/**
+ * Absorb `len` bytes of `msg` into a hash context in updates of 1, 3, 7, ...
+ * bytes, so that most updates start at a misaligned address.
+ *
+ * @param ctx Hash context.
+ * @param msg Input message.
+ * @param len Length of the message in bytes.
+ * @return Result (OK or error).
+ */
+static status_t update_in_pieces(otcrypto_hash_context_t *ctx,
+                                 const uint8_t *msg, size_t len) {
+  size_t update_size = 1;
+  while (len > 0) {
+    update_size = len <= update_size ? len : update_size;
+    otcrypto_const_byte_buf_t msg_buf = {
+        .data = msg,
+        .len = update_size,
+    };
+    TRY(otcrypto_hash_update(ctx, msg_buf));
+    msg += update_size;
+    len -= update_size;
+    update_size = 2 * update_size + 1;
+  }
+  return OK_STATUS();
+}
+
+/**
+ * Test streaming SHA3-256 with a short message in two updates.
+ */
+static status_t sha3_256_short_test(void) {
+  otcrypto_hash_context_t ctx;
+  TRY(otcrypto_hash_init(&ctx, kOtcryptoHashModeSha3_256));
+  TRY(update_in_pieces(&ctx, (const uint8_t *)"abc", 3));
+
+  uint32_t act_digest[8];
+  otcrypto_hash_digest_t digest_buf = {
+      .data = act_digest,
+      .len = ARRAYSIZE(act_digest),
+      .mode = kOtcryptoHashModeSha3_256,
+  };
+  TRY(otcrypto_hash_final(&ctx, digest_buf));
+  TRY_CHECK_ARRAYS_EQ((unsigned char *)act_digest, kAbcSha3_256ExpDigest,
+                      sizeof(kAbcSha3_256ExpDigest));
+  return OK_STATUS();
+}
+
+/**
+ * Test that streaming SHA-3 matches the one-shot API for all digest sizes.
+ */
+static status_t sha3_streaming_test(void) {
+  static const struct {
+    otcrypto_hash_mode_t mode;
+    size_t digest_words;
+  } kModes[] = {
+      {kOtcryptoHashModeSha3_224, 7},
+      {kOtcryptoHashModeSha3_256, 8},
+      {kOtcryptoHashModeSha3_384, 12},
+      {kOtcryptoHashModeSha3_512, 16},
+  };
+  for (size_t i = 0; i < ARRAYSIZE(kModes); i++) {
+    uint32_t exp_digest[16];
+    uint32_t act_digest[16];
+    otcrypto_hash_digest_t exp_buf = {
+        .data = exp_digest,
+        .len = kModes[i].digest_words,
+        .mode = kModes[i].mode,
+    };
+    otcrypto_hash_digest_t act_buf = {
+        .data = act_digest,
+        .len = kModes[i].digest_words,
+        .mode = kModes[i].mode,
+    };
+    otcrypto_const_byte_buf_t msg_buf = {
+        .data = long_message + 1,
+        .len = kLongMessageLen - 1,
+    };
+    TRY(otcrypto_hash(msg_buf, exp_buf));
+
+    otcrypto_hash_context_t ctx;
+    TRY(otcrypto_hash_init(&ctx, kModes[i].mode));
+    TRY(update_in_pieces(&ctx, msg_buf.data, msg_buf.len));
+    TRY(otcrypto_hash_final(&ctx, act_buf));
+    TRY_CHECK_ARRAYS_EQ(act_digest, exp_digest, kModes[i].digest_words);
+  }
+  return OK_STATUS();
+}
+
+/**
+ * Test that squeezing SHAKE256 in several steps matches the one-shot API.
+ */
+static status_t shake_squeeze_test(void) {
+  uint32_t exp_digest[kXofOutputWords];
+  otcrypto_hash_digest_t exp_buf = {
+      .data = exp_digest,
+      .len = ARRAYSIZE(exp_digest),
+      .mode = kOtcryptoHashXofModeShake256,
+  };
+  otcrypto_const_byte_buf_t msg_buf = {
+      .data = long_message,
+      .len = 1000,
+  };
+  TRY(otcrypto_xof_shake(msg_buf, exp_buf));
+
+  otcrypto_hash_context_t ctx;
+  TRY(otcrypto_hash_init(&ctx, kOtcryptoHashXofModeShake256));
+  TRY(update_in_pieces(&ctx, msg_buf.data, msg_buf.len));
+
+  // Squeeze 1, 3, 7, ... words until the output is complete.
+  uint32_t act_digest[kXofOutputWords];
+  size_t offset = 0;
+  size_t squeeze_words = 1;
+  while (offset < ARRAYSIZE(act_digest)) {
+    if (squeeze_words > ARRAYSIZE(act_digest) - offset) {
+      squeeze_words = ARRAYSIZE(act_digest) - offset;
+    }
+    otcrypto_hash_digest_t act_buf = {
+        .data = act_digest + offset,
+        .len = squeeze_words,
+        .mode = kOtcryptoHashXofModeShake256,
+    };
+    TRY(otcrypto_xof_squeeze(&ctx, act_buf));
+    offset += squeeze_words;
+    squeeze_words = 2 * squeeze_words + 1;
+  }
+  TRY(otcrypto_xof_final(&ctx));
+  TRY_CHECK_ARRAYS_EQ(act_digest, exp_digest, ARRAYSIZE(exp_digest));
+  return OK_STATUS();
+}
+
+/**
+ * Test streaming cSHAKE128 against NIST SP 800-185 cSHAKE sample #1.
+ */
+static status_t cshake_streaming_test(void) {
+  otcrypto_const_byte_buf_t function_name = {
+      .data = NULL,
+      .len = 0,
+  };
+  otcrypto_const_byte_buf_t customization_string = {
+      .data = (const uint8_t *)kCshakeCustomization,
+      .len = sizeof(kCshakeCustomization) - 1,
+  };
+  otcrypto_hash_context_t ctx;
+  TRY(otcrypto_xof_cshake_init(&ctx, kOtcryptoHashXofModeCshake128,
+                               function_name, customization_string));
+  TRY(update_in_pieces(&ctx, kNistSampleMessage, sizeof(kNistSampleMessage)));
+
+  uint32_t act_digest[8];
+  otcrypto_hash_digest_t act_buf = {
+      .data = act_digest,
+      .len = ARRAYSIZE(act_digest),
+      .mode = kOtcryptoHashXofModeCshake128,
+  };
+  TRY(otcrypto_xof_squeeze(&ctx, act_buf));
+  TRY(otcrypto_xof_final(&ctx));
+  TRY_CHECK_ARRAYS_EQ((unsigned char *)act_digest, kCshakeExpDigest,
+                      sizeof(kCshakeExpDigest));
+  return OK_STATUS();
+}
+
+/**
+ * Test streaming KMAC128 against NIST SP 800-185 KMAC sample #2.
+ *
+ * A first stream is abandoned to check that aborting releases the KMAC block.
+ */
+static status_t kmac_streaming_test(void) {
+  otcrypto_key_config_t config = {
+      .version = kOtcryptoLibVersion1,
+      .key_mode = kOtcryptoKeyModeKmac128,
+      .key_length = sizeof(kKmacKey),
+      .hw_backed = kHardenedBoolFalse,
+      .exportable = kHardenedBoolFalse,
+      .security_level = kOtcryptoKeySecurityLevelLow,
+  };
+  uint32_t keyblob[keyblob_num_words(config)];
+  TRY(keyblob_from_key_and_mask(kKmacKey, kKmacKeyMask, config, keyblob));
+  otcrypto_blinded_key_t key = {
+      .config = config,
+      .keyblob = keyblob,
+      .keyblob_length = sizeof(keyblob),
+      .checksum = 0,
+  };
+  key.checksum = integrity_blinded_checksum(&key);
+
+  otcrypto_const_byte_buf_t customization_string = {
+      .data = (const uint8_t *)kKmacCustomization,
+      .len = sizeof(kKmacCustomization) - 1,
+  };
+  otcrypto_kmac_context_t ctx;
+  TRY(otcrypto_kmac_init(&ctx, &key, kOtcryptoKmacModeKmac128,
+                         customization_string));
+  TRY(otcrypto_kmac_update(
+      &ctx, (otcrypto_const_byte_buf_t){.data = kNistSampleMessage, .len = 1}));
+  TRY(otcrypto_kmac_abort(&ctx));
+
+  TRY(otcrypto_kmac_init(&ctx, &key, kOtcryptoKmacModeKmac128,
+                         customization_string));
+  for (size_t i = 0; i < sizeof(kNistSampleMessage); i++) {
+    otcrypto_const_byte_buf_t msg_buf = {
+        .data = &kNistSampleMessage[i],
+        .len = 1,
+    };
+    TRY(otcrypto_kmac_update(&ctx, msg_buf));
+  }
+
+  uint32_t act_tag[8];
+  otcrypto_word32_buf_t tag_buf = {
+      .data = act_tag,
+      .len = ARRAYSIZE(act_tag),
+  };
+  TRY(otcrypto_kmac_final(&ctx, sizeof(kKmacExpTag), tag_buf));
+  TRY_CHECK_ARRAYS_EQ((unsigned char *)act_tag, kKmacExpTag,
+                      sizeof(kKmacExpTag));
+  return OK_STATUS();
+}
+
+/**
+ * Test that other users of the KMAC block are refused while a stream is
+ * active, and accepted again once it has ended.
+ */
+static status_t busy_test(void) {
+  otcrypto_hash_context_t ctx;
+  TRY(otcrypto_hash_init(&ctx, kOtcryptoHashXofModeShake128));
+
+  uint32_t digest[8];
+  otcrypto_hash_digest_t digest_buf = {
+      .data = digest,
+      .len = ARRAYSIZE(digest),
+      .mode = kOtcryptoHashModeSha3_256,
+  };
+  otcrypto_const_byte_buf_t msg_buf = {
+      .data = long_message,
+      .len = 16,
+  };
+  TRY_CHECK(!status_ok(otcrypto_hash(msg_buf, digest_buf)));
+
+  TRY(otcrypto_xof_final(&ctx));
+  TRY_CHECK(!status_ok(otcrypto_hash_update(&ctx, msg_buf)));
+  TRY(otcrypto_hash(msg_buf, digest_buf));
+  return OK_STATUS();
+}
+
+/**
+ * Test that an abandoned SHA-3 hash releases the KMAC block.
+ *
+ * A final call with a wrong digest length fails and leaves the stream open;
+ * aborting it must let a new hash start.
+ */
+static status_t abort_test(void) {
+  otcrypto_hash_context_t ctx;
+  TRY(otcrypto_hash_init(&ctx, kOtcryptoHashModeSha3_256));
+  TRY(update_in_pieces(&ctx, (const uint8_t *)"abc", 3));
+
+  uint32_t act_digest[8];
+  otcrypto_hash_digest_t digest_buf = {
+      .data = act_digest,
+      .len = ARRAYSIZE(act_digest) - 1,
+      .mode = kOtcryptoHashModeSha3_256,
+  };
+  TRY_CHECK(!status_ok(otcrypto_hash_final(&ctx, digest_buf)));
+  TRY(otcrypto_hash_abort(&ctx));
+
+  // SHA-2 contexts can be aborted too.
+  otcrypto_hash_context_t sha2_ctx;
+  TRY(otcrypto_hash_init(&sha2_ctx, kOtcryptoHashModeSha256));
+  TRY(otcrypto_hash_abort(&sha2_ctx));
+
+  TRY(otcrypto_hash_init(&ctx, kOtcryptoHashModeSha3_256));
+  TRY(update_in_pieces(&ctx, (const uint8_t *)"abc", 3));
+  digest_buf.len = ARRAYSIZE(act_digest);
+  TRY(otcrypto_hash_final(&ctx, digest_buf));
+  TRY_CHECK_ARRAYS_EQ((unsigned char *)act_digest, kAbcSha3_256ExpDigest,
+                      sizeof(kAbcSha3_256ExpDigest));
+  return OK_STATUS();
+}
+
+/**
+ * Log the throughput of SHA3-256 for the one-shot API and for streaming in
+ * updates of a few sizes.
+ */
+static status_t throughput_benchmark(void) {
+  uint32_t digest[8];
+  otcrypto_hash_digest_t digest_buf = {
+      .data = digest,
+      .len = ARRAYSIZE(digest),
+      .mode = kOtcryptoHashModeSha3_256,
+  };
+  otcrypto_const_byte_buf_t msg_buf = {
+      .data = long_message,
+      .len = kLongMessageLen,
+  };
+
+  uint64_t cycles = ibex_mcycle_read();
+  TRY(otcrypto_hash(msg_buf, digest_buf));
+  cycles = ibex_mcycle_read() - cycles;
+  LOG_INFO("SHA3-256 one-shot: %u bytes in %u cycles (%u.%02u cycles/byte)",
+           (uint32_t)kLongMessageLen, (uint32_t)cycles,
+           (uint32_t)(cycles / kLongMessageLen),
+           (uint32_t)(cycles * 100 / kLongMessageLen % 100));
+
+  static const size_t kUpdateSizes[] = {16, 64, 256, kLongMessageLen};
+  for (size_t i = 0; i < ARRAYSIZE(kUpdateSizes); i++) {
+    cycles = ibex_mcycle_read();
+    otcrypto_hash_context_t ctx;
+    TRY(otcrypto_hash_init(&ctx, kOtcryptoHashModeSha3_256));
+    for (size_t offset = 0; offset < kLongMessageLen;
+         offset += kUpdateSizes[i]) {
+      otcrypto_const_byte_buf_t update_buf = {
+          .data = long_message + offset,
+          .len = kUpdateSizes[i],
+      };
+      TRY(otcrypto_hash_update(&ctx, update_buf));
+    }
+    TRY(otcrypto_hash_final(&ctx, digest_buf));
+    cycles = ibex_mcycle_read() - cycles;
+    LOG_INFO(
+        "SHA3-256 streaming, %u byte updates: %u cycles (%u.%02u "
+        "cycles/byte)",
+        (uint32_t)kUpdateSizes[i], (uint32_t)cycles,
+        (uint32_t)(cycles / kLongMessageLen),
+        (uint32_t)(cycles * 100 / kLongMessageLen % 100));
+  }
+  return OK_STATUS();
+}
+
+OTTF_DEFINE_TEST_CONFIG();
+
+bool test_main(void) {
+  for (size_t i = 0; i < kLongMessageLen; i++) {
+    long_message[i] = (uint8_t)(i * 131 + 7);
+  }
+
+  status_t test_result = OK_STATUS();
+  CHECK_STATUS_OK(entropy_complex_init());
+  EXECUTE_TEST(test_result, sha3_256_short_test);
+  EXECUTE_TEST(test_result, sha3_streaming_test);
+  EXECUTE_TEST(test_result, shake_squeeze_test);
+  EXECUTE_TEST(test_result, cshake_streaming_test);
+  EXECUTE_TEST(test_result, kmac_streaming_test);
+  EXECUTE_TEST(test_result, busy_test);
+  EXECUTE_TEST(test_result, abort_test);
+  EXECUTE_TEST(test_result, throughput_benchmark);
+  return status_ok(test_result);
+}
@@ -0,0 +1,241 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/crypto/drivers/otbn.h"
+#include "sw/device/lib/crypto/impl/integrity.h"
+#include "sw/device/lib/crypto/impl/keyblob.h"
+#include "sw/device/lib/crypto/include/datatypes.h"
+#include "sw/device/lib/crypto/include/ecc.h"
+#include "sw/device/lib/runtime/ibex.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/entropy_testutils.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+enum {
+  /* Number of bytes in an X25519 private key. */
+  kX25519PrivateKeyBytes = 256 / 8,
+  /* Number of 32-bit words in an X25519 private key. */
+  kX25519PrivateKeyWords = kX25519PrivateKeyBytes / sizeof(uint32_t),
+  /* Number of 32-bit words in an X25519 public key. */
+  kX25519PublicKeyWords = 256 / 32,
+  /* Number of bytes in an X25519 shared key. */
+  kX25519SharedKeyBytes = 256 / 8,
+  /* Number of 32-bit words in an X25519 shared key. */
+  kX25519SharedKeyWords = kX25519SharedKeyBytes / sizeof(uint32_t),
+};
+
+// Configuration for the private key.
+static const otcrypto_key_config_t kPrivateKeyConfig = {
+    .version = kOtcryptoLibVersion1,
+    .key_mode = kOtcryptoKeyModeX25519,
+    .key_length = kX25519PrivateKeyBytes,
+    .hw_backed = kHardenedBoolFalse,
+    .security_level = kOtcryptoKeySecurityLevelLow,
+};
+
+// Configuration for the shared (symmetric) key. This configuration specifies
+// an AES key, but any symmetric mode that supports 256-bit keys is OK here.
+static const otcrypto_key_config_t kSharedKeyConfig = {
+    .version = kOtcryptoLibVersion1,
+    .key_mode = kOtcryptoKeyModeAesCtr,
+    .key_length = kX25519SharedKeyBytes,
+    .hw_backed = kHardenedBoolFalse,
+    .security_level = kOtcryptoKeySecurityLevelLow,
+};
+
+// Random mask for the private key.
+static const uint32_t kScalarMask[kX25519PrivateKeyWords] = {
+    0x4d2e91a7, 0xf0b8365c, 0x1c7ad4e9, 0x83f25b06,
+    0xa9e41c3d, 0x5b07f8e2, 0xe6193ca4, 0x270d8f5b,
+};
+
+// RFC 7748, section 6.1: Alice's private key. All values are in the byte
+// order of RFC 7748, read as little-endian words.
+static const uint32_t kRfc7748AlicePrivateKey[kX25519PrivateKeyWords] = {
+    0x0a6d0777, 0x7da51873, 0x72c1163c, 0x4566b251,
+    0x872f4cdf, 0x2a99c0eb, 0xa5fb77b1, 0x2a2cb91d,
+};
+
+// RFC 7748, section 6.1: Bob's public key.
+static const uint32_t kRfc7748BobPublicKey[kX25519PublicKeyWords] = {
+    0x7ddb9ede, 0xb4c17d7b, 0xc2615bd3, 0x3735e4ec,
+    0xc843833f, 0x4d67785b, 0x147efcad, 0x4f2b886f,
+};
+
+// RFC 7748, section 6.1: the shared secret K.
+static const uint32_t kRfc7748SharedKey[kX25519SharedKeyWords] = {
+    0x5b9d5d4a, 0xe12dcea4, 0xf43b8e72, 0x250f3580,
+    0xc9217ee0, 0x339ed147, 0x3c9bf076, 0x4217161e,
+};
+
+/**
+ * Unmask a shared key.
+ *
+ * @param shared_key Blinded shared key.
+ * @param[out] key Buffer for the unmasked key.
+ * @return OK or error.
+ */
+static status_t unmask_shared_key(const otcrypto_blinded_key_t *shared_key,
+                                  uint32_t *key) {
+  uint32_t *share0;
+  uint32_t *share1;
+  TRY(keyblob_to_shares(shared_key, &share0, &share1));
+  for (size_t i = 0; i < kX25519SharedKeyWords; i++) {
+    key[i] = share0[i] ^ share1[i];
+  }
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Check the known-answer test from RFC 7748, section 6.1.
+ */
+static status_t kat_test(void) {
+  LOG_INFO("Running RFC 7748 known-answer test...");
+
+  // share0 = k ^ mask, share1 = mask; the extra share words stay zero.
+  uint32_t keyblob[keyblob_num_words(kPrivateKeyConfig)];
+  size_t share_words = ARRAYSIZE(keyblob) / 2;
+  memset(keyblob, 0, sizeof(keyblob));
+  for (size_t i = 0; i < kX25519PrivateKeyWords; i++) {
+    keyblob[i] = kRfc7748AlicePrivateKey[i] ^ kScalarMask[i];
+    keyblob[share_words + i] = kScalarMask[i];
+  }
+  otcrypto_blinded_key_t private_key = {
+      .config = kPrivateKeyConfig,
+      .keyblob_length = sizeof(keyblob),
+      .keyblob = keyblob,
+  };
+  private_key.checksum = integrity_blinded_checksum(&private_key);
+
+  uint32_t pk[kX25519PublicKeyWords];
+  memcpy(pk, kRfc7748BobPublicKey, sizeof(pk));
+  otcrypto_unblinded_key_t public_key = {
+      .key_mode = kOtcryptoKeyModeX25519,
+      .key_length = sizeof(pk),
+      .key = pk,
+  };
+  public_key.checksum = integrity_unblinded_checksum(&public_key);
+
+  uint32_t shared_keyblob[keyblob_num_words(kSharedKeyConfig)];
+  otcrypto_blinded_key_t shared_key = {
+      .config = kSharedKeyConfig,
+      .keyblob_length = sizeof(shared_keyblob),
+      .keyblob = shared_keyblob,
+      .checksum = 0,
+  };
+
+  uint64_t t_start = ibex_mcycle_read();
+  TRY(otcrypto_x25519(&private_key, &public_key, &shared_key));
+  uint64_t cycles = ibex_mcycle_read() - t_start;
+  LOG_INFO("X25519 cycles: %d", (uint32_t)cycles);
+
+  uint32_t key[kX25519SharedKeyWords];
+  TRY(unmask_shared_key(&shared_key, key));
+  CHECK_ARRAYS_EQ(key, kRfc7748SharedKey, ARRAYSIZE(key));
+
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Generate two keypairs and check that both sides derive the same secret.
+ */
+static status_t key_exchange_test(void) {
+  // Allocate space for two private keys.
+  uint32_t keyblobA[keyblob_num_words(kPrivateKeyConfig)];
+  otcrypto_blinded_key_t private_keyA = {
+      .config = kPrivateKeyConfig,
+      .keyblob_length = sizeof(keyblobA),
+      .keyblob = keyblobA,
+      .checksum = 0,
+  };
+  uint32_t keyblobB[keyblob_num_words(kPrivateKeyConfig)];
+  otcrypto_blinded_key_t private_keyB = {
+      .config = kPrivateKeyConfig,
+      .keyblob_length = sizeof(keyblobB),
+      .keyblob = keyblobB,
+      .checksum = 0,
+  };
+
+  // Allocate space for two public keys.
+  uint32_t pkA[kX25519PublicKeyWords] = {0};
+  uint32_t pkB[kX25519PublicKeyWords] = {0};
+  otcrypto_unblinded_key_t public_keyA = {
+      .key_mode = kOtcryptoKeyModeX25519,
+      .key_length = sizeof(pkA),
+      .key = pkA,
+  };
+  otcrypto_unblinded_key_t public_keyB = {
+      .key_mode = kOtcryptoKeyModeX25519,
+      .key_length = sizeof(pkB),
+      .key = pkB,
+  };
+
+  LOG_INFO("Generating keypair A...");
+  uint64_t t_start = ibex_mcycle_read();
+  TRY(otcrypto_x25519_keygen(&private_keyA, &public_keyA));
+  uint64_t cycles = ibex_mcycle_read() - t_start;
+  LOG_INFO("Keygen cycles: %d", (uint32_t)cycles);
+
+  LOG_INFO("Generating keypair B...");
+  TRY(otcrypto_x25519_keygen(&private_keyB, &public_keyB));
+
+  // Sanity check; public keys should be different from each other.
+  CHECK_ARRAYS_NE(pkA, pkB, ARRAYSIZE(pkA));
+
+  // Allocate space for two shared keys.
+  uint32_t shared_keyblobA[keyblob_num_words(kSharedKeyConfig)];
+  otcrypto_blinded_key_t shared_keyA = {
+      .config = kSharedKeyConfig,
+      .keyblob_length = sizeof(shared_keyblobA),
+      .keyblob = shared_keyblobA,
+      .checksum = 0,
+  };
+  uint32_t shared_keyblobB[keyblob_num_words(kSharedKeyConfig)];
+  otcrypto_blinded_key_t shared_keyB = {
+      .config = kSharedKeyConfig,
+      .keyblob_length = sizeof(shared_keyblobB),
+      .keyblob = shared_keyblobB,
+      .checksum = 0,
+  };
+
+  LOG_INFO("Generating shared secret (A)...");
+  TRY(otcrypto_x25519(&private_keyA, &public_keyB, &shared_keyA));
+
+  LOG_INFO("Generating shared secret (B)...");
+  TRY(otcrypto_x25519(&private_keyB, &public_keyA, &shared_keyB));
+
+  // Unmask the keys and check that they match.
+  uint32_t keyA[kX25519SharedKeyWords];
+  uint32_t keyB[kX25519SharedKeyWords];
+  TRY(unmask_shared_key(&shared_keyA, keyA));
+  TRY(unmask_shared_key(&shared_keyB, keyB));
+  CHECK_ARRAYS_EQ(keyA, keyB, ARRAYSIZE(keyA));
+
+  return OTCRYPTO_OK;
+}
+
+static status_t run_tests(void) {
+  TRY(kat_test());
+  return key_exchange_test();
+}
+
+OTTF_DEFINE_TEST_CONFIG();
+
+bool test_main(void) {
+  CHECK_STATUS_OK(entropy_testutils_auto_mode_init());
+
+  status_t err = run_tests();
+  if (!status_ok(err)) {
+    // If there was an error, print the OTBN error bits and instruction count.
+    LOG_INFO("OTBN error bits: 0x%08x", otbn_err_bits_get());
+    LOG_INFO("OTBN instruction count: 0x%08x", otbn_instruction_count_get());
+    // Print the error.
+    CHECK_STATUS_OK(err);
+    return false;
+  }
+
+  return true;
+}
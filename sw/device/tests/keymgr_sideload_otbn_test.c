@@ -23,26 +23,23 @@
 
 /* Set up pointers to symbols in the OTBN application. */
 OTBN_DECLARE_APP_SYMBOLS(x25519_sideload);
-OTBN_DECLARE_SYMBOL_ADDR(x25519_sideload, enc_u);
-OTBN_DECLARE_SYMBOL_ADDR(x25519_sideload, enc_result);
+OTBN_DECLARE_SYMBOL_ADDR(x25519_sideload, mode);
+OTBN_DECLARE_SYMBOL_ADDR(x25519_sideload, u);
 static const otbn_app_t kOtbnAppX25519 = OTBN_APP_T_INIT(x25519_sideload);
-static const otbn_addr_t kOtbnVarEncU =
-    OTBN_ADDR_T_INIT(x25519_sideload, enc_u);
-static const otbn_addr_t kOtbnVarEncResult =
-    OTBN_ADDR_T_INIT(x25519_sideload, enc_result);
+static const otbn_addr_t kOtbnVarMode = OTBN_ADDR_T_INIT(x25519_sideload, mode);
+static const otbn_addr_t kOtbnVarU = OTBN_ADDR_T_INIT(x25519_sideload, u);
 
 OTTF_DEFINE_TEST_CONFIG();
 
 /**
- * Encoded Montgomery u-coordinate for testing.
+ * Mode that computes the public key for the sideloaded secret key.
  *
- * This value (9) is actually the u-coordinate of the Curve25519 base point, so
- * the X25519 function will effectively compute the public key. This is the
- * first step in key exchange (see RFC 7748, section 6.1).
+ * This multiplies the Curve25519 base point (u = 9) by the sideloaded key,
+ * which is the first step in key exchange (see RFC 7748, section 6.1). Must
+ * match `MODE_KEYPAIR_FROM_SEED` in the OTBN application.
  */
-static const uint32_t kEncodedU[8] = {
-    0x9, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-};
+static const uint32_t kModeKeypairFromSeed = 0x29f;
+
 static const dif_otbn_err_bits_t kOtbnInvalidKeyErr =
     0x1 << OTBN_ERR_BITS_KEY_INVALID_BIT;
 static const dif_otbn_err_bits_t kErrBitsOk = 0x0;
@@ -61,9 +58,10 @@ static const dif_otbn_err_bits_t kErrBitsOk = 0x0;
  */
 static void run_x25519_app(dif_otbn_t *otbn, uint32_t *result,
                            dif_otbn_err_bits_t expect_err_bits) {
-  // Copy the input argument (Montgomery u-coordinate).
-  CHECK_STATUS_OK(otbn_testutils_write_data(otbn, sizeof(kEncodedU), &kEncodedU,
-                                            kOtbnVarEncU));
+  // Select the operation.
+  CHECK_STATUS_OK(otbn_testutils_write_data(otbn, sizeof(kModeKeypairFromSeed),
+                                            &kModeKeypairFromSeed,
+                                            kOtbnVarMode));
 
   // Run the OTBN program and wait for it to complete. Clear software
   // error fatal flag as the test expects an intermediate error state.
@@ -72,9 +70,8 @@ static void run_x25519_app(dif_otbn_t *otbn, uint32_t *result,
   CHECK_STATUS_OK(otbn_testutils_execute(otbn));
   CHECK_STATUS_OK(otbn_testutils_wait_for_done(otbn, expect_err_bits));
 
-  // Copy the result (also a 256-bit Montgomery u-coordinate).
-  CHECK_STATUS_OK(
-      otbn_testutils_read_data(otbn, 32, kOtbnVarEncResult, result));
+  // Copy the result (a 256-bit Montgomery u-coordinate).
+  CHECK_STATUS_OK(otbn_testutils_read_data(otbn, 32, kOtbnVarU, result));
 }
 
 /**
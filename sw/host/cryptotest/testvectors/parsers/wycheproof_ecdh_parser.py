@@ -15,6 +15,7 @@ from Crypto.PublicKey import ECC
 EC_NAME_MAPPING = {
     "secp256r1": "p256",
     "secp384r1": "p384",
+    "curve25519": "x25519",
 }
 
 
@@ -43,8 +44,16 @@ def parse_test_vectors(raw_data):
                 "z": list(bytes.fromhex(test["shared"])),
             }
 
+            # X25519 keys and secrets are raw little-endian strings (RFC 7748);
+            # store them big-endian like the other curves. The public key is
+            # just the u-coordinate, so `qy` is left empty.
+            if group["curve"] == "curve25519":
+                test_vec["d"].reverse()
+                test_vec["z"].reverse()
+                test_vec["qx"] = list(bytes.fromhex(test["public"]))[::-1]
+                test_vec["qy"] = []
             # Parse ASN encoded public key
-            if group["encoding"] == "asn":
+            elif group["encoding"] == "asn":
                 try:
                     public_key = ECC.import_key(bytes.fromhex(test["public"]))
                 except ValueError as e:
@@ -76,6 +85,12 @@ def parse_test_vectors(raw_data):
                 # "acceptable" to err on the side of caution.
                 if "CompressedPoint" in test["flags"]:
                     test_vec["result"] = True
+                # X25519 does not validate public keys (RFC 7748, section 5),
+                # so "acceptable" inputs (twist points, low-order points,
+                # non-canonical encodings) must still produce the shared
+                # secret Wycheproof lists.
+                elif group["curve"] == "curve25519":
+                    test_vec["result"] = True
                 else:
                     test_vec["result"] = False
             else:
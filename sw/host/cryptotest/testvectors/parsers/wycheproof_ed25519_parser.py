@@ -24,6 +24,8 @@ def parse_test_vectors(raw_data):
         for test in group["tests"]:
             logging.debug(f"Parsing tcId {test['tcId']}")
             test_vec = {
+                "vendor": "wycheproof",
+                "test_case_id": test["tcId"],
                 "algorithm": "ed25519",
                 "operation": "verify",
                 "message": list(bytes.fromhex(test["msg"])),
@@ -44,7 +46,7 @@ def parse_test_vectors(raw_data):
 
             test_vectors.append(test_vec)
 
-        return test_vectors
+    return test_vectors
 
 
 def main():
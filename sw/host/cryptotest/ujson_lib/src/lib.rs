@@ -6,6 +6,7 @@ pub mod commands;
 pub mod drbg_commands;
 pub mod ecdh_commands;
 pub mod ecdsa_commands;
+pub mod ed25519_commands;
 pub mod hash_commands;
 pub mod hmac_commands;
 pub mod kmac_commands;
@@ -30,11 +30,15 @@ const ECDH_CMD_MAX_COORDINATE_BYTES_P256: usize = 32;
 const ECDH_CMD_MAX_PRIVATE_KEY_BYTES_P256: usize = 32;
 const ECDH_CMD_MAX_COORDINATE_BYTES_P384: usize = 48;
 const ECDH_CMD_MAX_PRIVATE_KEY_BYTES_P384: usize = 48;
+const ECDH_CMD_MAX_COORDINATE_BYTES_X25519: usize = 32;
+const ECDH_CMD_MAX_PRIVATE_KEY_BYTES_X25519: usize = 32;
 
 // These values were generated randomly for testing purposes.
 // Each value must be less than the value n for its respective curve.
 const RANDOM_MASK_P256: &str = "37c9e5b8e9e24402f2ec25a2eec87c1c531d67e38c18876d70aa50dd925265b1";
 const RANDOM_MASK_P384: &str = "b80fee36252d2c38350ad1c00803e09c90f4c086e4cfeed78f164b20b100d5d45f16b678a40a64295438bbebc3e29b09";
+// X25519 private keys are boolean-masked, so any 256-bit value works here.
+const RANDOM_MASK_X25519: &str = "5c0e7d21a94b3f86e2d750c91a6b48f73d25e08c96f1b4a7e3c05d8f21976ab4";
 
 #[derive(Debug, Parser)]
 struct Opts {
@@ -167,6 +171,31 @@ fn run_ecdh_testcase(
                 d1_bytes.to_vec(),
             )
         }
+        "x25519" => {
+            assert!(
+                qx.len() <= ECDH_CMD_MAX_COORDINATE_BYTES_X25519,
+                "ECDH u value was too long for curve x25519 (got: {}, max: {})",
+                qx.len(),
+                ECDH_CMD_MAX_COORDINATE_BYTES_X25519,
+            );
+            assert!(
+                d.len() <= ECDH_CMD_MAX_PRIVATE_KEY_BYTES_X25519,
+                "ECDH private key was too long for curve x25519 (got: {}, max: {})",
+                d.len(),
+                ECDH_CMD_MAX_PRIVATE_KEY_BYTES_X25519,
+            );
+            d.resize(32, 0u8);
+
+            // Calculate boolean-masked private key: d = d0 ^ d1
+            let d0 = BigUint::parse_bytes(RANDOM_MASK_X25519.as_bytes(), 16)
+                .unwrap()
+                .to_bytes_le();
+            let mut d1 = d.clone();
+            for (d1_byte, d0_byte) in d1.iter_mut().zip(d0.iter()) {
+                *d1_byte ^= d0_byte;
+            }
+            (CryptotestEcdhCurve::X25519, d0, d1)
+        }
         _ => panic!("Invalid ECDH curve name"),
     };
 
@@ -0,0 +1,175 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+use anyhow::Result;
+use arrayvec::ArrayVec;
+use clap::Parser;
+use serde::Deserialize;
+use std::fs;
+use std::time::Duration;
+
+use cryptotest_commands::commands::CryptotestCommand;
+use cryptotest_commands::ed25519_commands::{
+    CryptotestEd25519Message, CryptotestEd25519Operation, CryptotestEd25519PublicKey,
+    CryptotestEd25519SignMode, CryptotestEd25519Signature, CryptotestEd25519VerifyOutput,
+};
+
+use opentitanlib::app::TransportWrapper;
+use opentitanlib::execute_test;
+use opentitanlib::test_utils::init::InitializeTest;
+use opentitanlib::test_utils::rpc::{UartRecv, UartSend};
+use opentitanlib::uart::console::UartConsole;
+
+const ED25519_CMD_MAX_MESSAGE_BYTES: usize = 1024;
+const ED25519_CMD_MAX_SIGNATURE_BYTES: usize = 128;
+const ED25519_CMD_MAX_PUBLIC_KEY_BYTES: usize = 64;
+
+#[derive(Debug, Parser)]
+struct Opts {
+    #[command(flatten)]
+    init: InitializeTest,
+
+    // Console receive timeout.
+    #[arg(long, value_parser = humantime::parse_duration, default_value = "10s")]
+    timeout: Duration,
+
+    #[arg(long, num_args = 1..)]
+    ed25519_json: Vec<String>,
+}
+
+#[derive(Debug, Deserialize)]
+struct Ed25519TestCase {
+    vendor: String,
+    test_case_id: usize,
+    algorithm: String,
+    operation: String,
+    message: Vec<u8>,
+    public_key: Vec<u8>,
+    signature: Vec<u8>,
+    result: bool,
+}
+
+fn run_ed25519_testcase(
+    test_case: &Ed25519TestCase,
+    opts: &Opts,
+    transport: &TransportWrapper,
+    failures: &mut Vec<String>,
+) -> Result<()> {
+    log::info!(
+        "vendor: {}, test case: {}",
+        test_case.vendor,
+        test_case.test_case_id
+    );
+    let uart = transport.uart("console")?;
+    assert_eq!(test_case.algorithm.as_str(), "ed25519");
+    assert_eq!(
+        test_case.operation.as_str(),
+        "verify",
+        "Unsupported Ed25519 operation: {}",
+        test_case.operation
+    );
+    assert!(
+        test_case.message.len() <= ED25519_CMD_MAX_MESSAGE_BYTES,
+        "Ed25519 message was too long (got: {}, max: {})",
+        test_case.message.len(),
+        ED25519_CMD_MAX_MESSAGE_BYTES,
+    );
+    assert!(
+        test_case.signature.len() <= ED25519_CMD_MAX_SIGNATURE_BYTES,
+        "Ed25519 signature was too long (got: {}, max: {})",
+        test_case.signature.len(),
+        ED25519_CMD_MAX_SIGNATURE_BYTES,
+    );
+    assert!(
+        test_case.public_key.len() <= ED25519_CMD_MAX_PUBLIC_KEY_BYTES,
+        "Ed25519 public key was too long (got: {}, max: {})",
+        test_case.public_key.len(),
+        ED25519_CMD_MAX_PUBLIC_KEY_BYTES,
+    );
+
+    // Send everything. All values are already in the little-endian encoding
+    // of RFC 8032, which is what the device expects.
+    CryptotestCommand::Ed25519.send(&*uart)?;
+    CryptotestEd25519Operation::Verify.send(&*uart)?;
+    CryptotestEd25519SignMode::Eddsa.send(&*uart)?;
+
+    // `unwrap()` operations are safe here because we checked the sizes above.
+    CryptotestEd25519Message {
+        input: ArrayVec::try_from(test_case.message.as_slice()).unwrap(),
+        input_len: test_case.message.len(),
+    }
+    .send(&*uart)?;
+
+    CryptotestEd25519Signature {
+        signature: ArrayVec::try_from(test_case.signature.as_slice()).unwrap(),
+        signature_len: test_case.signature.len(),
+    }
+    .send(&*uart)?;
+
+    CryptotestEd25519PublicKey {
+        public_key: ArrayVec::try_from(test_case.public_key.as_slice()).unwrap(),
+        public_key_len: test_case.public_key.len(),
+    }
+    .send(&*uart)?;
+
+    let ed25519_output = CryptotestEd25519VerifyOutput::recv(&*uart, opts.timeout, false)?;
+    let success = match ed25519_output {
+        CryptotestEd25519VerifyOutput::Success => true,
+        CryptotestEd25519VerifyOutput::Failure => false,
+        CryptotestEd25519VerifyOutput::IntValue(i) => {
+            panic!("Invalid Ed25519 verify result: {}", i)
+        }
+    };
+    if test_case.result != success {
+        log::info!(
+            "FAILED test #{}: expected = {}, actual = {}",
+            test_case.test_case_id,
+            test_case.result,
+            success
+        );
+        failures.push(format!(
+            "{} {} #{}",
+            test_case.vendor, test_case.operation, test_case.test_case_id
+        ));
+    }
+    Ok(())
+}
+
+fn test_ed25519(opts: &Opts, transport: &TransportWrapper) -> Result<()> {
+    let uart = transport.uart("console")?;
+    uart.set_flow_control(true)?;
+    let _ = UartConsole::wait_for(&*uart, r"Running [^\r\n]*", opts.timeout)?;
+
+    let mut test_counter = 0u32;
+    let mut failures = vec![];
+    let test_vector_files = &opts.ed25519_json;
+    for file in test_vector_files {
+        let raw_json = fs::read_to_string(file)?;
+        let ed25519_tests: Vec<Ed25519TestCase> = serde_json::from_str(&raw_json)?;
+
+        for ed25519_test in &ed25519_tests {
+            test_counter += 1;
+            log::info!("Test counter: {}", test_counter);
+            run_ed25519_testcase(ed25519_test, opts, transport, &mut failures)?;
+        }
+    }
+    assert_eq!(
+        0,
+        failures.len(),
+        "Failed {} out of {} tests. Failures: {:?}",
+        failures.len(),
+        test_counter,
+        failures
+    );
+    Ok(())
+}
+
+fn main() -> Result<()> {
+    let opts = Opts::parse();
+    opts.init.init_logging();
+
+    let transport = opts.init.init_target()?;
+    execute_test!(test_ed25519, &opts, &transport);
+    Ok(())
+}
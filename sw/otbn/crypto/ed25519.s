@@ -8,6 +8,49 @@
  *   https://datatracker.ietf.org/doc/html/rfc8032
  */
 
+/**
+ * Hardened boolean values.
+ *
+ * Should match the values in `hardened_asm.h`.
+ */
+.equ HARDENED_BOOL_TRUE, 0x739
+.equ HARDENED_BOOL_FALSE, 0x1d4
+
+/**
+ * Set up the constants for arithmetic on the Ed25519 curve.
+ *
+ * This routine should run before any point operations, and again if MOD or
+ * the constants are subsequently overwritten (e.g. by the scalar field
+ * routines).
+ *
+ * This routine runs in constant time.
+ *
+ * @param[in]  w31: all-zero
+ * @param[out] w19: constant, w19 = 19
+ * @param[out] w30: constant, w30 = (2*d) mod p, d = (-121665/121666) mod p
+ * @param[out] MOD: p, modulus = 2^255 - 19
+ *
+ * clobbered registers: x2, x3, w19, w29, w30, MOD
+ * clobbered flag groups: FG0
+ */
+.globl ed25519_init
+ed25519_init:
+  /* w19 <= 19 */
+  bn.addi  w19, w31, 19
+
+  /* MOD <= 2^255 - 19 = p */
+  bn.not   w29, w31
+  bn.rshi  w29, w31, w29 >> 1
+  bn.subi  w29, w29, 18
+  bn.wsrw  MOD, w29
+
+  /* w30 <= dmem[ed25519_d2] = (2*d) mod p */
+  li       x2, 30
+  la       x3, ed25519_d2
+  bn.lid   x2, 0(x3)
+
+  ret
+
 /**
  * Add two points in extended twisted Edwards coordinates.
  *
@@ -155,3 +198,603 @@ ext_add:
   bn.mov   w13, w22
 
   ret
+
+/**
+ * Double a point in extended twisted Edwards coordinates.
+ *
+ * Returns (X3, Y3, Z3, T3) = 2 * (X1, Y1, Z1, T1)
+ *
+ * Overwrites the operand with the result.
+ *
+ * This implementation closely follows RFC 8032, section 5.1.4:
+ *   https://datatracker.ietf.org/doc/html/rfc8032#section-5.1.4
+ *
+ * The doubling formula does not need T1 or the curve constant:
+ *
+ *   A = X1^2
+ *   B = Y1^2
+ *   C = 2*Z1^2
+ *   H = A+B
+ *   E = H-(X1+Y1)^2
+ *   G = A-B
+ *   F = C+G
+ *   X3 = E*F
+ *   Y3 = G*H
+ *   T3 = E*H
+ *   Z3 = F*G
+ *
+ * This routine runs in constant time.
+ *
+ * Flags: Flags have no meaning beyond the scope of this subroutine.
+ *
+ * @param[in]  w19: constant, w19 = 19
+ * @param[in]  MOD: p, modulus = 2^255 - 19
+ * @param[in]  w31: all-zero
+ * @param[in,out] w10: input X1 (X1 < p), output X3
+ * @param[in,out] w11: input Y1 (Y1 < p), output Y3
+ * @param[in,out] w12: input Z1 (Z1 < p), output Z3
+ * @param[in,out] w13: input T1 (T1 < p), output T3
+ *
+ * clobbered registers: w10 to w13, w17, w18, w20 to w27
+ * clobbered flag groups: FG0
+ */
+.globl ext_double
+ext_double:
+  /* w24 <= X1^2 = A */
+  bn.mov   w22, w10
+  jal      x1, fe_square
+  bn.mov   w24, w22
+
+  /* w25 <= Y1^2 = B */
+  bn.mov   w22, w11
+  jal      x1, fe_square
+  bn.mov   w25, w22
+
+  /* w26 <= 2*Z1^2 = C */
+  bn.mov   w22, w12
+  jal      x1, fe_square
+  bn.addm  w26, w22, w22
+
+  /* w27 <= A + B = H */
+  bn.addm  w27, w24, w25
+  /* w24 <= A - B = G */
+  bn.subm  w24, w24, w25
+  /* w26 <= C + G = F */
+  bn.addm  w26, w26, w24
+
+  /* w25 <= H - (X1 + Y1)^2 = E */
+  bn.addm  w22, w10, w11
+  jal      x1, fe_square
+  bn.subm  w25, w27, w22
+
+  /* w10 <= E * F = X3 */
+  bn.mov   w22, w25
+  bn.mov   w23, w26
+  jal      x1, fe_mul
+  bn.mov   w10, w22
+
+  /* w11 <= G * H = Y3 */
+  bn.mov   w22, w24
+  bn.mov   w23, w27
+  jal      x1, fe_mul
+  bn.mov   w11, w22
+
+  /* w13 <= E * H = T3 */
+  bn.mov   w22, w25
+  jal      x1, fe_mul
+  bn.mov   w13, w22
+
+  /* w12 <= F * G = Z3 */
+  bn.mov   w22, w26
+  bn.mov   w23, w24
+  jal      x1, fe_mul
+  bn.mov   w12, w22
+
+  ret
+
+/**
+ * Multiply a point in extended twisted Edwards coordinates by a scalar.
+ *
+ * Returns (X, Y, Z, T) = k * (X1, Y1, Z1, T1)
+ *
+ * Uses a left-to-right double-and-add-always loop: in every iteration the
+ * point is doubled and the input point is added, and the sum is kept or
+ * discarded with a bn.sel on the next scalar bit. Because the addition
+ * formula is complete for Ed25519, no special cases arise for the identity.
+ *
+ * The scalar must be less than 2^255; the most significant bit is ignored.
+ * All Ed25519 scalars (clamped secret scalars and values reduced modulo L)
+ * satisfy this.
+ *
+ * This routine runs in constant time.
+ *
+ * Flags: Flags have no meaning beyond the scope of this subroutine.
+ *
+ * @param[in]  w19: constant, w19 = 19
+ * @param[in]  MOD: p, modulus = 2^255 - 19
+ * @param[in]  w30: constant, w30 = (2*d) mod p, d = (-121665/121666) mod p
+ * @param[in]  w31: all-zero
+ * @param[in]  w4: input X1 (X1 < p)
+ * @param[in]  w5: input Y1 (Y1 < p)
+ * @param[in]  w6: input Z1 (Z1 < p)
+ * @param[in]  w7: input T1 (T1 < p)
+ * @param[in]  w8: k, scalar (k < 2^255)
+ * @param[out] w10: output X
+ * @param[out] w11: output Y
+ * @param[out] w12: output Z
+ * @param[out] w13: output T
+ *
+ * clobbered registers: w0 to w3, w8, w10 to w18, w20 to w27
+ * clobbered flag groups: FG0
+ */
+.globl ext_scmul
+ext_scmul:
+  /* Initialize the accumulator to the identity point (0, 1, 1, 0). */
+  bn.mov   w10, w31
+  bn.addi  w11, w31, 1
+  bn.addi  w12, w31, 1
+  bn.mov   w13, w31
+
+  /* Shift out the unused most significant bit of the scalar.
+       w8 <= (w8 << 1) mod 2^256 */
+  bn.add   w8, w8, w8
+
+  loopi    255, 15
+    /* [w13:w10] <= 2 * [w13:w10] */
+    jal      x1, ext_double
+
+    /* Save the doubled point in [w3:w0]. */
+    bn.mov   w0, w10
+    bn.mov   w1, w11
+    bn.mov   w2, w12
+    bn.mov   w3, w13
+
+    /* [w13:w10] <= [w13:w10] + (X1, Y1, Z1, T1) */
+    bn.mov   w14, w4
+    bn.mov   w15, w5
+    bn.mov   w16, w6
+    bn.mov   w17, w7
+    jal      x1, ext_add
+
+    /* Shift the next scalar bit into the carry flag.
+         FG0.C <= w8[255]
+         w8 <= (w8 << 1) mod 2^256 */
+    bn.add   w8, w8, w8
+
+    /* Keep the sum if the bit is set, otherwise the doubled point. */
+    bn.sel   w10, w10, w0, FG0.C
+    bn.sel   w11, w11, w1, FG0.C
+    bn.sel   w12, w12, w2, FG0.C
+    bn.sel   w13, w13, w3, FG0.C
+
+  ret
+
+/**
+ * Compute a linear combination of two points in extended coordinates.
+ *
+ * Returns (X, Y, Z, T) = a * P + b * Q
+ *
+ * Uses Shamir's trick with a four-entry table {O, P, Q, P+Q} in DMEM, so that
+ * both scalar multiplications share one chain of doublings.
+ *
+ * This routine is NOT constant time: the table index, and therefore the
+ * memory access pattern, depends on the scalars. It must only be used with
+ * public inputs, as in signature verification.
+ *
+ * Both scalars must be less than 2^255; the most significant bits are
+ * ignored.
+ *
+ * Flags: Flags have no meaning beyond the scope of this subroutine.
+ *
+ * @param[in]  w19: constant, w19 = 19
+ * @param[in]  MOD: p, modulus = 2^255 - 19
+ * @param[in]  w30: constant, w30 = (2*d) mod p, d = (-121665/121666) mod p
+ * @param[in]  w31: all-zero
+ * @param[in]  [w3:w0]: P, first point (X, Y, Z, T)
+ * @param[in]  [w7:w4]: Q, second point (X, Y, Z, T)
+ * @param[in]  w8: a, first scalar (a < 2^255)
+ * @param[in]  w9: b, second scalar (b < 2^255)
+ * @param[out] w10: output X
+ * @param[out] w11: output Y
+ * @param[out] w12: output Z
+ * @param[out] w13: output T
+ *
+ * clobbered registers: x2 to x4, w8 to w18, w20 to w27
+ * clobbered flag groups: FG0
+ */
+.globl ext_double_scmul
+ext_double_scmul:
+  /* Write the table {O, P, Q, P+Q}; each entry is 128 bytes. */
+  la       x4, ed25519_ext_table
+
+  /* dmem[table] <= O = (0, 1, 1, 0) */
+  bn.addi  w10, w31, 1
+  li       x2, 31
+  bn.sid   x2, 0(x4)
+  li       x2, 10
+  bn.sid   x2, 32(x4)
+  bn.sid   x2, 64(x4)
+  li       x2, 31
+  bn.sid   x2, 96(x4)
+
+  /* dmem[table + 128] <= P */
+  li       x2, 0
+  bn.sid   x2++, 128(x4)
+  bn.sid   x2++, 160(x4)
+  bn.sid   x2++, 192(x4)
+  bn.sid   x2++, 224(x4)
+
+  /* dmem[table + 256] <= Q */
+  bn.sid   x2++, 256(x4)
+  bn.sid   x2++, 288(x4)
+  bn.sid   x2++, 320(x4)
+  bn.sid   x2++, 352(x4)
+
+  /* dmem[table + 384] <= P + Q */
+  bn.mov   w10, w0
+  bn.mov   w11, w1
+  bn.mov   w12, w2
+  bn.mov   w13, w3
+  bn.mov   w14, w4
+  bn.mov   w15, w5
+  bn.mov   w16, w6
+  bn.mov   w17, w7
+  jal      x1, ext_add
+  li       x2, 10
+  bn.sid   x2++, 384(x4)
+  bn.sid   x2++, 416(x4)
+  bn.sid   x2++, 448(x4)
+  bn.sid   x2++, 480(x4)
+
+  /* Initialize the accumulator to the identity point (0, 1, 1, 0). */
+  bn.mov   w10, w31
+  bn.addi  w11, w31, 1
+  bn.addi  w12, w31, 1
+  bn.mov   w13, w31
+
+  /* Shift out the unused most significant bits of the scalars. */
+  bn.add   w8, w8, w8
+  bn.add   w9, w9, w9
+
+  loopi    255, 18
+    /* [w13:w10] <= 2 * [w13:w10] */
+    jal      x1, ext_double
+
+    /* x2 <= next bit of a */
+    bn.add   w8, w8, w8
+    csrrs    x2, FG0, x0
+    andi     x2, x2, 1
+
+    /* x3 <= 2 * (next bit of b) */
+    bn.add   w9, w9, w9
+    csrrs    x3, FG0, x0
+    andi     x3, x3, 1
+    slli     x3, x3, 1
+
+    /* x3 <= table + 128 * (x2 + x3) */
+    add      x3, x3, x2
+    slli     x3, x3, 7
+    add      x3, x3, x4
+
+    /* [w17:w14] <= table entry */
+    li       x2, 14
+    bn.lid   x2++, 0(x3)
+    bn.lid   x2++, 32(x3)
+    bn.lid   x2++, 64(x3)
+    bn.lid   x2++, 96(x3)
+
+    /* [w13:w10] <= [w13:w10] + table entry */
+    jal      x1, ext_add
+    nop
+
+  ret
+
+/**
+ * Encode a point in extended twisted Edwards coordinates.
+ *
+ * Returns enc = y | ((x & 1) << 255), where (x, y) = (X/Z, Y/Z) are the affine
+ * coordinates of the point, as defined in RFC 8032, section 5.1.2:
+ *   https://datatracker.ietf.org/doc/html/rfc8032#section-5.1.2
+ *
+ * Since OTBN is little-endian, the result can be written directly to DMEM to
+ * obtain the 32-byte encoding.
+ *
+ * This routine runs in constant time.
+ *
+ * Flags: Flags have no meaning beyond the scope of this subroutine.
+ *
+ * @param[in]  w19: constant, w19 = 19
+ * @param[in]  MOD: p, modulus = 2^255 - 19
+ * @param[in]  w31: all-zero
+ * @param[in]  w10: input X (X < p)
+ * @param[in]  w11: input Y (Y < p)
+ * @param[in]  w12: input Z (0 < Z < p)
+ * @param[out] w22: enc, encoded point
+ *
+ * clobbered registers: w14 to w18, w20 to w25
+ * clobbered flag groups: FG0
+ */
+.globl ext_encode
+ext_encode:
+  /* w24 <= Z^-1 */
+  bn.mov   w16, w12
+  jal      x1, fe_inv
+  bn.mov   w24, w22
+
+  /* w25 <= X * Z^-1 = x */
+  bn.mov   w23, w10
+  jal      x1, fe_mul
+  bn.mov   w25, w22
+
+  /* w22 <= Y * Z^-1 = y */
+  bn.mov   w22, w11
+  bn.mov   w23, w24
+  jal      x1, fe_mul
+
+  /* w25 <= (x & 1) << 255 */
+  bn.rshi  w25, w25, w31 >> 1
+
+  /* w22 <= y | ((x & 1) << 255) = enc */
+  bn.or    w22, w22, w25
+
+  ret
+
+/**
+ * Decode a point to extended twisted Edwards coordinates.
+ *
+ * Returns (X, Y, Z, T) = (x, y, 1, x*y) for the point encoded as enc.
+ *
+ * Follows RFC 8032, section 5.1.3:
+ *   https://datatracker.ietf.org/doc/html/rfc8032#section-5.1.3
+ *
+ *   y = enc mod 2^255; fail if y >= p
+ *   u = y^2 - 1, v = d*y^2 + 1
+ *   x = u*v^3 * (u*v^7)^((p-5)/8)
+ *   if v*x^2 = -u, set x = x*sqrt(-1); else if v*x^2 != u, fail
+ *   if x = 0 and (enc >> 255) = 1, fail
+ *   if x mod 2 != (enc >> 255), set x = p - x
+ *
+ * If decoding fails, sets `ok` to false and immediately exits the program.
+ * Otherwise, `ok` is unmodified.
+ *
+ * This routine is NOT constant time, and must only be used to decode public
+ * values.
+ *
+ * Flags: Flags have no meaning beyond the scope of this subroutine.
+ *
+ * @param[in]  w19: constant, w19 = 19
+ * @param[in]  MOD: p, modulus = 2^255 - 19
+ * @param[in]  w31: all-zero
+ * @param[in]  w9: enc, encoded point
+ * @param[out] w10: output X
+ * @param[out] w11: output Y
+ * @param[out] w12: output Z
+ * @param[out] w13: output T
+ * @param[out] dmem[ok]: success/failure of decoding (32 bits)
+ *
+ * clobbered registers: x2, x3, x5, w9 to w18, w20 to w29
+ * clobbered flag groups: FG0
+ */
+.globl ext_decode
+ext_decode:
+  /* x5 <= enc >> 255 = x_0 */
+  bn.add   w10, w9, w9
+  csrrs    x5, FG0, x0
+  andi     x5, x5, 1
+
+  /* w11 <= enc mod 2^255 = y */
+  bn.rshi  w11, w9, w31 >> 255
+  bn.rshi  w11, w31, w11 >> 1
+
+  /* Fail if y >= p. */
+  bn.wsrr  w10, MOD
+  bn.cmp   w11, w10
+  csrrs    x2, FG0, x0
+  andi     x2, x2, 1
+  beq      x2, x0, ed25519_invalid_input
+
+  /* w25 <= y^2 */
+  bn.mov   w22, w11
+  jal      x1, fe_square
+  bn.mov   w25, w22
+
+  /* w26 <= y^2 - 1 = u */
+  bn.addi  w10, w31, 1
+  bn.subm  w26, w25, w10
+
+  /* w27 <= d * y^2 + 1 = v */
+  li       x2, 23
+  la       x3, ed25519_d
+  bn.lid   x2, 0(x3)
+  jal      x1, fe_mul
+  bn.addm  w27, w22, w10
+
+  /* w28 <= v^3 */
+  bn.mov   w22, w27
+  jal      x1, fe_square
+  bn.mov   w23, w27
+  jal      x1, fe_mul
+  bn.mov   w28, w22
+
+  /* w29 <= u * v^3 */
+  bn.mov   w23, w26
+  jal      x1, fe_mul
+  bn.mov   w29, w22
+
+  /* w16 <= u * v^7 = (u * v^3) * (v^3 * v) */
+  bn.mov   w22, w28
+  bn.mov   w23, w27
+  jal      x1, fe_mul
+  bn.mov   w23, w29
+  jal      x1, fe_mul
+  bn.mov   w16, w22
+
+  /* w28 <= u * v^3 * (u * v^7)^((p-5)/8) = x (candidate root) */
+  jal      x1, fe_pow_2252m3
+  bn.mov   w23, w29
+  jal      x1, fe_mul
+  bn.mov   w28, w22
+
+  /* w22 <= v * x^2 */
+  jal      x1, fe_square
+  bn.mov   w23, w27
+  jal      x1, fe_mul
+
+  /* If v * x^2 = u, the candidate root is correct. */
+  bn.cmp   w22, w26
+  csrrs    x2, FG0, x0
+  andi     x2, x2, 8
+  bne      x2, x0, ext_decode_root_ok
+
+  /* Otherwise, fail unless v * x^2 = -u. */
+  bn.addm  w22, w22, w26
+  bn.cmp   w22, w31
+  csrrs    x2, FG0, x0
+  andi     x2, x2, 8
+  beq      x2, x0, ed25519_invalid_input
+
+  /* w28 <= x * sqrt(-1) */
+  li       x2, 23
+  la       x3, ed25519_sqrt_m1
+  bn.lid   x2, 0(x3)
+  bn.mov   w22, w28
+  jal      x1, fe_mul
+  bn.mov   w28, w22
+
+  ext_decode_root_ok:
+  /* Fail if x = 0 and x_0 = 1. */
+  bn.cmp   w28, w31
+  csrrs    x2, FG0, x0
+  andi     x2, x2, 8
+  beq      x2, x0, ext_decode_x_nonzero
+  bne      x5, x0, ed25519_invalid_input
+
+  ext_decode_x_nonzero:
+  /* x2 <= x mod 2 */
+  bn.rshi  w10, w28, w31 >> 1
+  bn.add   w10, w10, w10
+  csrrs    x2, FG0, x0
+  andi     x2, x2, 1
+
+  /* If x mod 2 != x_0, negate x. */
+  beq      x2, x5, ext_decode_sign_ok
+  bn.subm  w28, w31, w28
+
+  ext_decode_sign_ok:
+  /* [w13:w10] <= (x, y, 1, x*y) */
+  bn.mov   w10, w28
+  bn.addi  w12, w31, 1
+  bn.mov   w22, w28
+  bn.mov   w23, w11
+  jal      x1, fe_mul
+  bn.mov   w13, w22
+
+  ret
+
+/**
+ * Mark the input as invalid and end the program.
+ *
+ * @param[out] dmem[ok]: success/failure of basic checks (32 bits)
+ */
+ed25519_invalid_input:
+  /* Set the `ok` code to false. */
+  la       x2, ok
+  addi     x3, x0, HARDENED_BOOL_FALSE
+  sw       x3, 0(x2)
+
+  /* End the program. */
+  ecall
+
+.section .data
+
+/* Curve constant d = (-121665/121666) mod p */
+.globl ed25519_d
+.balign 32
+ed25519_d:
+  .word 0x135978a3
+  .word 0x75eb4dca
+  .word 0x4141d8ab
+  .word 0x00700a4d
+  .word 0x7779e898
+  .word 0x8cc74079
+  .word 0x2b6ffe73
+  .word 0x52036cee
+
+/* Precomputed constant 2*d mod p */
+.globl ed25519_d2
+.balign 32
+ed25519_d2:
+  .word 0x26b2f159
+  .word 0xebd69b94
+  .word 0x8283b156
+  .word 0x00e0149a
+  .word 0xeef3d130
+  .word 0x198e80f2
+  .word 0x56dffce7
+  .word 0x2406d9dc
+
+/* Precomputed constant sqrt(-1) = 2^((p-1)/4) mod p */
+.globl ed25519_sqrt_m1
+.balign 32
+ed25519_sqrt_m1:
+  .word 0x4a0ea0b0
+  .word 0xc4ee1b27
+  .word 0xad2fe478
+  .word 0x2f431806
+  .word 0x3dfbd7a7
+  .word 0x2b4d0099
+  .word 0x4fc1df0b
+  .word 0x2b832480
+
+/* Base point B, x-coordinate (RFC 8032, section 5.1) */
+.globl ed25519_bx
+.balign 32
+ed25519_bx:
+  .word 0x8f25d51a
+  .word 0xc9562d60
+  .word 0x9525a7b2
+  .word 0x692cc760
+  .word 0xfdd6dc5c
+  .word 0xc0a4e231
+  .word 0xcd6e53fe
+  .word 0x216936d3
+
+/* Base point B, y-coordinate = 4/5 mod p */
+.globl ed25519_by
+.balign 32
+ed25519_by:
+  .word 0x66666658
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+
+/* Base point B, extended coordinate T = (x * y) mod p */
+.globl ed25519_bt
+.balign 32
+ed25519_bt:
+  .word 0xa5b7dda3
+  .word 0x6dde8ab3
+  .word 0x775152f5
+  .word 0x20f09f80
+  .word 0x64abe37d
+  .word 0x66ea4e8e
+  .word 0xd78b7665
+  .word 0x67875f0f
+
+.section .bss
+
+/* Point table for ext_double_scmul: {O, P, Q, P+Q}, 128 bytes per point. */
+.balign 32
+ed25519_ext_table:
+  .zero 512
+
+/* Success code for basic validity checks on the public key and signature.
+   Should be HARDENED_BOOL_TRUE or HARDENED_BOOL_FALSE. */
+.balign 4
+.weak ok
+ok:
+  .zero 4
@@ -241,6 +241,80 @@ fe_square:
  */
 .globl fe_inv
 fe_inv:
+  /* w22 <= a^(2^250-1), w14 <= a^11 */
+  jal     x1, fe_pow_2250m1
+
+  /* w22 <= w22^(2^5) = a^(2^255-2^5) */
+  loopi   5,2
+    jal     x1, fe_square
+    nop
+
+  /* w22 <= w22 * w14 = a^(2^255 - 2^5 + 11) = a^(2^255 - 21) = a^(p-2) */
+  bn.mov  w23, w14
+  jal     x1, fe_mul
+
+  ret
+
+/**
+ * Raise an element of the finite field modulo (2^255-19) to the (p-5)/8 power.
+ *
+ * Returns c = a^((p-5)/8) = a^(2^252-3) mod p.
+ *
+ * This exponent appears in the square-root computation for Ed25519 point
+ * decoding; see RFC 8032, section 5.1.3:
+ *   https://datatracker.ietf.org/doc/html/rfc8032#section-5.1.3
+ *
+ * Shares its addition chain up to a^(2^250-1) with fe_inv.
+ *
+ * This routine runs in constant time.
+ *
+ * Flags: Flags have no meaning beyond the scope of this subroutine.
+ *
+ * @param[in]  w19: constant, w19 = 19
+ * @param[in]  w16: a, first operand, a < p
+ * @param[in]  MOD: p, modulus = 2^255 - 19
+ * @param[in]  w31: all-zero
+ * @param[out] w22: c, result
+ *
+ * clobbered registers: w14, w15, w17, w18, w20 to w23
+ * clobbered flag groups: FG0
+ */
+.globl fe_pow_2252m3
+fe_pow_2252m3:
+  /* w22 <= a^(2^250-1) */
+  jal     x1, fe_pow_2250m1
+
+  /* w22 <= w22^(2^2) = a^(2^252-4) */
+  jal     x1, fe_square
+  jal     x1, fe_square
+
+  /* w22 <= w22 * w16 = a^(2^252-3) */
+  bn.mov  w23, w16
+  jal     x1, fe_mul
+
+  ret
+
+/**
+ * Compute a^(2^250-1) for an element of the finite field modulo (2^255-19).
+ *
+ * This is the common prefix of the addition chains for fe_inv and
+ * fe_pow_2252m3. As a side effect, leaves a^11 in w14.
+ *
+ * This routine runs in constant time.
+ *
+ * Flags: Flags have no meaning beyond the scope of this subroutine.
+ *
+ * @param[in]  w19: constant, w19 = 19
+ * @param[in]  w16: a, first operand, a < p
+ * @param[in]  MOD: p, modulus = 2^255 - 19
+ * @param[in]  w31: all-zero
+ * @param[out] w22: a^(2^250-1) mod p
+ * @param[out] w14: a^11 mod p
+ *
+ * clobbered registers: w14, w15, w17, w18, w20 to w23
+ * clobbered flag groups: FG0
+ */
+fe_pow_2250m1:
   /* w22 <= w16^2 = a^2 */
   bn.mov  w22, w16
   jal     x1, fe_square
@@ -342,13 +416,4 @@ fe_inv:
   bn.mov  w23, w15
   jal     x1, fe_mul
 
-  /* w22 <= w22^(2^5) = a^(2^255-2^5) */
-  loopi   5,2
-    jal     x1, fe_square
-    nop
-
-  /* w22 <= w22 * w14 = a^(2^255 - 2^5 + 11) = a^(2^255 - 21) = a^(p-2) */
-  bn.mov  w23, w14
-  jal     x1, fe_mul
-
   ret
@@ -0,0 +1,460 @@
+/* Copyright lowRISC contributors (OpenTitan project). */
+/* Licensed under the Apache License, Version 2.0, see LICENSE for details. */
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/**
+ * HMAC-SHA2 intermediate hash states ("midstates") for a sideloaded key.
+ *
+ * HMAC (FIPS 198-1) computes H((K0 ^ opad) || H((K0 ^ ipad) || message)).
+ * The routines here compress the two key blocks (K0 ^ ipad) and (K0 ^ opad)
+ * and write the resulting hash states to `inner_state` and `outer_state`.
+ *
+ * The key manager provides 384 bits of sideloaded data, expressed in 2 shares
+ * across the special registers KEY_S0_L, KEY_S0_H, KEY_S1_L, and KEY_S1_H.
+ * The HMAC key K is the full 384-bit value, read as a 48-byte string in
+ * little-endian order: the first 32 bytes are KEY_S0_L ^ KEY_S1_L and the
+ * last 16 bytes are the lower 128 bits of KEY_S0_H ^ KEY_S1_H. Since the key
+ * is shorter than the block size of every supported hash function, K0 is K
+ * padded with zeroes.
+ *
+ * Note that the shares are combined before hashing, so the SHA-2 computation
+ * itself is not masked.
+ */
+
+.text
+
+/**
+ * Compute the HMAC-SHA256 midstates for the sideloaded key.
+ *
+ * The midstates are in the same format as the SHA-256 state (see
+ * `run_sha256.s`): little-endian words in reverse order, so the first word is
+ * H[7] and the last is H[0].
+ *
+ * @param[in]             w31: all-zero
+ * @param[out] dmem[inner_state]: SHA-256 state after (K0 ^ ipad)
+ * @param[out] dmem[outer_state]: SHA-256 state after (K0 ^ opad)
+ *
+ * clobbered registers: x2 to x5, x10 to x12, x21 to x23, x30,
+ *                      w0 to w4, w20 to w30
+ * clobbered flag groups: FG0
+ */
+.globl hmac_sha256_midstates
+hmac_sha256_midstates:
+  /* w0, w4 <= K */
+  jal      x1, load_key
+
+  /* dmem[inner_state] <= SHA-256 state after (K0 ^ ipad) */
+  la       x4, ipad
+  la       x5, inner_state
+  jal      x1, sha256_key_block
+
+  /* dmem[outer_state] <= SHA-256 state after (K0 ^ opad) */
+  la       x4, opad
+  la       x5, outer_state
+  jal      x1, sha256_key_block
+
+  ret
+
+/**
+ * Compute the HMAC-SHA384 midstates for the sideloaded key.
+ *
+ * The midstates are the full SHA-512 state; see `sha512_midstates`.
+ *
+ * @param[in]             w31: all-zero
+ * @param[out] dmem[inner_state]: SHA-384 state after (K0 ^ ipad)
+ * @param[out] dmem[outer_state]: SHA-384 state after (K0 ^ opad)
+ *
+ * clobbered registers: x1 to x7, x10 to x17, x20, w0 to w27
+ * clobbered flag groups: FG0
+ */
+.globl hmac_sha384_midstates
+hmac_sha384_midstates:
+  la       x4, sha384_iv
+  jal      x0, sha512_midstates
+
+/**
+ * Compute the HMAC-SHA512 midstates for the sideloaded key.
+ *
+ * @param[in]             w31: all-zero
+ * @param[out] dmem[inner_state]: SHA-512 state after (K0 ^ ipad)
+ * @param[out] dmem[outer_state]: SHA-512 state after (K0 ^ opad)
+ *
+ * clobbered registers: x1 to x7, x10 to x17, x20, w0 to w27
+ * clobbered flag groups: FG0
+ */
+.globl hmac_sha512_midstates
+hmac_sha512_midstates:
+  la       x4, sha512_iv
+  jal      x0, sha512_midstates
+
+/**
+ * Compress one key block with SHA-256.
+ *
+ * Hashes the single block (K0 ^ pad) starting from the SHA-256 initial state.
+ *
+ * This routine runs in constant time.
+ *
+ * @param[in]   w0: lower 256 bits of K
+ * @param[in]   w4: upper 128 bits of K
+ * @param[in]   x4: dptr_pad, pointer to 256 bits of ipad or opad
+ * @param[in]   x5: dptr_out, pointer to output buffer in DMEM
+ * @param[out] dmem[dptr_out]: SHA-256 state after (K0 ^ pad)
+ *
+ * clobbered registers: x2, x3, x10 to x12, x21 to x23, x30,
+ *                      w1 to w3, w20 to w30
+ * clobbered flag groups: FG0
+ */
+sha256_key_block:
+  /* w1 <= dmem[dptr_pad] */
+  li       x2, 1
+  bn.lid   x2, 0(x4)
+
+  /* dmem[key_block] <= K0 ^ pad */
+  bn.xor   w2, w0, w1
+  bn.xor   w3, w4, w1
+  la       x3, key_block
+  li       x2, 2
+  bn.sid   x2, 0(x3)
+  li       x2, 3
+  bn.sid   x2, 32(x3)
+
+  /* dmem[state] <= SHA-256 initial state */
+  la       x3, sha256_iv
+  li       x2, 2
+  bn.lid   x2, 0(x3)
+  la       x3, state
+  bn.sid   x2, 0(x3)
+
+  /* dmem[state] <= sha256(dmem[state], dmem[key_block]) */
+  la       x10, key_block
+  li       x30, 1
+  jal      x1, sha256
+
+  /* dmem[dptr_out] <= dmem[state] */
+  la       x3, state
+  li       x2, 2
+  bn.lid   x2, 0(x3)
+  bn.sid   x2, 0(x5)
+
+  ret
+
+/**
+ * Compute HMAC midstates with SHA-512 or SHA-384.
+ *
+ * The two variants only differ in their initial state. The midstates are
+ * returned as eight 64-bit words packed densely in DMEM, H[0] first.
+ *
+ * @param[in]   x4: dptr_iv, pointer to the packed initial hash state
+ * @param[in]  w31: all-zero
+ * @param[out] dmem[inner_state]: state after (K0 ^ ipad)
+ * @param[out] dmem[outer_state]: state after (K0 ^ opad)
+ *
+ * clobbered registers: x1 to x3, x5 to x7, x10 to x17, x20,
+ *                      w0 to w27
+ * clobbered flag groups: FG0
+ */
+sha512_midstates:
+  /* w0, w4 <= K */
+  jal      x1, load_key
+
+  /* The SHA-512 routine expects the message as big-endian 64-bit words.
+       w8 <= bswap64(K[255:0])
+       w27 <= bswap64(K[383:256]) */
+  jal      x1, bswap64_w0
+  bn.mov   w8, w0
+  bn.mov   w0, w4
+  jal      x1, bswap64_w0
+  bn.mov   w27, w0
+
+  /* Set up the pointers for the SHA-512 routine. */
+  la       x2, state512
+  la       x3, dptr_state
+  sw       x2, 0(x3)
+  la       x2, key_block
+  la       x3, dptr_msg
+  sw       x2, 0(x3)
+  addi     x2, x0, 1
+  la       x3, n_chunks
+  sw       x2, 0(x3)
+
+  /* dmem[inner_state] <= SHA-512 state after (K0 ^ ipad) */
+  la       x6, ipad
+  la       x5, inner_state
+  jal      x1, sha512_key_block
+
+  /* dmem[outer_state] <= SHA-512 state after (K0 ^ opad) */
+  la       x6, opad
+  la       x5, outer_state
+  jal      x1, sha512_key_block
+
+  ret
+
+/**
+ * Compress one key block with SHA-512.
+ *
+ * Hashes the single block (K0 ^ pad) starting from the given initial state.
+ *
+ * This routine runs in constant time.
+ *
+ * @param[in]   w8: lower 256 bits of K in SHA-512 message format
+ * @param[in]  w27: upper 128 bits of K in SHA-512 message format
+ * @param[in]  w31: all-zero
+ * @param[in]   x4: dptr_iv, pointer to the packed initial hash state
+ * @param[in]   x5: dptr_out, pointer to output buffer in DMEM
+ * @param[in]   x6: dptr_pad, pointer to 256 bits of ipad or opad
+ * @param[out] dmem[dptr_out]: packed state after (K0 ^ pad)
+ *
+ * clobbered registers: x1 to x3, x5, x7, x10 to x17, x20,
+ *                      w0 to w7, w9, w10 to w26
+ * clobbered flag groups: FG0
+ */
+sha512_key_block:
+  /* w9 <= dmem[dptr_pad] */
+  li       x2, 9
+  bn.lid   x2, 0(x6)
+
+  /* dmem[key_block] <= K0 ^ pad */
+  bn.xor   w12, w8, w9
+  la       x3, key_block
+  li       x2, 12
+  bn.sid   x2, 0(x3)
+  bn.xor   w12, w27, w9
+  bn.sid   x2, 32(x3)
+  li       x2, 9
+  bn.sid   x2, 64(x3)
+  bn.sid   x2, 96(x3)
+
+  /* w13 <= 2^64 - 1 */
+  bn.not   w13, w31
+  bn.rshi  w13, w31, w13 >> 192
+
+  /* Unpack the initial state so that each 64-bit word occupies the lower
+     bits of a 256-bit cell.
+       dmem[state512 + 32*i] <= H[i] */
+  la       x3, state512
+  addi     x7, x4, 0
+  li       x2, 14
+  li       x10, 12
+  bn.lid   x10, 0(x7++)
+  loopi    4, 3
+    bn.and   w14, w13, w12
+    bn.sid   x2, 0(x3++)
+    bn.rshi  w12, w31, w12 >> 64
+  bn.lid   x10, 0(x7)
+  loopi    4, 3
+    bn.and   w14, w13, w12
+    bn.sid   x2, 0(x3++)
+    bn.rshi  w12, w31, w12 >> 64
+
+  /* dmem[state512] <= sha512(dmem[state512], dmem[key_block]) */
+  jal      x1, sha512
+
+  /* Pack the state densely into the output buffer.
+       dmem[dptr_out] <= H[3] || H[2] || H[1] || H[0]
+       dmem[dptr_out + 32] <= H[7] || H[6] || H[5] || H[4] */
+  bn.not   w13, w31
+  bn.rshi  w13, w31, w13 >> 192
+  la       x3, state512
+  li       x2, 14
+  li       x10, 12
+  loopi    4, 3
+    bn.lid   x2, 0(x3++)
+    bn.and   w14, w13, w14
+    bn.rshi  w12, w14, w12 >> 64
+  bn.sid   x10, 0(x5++)
+  loopi    4, 3
+    bn.lid   x2, 0(x3++)
+    bn.and   w14, w13, w14
+    bn.rshi  w12, w14, w12 >> 64
+  bn.sid   x10, 0(x5)
+
+  ret
+
+/**
+ * Load and unmask the sideloaded key.
+ *
+ * @param[in]  w31: all-zero
+ * @param[out]  w0: K[255:0] = KEY_S0_L ^ KEY_S1_L
+ * @param[out]  w4: K[383:256] = (KEY_S0_H ^ KEY_S1_H) mod 2^128
+ *
+ * clobbered registers: w0 to w4
+ * clobbered flag groups: none
+ */
+load_key:
+  /* w0 <= KEY_S0_L ^ KEY_S1_L */
+  bn.wsrr  w1, KEY_S0_L
+  bn.wsrr  w2, KEY_S1_L
+  bn.xor   w0, w1, w2
+
+  /* w4 <= (KEY_S0_H ^ KEY_S1_H) mod 2^128 */
+  bn.wsrr  w1, KEY_S0_H
+  bn.wsrr  w2, KEY_S1_H
+  bn.xor   w3, w1, w2
+  bn.rshi  w4, w3, w31 >> 128
+  bn.rshi  w4, w31, w4 >> 128
+
+  ret
+
+/**
+ * Reverse the byte order of each 64-bit word of a 256-bit value.
+ *
+ * This routine runs in constant time.
+ *
+ * @param[in,out]  w0: Wide register to flip (modified in-place).
+ *
+ * clobbered registers: x2, x3, w0 to w3
+ * clobbered flag groups: none
+ */
+bswap64_w0:
+  /* Swap the bytes in each 16-bit word. */
+  li       x2, 1
+  la       x3, bswap_mask8
+  bn.lid   x2, 0(x3)
+  bn.and   w2, w1, w0 >> 8
+  bn.and   w3, w0, w1
+  bn.or    w0, w2, w3 << 8
+
+  /* Swap the 16-bit words in each 32-bit word. */
+  la       x3, bswap_mask16
+  bn.lid   x2, 0(x3)
+  bn.and   w2, w1, w0 >> 16
+  bn.and   w3, w0, w1
+  bn.or    w0, w2, w3 << 16
+
+  /* Swap the 32-bit words in each 64-bit word. */
+  la       x3, bswap_mask32
+  bn.lid   x2, 0(x3)
+  bn.and   w2, w1, w0 >> 32
+  bn.and   w3, w0, w1
+  bn.or    w0, w2, w3 << 32
+
+  ret
+
+.bss
+
+/* Intermediate hash state after the inner key block (512 bits). */
+.globl inner_state
+.balign 32
+inner_state:
+.zero 64
+
+/* Intermediate hash state after the outer key block (512 bits). */
+.globl outer_state
+.balign 32
+outer_state:
+.zero 64
+
+/* Message block for the key (1024 bits; SHA-256 only uses the first half). */
+.balign 32
+key_block:
+.zero 128
+
+/* Working state for SHA-256 (256 bits). */
+.balign 32
+.globl state
+state:
+.zero 32
+
+/* Working state for SHA-512, one 64-bit word per 256-bit cell. */
+.balign 32
+state512:
+.zero 256
+
+.data
+
+/* HMAC inner pad (FIPS 198-1, section 3), 256 bits. */
+.balign 32
+ipad:
+.word 0x36363636
+.word 0x36363636
+.word 0x36363636
+.word 0x36363636
+.word 0x36363636
+.word 0x36363636
+.word 0x36363636
+.word 0x36363636
+
+/* HMAC outer pad (FIPS 198-1, section 3), 256 bits. */
+.balign 32
+opad:
+.word 0x5c5c5c5c
+.word 0x5c5c5c5c
+.word 0x5c5c5c5c
+.word 0x5c5c5c5c
+.word 0x5c5c5c5c
+.word 0x5c5c5c5c
+.word 0x5c5c5c5c
+.word 0x5c5c5c5c
+
+/* Masks for 64-bit byte-swaps. */
+.balign 32
+bswap_mask8:
+.word 0x00ff00ff
+.word 0x00ff00ff
+.word 0x00ff00ff
+.word 0x00ff00ff
+.word 0x00ff00ff
+.word 0x00ff00ff
+.word 0x00ff00ff
+.word 0x00ff00ff
+
+.balign 32
+bswap_mask16:
+.word 0x0000ffff
+.word 0x0000ffff
+.word 0x0000ffff
+.word 0x0000ffff
+.word 0x0000ffff
+.word 0x0000ffff
+.word 0x0000ffff
+.word 0x0000ffff
+
+.balign 32
+bswap_mask32:
+.word 0xffffffff
+.word 0x00000000
+.word 0xffffffff
+.word 0x00000000
+.word 0xffffffff
+.word 0x00000000
+.word 0xffffffff
+.word 0x00000000
+
+/**
+ * SHA-256 initial state (FIPS 180-4, section 5.3.3), in the same format as
+ * the state: the first word is H[7] and the last is H[0].
+ */
+.balign 32
+sha256_iv:
+.word 0x5be0cd19
+.word 0x1f83d9ab
+.word 0x9b05688c
+.word 0x510e527f
+.word 0xa54ff53a
+.word 0x3c6ef372
+.word 0xbb67ae85
+.word 0x6a09e667
+
+/* SHA-384 initial state (FIPS 180-4, section 5.3.4), H[0] first. */
+.balign 32
+sha384_iv:
+.dword 0xcbbb9d5dc1059ed8
+.dword 0x629a292a367cd507
+.dword 0x9159015a3070dd17
+.dword 0x152fecd8f70e5939
+.dword 0x67332667ffc00b31
+.dword 0x8eb44a8768581511
+.dword 0xdb0c2e0d64f98fa7
+.dword 0x47b5481dbefa4fa4
+
+/* SHA-512 initial state (FIPS 180-4, section 5.3.5), H[0] first. */
+.balign 32
+sha512_iv:
+.dword 0x6a09e667f3bcc908
+.dword 0xbb67ae8584caa73b
+.dword 0x3c6ef372fe94f82b
+.dword 0xa54ff53a5f1d36f1
+.dword 0x510e527fade682d1
+.dword 0x9b05688c2b3e6c1f
+.dword 0x1f83d9abfb41bd6b
+.dword 0x5be0cd19137e2179
@@ -0,0 +1,81 @@
+/* Copyright lowRISC contributors (OpenTitan project). */
+/* Licensed under the Apache License, Version 2.0, see LICENSE for details. */
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/**
+ * This application starts HMAC-SHA2 with a sideloaded key.
+ *
+ * HMAC (FIPS 198-1) computes H((K0 ^ opad) || H((K0 ^ ipad) || message)).
+ * The key only enters the computation through the first message block of the
+ * inner and outer hashes, so this application compresses those two blocks
+ * and returns the resulting intermediate hash states ("midstates"). The
+ * caller can then continue both hashes with any SHA-2 implementation, for
+ * example the HMAC hardware block, without ever handling the key itself.
+ *
+ * See `hmac_midstates.s` for how the key is read from the sideload slot and
+ * for the format of the midstates.
+ *
+ * This binary has the following modes of operation:
+ * 1. MODE_HMAC_SHA256: midstates for HMAC-SHA256
+ * 2. MODE_HMAC_SHA384: midstates for HMAC-SHA384
+ * 3. MODE_HMAC_SHA512: midstates for HMAC-SHA512
+ *
+ * The caller must check that the key manager has finished generating the key
+ * before attempting to run this application.
+ */
+
+/**
+ * Mode magic values, chosen to have a minimum Hamming distance of 6 from each
+ * other and from zero.
+ *
+ * TODO(#17727): in some places the OTBN assembler support for .equ directives
+ * is lacking, so they cannot be used in bignum instructions or pseudo-ops such
+ * as `li`. If support is added, we could use 32-bit values here instead of
+ * 11-bit.
+ */
+.equ MODE_HMAC_SHA256, 0x39b
+.equ MODE_HMAC_SHA384, 0x74d
+.equ MODE_HMAC_SHA512, 0x4ae
+
+.section .text.start
+start:
+  /* Init all-zero register. */
+  bn.xor  w31, w31, w31
+
+  /* Read the mode and tail-call the requested operation. */
+  la      x2, mode
+  lw      x2, 0(x2)
+
+  addi    x3, x0, MODE_HMAC_SHA256
+  beq     x2, x3, hmac_sha256
+
+  addi    x3, x0, MODE_HMAC_SHA384
+  beq     x2, x3, hmac_sha384
+
+  addi    x3, x0, MODE_HMAC_SHA512
+  beq     x2, x3, hmac_sha512
+
+  /* Unsupported mode; fail. */
+  unimp
+  unimp
+  unimp
+
+hmac_sha256:
+  jal      x1, hmac_sha256_midstates
+  ecall
+
+hmac_sha384:
+  jal      x1, hmac_sha384_midstates
+  ecall
+
+hmac_sha512:
+  jal      x1, hmac_sha512_midstates
+  ecall
+
+.bss
+
+/* Operation mode. */
+.globl mode
+.balign 4
+mode:
+.zero 4
@@ -0,0 +1,398 @@
+/* Copyright lowRISC contributors (OpenTitan project). */
+/* Licensed under the Apache License, Version 2.0, see LICENSE for details. */
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/**
+ * Ed25519 signatures (RFC 8032).
+ *
+ * All SHA-512 computations are done by the caller; this binary only handles
+ * the scalar and curve arithmetic. The caller passes in the secret scalar `s`
+ * (the clamped lower half of SHA-512(seed)) and the 512-bit hashes, which are
+ * interpreted as little-endian integers as specified by the RFC.
+ *
+ * This binary has the following modes of operation:
+ * 1. MODE_KEYGEN: compute the encoded public key A = [s]B
+ * 2. MODE_SIGN: first half of signing; compute the encoded commitment R = [r]B
+ *    and public key A = [s]B
+ * 3. MODE_VERIFY: verify a signature
+ * 4. MODE_SIGN_FINALIZE: second half of signing; compute S = (r + k * s) mod L
+ *
+ * MODE_SIGN and MODE_SIGN_FINALIZE must run back-to-back, since the nonce r is
+ * kept in DMEM between the two runs.
+ */
+
+/**
+ * Mode magic values generated with
+ * $ ./util/design/sparse-fsm-encode.py -d 6 -m 4 -n 11 \
+ *     --avoid-zero -s 2205231843
+ *
+ * Call the same utility with the same arguments and a higher -m to generate
+ * additional value(s) without changing the others or sacrificing mutual HD.
+ *
+ * TODO(#17727): in some places the OTBN assembler support for .equ directives
+ * is lacking, so they cannot be used in bignum instructions or pseudo-ops such
+ * as `li`. If support is added, we could use 32-bit values here instead of
+ * 11-bit.
+ */
+.equ MODE_KEYGEN, 0x3d4
+.equ MODE_SIGN, 0x15b
+.equ MODE_VERIFY, 0x727
+.equ MODE_SIGN_FINALIZE, 0x5e8
+
+/**
+ * Hardened boolean values.
+ *
+ * Should match the values in `hardened_asm.h`.
+ */
+.equ HARDENED_BOOL_TRUE, 0x739
+.equ HARDENED_BOOL_FALSE, 0x1d4
+
+.section .text.start
+start:
+  /* Init all-zero register. */
+  bn.xor  w31, w31, w31
+
+  /* Read the mode and tail-call the requested operation. */
+  la      x2, mode
+  lw      x2, 0(x2)
+
+  addi    x3, x0, MODE_KEYGEN
+  beq     x2, x3, keygen
+
+  addi    x3, x0, MODE_SIGN
+  beq     x2, x3, sign
+
+  addi    x3, x0, MODE_VERIFY
+  beq     x2, x3, verify
+
+  addi    x3, x0, MODE_SIGN_FINALIZE
+  beq     x2, x3, sign_finalize
+
+  /* Unsupported mode; fail. */
+  unimp
+  unimp
+  unimp
+
+/**
+ * Compute the public key from the secret scalar.
+ *
+ * This routine runs in constant time.
+ *
+ * @param[in]       w31: all-zero
+ * The caller may also store the private key seed shares in `seed0` and
+ * `seed1`; they are not used here, but this keeps them in DMEM so they can be
+ * read back along with the public key.
+ *
+ * @param[in]  dmem[scalar]: s, secret scalar (s < 2^255)
+ * @param[out]  dmem[enc_a]: enc(A), encoded public key A = [s]B
+ */
+keygen:
+  /* Set up the field constants. */
+  jal      x1, ed25519_init
+
+  /* dmem[enc_a] <= enc([s]B) */
+  li       x2, 8
+  la       x3, scalar
+  bn.lid   x2, 0(x3)
+  la       x4, enc_a
+  jal      x1, base_mult_encode
+
+  ecall
+
+/**
+ * First half of signing (RFC 8032, section 5.1.6, steps 2 and 3).
+ *
+ * Reduces the nonce hash to r = hash_r mod L, keeps r in DMEM for
+ * MODE_SIGN_FINALIZE, and returns the encodings of R = [r]B and A = [s]B. The
+ * caller hashes these together with the message to obtain hash_k.
+ *
+ * This routine runs in constant time.
+ *
+ * @param[in]       w31: all-zero
+ * @param[in]  dmem[scalar]: s, secret scalar (s < 2^255)
+ * @param[in]  dmem[hash_r]: SHA-512(dom2(F, C) || prefix || PH(M)), 512 bits
+ * @param[out]  dmem[enc_r]: enc(R), encoded commitment R = [r]B
+ * @param[out]  dmem[enc_a]: enc(A), encoded public key A = [s]B
+ */
+sign:
+  /* w18 <= hash_r mod L = r */
+  jal      x1, sc_init
+  li       x2, 16
+  la       x3, hash_r
+  bn.lid   x2++, 0(x3)
+  bn.lid   x2, 32(x3)
+  jal      x1, sc_reduce
+
+  /* dmem[nonce] <= r */
+  li       x2, 18
+  la       x3, nonce
+  bn.sid   x2, 0(x3)
+
+  /* Set up the field constants. */
+  jal      x1, ed25519_init
+
+  /* dmem[enc_r] <= enc([r]B) */
+  bn.mov   w8, w18
+  la       x4, enc_r
+  jal      x1, base_mult_encode
+
+  /* dmem[enc_a] <= enc([s]B) */
+  li       x2, 8
+  la       x3, scalar
+  bn.lid   x2, 0(x3)
+  la       x4, enc_a
+  jal      x1, base_mult_encode
+
+  ecall
+
+/**
+ * Second half of signing (RFC 8032, section 5.1.6, steps 4 and 5).
+ *
+ * Computes S = (r + k * s) mod L, where k = hash_k mod L and r was stored by
+ * the preceding MODE_SIGN run.
+ *
+ * This routine runs in constant time.
+ *
+ * @param[in]       w31: all-zero
+ * @param[in]  dmem[scalar]: s, secret scalar (s < 2^255)
+ * @param[in]  dmem[hash_k]: SHA-512(dom2(F, C) || R || A || PH(M)), 512 bits
+ * @param[out]  dmem[sig_s]: S, second half of the signature
+ */
+sign_finalize:
+  /* w21 <= hash_k mod L = k */
+  jal      x1, sc_init
+  li       x2, 16
+  la       x3, hash_k
+  bn.lid   x2++, 0(x3)
+  bn.lid   x2, 32(x3)
+  jal      x1, sc_reduce
+  bn.mov   w21, w18
+
+  /* w18 <= (k * s) mod L */
+  li       x2, 22
+  la       x3, scalar
+  bn.lid   x2, 0(x3)
+  jal      x1, sc_mul
+
+  /* w18 <= (r + k * s) mod L = S */
+  li       x2, 10
+  la       x3, nonce
+  bn.lid   x2, 0(x3)
+  bn.addm  w18, w18, w10
+
+  /* dmem[sig_s] <= S */
+  li       x2, 18
+  la       x3, sig_s
+  bn.sid   x2, 0(x3)
+
+  ecall
+
+/**
+ * Verify a signature (RFC 8032, section 5.1.7).
+ *
+ * Checks that S < L and that A decodes to a valid point, then computes
+ * R' = [S]B - [k]A with k = hash_k mod L and returns its encoding. The
+ * signature is valid if `ok` is true and enc(R') matches the R half of the
+ * signature; the caller must perform the final comparison.
+ *
+ * If `ok` is false, the signature or public key is invalid and enc(R') is
+ * meaningless. The value will be either HARDENED_BOOL_TRUE or
+ * HARDENED_BOOL_FALSE.
+ *
+ * This routine is NOT constant time; all inputs are public.
+ *
+ * @param[in]            w31: all-zero
+ * @param[in]     dmem[sig_s]: S, second half of the signature
+ * @param[in]     dmem[enc_a]: enc(A), encoded public key
+ * @param[in]    dmem[hash_k]: SHA-512(dom2(F, C) || R || A || PH(M)), 512 bits
+ * @param[out]       dmem[ok]: Whether the basic checks passed.
+ * @param[out] dmem[enc_r_check]: enc(R'), to be compared with R
+ */
+verify:
+  /* Set `ok` to false until all checks have passed. */
+  la       x2, ok
+  addi     x3, x0, HARDENED_BOOL_FALSE
+  sw       x3, 0(x2)
+
+  /* w8 <= dmem[sig_s] = S */
+  jal      x1, sc_init
+  li       x2, 8
+  la       x3, sig_s
+  bn.lid   x2, 0(x3)
+
+  /* Fail if S >= L. */
+  bn.wsrr  w10, MOD
+  bn.cmp   w8, w10
+  csrrs    x2, FG0, x0
+  andi     x2, x2, 1
+  beq      x2, x0, ed25519_invalid_input
+
+  /* w4 <= hash_k mod L = k */
+  li       x2, 16
+  la       x3, hash_k
+  bn.lid   x2++, 0(x3)
+  bn.lid   x2, 32(x3)
+  jal      x1, sc_reduce
+  bn.mov   w4, w18
+
+  /* Set up the field constants. */
+  jal      x1, ed25519_init
+
+  /* [w13:w10] <= A (ends the program on failure) */
+  li       x2, 9
+  la       x3, enc_a
+  bn.lid   x2, 0(x3)
+  jal      x1, ext_decode
+
+  /* w9 <= k */
+  bn.mov   w9, w4
+
+  /* [w3:w0] <= B */
+  jal      x1, load_base_point
+  bn.mov   w0, w4
+  bn.mov   w1, w5
+  bn.mov   w2, w6
+  bn.mov   w3, w7
+
+  /* [w7:w4] <= -A = (p - X, Y, Z, p - T) */
+  bn.subm  w4, w31, w10
+  bn.mov   w5, w11
+  bn.mov   w6, w12
+  bn.subm  w7, w31, w13
+
+  /* [w13:w10] <= [S]B + [k](-A) = R' */
+  jal      x1, ext_double_scmul
+
+  /* dmem[enc_r_check] <= enc(R') */
+  jal      x1, ext_encode
+  li       x2, 22
+  la       x3, enc_r_check
+  bn.sid   x2, 0(x3)
+
+  /* If we got here the basic validity checks passed, so set `ok` to true. */
+  la       x2, ok
+  addi     x3, x0, HARDENED_BOOL_TRUE
+  sw       x3, 0(x2)
+
+  ecall
+
+/**
+ * Load the Ed25519 base point B in extended coordinates.
+ *
+ * @param[out] [w7:w4]: B = (x, y, 1, x*y)
+ *
+ * clobbered registers: x2, x3, w4 to w7
+ * clobbered flag groups: none
+ */
+load_base_point:
+  li       x2, 4
+  la       x3, ed25519_bx
+  bn.lid   x2, 0(x3)
+  li       x2, 5
+  la       x3, ed25519_by
+  bn.lid   x2, 0(x3)
+  bn.addi  w6, w31, 1
+  li       x2, 7
+  la       x3, ed25519_bt
+  bn.lid   x2, 0(x3)
+  ret
+
+/**
+ * Multiply the base point by a scalar and store the encoded result.
+ *
+ * This routine runs in constant time.
+ *
+ * @param[in]  w8: k, scalar (k < 2^255)
+ * @param[in]  x4: DMEM address for the result
+ * @param[in]  w19: constant, w19 = 19
+ * @param[in]  w30: constant, w30 = (2*d) mod p
+ * @param[in]  MOD: p, modulus = 2^255 - 19
+ * @param[in]  w31: all-zero
+ * @param[out] dmem[x4]: enc([k]B)
+ *
+ * clobbered registers: x2, x3, w0 to w18, w20 to w27
+ * clobbered flag groups: FG0
+ */
+base_mult_encode:
+  /* [w13:w10] <= [k]B */
+  jal      x1, load_base_point
+  jal      x1, ext_scmul
+
+  /* dmem[x4] <= enc([k]B) */
+  jal      x1, ext_encode
+  li       x2, 22
+  bn.sid   x2, 0(x4)
+
+  ret
+
+.bss
+
+/* Operational mode. */
+.globl mode
+.balign 4
+mode:
+  .zero 4
+
+/* Success code for basic validity checks on the public key and signature. */
+.globl ok
+.balign 4
+ok:
+  .zero 4
+
+/* Private key seed in two shares; passed through for key generation. */
+.globl seed0
+.balign 32
+seed0:
+  .zero 32
+
+.globl seed1
+.balign 32
+seed1:
+  .zero 32
+
+/* Secret scalar s (clamped lower half of SHA-512(seed)). */
+.globl scalar
+.balign 32
+scalar:
+  .zero 32
+
+/* Nonce hash for signing (512 bits). */
+.globl hash_r
+.balign 32
+hash_r:
+  .zero 64
+
+/* Challenge hash for signing and verification (512 bits). */
+.globl hash_k
+.balign 32
+hash_k:
+  .zero 64
+
+/* Encoded commitment R; first half of the signature. */
+.globl enc_r
+.balign 32
+enc_r:
+  .zero 32
+
+/* Second half of the signature (S). */
+.globl sig_s
+.balign 32
+sig_s:
+  .zero 32
+
+/* Encoded public key A. */
+.globl enc_a
+.balign 32
+enc_a:
+  .zero 32
+
+/* Encoding of the recovered commitment R' for verification. */
+.globl enc_r_check
+.balign 32
+enc_r_check:
+  .zero 32
+
+/* Nonce r = hash_r mod L, kept between MODE_SIGN and MODE_SIGN_FINALIZE. */
+.balign 32
+nonce:
+  .zero 32
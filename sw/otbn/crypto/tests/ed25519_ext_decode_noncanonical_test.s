@@ -0,0 +1,54 @@
+/* Copyright lowRISC contributors (OpenTitan project). */
+/* Licensed under the Apache License, Version 2.0, see LICENSE for details. */
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/**
+ * Standalone test that ext_decode rejects an non-canonical encoding of y.
+ *
+ * The encoding has y = p + 1, which would reduce to the valid y = 1 (the
+ * identity) but is not canonical, so decoding must reject it before any
+ * arithmetic.
+ *
+ * On rejection, ext_decode ends the program with x3 = HARDENED_BOOL_FALSE
+ * after writing it to `ok`. If ext_decode returns instead, the test ends with
+ * w0 = 1.
+ */
+
+.section .text.start
+
+main:
+  /* Prepare all-zero register. */
+  bn.xor  w31, w31, w31
+
+  /* Initialize failure counter to 0. */
+  bn.mov  w0, w31
+
+  /* Set up MOD and the curve constants. */
+  jal     x1, ed25519_init
+
+  /* w9 <= dmem[enc] */
+  li      x2, 9
+  la      x3, enc
+  bn.lid  x2, 0(x3)
+
+  /* Decode the point; this should not return. */
+  jal     x1, ext_decode
+
+  /* Decoding wrongly succeeded; mark the test as failed. */
+  bn.addi w0, w31, 1
+  li      x3, 0
+  ecall
+
+.data
+
+/* Encoded point: y = p + 1, sign bit clear. */
+.balign 32
+enc:
+  .word 0xffffffee
+  .word 0xffffffff
+  .word 0xffffffff
+  .word 0xffffffff
+  .word 0xffffffff
+  .word 0xffffffff
+  .word 0xffffffff
+  .word 0x7fffffff
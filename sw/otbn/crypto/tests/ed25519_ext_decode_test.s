@@ -0,0 +1,218 @@
+/* Copyright lowRISC contributors (OpenTitan project). */
+/* Licensed under the Apache License, Version 2.0, see LICENSE for details. */
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/**
+ * Standalone unit tests for decoding Ed25519 points from valid encodings.
+ *
+ * Covers both branches of the square root computation, negating x for a set
+ * sign bit, and the x = 0 case with a clear sign bit. Invalid encodings end
+ * the program, so they are covered by the separate ed25519_ext_decode_*_test
+ * programs.
+ *
+ * This test will exit with the number of failures written to the w0 register;
+ * w0=0 means all tests succeeded.
+ */
+
+.section .text.start
+
+main:
+  /* Prepare all-zero register. */
+  bn.xor  w31, w31, w31
+
+  /* Initialize failure counter to 0. */
+  bn.mov  w0, w31
+
+  /* Set up MOD and the curve constants. */
+  jal     x1, ed25519_init
+
+  /* Base point: the root is correct as computed and x is even. */
+  la      x10, base_point
+  jal     x1, check_decode
+
+  /* y = 3 with the sign bit set: the root must be multiplied by sqrt(-1)
+     and then negated. */
+  la      x10, y3_odd
+  jal     x1, check_decode
+
+  /* y = 1 with the sign bit clear: the identity, x = 0. */
+  la      x10, identity
+  jal     x1, check_decode
+
+  ecall
+
+/**
+ * Decode a point and compare it to the expected coordinates.
+ *
+ * The test vector consists of four consecutive 256-bit values: the encoded
+ * point, x, y, and x*y. The decoded point must be exactly (x, y, 1, x*y).
+ *
+ * @param[in]     x10: DMEM address of the test vector
+ * @param[in]     w19: constant, w19 = 19
+ * @param[in]     MOD: p, modulus = 2^255 - 19
+ * @param[in]     w31: all-zero
+ * @param[in,out] w0:  test failure counter
+ *
+ * clobbered registers: x2, x3, x5, w1, w9 to w18, w20 to w29
+ * clobbered flag groups: FG0
+ */
+check_decode:
+  /* w9 <= dmem[x10] = enc */
+  li      x2, 9
+  bn.lid  x2, 0(x10)
+
+  /* [w13:w10] <= decoded point */
+  jal     x1, ext_decode
+
+  /* Check X. */
+  bn.mov  w22, w10
+  li      x2, 25
+  bn.lid  x2, 32(x10)
+  jal     x1, check_result
+
+  /* Check Y. */
+  bn.mov  w22, w11
+  bn.lid  x2, 64(x10)
+  jal     x1, check_result
+
+  /* Check Z. */
+  bn.mov  w22, w12
+  bn.addi w25, w31, 1
+  jal     x1, check_result
+
+  /* Check T. */
+  bn.mov  w22, w13
+  bn.lid  x2, 96(x10)
+  jal     x1, check_result
+
+  ret
+
+/**
+ * Increment the error register if expected/actual results don't match.
+ *
+ * @param[in] w25: expected result
+ * @param[in] w22: actual result
+ * @param[in,out] w0: error count
+ *
+ * clobbered registers: w0, w1
+ * clobbered flag groups: FG0
+ */
+check_result:
+  /* Increment error register if expected < actual. */
+  bn.addi w1, w0, 1
+  bn.cmp  w22, w25
+  bn.sel  w0, w1, w0, C
+
+  /* Increment error register if actual < expected. */
+  bn.addi w1, w0, 1
+  bn.cmp  w25, w22
+  bn.sel  w0, w1, w0, C
+  ret
+
+.data
+
+/* Base point B (RFC 8032, section 5.1). */
+.balign 32
+base_point:
+  /* enc(B) */
+  .word 0x66666658
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+  /* x */
+  .word 0x8f25d51a
+  .word 0xc9562d60
+  .word 0x9525a7b2
+  .word 0x692cc760
+  .word 0xfdd6dc5c
+  .word 0xc0a4e231
+  .word 0xcd6e53fe
+  .word 0x216936d3
+  /* y */
+  .word 0x66666658
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+  /* x*y */
+  .word 0xa5b7dda3
+  .word 0x6dde8ab3
+  .word 0x775152f5
+  .word 0x20f09f80
+  .word 0x64abe37d
+  .word 0x66ea4e8e
+  .word 0xd78b7665
+  .word 0x67875f0f
+
+/* Point with y = 3 and an odd x. */
+.balign 32
+y3_odd:
+  /* enc = 3 | (1 << 255) */
+  .word 0x00000003
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x80000000
+  /* x */
+  .word 0xfe51fa0b
+  .word 0x010919e0
+  .word 0x22cf43f8
+  .word 0xe3f269b4
+  .word 0x4e10d7ce
+  .word 0x0bb750a7
+  .word 0xd9ec9f71
+  .word 0x1701402b
+  /* y */
+  .word 0x00000003
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  /* x*y */
+  .word 0xfaf5ee21
+  .word 0x031b4da2
+  .word 0x686dcbe8
+  .word 0xabd73d1c
+  .word 0xea32876c
+  .word 0x2325f1f5
+  .word 0x8dc5de53
+  .word 0x4503c083
+
+/* Identity point (0, 1). */
+.balign 32
+identity:
+  /* enc = 1 */
+  .word 0x00000001
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  /* x */
+  .zero 32
+  /* y */
+  .word 0x00000001
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  /* x*y */
+  .zero 32
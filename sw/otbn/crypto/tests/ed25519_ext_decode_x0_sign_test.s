@@ -0,0 +1,53 @@
+/* Copyright lowRISC contributors (OpenTitan project). */
+/* Licensed under the Apache License, Version 2.0, see LICENSE for details. */
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/**
+ * Standalone test that ext_decode rejects an encoding of x = 0 with the sign bit set.
+ *
+ * For y = 1 the only matching x is 0, which has no negative; RFC 8032,
+ * section 5.1.3, step 4 requires rejecting a set sign bit in this case.
+ *
+ * On rejection, ext_decode ends the program with x3 = HARDENED_BOOL_FALSE
+ * after writing it to `ok`. If ext_decode returns instead, the test ends with
+ * w0 = 1.
+ */
+
+.section .text.start
+
+main:
+  /* Prepare all-zero register. */
+  bn.xor  w31, w31, w31
+
+  /* Initialize failure counter to 0. */
+  bn.mov  w0, w31
+
+  /* Set up MOD and the curve constants. */
+  jal     x1, ed25519_init
+
+  /* w9 <= dmem[enc] */
+  li      x2, 9
+  la      x3, enc
+  bn.lid  x2, 0(x3)
+
+  /* Decode the point; this should not return. */
+  jal     x1, ext_decode
+
+  /* Decoding wrongly succeeded; mark the test as failed. */
+  bn.addi w0, w31, 1
+  li      x3, 0
+  ecall
+
+.data
+
+/* Encoded point: y = 1, sign bit set. */
+.balign 32
+enc:
+  .word 0x00000001
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x00000000
+  .word 0x80000000
@@ -33,6 +33,9 @@ main:
   /* Call inverse test. */
   jal     x1, fe_inv_test
 
+  /* Call exponentiation test. */
+  jal     x1, fe_pow_2252m3_test
+
   ecall
 
 fe_mul_test:
@@ -91,6 +94,25 @@ fe_inv_test:
 
   ret
 
+fe_pow_2252m3_test:
+  /* w16 <= dmem[value_y] = y */
+  li      x2, 16
+  la      x3, value_y
+  bn.lid  x2, 0(x3)
+
+  /* w22 <= fe_pow_2252m3(w16) = (y^(2^252-3)) mod p */
+  jal     x1, fe_pow_2252m3
+
+  /* w25 <= dmem[value_y_pow_2252m3] */
+  li      x2, 25
+  la      x3, value_y_pow_2252m3
+  bn.lid  x2, 0(x3)
+
+  /* Check that the result matches the precomputed value. */
+  jal     x1, check_result
+
+  ret
+
 /**
  * Increment the error register if expected/actual results don't match.
  *
@@ -150,3 +172,15 @@ value_y:
   .word 0xffffffff
   .word 0xffffffff
   .word 0x7fffffff
+
+/* Expected value of (y^(2^252-3)) mod p for y = p - 2. */
+.balign 32
+value_y_pow_2252m3:
+  .word 0x5af8af9e
+  .word 0x9d88f26c
+  .word 0xa9680dc3
+  .word 0x685e73fc
+  .word 0x6102142c
+  .word 0x6a597fb3
+  .word 0xd81f107a
+  .word 0x2a3e6dbf
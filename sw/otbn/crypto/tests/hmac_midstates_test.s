@@ -0,0 +1,206 @@
+/* Copyright lowRISC contributors (OpenTitan project). */
+/* Licensed under the Apache License, Version 2.0, see LICENSE for details. */
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/**
+ * Standalone test for the HMAC midstates used by the `hmac_sideload` app.
+ *
+ * Computes the HMAC-SHA256, HMAC-SHA384 and HMAC-SHA512 midstates for the
+ * key in the simulator's sideload slot and compares them with precomputed
+ * values. The simulator always sideloads the shares 0xdeadbeef... and
+ * 0xbaadf00d..., so the 48-byte HMAC key is the bytes e2 4e 00 64 repeated
+ * 12 times. The expected values were computed on the host, and checked by
+ * finishing HMAC("abc") from them and comparing with a reference HMAC.
+ *
+ * This test will exit with the number of failures written to the w0 register;
+ * w0=0 means all tests succeeded.
+ */
+
+.section .text.start
+
+main:
+  /* Prepare all-zero register. */
+  bn.xor  w31, w31, w31
+
+  /* dmem[results] <= HMAC-SHA256 midstates (one 256-bit cell each) */
+  jal     x1, hmac_sha256_midstates
+  la      x8, results
+  li      x9, 1
+  jal     x1, save_midstates
+
+  /* dmem[results + 64] <= HMAC-SHA384 midstates (two cells each) */
+  jal     x1, hmac_sha384_midstates
+  la      x8, results
+  addi    x8, x8, 64
+  li      x9, 2
+  jal     x1, save_midstates
+
+  /* dmem[results + 192] <= HMAC-SHA512 midstates (two cells each) */
+  jal     x1, hmac_sha512_midstates
+  la      x8, results
+  addi    x8, x8, 192
+  li      x9, 2
+  jal     x1, save_midstates
+
+  /* Initialize failure counter to 0. */
+  bn.mov  w0, w31
+
+  /* Compare all 10 cells with the expected values. */
+  la      x8, results
+  la      x9, expected
+  li      x2, 22
+  li      x3, 25
+  loopi   10, 4
+    bn.lid  x2, 0(x8++)
+    bn.lid  x3, 0(x9++)
+    jal     x1, check_result
+    nop
+
+  ecall
+
+/**
+ * Copy the inner and outer states to a results buffer.
+ *
+ * @param[in]  x8: dptr_out, pointer to the results buffer in DMEM
+ * @param[in]  x9: number of 256-bit cells in each state
+ * @param[out] dmem[dptr_out]: inner state followed by outer state
+ *
+ * clobbered registers: x2 to x4, x8, w1
+ * clobbered flag groups: none
+ */
+save_midstates:
+  li      x2, 1
+  la      x3, inner_state
+  la      x4, outer_state
+  loop    x9, 2
+    bn.lid  x2, 0(x3++)
+    bn.sid  x2, 0(x8++)
+  loop    x9, 2
+    bn.lid  x2, 0(x4++)
+    bn.sid  x2, 0(x8++)
+  ret
+
+/**
+ * Increment the error register if expected/actual results don't match.
+ *
+ * @param[in] w25: expected result
+ * @param[in] w22: actual result
+ * @param[in,out] w0: error count
+ *
+ * clobbered registers: w0, w1
+ * clobbered flag groups: FG0
+ */
+check_result:
+  /* Increment error register if expected < actual. */
+  bn.addi w1, w0, 1
+  bn.cmp  w22, w25
+  bn.sel  w0, w1, w0, C
+
+  /* Increment error register if actual < expected. */
+  bn.addi w1, w0, 1
+  bn.cmp  w25, w22
+  bn.sel  w0, w1, w0, C
+  ret
+
+.bss
+
+/* Midstates computed by the test, in the same layout as `expected`. */
+.balign 32
+results:
+.zero 320
+
+.data
+
+/**
+ * Expected midstates, inner state first. The SHA-256 states use the SHA-256
+ * state format (H[7] first); the SHA-384 and SHA-512 states are packed 64-bit
+ * words, H[0] first.
+ */
+.balign 32
+expected:
+  /* SHA-256 inner state */
+  .word 0xacd6a330
+  .word 0x1f9f71c8
+  .word 0x14a348b6
+  .word 0x04fa8a13
+  .word 0x1dfeee85
+  .word 0x38246564
+  .word 0x7a178bcb
+  .word 0xe53cc4d9
+  /* SHA-256 outer state */
+  .word 0xbf9b2e3f
+  .word 0xaf6efb21
+  .word 0x0b122ed4
+  .word 0x2075b2ab
+  .word 0x4932a37b
+  .word 0x634e335a
+  .word 0x1c8a7770
+  .word 0xa9389ac0
+  /* SHA-384 inner state */
+  .word 0x8a517ae8
+  .word 0xee009feb
+  .word 0xd175d946
+  .word 0x6aaf6c27
+  .word 0x43f9dee4
+  .word 0xcf1b279d
+  .word 0x0ebf7f51
+  .word 0xa53a368e
+  .word 0x85885f66
+  .word 0xd9ab5cc2
+  .word 0xebc39bc2
+  .word 0x402f6ed2
+  .word 0x2431b85c
+  .word 0x54dae2bb
+  .word 0xa4445393
+  .word 0xf51681d1
+  /* SHA-384 outer state */
+  .word 0x82b365d3
+  .word 0x0155e2c1
+  .word 0xe43dd4fa
+  .word 0x746f6a2f
+  .word 0xecf72612
+  .word 0x630d8b03
+  .word 0x6e403a7d
+  .word 0x0707f953
+  .word 0xb00f5248
+  .word 0x320dca12
+  .word 0x89e40d92
+  .word 0x3298ad20
+  .word 0x7041c43c
+  .word 0x9defefac
+  .word 0xb222e3c8
+  .word 0x27b84134
+  /* SHA-512 inner state */
+  .word 0x3899341d
+  .word 0x2731191c
+  .word 0xac7df4a0
+  .word 0x06ec31d9
+  .word 0xf84c3e0e
+  .word 0x861235e5
+  .word 0x4c86faed
+  .word 0x2f0e1b19
+  .word 0x91bf6404
+  .word 0xdfaf65f7
+  .word 0x56ff62f9
+  .word 0xd4c2e0d9
+  .word 0x0cbbced3
+  .word 0xec422df9
+  .word 0x872cdefe
+  .word 0x4c5b4866
+  /* SHA-512 outer state */
+  .word 0xac89e21a
+  .word 0xc67d01ce
+  .word 0xd25038cf
+  .word 0x550e3ecd
+  .word 0xc95a0c3d
+  .word 0xe4171756
+  .word 0x564073db
+  .word 0x8ac80f20
+  .word 0x2a870d65
+  .word 0xf6e7e412
+  .word 0x46f31973
+  .word 0x5ce89d6b
+  .word 0x1bcf4783
+  .word 0x9d558ae7
+  .word 0xbb284c9e
+  .word 0xc08c7c62
@@ -3,56 +3,280 @@
 /* SPDX-License-Identifier: Apache-2.0 */
 
 /**
- * This application runs X25519 with a sideloaded secret key.
+ * Elliptic-curve Diffie-Hellman (ECDH) on Curve25519 (X25519, RFC 7748).
  *
- * Computes X25519(k, u) according to RFC 7748, where:
- *   - k is the 256-bit value derived from the sideloaded key
- *   - u is the caller-provided Montgomery u-coordinate.
+ * Secret keys are 32-byte encoded scalars enc(k), handled in two boolean
+ * shares such that enc(k) = k0 ^ k1. Shared secrets are returned in two
+ * boolean shares in the same way. Note that the shares are combined before
+ * calling X25519, so the scalar multiplication itself is not masked.
  *
- * The key manager provides 384 bits of sideloaded data, expressed in 2 shares
- * across the special registers KEY_S0_L, KEY_S0_H, KEY_S1_L, and KEY_S1_H.
- * Since we only need 256 bits, the extra bits in KEY_S0_H and KEY_S1_H are
- * ignored and the encoded value of k, enc(k), is equal to KEY_S0_L ^ KEY_S1_L.
+ * Secret keys can also be sideloaded from the key manager, which provides 384
+ * bits of sideloaded data, expressed in 2 shares across the special registers
+ * KEY_S0_L, KEY_S0_H, KEY_S1_L, and KEY_S1_H. Since we only need 256 bits, the
+ * extra bits in KEY_S0_H and KEY_S1_H are ignored and the encoded value of k,
+ * enc(k), is equal to KEY_S0_L ^ KEY_S1_L. The caller must check that the key
+ * manager has finished generating the key before running a sideloaded mode.
  *
- * The caller must check that the key manager has finished generating the key
- * before attempting to run this application.
+ * This binary has the following modes of operation:
+ * 1. MODE_KEYPAIR_RANDOM: generate a random keypair
+ * 2. MODE_SHARED_KEY: compute shared key
+ * 3. MODE_KEYPAIR_FROM_SEED: generate keypair from a sideloaded seed
+ * 4. MODE_SHARED_KEY_FROM_SEED: compute shared key using sideloaded seed
  */
 
+/**
+ * Mode magic values generated with
+ * $ ./util/design/sparse-fsm-encode.py -d 6 -m 4 -n 11 \
+ *    --avoid-zero -s 3660400884
+ *
+ * Call the same utility with the same arguments and a higher -m to generate
+ * additional value(s) without changing the others or sacrificing mutual HD.
+ *
+ * TODO(#17727): in some places the OTBN assembler support for .equ directives
+ * is lacking, so they cannot be used in bignum instructions or pseudo-ops such
+ * as `li`. If support is added, we could use 32-bit values here instead of
+ * 11-bit.
+ */
+.equ MODE_KEYPAIR_RANDOM, 0x3f1
+.equ MODE_SHARED_KEY, 0x5ec
+.equ MODE_KEYPAIR_FROM_SEED, 0x29f
+.equ MODE_SHARED_KEY_FROM_SEED, 0x74b
+
 .section .text.start
+start:
+  /* Init all-zero register. */
+  bn.xor  w31, w31, w31
+
+  /* Read the mode and tail-call the requested operation. */
+  la      x2, mode
+  lw      x2, 0(x2)
+
+  addi    x3, x0, MODE_KEYPAIR_RANDOM
+  beq     x2, x3, keypair_random
+
+  addi    x3, x0, MODE_SHARED_KEY
+  beq     x2, x3, shared_key
+
+  addi    x3, x0, MODE_KEYPAIR_FROM_SEED
+  beq     x2, x3, keypair_from_seed
+
+  addi    x3, x0, MODE_SHARED_KEY_FROM_SEED
+  beq     x2, x3, shared_key_from_seed
+
+  /* Unsupported mode; fail. */
+  unimp
+  unimp
+  unimp
+
+/**
+ * Generate a fresh random keypair.
+ *
+ * Returns the secret key enc(k) in boolean shares k0, k1 and the public key
+ * enc(X25519(k, 9)).
+ *
+ * This routine runs in constant time (except potentially waiting for entropy
+ * from RND).
+ *
+ * @param[in]      w31: all-zero
+ * @param[out] dmem[k0]: First share of secret key.
+ * @param[out] dmem[k1]: Second share of secret key.
+ * @param[out]  dmem[u]: Public key (encoded u-coordinate).
+ *
+ * clobbered registers: x2, x3, w0, w1, w2 to w24
+ * clobbered flag groups: FG0
+ */
+keypair_random:
+  /* Generate secret key shares.
+       w0 <= k0
+       w1 <= k1 */
+  bn.wsrr  w0, RND
+  bn.wsrr  w1, RND
+
+  /* Store secret key shares.
+       dmem[k0] <= k0
+       dmem[k1] <= k1 */
+  li       x2, 0
+  la       x3, k0
+  bn.sid   x2, 0(x3)
+  li       x2, 1
+  la       x3, k1
+  bn.sid   x2, 0(x3)
+
+  /* Tail-call public key generation. */
+  jal      x0, public_key
+
+/**
+ * Generate a keypair from a keymgr-derived seed.
+ *
+ * The secret key is enc(k) = KEY_S0_L ^ KEY_S1_L; the upper halves of the
+ * sideloaded key are ignored. Only the public key is returned.
+ *
+ * This routine runs in constant time.
+ *
+ * @param[in]      w31: all-zero
+ * @param[out]  dmem[u]: Public key (encoded u-coordinate).
+ *
+ * clobbered registers: x2, x3, w0, w1, w2 to w24
+ * clobbered flag groups: FG0
+ */
+keypair_from_seed:
+  /* w0, w1 <= KEY_S0_L, KEY_S1_L */
+  bn.wsrr  w0, KEY_S0_L
+  bn.wsrr  w1, KEY_S1_L
+
+  /* Fall through to public key generation. */
+
+/**
+ * Compute the public key for the secret key in shares w0, w1.
+ *
+ * @param[in]      w0: First share of secret key.
+ * @param[in]      w1: Second share of secret key.
+ * @param[out] dmem[u]: Public key (encoded u-coordinate).
+ */
+public_key:
+  /* w8 <= w0 ^ w1 = enc(k) */
+  bn.xor   w8, w0, w1
+
+  /* w9 <= 9 = enc(u) for the base point */
+  bn.addi  w9, w31, 9
 
-main:
-  /* w7 <= KEY_S0_L */
-  bn.wsrr w7, 4
-  /* w8 <= KEY_S1_L */
-  bn.wsrr w8, 6
-  /* w8 <= KEY_S0_L ^ KEY_S1_L = enc(k) */
-  bn.xor  w8, w7, w8
+  /* w22 <= enc(X25519(k, 9)) */
+  jal      x1, X25519
 
-  /* w9 <= dmem[enc_u] = enc(u) */
-  li      x2, 9
-  la      x3, enc_u
-  bn.lid  x2, 0(x3)
+  /* dmem[u] <= w22 */
+  li       x2, 22
+  la       x3, u
+  bn.sid   x2, 0(x3)
+
+  ecall
+
+/**
+ * Generate a shared key from a secret and public key.
+ *
+ * Returns the shared key enc(X25519(k, u)) in boolean shares z0, z1.
+ *
+ * As described in RFC 7748, section 5, the public key does not need to be
+ * validated. The caller may reject an all-zero shared key.
+ *
+ * This routine runs in constant time.
+ *
+ * @param[in]      w31: all-zero
+ * @param[in]  dmem[k0]: First share of secret key.
+ * @param[in]  dmem[k1]: Second share of secret key.
+ * @param[in]   dmem[u]: Public key (encoded u-coordinate).
+ * @param[out] dmem[z0]: First share of shared key.
+ * @param[out] dmem[z1]: Second share of shared key.
+ *
+ * clobbered registers: x2, x3, w0, w1, w2 to w24
+ * clobbered flag groups: FG0
+ */
+shared_key:
+  /* Load secret key shares.
+       w0 <= dmem[k0]
+       w1 <= dmem[k1] */
+  li       x2, 0
+  la       x3, k0
+  bn.lid   x2, 0(x3)
+  li       x2, 1
+  la       x3, k1
+  bn.lid   x2, 0(x3)
+
+  /* Fall through to shared key generation. */
+
+/**
+ * Compute the shared key for the secret key in shares w0, w1.
+ *
+ * @param[in]       w0: First share of secret key.
+ * @param[in]       w1: Second share of secret key.
+ * @param[in]   dmem[u]: Public key (encoded u-coordinate).
+ * @param[out] dmem[z0]: First share of shared key.
+ * @param[out] dmem[z1]: Second share of shared key.
+ */
+shared_key_shares:
+  /* w8 <= w0 ^ w1 = enc(k) */
+  bn.xor   w8, w0, w1
+
+  /* w9 <= dmem[u] = enc(u) */
+  li       x2, 9
+  la       x3, u
+  bn.lid   x2, 0(x3)
 
   /* w22 <= enc(X25519(k, u)) */
-  jal     x1, X25519
+  jal      x1, X25519
 
-  /* dmem[enc_result] <= w22 = enc(X25519(k, u)) */
-  li      x2, 22
-  la      x3, enc_result
-  bn.sid  x2, 0(x3)
+  /* Split the result into boolean shares.
+       w1 <= URND
+       w0 <= w22 ^ w1 */
+  bn.wsrr  w1, URND
+  bn.xor   w0, w22, w1
+
+  /* dmem[z0] <= w0
+     dmem[z1] <= w1 */
+  li       x2, 0
+  la       x3, z0
+  bn.sid   x2, 0(x3)
+  li       x2, 1
+  la       x3, z1
+  bn.sid   x2, 0(x3)
 
   ecall
 
-.data
+/**
+ * Generate a shared key from a keymgr-derived seed.
+ *
+ * Returns the shared key enc(X25519(k, u)) in boolean shares z0, z1, where
+ * enc(k) = KEY_S0_L ^ KEY_S1_L.
+ *
+ * This routine runs in constant time.
+ *
+ * @param[in]      w31: all-zero
+ * @param[in]   dmem[u]: Public key (encoded u-coordinate).
+ * @param[out] dmem[z0]: First share of shared key.
+ * @param[out] dmem[z1]: Second share of shared key.
+ *
+ * clobbered registers: x2, x3, w0, w1, w2 to w24
+ * clobbered flag groups: FG0
+ */
+shared_key_from_seed:
+  /* w0, w1 <= KEY_S0_L, KEY_S1_L */
+  bn.wsrr  w0, KEY_S0_L
+  bn.wsrr  w1, KEY_S1_L
+
+  /* Tail-call shared-key generation. */
+  jal      x0, shared_key_shares
+
+.bss
+
+/* Operational mode. */
+.globl mode
+.balign 4
+mode:
+  .zero 4
+
+/* Public key (encoded u-coordinate). */
+.globl u
+.balign 32
+u:
+  .zero 32
+
+/* Secret key (enc(k)) in two shares: enc(k) = k0 ^ k1. */
+.globl k0
+.balign 32
+k0:
+  .zero 32
+
+.globl k1
+.balign 32
+k1:
+  .zero 32
 
-/* Input Montgomery u-coordinate (encoded, 256 bits). */
-.globl enc_u
+/* Shared key in two shares: enc(X25519(k, u)) = z0 ^ z1. */
+.globl z0
 .balign 32
-enc_u:
-.zero 32
+z0:
+  .zero 32
 
-/* Output Montgomery u-coordinate (encoded, 256 bits). */
-.globl enc_result
+.globl z1
 .balign 32
-enc_result:
-.zero 32
+z1:
+  .zero 32
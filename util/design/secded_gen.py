@@ -32,21 +32,169 @@ C_SRC_TOP = """
 #include "secded_enc.h"
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SECDED_ENC_AVX2 1
+#endif
+
 // Calculates even parity for a 64-bit word
 static uint8_t calc_parity(uint64_t word, bool invert) {
-  bool parity = false;
+  return (uint8_t)__builtin_parityll(word) ^ invert;
+}
+
+// Corrects the data bit whose error gives `syndrome`, if any. `syndromes` holds
+// the syndrome of an error in each of the `k` data bits.
+static void correct_bytes(uint8_t *bytes, size_t num_bytes, uint8_t syndrome,
+                          const uint8_t *syndromes, int k) {
+  uint64_t flip = 0;
+  for (int i = 0; i < k; ++i) {
+    flip |= (uint64_t)(syndrome == syndromes[i]) << i;
+  }
+  for (size_t i = 0; i < num_bytes; ++i) {
+    bytes[i] ^= (uint8_t)(flip >> (8 * i));
+  }
+}
+
+// Error status from the syndrome of a Hsiao code. Bit 0: single error, bit 1:
+// double error.
+static uint8_t hsiao_err(uint8_t syndrome) {
+  uint8_t single = calc_parity(syndrome, false);
+  return single | ((!single && syndrome) << 1);
+}
+
+// Error status from the syndrome of a Hamming code with `m` integrity bits.
+// Bit 0: single error, bit 1: double error.
+static uint8_t hamming_err(uint8_t syndrome, int m) {
+  uint8_t single = (syndrome >> (m - 1)) & 1;
+  uint8_t others = syndrome & ((1 << (m - 1)) - 1);
+  return single | ((!single && others) << 1);
+}
 
-  while (word) {
-    if (word & 1) {
-      parity = !parity;
+// Lookup tables for the batch encoders. As the codes are linear, apart from
+// the inverted integrity bits, the integrity bits of a word are `inv` XORed
+// with nibbles[i][v] for each nibble i of the word with value v.
+typedef struct enc_batch_tables {
+  bool ready;
+  uint8_t inv;
+  uint8_t nibbles[16][16];
+} enc_batch_tables_t;
+
+typedef uint8_t (*enc_fn_t)(const uint8_t *bytes);
+
+static void enc_batch_tables_init(enc_batch_tables_t *tables, enc_fn_t enc,
+                                  size_t word_size) {
+  uint8_t bytes[8] = {0};
+  tables->inv = enc(bytes);
+  for (size_t i = 0; i < 2 * word_size; ++i) {
+    for (uint8_t v = 0; v < 16; ++v) {
+      bytes[i / 2] = v << (4 * (i % 2));
+      tables->nibbles[i][v] = enc(bytes) ^ tables->inv;
     }
+    bytes[i / 2] = 0;
+  }
+  tables->ready = true;
+}
 
-    word >>= 1;
+static uint64_t load_word(const void *words, size_t word_size, size_t i) {
+  switch (word_size) {
+    case 2:
+      return ((const uint16_t *)words)[i];
+    case 4:
+      return ((const uint32_t *)words)[i];
+    default:
+      return ((const uint64_t *)words)[i];
   }
+}
 
-  return parity ^ invert;
+#ifdef SECDED_ENC_AVX2
+// Encodes words 4 at a time, looking up the integrity bits of all their
+// nibbles with byte shuffles. The table for byte i of a word is applied to all
+// bytes, then only byte i of each word is kept. The integrity bits of a word
+// are then the XOR of its bytes.
+__attribute__((target("avx2"))) static size_t enc_batch_avx2(
+    const enc_batch_tables_t *tables, const void *words, size_t word_size,
+    uint8_t *ecc, size_t num_words) {
+  __m256i lo_tables[8], hi_tables[8], byte_masks[8];
+  for (size_t i = 0; i < word_size; ++i) {
+    lo_tables[i] = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)tables->nibbles[2 * i]));
+    hi_tables[i] = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)tables->nibbles[2 * i + 1]));
+    byte_masks[i] = _mm256_set1_epi64x((int64_t)((uint64_t)0xff << (8 * i)));
+  }
+  const __m256i nibble_mask = _mm256_set1_epi8(0x0f);
+
+  size_t i = 0;
+  for (; i + 4 <= num_words; i += 4) {
+    __m256i w;
+    switch (word_size) {
+      case 2:
+        w = _mm256_cvtepu16_epi64(
+            _mm_loadl_epi64((const __m128i *)((const uint16_t *)words + i)));
+        break;
+      case 4:
+        w = _mm256_cvtepu32_epi64(
+            _mm_loadu_si128((const __m128i *)((const uint32_t *)words + i)));
+        break;
+      default:
+        w = _mm256_loadu_si256((const __m256i *)((const uint64_t *)words + i));
+        break;
+    }
+    __m256i lo = _mm256_and_si256(w, nibble_mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(w, 4), nibble_mask);
+
+    __m256i acc = _mm256_setzero_si256();
+    for (size_t j = 0; j < word_size; ++j) {
+      __m256i bits = _mm256_xor_si256(_mm256_shuffle_epi8(lo_tables[j], lo),
+                                      _mm256_shuffle_epi8(hi_tables[j], hi));
+      acc = _mm256_xor_si256(acc, _mm256_and_si256(bits, byte_masks[j]));
+    }
+    acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 32));
+    acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 16));
+    acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 8));
+
+    uint64_t out[4];
+    _mm256_storeu_si256((__m256i *)out, acc);
+    for (int j = 0; j < 4; ++j) {
+      ecc[i + j] = (uint8_t)out[j] ^ tables->inv;
+    }
+  }
+  return i;
+}
+#endif
+
+// Encodes `num_words` words of `word_size` bytes with `enc`, using AVX2 if the
+// host supports it.
+static void enc_batch(enc_batch_tables_t *tables, enc_fn_t enc,
+                      const void *words, size_t word_size, uint8_t *ecc,
+                      size_t num_words) {
+  size_t i = 0;
+
+#ifdef SECDED_ENC_AVX2
+  static int has_avx2 = -1;
+  if (has_avx2 < 0) {
+    __builtin_cpu_init();
+    has_avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+  }
+  if (has_avx2) {
+    if (!tables->ready) {
+      enc_batch_tables_init(tables, enc, word_size);
+    }
+    i = enc_batch_avx2(tables, words, word_size, ecc, num_words);
+  }
+#endif
+
+  for (; i < num_words; ++i) {
+    uint64_t word = load_word(words, word_size, i);
+    uint8_t bytes[8];
+    for (size_t j = 0; j < word_size; ++j) {
+      bytes[j] = (uint8_t)(word >> (8 * j));
+    }
+    ecc[i] = enc(bytes);
+  }
 }
 """
 
@@ -54,15 +202,26 @@ C_H_TOP = """
 #ifndef OPENTITAN_HW_IP_PRIM_DV_PRIM_SECDED_SECDED_ENC_H_
 #define OPENTITAN_HW_IP_PRIM_DV_PRIM_SECDED_SECDED_ENC_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif  // __cplusplus
 
-// Integrity encode functions for varying bit widths matching the functionality
-// of the RTL modules of the same name. Each takes an array of bytes in
-// little-endian order and returns the calculated integrity bits.
+// Integrity encode and decode functions for varying bit widths matching the
+// functionality of the RTL modules of the same name.
+//
+// The enc_* functions take an array of bytes in little-endian order and return
+// the calculated integrity bits.
+//
+// The dec_* functions take the same bytes and the integrity bits read with
+// them. They correct a single bit error in the bytes in place and return the
+// error status like the RTL decoder: bit 0 is set for a single error and bit 1
+// for a double error.
+//
+// The enc_*_batch functions calculate the integrity bits of each of an array
+// of words, using AVX2 where the host supports it.
 
 """
 
@@ -437,13 +596,13 @@ def generate(cfgs, args):
 
     with open(c_src_filename, "w") as f:
         f.write(COPYRIGHT)
-        f.write("// SECDED encode code generated by\n")
+        f.write("// SECDED encode and decode code generated by\n")
         f.write(f"// util/design/secded_gen.py from {SECDED_CFG_FILE}\n\n")
         f.write(C_SRC_TOP)
 
     with open(c_h_filename, "w") as f:
         f.write(COPYRIGHT)
-        f.write("// SECDED encode code generated by\n")
+        f.write("// SECDED encode and decode code generated by\n")
         f.write(f"// util/design/secded_gen.py from {SECDED_CFG_FILE}\n")
         f.write(C_H_TOP)
 
@@ -459,10 +618,9 @@ def generate(cfgs, args):
         # write out rtl files
         write_enc_dec_files(n, k, m, codes, suffix, args.outdir, codetype)
 
-        # write out C files, only hsiao codes are supported
-        if codetype in ["hsiao", "inv_hsiao"]:
-            write_c_files(n, k, m, codes, suffix, c_src_filename, c_h_filename,
-                          codetype)
+        # write out C files
+        write_c_files(n, k, m, codes, suffix, c_src_filename, c_h_filename,
+                      codetype)
 
         # write out all-zero word values for all codes
         pkg_type_str += print_pkg_allzero(n, k, m, codes, suffix, codetype)
@@ -631,6 +789,24 @@ def bytes_to_c_type(num_bytes):
     return None
 
 
+def calc_c_enc_masks(k, m, codes):
+    """Masks of the data bits that each integrity bit is the parity of.
+
+    The Hamming codes include earlier integrity bits in the last one. As those
+    are parities of data bits themselves, fold their masks into its mask.
+    """
+    data_mask = (1 << k) - 1
+    masks = []
+    for j, mask in enumerate(calc_bitmasks(k, m, codes, False)):
+        data_bits = mask & data_mask
+        for i in range(j):
+            if (mask >> (k + i)) & 1:
+                data_bits ^= masks[i]
+        assert (mask >> (k + j)) == 0
+        masks.append(data_bits)
+    return masks
+
+
 def write_c_files(n, k, m, codes, suffix, c_src_filename, c_h_filename,
                   codetype):
     in_bytes = math.ceil(k / 8)
@@ -646,13 +822,18 @@ def write_c_files(n, k, m, codes, suffix, c_src_filename, c_h_filename,
     out_type = bytes_to_c_type(out_bytes)
 
     assert in_type
-    assert out_type
-    assert codetype in ["hsiao", "inv_hsiao"]
-    invert = (codetype == "inv_hsiao")
+    assert out_type == "uint8_t"
+    invert = codetype in ["inv_hsiao", "inv_hamming"]
+    hamming = codetype in ["hamming", "inv_hamming"]
+
+    enc_name = f"enc_secded{suffix}_{n}_{k}"
+    dec_name = f"dec_secded{suffix}_{n}_{k}"
+    syndromes_name = "kSyndromes{}{}_{}".format(
+        "".join(w.capitalize() for w in suffix.split("_")), n, k)
 
     with open(c_src_filename, "a") as f:
         # Write out function prototype in src
-        f.write(f"\n{out_type} enc_secded{suffix}_{n}_{k}"
+        f.write(f"\n{out_type} {enc_name}"
                 f"(const uint8_t bytes[{in_bytes}]) {{\n")
 
         # Form a single word from the incoming byte data
@@ -664,7 +845,7 @@ def write_c_files(n, k, m, codes, suffix, c_src_filename, c_h_filename,
         # AND the word with the codes, calculating parity of each and combine
         # into a single word of integrity bits
         f.write("return ")
-        parity_bit_masks = enumerate(calc_bitmasks(k, m, codes, False))
+        parity_bit_masks = enumerate(calc_c_enc_masks(k, m, codes))
         # Add ECC bit inversion if needed (see print_enc function).
         f.write(" | ".join(
                 [f"(calc_parity(word & 0x{mask:x}, "
@@ -673,10 +854,52 @@ def write_c_files(n, k, m, codes, suffix, c_src_filename, c_h_filename,
 
         f.write(";\n}\n")
 
+        # Syndromes of single errors in the data bits (see print_dec function)
+        f.write(f"\nstatic const uint8_t {syndromes_name}[{k}] = {{")
+        f.write(", ".join(
+                [f"0x{calc_syndrome(codes[i]):02x}" for i in range(k)]))
+        f.write("};\n")
+
+        # The syndrome is the difference between the integrity bits read and
+        # those of the data read, as the inversion cancels out. The last
+        # Hamming syndrome bit also covers the other integrity bits read, but
+        # the integrity bits of the data cover the other calculated integrity
+        # bits instead, so also add their difference.
+        f.write(f"\n{out_type} {dec_name}"
+                f"(uint8_t bytes[{in_bytes}], {out_type} ecc) {{\n")
+        if m < 8:
+            f.write(f"{out_type} syndrome = ({enc_name}(bytes) ^ ecc) & "
+                    f"0x{(1 << m) - 1:x};\n")
+        else:
+            f.write(f"{out_type} syndrome = {enc_name}(bytes) ^ ecc;\n")
+        for j, mask in enumerate(calc_bitmasks(k, m, codes, True)):
+            others = (mask >> k) & ~(1 << j)
+            if others:
+                f.write(f"syndrome ^= calc_parity(syndrome & 0x{others:x}, "
+                        f"false) << {j};\n")
+        f.write(f"\ncorrect_bytes(bytes, {in_bytes}, syndrome, "
+                f"{syndromes_name}, {k});\n")
+        if hamming:
+            f.write(f"return hamming_err(syndrome, {m});\n")
+        else:
+            f.write("return hsiao_err(syndrome);\n")
+        f.write("}\n")
+
+        f.write(f"\nvoid {enc_name}_batch(const {in_type} *words, "
+                f"{out_type} *ecc, size_t num_words) {{\n")
+        f.write("static enc_batch_tables_t tables;\n")
+        f.write(f"enc_batch(&tables, {enc_name}, words, sizeof(*words), ecc, "
+                "num_words);\n")
+        f.write("}\n")
+
     with open(c_h_filename, "a") as f:
-        # Write out function declaration in header
-        f.write(f"{out_type} enc_secded{suffix}_{n}_{k}"
+        # Write out function declarations in header
+        f.write(f"{out_type} {enc_name}"
                 f"(const uint8_t bytes[{in_bytes}]);\n")
+        f.write(f"{out_type} {dec_name}"
+                f"(uint8_t bytes[{in_bytes}], {out_type} ecc);\n")
+        f.write(f"void {enc_name}_batch(const {in_type} *words, "
+                f"{out_type} *ecc, size_t num_words);\n")
 
 
 def format_c_files(c_src_filename, c_h_filename):